@@ -26,6 +26,7 @@ namespace antares {
 struct Directories {
     sfz::String root;
 
+    sfz::String cache;
     sfz::String downloads;
     sfz::String registry;
     sfz::String replays;
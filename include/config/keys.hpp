@@ -19,6 +19,8 @@
 #ifndef ANTARES_CONFIG_KEYS_HPP_
 #define ANTARES_CONFIG_KEYS_HPP_
 
+#include <sfz/sfz.hpp>
+
 #include "config/preferences.hpp"
 
 namespace antares {
@@ -36,6 +38,9 @@ class KeyMap {
     void clear();
 
   private:
+    friend void read_from(sfz::ReadSource in, KeyMap& keys);
+    friend void write_to(sfz::WriteTarget out, const KeyMap& keys);
+
     typedef uint8_t Data[32];
     static const size_t kDataSize = sizeof(Data);
 
@@ -44,6 +49,9 @@ class KeyMap {
     DISALLOW_COPY_AND_ASSIGN(KeyMap);
 };
 
+void read_from(sfz::ReadSource in, KeyMap& keys);
+void write_to(sfz::WriteTarget out, const KeyMap& keys);
+
 bool operator==(const KeyMap& a, const KeyMap& b);
 bool operator!=(const KeyMap& a, const KeyMap& b);
 
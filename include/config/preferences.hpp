@@ -47,6 +47,7 @@ class Preferences {
     bool fullscreen() const;
     Size screen_size() const;
     sfz::StringSlice scenario_identifier() const;
+    int32_t object_capacity() const;  // object slots per game; at least kMinSpaceObjectCapacity
 
     void set_key(size_t index, uint32_t key);
     void set_play_idle_music(bool on);
@@ -56,6 +57,7 @@ class Preferences {
     void set_fullscreen(bool fullscreen);
     void set_screen_size(Size size);
     void set_scenario_identifier(sfz::StringSlice id);
+    void set_object_capacity(int32_t capacity);
 
   private:
     static std::unique_ptr<Preferences> _preferences;
@@ -68,6 +70,7 @@ class Preferences {
     bool                _fullscreen;
     Size                _screen_size;
     sfz::String         _scenario_identifier;
+    int32_t             _object_capacity;
 };
 
 class PrefsDriver {
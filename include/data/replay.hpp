@@ -59,6 +59,33 @@ void write_to(sfz::WriteTarget out, const ReplayData& replay);
 void write_to(sfz::WriteTarget out, const ReplayData::Scenario& scenario);
 void write_to(sfz::WriteTarget out, const ReplayData::Action& action);
 
+// A sidecar to a replay, holding a snapshot of the game (see game/state.hpp) every `interval`
+// ticks, so that playback can begin partway through instead of at the start.
+struct ReplayIndex {
+    struct Keyframe {
+        uint64_t at;  // ticks since the start of the game
+        sfz::Bytes state;
+    };
+
+    int32_t chapter_id;
+    int32_t global_seed;
+    uint64_t interval;
+    std::vector<Keyframe> keyframes;
+
+    ReplayIndex();
+    ReplayIndex(sfz::BytesSlice in);
+
+    // Returns the latest keyframe at or before `at`, or NULL if there is none.
+    const Keyframe* find(uint64_t at) const;
+};
+void read_from(sfz::ReadSource in, ReplayIndex& index);
+void read_from(sfz::ReadSource in, ReplayIndex::Keyframe& keyframe);
+void write_to(sfz::WriteTarget out, const ReplayIndex& index);
+void write_to(sfz::WriteTarget out, const ReplayIndex::Keyframe& keyframe);
+
+// Returns the path of the index for the replay at `replay_path`.
+sfz::String replay_index_path(sfz::StringSlice replay_path);
+
 class ReplayBuilder : public EventReceiver {
   public:
     ReplayBuilder();
@@ -0,0 +1,62 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#ifndef ANTARES_DATA_RESOURCE_ARCHIVE_HPP_
+#define ANTARES_DATA_RESOURCE_ARCHIVE_HPP_
+
+#include <stdint.h>
+#include <sfz/sfz.hpp>
+
+namespace antares {
+
+// The name an archive is given in a scenario directory.
+extern const char kResourceArchiveName[];
+
+// A single file holding all of a scenario's resources.
+//
+// Archives let a scenario's resources be mapped once, rather than looked up and mapped one small
+// file at a time.  Entries are named by their paths relative to the scenario directory, such as
+// "sprites/500.json", and sorted by name, so that they can be found by binary search.
+class ResourceArchive {
+  public:
+    explicit ResourceArchive(const sfz::StringSlice& path);
+    ~ResourceArchive();
+
+    // Finds the resource at `resource_path`.
+    //
+    // @param [in] resource_path    the path of a resource, such as "sprites/500.json".
+    // @param [out] data            set to the resource's contents, if found.  Valid for as long
+    //                              as the archive is.
+    // @returns                     true if the archive has the resource.
+    bool find(const sfz::StringSlice& resource_path, sfz::BytesSlice& data) const;
+
+  private:
+    sfz::MappedFile _file;
+    sfz::BytesSlice _index;
+    uint32_t _count;
+
+    DISALLOW_COPY_AND_ASSIGN(ResourceArchive);
+};
+
+// Packs every file under `root`, other than archives, into a new archive at `path`.
+void write_resource_archive(const sfz::StringSlice& root, const sfz::StringSlice& path);
+
+}  // namespace antares
+
+#endif // ANTARES_DATA_RESOURCE_ARCHIVE_HPP_
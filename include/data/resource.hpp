@@ -33,9 +33,16 @@ class Resource {
     sfz::BytesSlice data() const;
 
   private:
-    std::unique_ptr<sfz::MappedFile> _file;
+    std::unique_ptr<sfz::MappedFile> _file;  // NULL if the resource came from an archive
+    sfz::BytesSlice _data;
 };
 
+// Returns the file that Resource(resource_path) would read from: the resource's own file, or the
+// archive holding it.  Nothing is mapped or read, so checking the file's size and modification
+// time is a cheap way to tell whether the resource may have changed.  Throws sfz::Exception if
+// there is no such resource.
+sfz::String resource_source(const sfz::PrintItem& resource_path);
+
 }  // namespace antares
 
 #endif // ANTARES_DATA_RESOURCE_HPP_
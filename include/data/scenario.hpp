@@ -149,10 +149,10 @@ struct Scenario {
 
     static const size_t byte_size = 124;
 
-    InitialObject* initial(size_t at) const;
-    Condition* condition(size_t at) const;
+    const InitialObject* initial(size_t at) const;
+    const Condition* condition(size_t at) const;
 
-    BriefPoint* brief_point(size_t at) const;
+    const BriefPoint* brief_point(size_t at) const;
     size_t brief_point_size() const;
 
     int32_t angle() const;
@@ -173,8 +173,6 @@ void print_to(sfz::PrintTarget out, ScenarioName name);
 struct Scenario::InitialObject {
     int32_t         type;
     int32_t         owner;
-    int32_t         realObjectNumber;
-    int32_t         realObjectID;
     Point           location;
     Fixed           earning;
     int32_t         distanceRange;
@@ -214,9 +212,6 @@ struct Scenario::Condition {
     int32_t         direction;
 
     static const size_t byte_size = 38;
-
-    bool true_yet() const;
-    void set_true_yet(bool state);
 };
 void read_from(sfz::ReadSource in, Scenario::Condition& scenario_condition);
 void read_from(sfz::ReadSource in, Scenario::Condition::CounterArgument& counter_argument);
@@ -29,7 +29,10 @@
 
 namespace antares {
 
-const int32_t kMaxSpaceObject           = 250;
+// Object slots given to every scenario, as in the original engine.  More can be asked for with
+// Preferences::object_capacity(), but replays only play back with the capacity they were
+// recorded with.
+const int32_t kMinSpaceObjectCapacity   = 250;
 
 const int32_t kTimeToCheckHome          = 900;
 
@@ -612,9 +615,32 @@ enum dutyType {
 //typedef beamTypeStruct;
 
 
+// The kinematic state of a space object.  It is kept out of spaceObjectType, in an array
+// parallel to the objects themselves, so that the per-unit motion passes walk densely-packed
+// records instead of striding over whole objects.
+struct spaceObjectMotionType {
+    coordPointType          location;
+    fixedPointType          velocity;
+    fixedPointType          motionFraction;
+    Fixed                   maxVelocity;
+    Fixed                   thrust;
+    int32_t                 direction;
+    Fixed                   turnVelocity;
+    Fixed                   turnFraction;
+    coordPointType          lastLocation;
+    int32_t                 lastDir;
+};
+
 struct spaceObjectType {
     uint32_t                attributes;
     baseObjectType          *baseType;
+    spaceObjectMotionType   *motion;
+
+    // Checked by the motion passes for every object, so kept on the same line as attributes.
+    int16_t                 active;
+    kPresenceStateType      presenceState;
+    int32_t                 presenceData;
+
     int32_t                 whichBaseObject;
     int32_t                 entryNumber;            // major hack?
 
@@ -623,16 +649,10 @@ struct spaceObjectType {
     int32_t                 tinySize;
     RgbColor                tinyColor;
 
-    int32_t                 direction;
     int32_t                 directionGoal;
-    Fixed                   turnVelocity;
-    Fixed                   turnFraction;
 
     int32_t                 offlineTime;
 
-    coordPointType          location;
-    coordPointType          lastLocation;
-    int32_t                 lastDir;
     spaceObjectType*        collideObject;
     Point                   collisionGrid;
     spaceObjectType*        nextNearObject;
@@ -665,10 +685,6 @@ struct spaceObjectType {
     fixedPointType          idealLocationCalc;  // calced when we got origin
     coordPointType          originLocation;     // coords of our origin
 
-    fixedPointType          motionFraction;
-    fixedPointType          velocity;
-    Fixed                   thrust;
-    Fixed                   maxVelocity;
     Point                   scaledCornerOffset;
     Point                   scaledSize;
     Rect                absoluteBounds;
@@ -707,7 +723,6 @@ struct spaceObjectType {
     int16_t                 pulseCharge;
     int16_t                 beamCharge;
     int16_t                 specialCharge;
-    int16_t                 active;
 
     int32_t                 warpEnergyCollected;
 
@@ -727,9 +742,6 @@ struct spaceObjectType {
     int32_t                 shortestWeaponRange;
     int32_t                 engageRange;            // either longestWeaponRange or kEngageRange
 
-    kPresenceStateType      presenceState;
-    int32_t                 presenceData;
-
     int32_t                 hitState;
     int32_t                 cloakState;
     dutyType                duty;
@@ -0,0 +1,58 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_DRAWING_PIX_KERNELS_HPP_
+#define ANTARES_DRAWING_PIX_KERNELS_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "drawing/color.hpp"
+
+namespace antares {
+
+// Loops over runs of pixels, which PixMap applies row by row.
+//
+// There is one set of kernels per instruction set: scalar ones, which are always present, and
+// SSE2, AVX2 or NEON ones, where the compiler and CPU have them.  All sets give bit-for-bit
+// identical results; `pix_kernels()` picks the fastest the CPU supports, once, at first use.
+struct PixKernels {
+    const char* name;
+
+    // Sets the `count` pixels at `dst` to `color`.
+    void (*fill)(RgbColor* dst, size_t count, const RgbColor& color);
+
+    // Draws the `count` pixels at `src` over those at `dst`, as in `PixMap::composite()`.  Where
+    // both are fully transparent, the result is RgbColor(0, 0, 0, 0).
+    void (*composite)(RgbColor* dst, const RgbColor* src, size_t count);
+
+    // Converts `count` pixels of 32-bit BGRA at `src`, as OpenGL reads them back, into opaque
+    // pixels at `dst`.  The source alpha is ignored.
+    void (*convert_bgra)(RgbColor* dst, const uint8_t* src, size_t count);
+};
+
+// The kernels in use.
+const PixKernels& pix_kernels();
+
+// Every set of kernels that this CPU can run, scalar first.  For tests and benchmarks.
+std::vector<const PixKernels*> available_pix_kernels();
+
+}  // namespace antares
+
+#endif  // ANTARES_DRAWING_PIX_KERNELS_HPP_
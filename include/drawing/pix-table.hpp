@@ -32,13 +32,27 @@ class NatePixTable {
   public:
     class Frame;
 
+    // Decoding a table only touches memory, so it may happen on any thread.  Building it creates
+    // its sprites with the video driver, so must happen on the main thread, before it is drawn.
     NatePixTable(int id, uint8_t color);
     ~NatePixTable();
+    void build();
 
     const Frame& at(size_t index) const;
     size_t size() const;
 
+    // Once set, tables are saved under `dir` after they are first decoded, already sliced into
+    // frames and tinted, and loaded from there while the sprite's resources are unchanged.  An
+    // empty `dir` (the default) turns the cache off.
+    static void set_cache_dir(const sfz::StringSlice& dir);
+
   private:
+    bool load_cache(const sfz::StringSlice& path, int id);
+    void save_cache(const sfz::StringSlice& path, int id,
+                    const sfz::StringSlice& image, const sfz::StringSlice& overlay,
+                    const sfz::Sha1::Digest& digest) const;
+
+    int _id;
     size_t _size;
     std::vector<Frame> _frames;
 
@@ -50,6 +64,7 @@ class NatePixTable::Frame {
     Frame(Rect bounds, const PixMap& image, int16_t id, int frame);
     Frame(Rect bounds, const PixMap& image, int16_t id, int frame,
           const PixMap& overlay, uint8_t color);
+    Frame(Rect bounds, const sfz::BytesSlice& pixels, int16_t id, int frame);
     Frame(Frame&&) = default;
     ~Frame();
     
@@ -60,8 +75,11 @@ class NatePixTable::Frame {
     const Sprite& sprite() const;
 
   private:
+    friend class NatePixTable;
+
     void load_image(const PixMap& pix);
     void load_overlay(const PixMap& pix, uint8_t color);
+    void load_pixels(const sfz::BytesSlice& pixels);
     void build(int16_t id, int frame);
 
     Rect _bounds;
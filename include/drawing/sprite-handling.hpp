@@ -19,12 +19,15 @@
 #ifndef ANTARES_DRAWING_SPRITE_HANDLING_HPP_
 #define ANTARES_DRAWING_SPRITE_HANDLING_HPP_
 
+#include <vector>
+
 #include "drawing/color.hpp"
 #include "drawing/pix-table.hpp"
 
 namespace antares {
 
 const int32_t kNoSpriteTable = -1;
+const size_t kMinSpriteNum = 500;
 
 const int16_t kSpriteTableColorShift = 11;
 const int16_t kSpriteTableColorIDMask = 0x7800;  // bits 11-14
@@ -83,8 +86,6 @@ struct spriteType {
     spriteType();
 };
 
-extern int32_t gAbsoluteScale;
-
 // Scale `value` by `scale`.
 //
 // The regular variant calculates the final scale as ``(value * scale) / 4096``.  The evil variant
@@ -95,20 +96,31 @@ int32_t evil_scale_by(int32_t value, int32_t scale);
 
 void SpriteHandlingInit();
 void ResetAllSprites();
+void SetSpriteCapacity(size_t count);
 Rect scale_sprite_rect(const NatePixTable::Frame& frame, Point where, int32_t scale);
 void ResetAllPixTables();
 void SetAllPixTablesNoKeep();
-void KeepPixTable(int16_t resource_id);
+bool KeepPixTable(int16_t resource_id);    // false if the table isn't loaded
 void RemoveAllUnusedPixTables();
 NatePixTable* AddPixTable(int16_t resource_id);
+
+// Loads all of the tables in `resource_ids` that aren't already loaded.  The same as calling
+// AddPixTable() on each, except that the tables are decoded in parallel.
+void LoadPixTables(std::vector<int16_t> resource_ids);
 NatePixTable* GetPixTable(int16_t resource_id);
 spriteType *AddSprite(
         Point where, NatePixTable* table, int16_t resID, int16_t whichShape, int32_t scale, int32_t size,
         int16_t layer, const RgbColor& color, int32_t *whichSprite);
 void RemoveSprite(spriteType *);
+int32_t GetSpriteIndex(const spriteType* sprite);   // -1 for NULL
+spriteType* GetSpriteAtIndex(int32_t index);        // NULL for -1
 void draw_sprites();
 void CullSprites();
 
+// The sprite part of save_state() and restore_state().
+void write_sprites(sfz::WriteTarget out);
+void read_sprites(sfz::ReadSource in);
+
 }  // namespace antares
 
 #endif // ANTARES_DRAWING_SPRITE_HANDLING_HPP_
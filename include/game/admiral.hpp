@@ -128,6 +128,10 @@ void ResetAllDestObjectData();
 destBalanceType* mGetDestObjectBalancePtr(int32_t whichObject);
 admiralType* mGetAdmiralPtr(int32_t mwhichAdmiral);
 
+// Saves and restores every admiral and destination balance entry, for game/state.hpp.
+void write_admirals(sfz::WriteTarget out);
+void read_admirals(sfz::ReadSource in);
+
 int32_t MakeNewAdmiral(
         int32_t flagship, int32_t destinationObject, destinationType dType, uint32_t attributes,
         int32_t race, int16_t nameResID, int16_t nameStrNum, Fixed earningPower);
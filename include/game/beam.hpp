@@ -20,6 +20,7 @@
 #define ANTARES_GAME_BEAM_HPP_
 
 #include <stdint.h>
+#include <sfz/sfz.hpp>
 
 #include "math/geometry.hpp"
 
@@ -80,8 +81,13 @@ class Beams {
     static void draw();
     static void show_all();
     static void cull();
-  private:
-    static std::unique_ptr<beamType[]> _data;
+
+    static int32_t index_of(const beamType* beam);  // -1 for NULL
+    static beamType* at(int32_t index);             // NULL for -1
+
+    // The beam part of save_state() and restore_state().
+    static void write_to(sfz::WriteTarget out);
+    static void read_from(sfz::ReadSource in);
 };
 
 }  // namespace antares
@@ -20,12 +20,15 @@
 #define ANTARES_GAME_GLOBALS_HPP_
 
 #include <queue>
+#include <utility>
+#include <vector>
 #include <sfz/sfz.hpp>
 
 #include "config/keys.hpp"
 #include "data/scenario.hpp"
 #include "drawing/color.hpp"
 #include "game/starfield.hpp"
+#include "math/random.hpp"
 #include "sound/fx.hpp"
 #include "video/transitions.hpp"
 
@@ -76,10 +79,18 @@ struct hotKeyType {
     int32_t     objectID;
 };
 
+struct actionQueueType;
 struct admiralType;
+struct baseObjectType;
+struct beamType;
 struct destBalanceType;
+struct longMessageType;
 struct proximityUnitType;
+struct screenLabelType;
 struct scrollStarType;
+struct spaceObjectMotionType;
+struct spaceObjectType;
+struct spriteType;
 class InputSource;
 class StringList;
 
@@ -137,14 +148,7 @@ struct aresGlobalType {
     bool         gAutoPilotOff;          // hack for turning off auto in netgame
     int32_t         levelNum;
     uint32_t        keyMask;
-    scenarioInfoType    scenarioFileInfo;   // x-ares; for factory +
-                                            // 3rd party files
-    int32_t         maxScenarioBrief;
-    int32_t         maxScenarioCondition;
-    int32_t         maxScenarioInitial;
-    int32_t         maxBaseObject;
-    int32_t         maxObjectAction;
-    int32_t         scenarioNum;
+    int32_t         maxSpaceObject;
 
     hotKeyType      hotKey[kHotKeyNum];
     int32_t         hotKeyDownTime;
@@ -157,10 +161,130 @@ struct aresGlobalType {
 
     Starfield starfield;
     Transitions transitions;
+
+    Random          gRandomSeed;
+    int64_t         headless_ticks;
+
+    const Scenario* gThisScenario;
+    int32_t         gScenarioRotation;
+    int32_t         gAdmiralNumbers[kMaxPlayerNum];
+    // What became of each of gThisScenario's initial objects, and which of its conditions have
+    // been true, in this game.  The scenario itself is shared by every game in the process.
+    std::vector<int32_t>    gInitialObjectNumbers;  // -1 if not (yet) created
+    std::vector<int32_t>    gInitialObjectIDs;
+    std::vector<uint8_t>    gConditionTrueYet;
+    // The conditions CheckScenarioConditions() has to look at on its next pass, and what it
+    // remembers of each; see scenario-maker.cpp.
+    std::vector<uint64_t>   gConditionsToCheck;
+    std::vector<uint8_t>    gConditionState;
+    std::vector<int32_t>    gCounterConditions;
+    std::vector<int32_t>    gTimeConditions;        // soonest first
+    size_t                  gNextTimeCondition;     // the first one not yet due
+    std::vector<int32_t>    gBaseObjectMediaFlags;
+    std::vector<int16_t>    gPixTablesToLoad;   // found by the media check, loaded in parallel
+    std::unique_ptr<destBalanceType[]>   gDestBalanceData;
+
+    spaceObjectType*    gRootObject;
+    int32_t             gRootObjectNumber;
+    // This object is also used for the radar center, and for zoom to hostile and object modes.
+    // It would be preferable for it to be entirely private to the starfield.
+    spaceObjectType*    gScrollStarObject;
+    std::unique_ptr<spaceObjectType[]>       gSpaceObjectData;
+    std::unique_ptr<spaceObjectMotionType[]> gSpaceObjectMotionData;
+    // Stands in for a missing subject or direct object of an action; see space-object.cpp.
+    std::unique_ptr<spaceObjectType>         gZeroSpaceObject;
+    std::unique_ptr<spaceObjectMotionType>   gZeroSpaceObjectMotion;
+    std::unique_ptr<baseObjectType>          gZeroBaseObject;
+    // One bit per object slot, set while the slot's `active` is anything but kObjectAvailable.
+    // Allocation still takes the lowest free slot, as the linear scan it replaces did, so slot
+    // numbers (and everything that walks objects in slot order) come out the same.
+    std::vector<uint64_t>   gSpaceObjectSlots;
+    size_t                  gFirstOpenSlotWord;     // every word before this one is full
+    int32_t                 gSpaceObjectHighWater;  // no slot at or past this one has held an object
+    int32_t                 gDroppedSpaceObjects;   // objects not created for want of a slot
+    // The objects in occupied slots, by owner (in no particular order), and how many there are of
+    // each base type and owner.  Kept up to date as slots are occupied and released, and as
+    // objects change owner or base type; see CountObjectsOfBaseType() and ObjectsOfOwner().
+    std::vector<std::vector<int32_t>>   gObjectsByOwner;
+    std::vector<int32_t>                gObjectOwnerPosition;   // each object's place in its list
+    std::vector<int32_t>                gObjectCounts;
+    // Delayed actions hang off a timing wheel, one slot per tick, in the slot for their due
+    // time.  Entries are allocated in blocks, so that they stay put when the pool grows.
+    std::vector<std::unique_ptr<actionQueueType[]>>  gActionQueueBlocks;
+    actionQueueType*    gFreeActionQueue;
+    std::vector<actionQueueType*>   gActionWheel;
+    int64_t             gActionQueueTime;   // sum of the units passed to ExecuteActionQueue()
+
+    coordPointType  gGlobalCorner;
+    std::unique_ptr<proximityUnitType[]> gProximityGrid;
+    // One bit per unit of gProximityGrid with a non-empty near (or far) chain.  Most units are
+    // empty in most scenarios, so the collision passes only visit and clear the occupied ones.
+    std::vector<uint64_t>   gNearUnits;
+    std::vector<uint64_t>   gFarUnits;
+    // The objects in the distance grid, sorted by distance unit (row-major), then slot, for the
+    // proximity queries in motion.hpp.  Built by the first query after it is invalidated.
+    std::vector<std::pair<uint64_t, spaceObjectType*>>  gProximityIndex;
+    bool            gProximityIndexBuilt;
+
+    int32_t         gAbsoluteScale;
+    // Sprites are allocated in blocks, so that they stay put when the table grows.
+    std::vector<std::unique_ptr<spriteType[]>>   gSpriteBlocks;
+    size_t          gSpriteNum;
+    std::vector<uint64_t>   gSpriteSlots;           // one bit per slot, set while it has a table
+    size_t                  gFirstOpenSpriteWord;   // every word before this one is full
+    std::unique_ptr<beamType[]>      gBeamData;
+    std::unique_ptr<screenLabelType[]>   gLabelData;
+
+    std::queue<sfz::String>     gMessageData;
+    std::unique_ptr<longMessageType>    gLongMessageData;
+    int32_t         gMessageTimeCount;
+    int32_t         gMessageLabelNum;
+    int32_t         gStatusLabelNum;
+
+    KeyMap          gLastKeyMap;
+    int32_t         gDestKeyTime;
+    int32_t         gDestinationLabel;
+    int32_t         gAlarmCount;
+    int32_t         gSendMessageLabel;
+
+    coordPointType  gLastGlobalCorner;
+    std::unique_ptr<Point[]>     gRadarBlipData;
+    std::unique_ptr<int32_t[]>   gScaleList;
+    std::unique_ptr<int32_t[]>   gSectorLineData;
 };
 
+// Data loaded from the scenario files.  It is loaded once, before any game starts, and is
+// shared by every game in the process, along with the base objects, actions, scenarios and
+// sprite tables themselves.
+struct aresPluginType {
+    scenarioInfoType    scenarioFileInfo;   // x-ares; for factory +
+                                            // 3rd party files
+    int32_t         maxScenarioBrief;
+    int32_t         maxScenarioCondition;
+    int32_t         maxScenarioInitial;
+    int32_t         maxBaseObject;
+    int32_t         maxObjectAction;
+    int32_t         scenarioNum;
+};
+
+// The state of the game the calling thread is playing.  Each thread that plays a game needs
+// its own, entered with ScopedGlobals; init_globals() creates the one for the main thread.
 aresGlobalType* globals();
 void init_globals();
+int32_t globals_count();  // how many aresGlobalType exist, on any thread
+
+aresPluginType* plugin();
+
+class ScopedGlobals {
+  public:
+    explicit ScopedGlobals(aresGlobalType* game);
+    ~ScopedGlobals();
+
+  private:
+    aresGlobalType* const _saved;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedGlobals);
+};
 
 extern Rect world;
 extern Rect play_screen;
@@ -0,0 +1,92 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+#ifndef ANTARES_GAME_HEADLESS_HPP_
+#define ANTARES_GAME_HEADLESS_HPP_
+
+#include <stdint.h>
+#include <sfz/sfz.hpp>
+
+#include "data/scenario.hpp"
+#include "game/cursor.hpp"
+#include "game/main.hpp"
+#include "game/player-ship.hpp"
+
+namespace antares {
+
+class SyncRecorder;
+
+// Initializes the subsystems the simulation needs, without requiring a VideoDriver.  Stands in
+// for the init sequence of the interactive flows.
+void HeadlessInit();
+
+// Sets up the globals() of the calling thread for another game, sharing the data HeadlessInit()
+// loaded.  To play games on several threads, call HeadlessInit() once, then on each thread:
+//
+//     aresGlobalType game;
+//     ScopedGlobals scoped(&game);
+//     HeadlessInitGame();
+void HeadlessInitGame();
+
+// Returns the debriefing for the game that just ended, as `antares/replay` writes it: the text
+// of gScenarioWinner and, after a win, the score.  Empty if the game ended without any text.
+sfz::Bytes replay_debriefing(GameResult result, int32_t seconds);
+
+// Plays a scenario with no VideoDriver installed: nothing is drawn, and time advances by one
+// tick per call to step(), as fast as the simulation can run.  Input comes from
+// globals()->gInputSource, which should be set before construction, along with gRandomSeed.
+//
+// The per-tick sequence matches GamePlay::fire_timer() when it runs at one unit per tick (as
+// it does under the text and offscreen drivers), so the outcome and gSynchValue agree with
+// those of a rendered replay.
+class HeadlessGame {
+  public:
+    explicit HeadlessGame(const Scenario* scenario);
+
+    // Advances the game by one tick.  Returns false once the game is over.
+    bool step();
+
+    // Saves and restores the game with save_game() and restore_game() from game/state.hpp.
+    // restore_state() must be called on a HeadlessGame constructed from the same scenario as
+    // the one that was saved.
+    sfz::Bytes save_state() const;
+    void restore_state(sfz::BytesSlice state);
+
+    // If set, `recorder` gets a record at the end of every decide cycle.
+    void set_sync_recorder(SyncRecorder* recorder) { _sync_recorder = recorder; }
+
+    GameResult result() const { return _game_result; }
+    int32_t seconds() const { return _seconds; }
+    int64_t ticks() const { return _ticks; }
+
+  private:
+    GameCursor _cursor;
+    PlayerShip _player_ship;
+    const int64_t _scenario_start_time;
+    uint32_t _decide_cycle;
+    int _scenario_check_time;
+    int64_t _ticks;
+    GameResult _game_result;
+    int32_t _seconds;
+    SyncRecorder* _sync_recorder;
+
+    DISALLOW_COPY_AND_ASSIGN(HeadlessGame);
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_HEADLESS_HPP_
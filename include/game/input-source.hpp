@@ -34,6 +34,11 @@ class InputSource {
     virtual ~InputSource();
 
     virtual bool next(EventReceiver& key_map) = 0;
+
+    // Saves and restores the position within the input, so that a restored game picks up where
+    // the saved one left off.  Sources without a position need not override these.
+    virtual void save(sfz::WriteTarget out) const;
+    virtual void restore(sfz::ReadSource in);
 };
 
 class ReplayInputSource : public InputSource {
@@ -41,6 +46,8 @@ class ReplayInputSource : public InputSource {
     explicit ReplayInputSource(ReplayData* data);
 
     virtual bool next(EventReceiver& receiver);
+    virtual void save(sfz::WriteTarget out) const;
+    virtual void restore(sfz::ReadSource in);
 
   private:
     bool advance(EventReceiver& receiver);
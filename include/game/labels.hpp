@@ -25,6 +25,31 @@
 
 namespace antares {
 
+struct screenLabelType {
+    Point               where;
+    Point               offset;
+    Rect                thisRect;
+    int32_t             width;
+    int32_t             height;
+    int32_t             age;
+    sfz::String         text;
+    uint8_t             color;
+    bool                active;
+    bool                killMe;
+    bool                visible;
+    int32_t             whichObject;
+    spaceObjectType*    object;
+    bool                objectLink;     // true if label requires an object to be seen
+    int32_t             lineNum;
+    int32_t             lineHeight;
+    bool                keepOnScreenAnyway; // if not attached to object, keep on screen if it's off
+    bool                attachedHintLine;
+    Point               attachedToWhere;
+    int32_t             retroCount;
+
+    screenLabelType();
+};
+
 class Labels {
   public:
     static const int32_t kNone = -1;
@@ -56,9 +81,10 @@ class Labels {
     static void recalc_size(int32_t);
 
   private:
-    struct screenLabelType;
+    friend struct screenLabelType;
+
     static void zero(screenLabelType& label);
-    static screenLabelType* data;
+    static screenLabelType* data();  // the labels of the game in globals()
 };
 
 }  // namespace antares
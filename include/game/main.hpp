@@ -35,9 +35,10 @@ enum GameResult {
 
 class MainPlay : public Card {
   public:
+    // If `keyframe` is non-NULL, play begins from it instead of from the start of the scenario.
     MainPlay(
             const Scenario* scenario, bool replay, bool show_loading_screen,
-            GameResult* game_result, int32_t* seconds);
+            const ReplayIndex::Keyframe* keyframe, GameResult* game_result, int32_t* seconds);
 
     virtual void become_front();
 
@@ -53,6 +54,7 @@ class MainPlay : public Card {
     const Scenario* _scenario;
     const bool _replay;
     const bool _show_loading_screen;
+    const ReplayIndex::Keyframe* const _keyframe;
     bool _cancelled;
     GameResult* const _game_result;
     int32_t* const _seconds;
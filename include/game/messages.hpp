@@ -19,7 +19,6 @@
 #ifndef ANTARES_GAME_MESSAGES_HPP_
 #define ANTARES_GAME_MESSAGES_HPP_
 
-#include <queue>
 #include <sfz/sfz.hpp>
 
 #include "drawing/color.hpp"
@@ -36,6 +35,43 @@ const int16_t kAutoPilotOffString   = 10;
 const uint8_t kStatusLabelColor     = AQUA;
 const uint8_t kStatusWarnColor      = PINK;
 
+enum longMessageStageType {
+    kNoStage = 0,
+    kStartStage = 1,
+    kClipStage = 2,
+    kShowStage = 3,
+    kEndStage = 4
+};
+
+struct longMessageType {
+    longMessageStageType    stage;
+    int32_t                 charDelayCount;
+    Rect                    pictBounds;
+    int32_t                 pictDelayCount;
+    int32_t                 pictCurrentLeft;
+    int32_t                 pictCurrentTop;
+    int32_t                 time;
+    int32_t                 textHeight;
+    int16_t                 startResID;
+    int16_t                 endResID;
+    int16_t                 currentResID;
+    int16_t                 lastResID;
+    int16_t                 previousStartResID;
+    int16_t                 previousEndResID;
+    int16_t                 pictID;
+    uint8_t                 backColor;
+    sfz::String             stringMessage;
+    sfz::String             lastStringMessage;
+    bool                 newStringMessage;
+    sfz::String             text;
+    std::unique_ptr<StyledText> retro_text;
+    Point                   retro_origin;
+    int32_t                 at_char;
+    bool                 labelMessage;
+    bool                 lastLabelMessage;
+    int16_t                 labelMessageID;
+};
+
 class Messages {
   public:
     static void init();
@@ -43,6 +79,9 @@ class Messages {
     static void add(const sfz::PrintItem& message);
     static void start( int16_t, int16_t);
     static void clip();
+    // As clip(), but lays nothing out; for games with no VideoDriver.  Conditions can depend on
+    // which long message is showing, so they must still step through its stages.
+    static void clip_headless();
     static void end();
     static void advance();
     static void previous();
@@ -50,18 +89,15 @@ class Messages {
     static void set_status(const sfz::StringSlice& status, uint8_t color);
     static int16_t current();
 
+    // The long message part of save_state() and restore_state().  Only the state that conditions
+    // and the message keys can see is kept: which message is showing, and at what stage.
+    static void write_to(sfz::WriteTarget out);
+    static void read_from(sfz::ReadSource in);
+
     static void draw_long_message(int32_t time_pass);
     static void draw_message_screen(int32_t by_units);
     static void draw_message();
 
-  private:
-    struct longMessageType;
-
-    static std::queue<sfz::String> message_data;
-    static longMessageType* long_message_data;
-    static int32_t time_count;
-    static int32_t message_label_num;
-    static int32_t status_label_num;
 };
 
 }  // namespace antares
@@ -82,6 +82,11 @@ void MiniComputerHandleMouseUp( Point);
 void MiniComputerHandleMouseStillDown( Point);
 void MiniComputer_SetScreenAndLineHack(int32_t whichScreen, int32_t whichLine);
 
+// Saves and restores the mini-computer's screen and selection, which decide what the player's
+// build and command keys do.
+void write_mini_screen(sfz::WriteTarget out);
+void read_mini_screen(sfz::ReadSource in);
+
 }  // namespace antares
 
 #endif // ANTARES_GAME_MINICOMPUTER_HPP_
@@ -19,6 +19,9 @@
 #ifndef ANTARES_GAME_MOTION_HPP_
 #define ANTARES_GAME_MOTION_HPP_
 
+#include <vector>
+#include <sfz/sfz.hpp>
+
 #include "data/space-object.hpp"
 
 namespace antares {
@@ -36,16 +39,62 @@ struct proximityUnitType {
     adjacentUnitType        unitsToCheck[kUnitsToCheckNumber];  // adjacent units to check
 };
 
-extern coordPointType gGlobalCorner;
-
 void InitMotion();
 void ResetMotionGlobals();
 
 void MotionCleanup();
 void MoveSpaceObjects(const int32_t unitsToDo);
 void CollideSpaceObjects();
+int32_t CountOccupiedProximityUnits();  // collision units holding objects, as of the last collide
+// Makes the next CollideSpaceObjects() clear and visit every unit, as it did before occupied
+// units were tracked.  The outcome is the same; sim-bench uses it to time the difference.
+void MarkAllProximityUnitsOccupied();
 void CorrectPhysicalSpace( spaceObjectType *, spaceObjectType *);
 
+// Which objects a proximity query finds.  Queries see the objects that the distance grid would
+// hold, as they were at the first query since objects last moved, collided, or were added; then
+// distances are measured between where the objects are now.  They don't reach or break ties the way the collide
+// pass does when it picks each object's closestObject, so AI targeting keeps using that.
+struct ProximityFilter {
+    enum Owner {
+        kAnyOwner,
+        kSameOwner,     // as the asking object
+        kOtherOwner,
+    };
+    Owner       owner;
+    uint32_t    allAttributes;  // found objects have all of these,
+    uint32_t    anyAttributes;  // and at least one of these, unless it is zero
+    // If not NULL, found objects must also pass this test.
+    bool        (*accept)(const spaceObjectType* asker, const spaceObjectType* candidate);
+};
+
+struct ProximityResult {
+    spaceObjectType*    object;
+    uint32_t            distance;   // squared
+};
+
+// Finds the objects closer than `radius` to `asker`, which is never found itself.  The radius is
+// capped at kMaximumRelevantDistance.  Results come nearest first, with ties going to the lower
+// object number, so that they are the same on every machine.
+void FindObjectsInRadius(
+        const spaceObjectType* asker, int32_t radius, const ProximityFilter& filter,
+        std::vector<ProximityResult>& found);
+
+// As FindObjectsInRadius(), but keeps only the `count` nearest.
+void FindNearestObjects(
+        const spaceObjectType* asker, size_t count, int32_t radius, const ProximityFilter& filter,
+        std::vector<ProximityResult>& found);
+
+// As FindNearestObjects() with a count of one, without allocating.  Returns NULL if nothing is
+// found, leaving `distance` alone.
+spaceObjectType* FindNearestObject(
+        const spaceObjectType* asker, int32_t radius, const ProximityFilter& filter,
+        uint32_t* distance);
+
+// Makes the next proximity query rebuild its index.  Moving, colliding, and adding objects call
+// this; so must anything else that moves objects or changes which are active.
+void InvalidateProximityIndex();
+
 }  // namespace antares
 
 #endif // ANTARES_GAME_MOTION_HPP_
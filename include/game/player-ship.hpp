@@ -47,6 +47,9 @@ class PlayerShip : public EventReceiver {
     int32_t goal_direction() const;
 
   private:
+    friend void read_from(sfz::ReadSource in, PlayerShip& ship);
+    friend void write_to(sfz::WriteTarget out, const PlayerShip& ship);
+
     bool active() const;
 
     uint32_t gTheseKeys;
@@ -68,6 +71,11 @@ class PlayerShip : public EventReceiver {
     int32_t _control_direction;
 };
 
+// Saves and restores the held keys and controls of `ship`, along with the alarm and
+// destination-key timers shared by all ships.
+void read_from(sfz::ReadSource in, PlayerShip& ship);
+void write_to(sfz::WriteTarget out, const PlayerShip& ship);
+
 void ResetPlayerShip(int32_t);
 void PlayerShipHandleClick(Point where, int button);
 void SetPlayerSelectShip(int32_t, bool, int32_t);
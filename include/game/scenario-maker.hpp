@@ -29,8 +29,6 @@ namespace antares {
 
 const int16_t kScenarioNoShipTextID = 10000;
 
-extern const Scenario* gThisScenario;
-
 enum {
     kDestroyActionType = 1,
     kExpireActionType = 2,
@@ -40,7 +38,7 @@ enum {
     kArriveActionType = 6
 };
 
-Scenario* mGetScenario(int32_t num);
+const Scenario* mGetScenario(int32_t num);
 int32_t mGetRealAdmiralNum(int32_t mplayernum);
 
 void ScenarioMakerInit();
@@ -48,6 +46,14 @@ bool start_construct_scenario(const Scenario* scenario, int32_t* max);
 void construct_scenario(const Scenario* scenario, int32_t* current);
 void DeclareWinner(int32_t whichPlayer, int32_t nextLevel, int32_t textID);
 void CheckScenarioConditions(int32_t timePass);
+// Tell CheckScenarioConditions() to look again at the conditions that depend on a counter, or at
+// a condition whose flags were changed.
+void MarkCounterConditionsDirty(int32_t whichAdmiral, int32_t whichCounter);
+void MarkConditionDirty(int32_t whichCondition);
+// Whether a condition has been true yet in this game; kTrueOnlyOnce conditions stop once it is.
+bool ConditionTrueYet(int32_t whichCondition);
+void SetConditionTrueYet(int32_t whichCondition, bool state);
+void AddBaseObjectMedia(int32_t whichBase, uint8_t color);
 int32_t GetRealAdmiralNumber(int32_t whichAdmiral);
 void UnhideInitialObject(int32_t whichInitial);
 spaceObjectType *GetObjectFromInitialNumber(int32_t initialNumber);
@@ -57,6 +63,12 @@ void GetScenarioFullScaleAndCorner(
 const Scenario* GetScenarioPtrFromChapter(int32_t chapter);
 coordPointType Translate_Coord_To_Scenario_Rotation(int32_t h, int32_t v);
 
+// Saves and restores the parts of the running scenario that change during play: its rotation,
+// the admirals standing in for each player, which conditions have been true, and the objects
+// made from initials.
+void write_scenario_state(sfz::WriteTarget out);
+void read_scenario_state(sfz::ReadSource in);
+
 }  // namespace antares
 
 #endif // ANTARES_GAME_SCENARIO_MAKER_HPP_
@@ -19,6 +19,8 @@
 #ifndef ANTARES_GAME_SPACE_OBJECT_HPP_
 #define ANTARES_GAME_SPACE_OBJECT_HPP_
 
+#include <vector>
+
 #include "data/space-object.hpp"
 
 namespace antares {
@@ -26,12 +28,28 @@ namespace antares {
 const int16_t kBaseObjectResID      = 500;
 const int16_t kObjectActionResID    = 500;
 
-extern spaceObjectType* gRootObject;
-extern int32_t gRootObjectNumber;
+// A delayed action, waiting on the action timing wheel for `dueTime`.
+struct actionQueueType {
+    objectActionType            *action;
+    int32_t                         actionNum;
+    int32_t                         actionToDo;
+    int64_t                         dueTime;
+    actionQueueType         *nextActionQueue;   // in the same wheel slot, or the free list
+    spaceObjectType         *subjectObject;
+    int32_t                         subjectObjectNum;
+    int32_t                         subjectObjectID;
+    spaceObjectType         *directObject;
+    int32_t                         directObjectNum;
+    int32_t                         directObjectID;
+    Point                       offset;
+};
 
 void SpaceObjectHandlingInit( void);
 void CleanupSpaceObjectHandling( void);
 void ResetAllSpaceObjects( void);
+void SetSpaceObjectCapacity(int32_t capacity);
+int32_t NextSpaceObjectSlot(int32_t whichObject);
+void ReleaseSpaceObjectSlot(int32_t whichObject);
 void ResetActionQueueData( void);
 int AddSpaceObject( spaceObjectType *);
 //int AddSpaceObject( spaceObjectType *, int32_t *, int16_t, int16_t);
@@ -46,6 +64,7 @@ void ExecuteObjectActions(int32_t, int32_t, spaceObjectType *, spaceObjectType *
 int32_t CreateAnySpaceObject(int32_t, fixedPointType *, coordPointType *, int32_t, int32_t, uint32_t,
                             int16_t);
 int32_t CountObjectsOfBaseType(int32_t, int32_t);
+const std::vector<int32_t>& ObjectsOfOwner(int32_t owner);  // object numbers, in no set order
 int32_t GetNextObjectWithAttributes(int32_t, uint32_t, bool);
 void AlterObjectHealth( spaceObjectType *, int32_t);
 void AlterObjectEnergy( spaceObjectType *, int32_t);
@@ -59,7 +78,10 @@ void CreateFloatingBodyOfPlayer( spaceObjectType *);
 
 baseObjectType* mGetBaseObjectPtr(int32_t whichObject);
 spaceObjectType* mGetSpaceObjectPtr(int32_t whichObject);
+spaceObjectMotionType* mGetSpaceObjectMotionPtr(int32_t whichObject);
 objectActionType* mGetObjectActionPtr(int32_t whichAction);
+int32_t GetBaseObjectIndex(const baseObjectType* base);        // -1 for NULL
+int32_t GetSpaceObjectIndex(const spaceObjectType* object);    // -1 for NULL
 
 void mGetBaseObjectFromClassRace(
         baseObjectType*& mbaseObject, int32_t& mcount, int mbaseClass, int mbaseRace);
@@ -67,6 +89,12 @@ void mGetBaseObjectFromClassRace(
 sfz::StringSlice get_object_name(int16_t id);
 sfz::StringSlice get_object_short_name(int16_t id);
 
+// The object and action-queue part of save_state() and restore_state().  write_space_object()
+// writes a single object, in the same form.
+void write_space_object(sfz::WriteTarget out, const spaceObjectType& o);
+void write_space_objects(sfz::WriteTarget out);
+void read_space_objects(sfz::ReadSource in);
+
 }  // namespace antares
 
 #endif // ANTARES_GAME_SPACE_OBJECT_HPP_
@@ -46,8 +46,6 @@ struct scrollStarType {
     uint8_t         color;
 };
 
-extern spaceObjectType* gScrollStarObject;
-
 class Starfield {
   public:
     static const int32_t kScrollStarNum = 125;
@@ -0,0 +1,60 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_STATE_HPP_
+#define ANTARES_GAME_STATE_HPP_
+
+#include <sfz/sfz.hpp>
+
+namespace antares {
+
+class PlayerShip;
+
+// Captures everything the simulation reads from one tick to the next: objects and their action
+// queue, admirals and destinations, beams, sprites, scenario progress, the long message that is
+// showing, the random seed, and the gameplay fields of globals().  Restoring the snapshot and feeding in the same input afterwards
+// reproduces the original game, including gSynchValue.
+//
+// A snapshot is only meaningful to the same build, playing the same scenario: restore_state()
+// expects that scenario to have been constructed already, and throws sfz::Exception if the
+// snapshot was taken from another.  Purely visual state (labels, the short messages, the text of
+// the long message, the starfield, and the instruments) is not captured; the starfield is reset
+// around the restored player ship.
+sfz::Bytes save_state();
+void restore_state(sfz::BytesSlice state);
+
+// The counters a game loop keeps outside of the simulation proper.
+struct GameLoopState {
+    uint32_t decide_cycle;
+    int32_t scenario_check_time;
+    int64_t ticks;
+};
+
+// Wraps save_state() with the loop's counters, the player ship's keys, the game clock, and the
+// position within globals()->gInputSource.  This is what a replay keyframe holds, and it can
+// be restored into either a HeadlessGame or a rendered game of the same scenario.
+sfz::Bytes save_game(const GameLoopState& loop, const PlayerShip& ship);
+void restore_game(sfz::BytesSlice state, GameLoopState& loop, PlayerShip& ship);
+
+// Strings inside a snapshot are stored as a length followed by UTF-8.
+void write_state_string(sfz::WriteTarget out, const sfz::StringSlice& string);
+sfz::String read_state_string(sfz::ReadSource in);
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_STATE_HPP_
@@ -0,0 +1,74 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_GAME_SYNC_HPP_
+#define ANTARES_GAME_SYNC_HPP_
+
+#include <stdint.h>
+#include <vector>
+#include <sfz/sfz.hpp>
+
+namespace antares {
+
+// One entry of a sync stream, taken at the end of a decide cycle: gSynchValue, plus a hash of
+// each object in use.  Two runs of the same replay should produce identical streams; the first
+// record where they differ is where they desynchronized.
+struct SyncRecord {
+    struct Object {
+        int32_t slot;
+        int32_t id;
+        uint32_t hash;  // of the object as written by write_space_object()
+    };
+
+    int64_t at;  // ticks since the start of the game
+    uint32_t synch;
+    std::vector<Object> objects;
+};
+void read_from(sfz::ReadSource in, SyncRecord& record);
+void read_from(sfz::ReadSource in, SyncRecord::Object& object);
+void write_to(sfz::WriteTarget out, const SyncRecord& record);
+void write_to(sfz::WriteTarget out, const SyncRecord::Object& object);
+
+// Returns the record for the current state of the game.
+SyncRecord sync_record(int64_t at);
+
+// Appends one record per call to the file at `path`, after a header identifying it as a sync
+// stream.
+class SyncRecorder {
+  public:
+    explicit SyncRecorder(sfz::StringSlice path);
+
+    void record(int64_t at);
+
+  private:
+    sfz::ScopedFd _file;
+
+    DISALLOW_COPY_AND_ASSIGN(SyncRecorder);
+};
+
+// Returns true if `data` starts with a sync stream header, and reads the records that follow
+// into `records`.
+bool read_sync_stream(sfz::BytesSlice data, std::vector<SyncRecord>& records);
+
+// Prints the current state as one "<object> <field> <value>" line per field, for comparing two
+// runs at the point where their sync streams first differ.
+void dump_state(sfz::PrintTarget out);
+
+}  // namespace antares
+
+#endif  // ANTARES_GAME_SYNC_HPP_
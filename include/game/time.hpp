@@ -25,6 +25,10 @@ namespace antares {
 
 int64_t now_usecs();
 
+// When no VideoDriver is installed (headless simulation), time does not pass on its own; the
+// caller moves the clock forward explicitly, one tick at a time.
+void advance_headless_clock(int ticks);
+
 }  // namespace antares
 
 #endif  // ANTARES_GAME_TIME_HPP_
@@ -79,6 +79,7 @@ struct fixedPointType {
     Fixed               v;
 };
 void read_from(sfz::ReadSource in, fixedPointType& point);
+void write_to(sfz::WriteTarget out, const fixedPointType& point);
 
 }  // namespace antares
 
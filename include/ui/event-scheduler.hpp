@@ -43,6 +43,10 @@ class EventScheduler {
 
     EventScheduler();
 
+    // Starts the clock at `ticks` rather than zero, as when resuming a replay from a keyframe.
+    // Must be called before anything is scheduled.
+    void start_at(int64_t ticks);
+
     void schedule_snapshot(int64_t at);
     void schedule_event(std::unique_ptr<Event> event);
     void schedule_key(int32_t key, int64_t down, int64_t up);
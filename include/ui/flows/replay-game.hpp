@@ -33,7 +33,9 @@ struct Scenario;
 
 class ReplayGame : public Card {
   public:
-    ReplayGame(int16_t replay_id);
+    // Plays back the replay with the given ID, beginning at the keyframe nearest `start_at` if
+    // the replay has an index beside it (and at the start of the game if it doesn't).
+    ReplayGame(int16_t replay_id, uint64_t start_at);
     ~ReplayGame();
 
     virtual void become_front();
@@ -48,6 +50,8 @@ class ReplayGame : public Card {
 
     Resource _resource;
     ReplayData _data;
+    ReplayIndex _index;
+    const ReplayIndex::Keyframe* _keyframe;
     Random _random_seed;
     const Scenario* _scenario;
     GameResult _game_result;
@@ -0,0 +1,119 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_VIDEO_DRAW_LOG_HPP_
+#define ANTARES_VIDEO_DRAW_LOG_HPP_
+
+#include <stdint.h>
+#include <vector>
+#include <sfz/sfz.hpp>
+
+#include "drawing/color.hpp"
+#include "math/geometry.hpp"
+
+namespace antares {
+
+// A color as TextVideoDriver prints it: "rrggbb", followed by "aa" if not opaque.
+struct HexColor {
+    RgbColor color;
+};
+HexColor hex(RgbColor color);
+void print_to(sfz::PrintTarget target, HexColor color);
+
+// The commands logged by TextVideoDriver.
+enum DrawCommand {
+    kRectCommand,
+    kDitherCommand,
+    kPointCommand,
+    kLineCommand,
+    kTriangleCommand,
+    kDiamondCommand,
+    kPlusCommand,
+    kDrawCommand,
+    kCropCommand,
+    kTintCommand,
+    kStaticCommand,
+    kOutlineCommand,
+    kDrawCommandCount,
+};
+
+// Writes the commands drawn in each snapshot to a single binary stream, as a compact alternative
+// to TextVideoDriver's text files.
+//
+// After a header, the stream is a series of records, each starting with a marker byte.  A name
+// record interns a sprite name; it holds the name's ID and its UTF-8 bytes, and precedes the
+// first frame that uses it.  A frame record holds the frame's ticks, then the length and bytes of
+// its commands.  Each command is its DrawCommand, as a byte, followed by its fields: integers as
+// zigzag varints, each the difference from the same field of the previous command of the same
+// kind in the frame; colors as four bytes (alpha, red, green, blue); names as varint IDs.
+// Frames can be decoded independently, given the names before them.
+class DrawLogWriter {
+  public:
+    // The most integers a command has.
+    enum { kMaxIntegers = 8 };
+
+    explicit DrawLogWriter(const sfz::StringSlice& path);
+
+    // Returns the ID of `name`, assigning the next one if it is new.
+    int32_t intern(const sfz::StringSlice& name);
+
+    // Discards the commands logged since the last call to `clear()`.  Called at the start of
+    // every frame drawn, whether or not it is written.
+    void clear();
+
+    // Starts a command, whose fields are given by the calls that follow.
+    DrawLogWriter& begin(DrawCommand command);
+    DrawLogWriter& integer(int32_t value);
+    DrawLogWriter& point(const Point& point);
+    DrawLogWriter& rect(const Rect& rect);
+    DrawLogWriter& color(const RgbColor& color);
+    DrawLogWriter& name(int32_t id);
+
+    // Appends the commands logged since the last call to `clear()`, as the frame for `ticks`.
+    void write_frame(int64_t ticks);
+
+  private:
+    sfz::ScopedFd _file;
+    std::vector<sfz::String> _names;
+    sfz::StringMap<int32_t> _ids;
+    size_t _names_written;
+
+    sfz::Bytes _frame;
+    int _command;
+    int _integer;
+    int32_t _last[kDrawCommandCount][kMaxIntegers];
+
+    DISALLOW_COPY_AND_ASSIGN(DrawLogWriter);
+};
+
+// One frame of a draw log, with each command as the line TextVideoDriver would print for it
+// (without its elision of repeated fields).
+struct DrawLogFrame {
+    int64_t ticks;
+    std::vector<sfz::String> commands;
+};
+
+// Returns true if `data` starts with a draw log header, and reads the frames that follow into
+// `frames`.
+//
+// @throws Exception if the log is malformed.
+bool read_draw_log(sfz::BytesSlice data, std::vector<DrawLogFrame>& frames);
+
+}  // namespace antares
+
+#endif  // ANTARES_VIDEO_DRAW_LOG_HPP_
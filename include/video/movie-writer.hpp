@@ -0,0 +1,58 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#ifndef ANTARES_VIDEO_MOVIE_WRITER_HPP_
+#define ANTARES_VIDEO_MOVIE_WRITER_HPP_
+
+#include <stdint.h>
+#include <sfz/sfz.hpp>
+
+#include "drawing/pix-map.hpp"
+#include "math/geometry.hpp"
+
+namespace antares {
+
+// Writes snapshots into a single YUV4MPEG2 stream, as an alternative to one PNG per snapshot.
+//
+// The stream runs at 60 frames per second, one frame per tick, so that it lines up with the
+// ticks in the log of LogSoundDriver.  It begins at the tick of the first frame written, which is
+// recorded in the stream header as "XANTARES_START_TICK=<n>".  Ticks between snapshots repeat the
+// previous frame.
+class MovieWriter {
+  public:
+    MovieWriter(const sfz::StringSlice& path, Size size);
+    ~MovieWriter();
+
+    // Appends `pix`, which must be of the size given to the constructor, as the frame for
+    // `ticks`.  Ticks at or before the last frame written are ignored.
+    void write_frame(int64_t ticks, const PixMap& pix);
+
+  private:
+    sfz::ScopedFd _file;
+    const Size _size;
+    const size_t _frame_size;
+    int64_t _next_ticks;
+    std::unique_ptr<uint8_t[]> _frame;
+
+    DISALLOW_COPY_AND_ASSIGN(MovieWriter);
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_VIDEO_MOVIE_WRITER_HPP_
@@ -42,10 +42,15 @@ class OffscreenVideoDriver : public OpenGlVideoDriver {
     virtual int usecs() const { return _scheduler.usecs(); }
     virtual int64_t double_click_interval_usecs() const { return 0.5e6; }
 
+    // Writes snapshots into a single stream at `path` (see MovieWriter), instead of as PNGs in
+    // the output directory.
+    void write_movie(const sfz::StringSlice& path);
+
     void loop(Card* initial);
 
   private:
     const sfz::Optional<sfz::String> _output_dir;
+    sfz::String _movie_path;
 
     EventScheduler& _scheduler;
 
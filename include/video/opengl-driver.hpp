@@ -20,6 +20,9 @@
 #define ANTARES_VIDEO_OPEN_GL_DRIVER_HPP_
 
 #include <stdint.h>
+#include <map>
+#include <memory>
+#include <vector>
 #include <sfz/sfz.hpp>
 
 #include "drawing/color.hpp"
@@ -36,7 +39,7 @@ class OpenGlVideoDriver : public VideoDriver {
   public:
     OpenGlVideoDriver(Size screen_size);
 
-    virtual std::unique_ptr<Sprite> new_sprite(sfz::PrintItem name, const PixMap& content);
+    virtual std::unique_ptr<antares::Sprite> new_sprite(sfz::PrintItem name, const PixMap& content);
     virtual void fill_rect(const Rect& rect, const RgbColor& color);
     virtual void dither_rect(const Rect& rect, const RgbColor& color);
     virtual void draw_point(const Point& at, const RgbColor& color);
@@ -77,14 +80,43 @@ class OpenGlVideoDriver : public VideoDriver {
     Size screen_size() const { return _screen_size; }
 
   private:
+    class Atlas;
+    class Sprite;
+
+    // One corner of a quad in the batch.  The color mode and static fraction, which are uniforms
+    // when drawing unbatched, are passed to the shader as the third texture coordinate.
+    struct Vertex {
+        float x, y;
+        float u, v;
+        float mode, fraction;
+        uint8_t color[4];
+    };
+
+    // Finds space for `size` texels in an atlas, creating a new one if none has room.
+    std::shared_ptr<Atlas> allocate(Size size, Point* origin);
+
+    // Adds a quad sampling `texture_rect` of `atlas` to the batch, flushing it first if it holds
+    // quads from another atlas.
+    void enqueue(
+            const std::shared_ptr<Atlas>& atlas, const Rect& draw_rect, const Rect& texture_rect,
+            const RgbColor& color, int mode, float fraction);
+
+    // Draws the batch, if it has anything in it.  Anything not drawn through the batch must call
+    // this first, so that it is drawn in the right order.
+    void flush();
+
     const Size _screen_size;
     Random _static_seed;
 
     Uniforms _uniforms;
 
-    std::map<size_t, std::unique_ptr<Sprite>> _triangles;
-    std::map<size_t, std::unique_ptr<Sprite>> _diamonds;
-    std::map<size_t, std::unique_ptr<Sprite>> _pluses;
+    std::vector<std::shared_ptr<Atlas>> _atlases;
+    std::shared_ptr<Atlas> _batch_atlas;
+    std::vector<Vertex> _batch;
+
+    std::map<size_t, std::unique_ptr<antares::Sprite>> _triangles;
+    std::map<size_t, std::unique_ptr<antares::Sprite>> _diamonds;
+    std::map<size_t, std::unique_ptr<antares::Sprite>> _pluses;
 
     DISALLOW_COPY_AND_ASSIGN(OpenGlVideoDriver);
 };
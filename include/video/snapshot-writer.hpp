@@ -0,0 +1,92 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_VIDEO_SNAPSHOT_WRITER_HPP_
+#define ANTARES_VIDEO_SNAPSHOT_WRITER_HPP_
+
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sfz/sfz.hpp>
+
+#include "drawing/pix-map.hpp"
+#include "math/geometry.hpp"
+
+namespace antares {
+
+// Writes snapshots as PNGs, one per snapshot, named "<dir>/<ticks>.png".
+//
+// Converting and encoding happen on a pool of worker threads.  The write methods copy the
+// snapshot into one of a fixed number of buffers and return; they block only when every buffer
+// is still waiting on a worker, which bounds the memory used.  Files are completed in the order
+// their snapshots were queued.
+class SnapshotWriter {
+  public:
+    SnapshotWriter(const sfz::StringSlice& dir, Size size);
+
+    // Waits for every queued snapshot to be written.  Errors are dropped; call `finish()` first
+    // to see them.
+    ~SnapshotWriter();
+
+    // Queues `pix`, which must be of the size given to the constructor, as the snapshot for
+    // `ticks`.
+    //
+    // @throws Exception if writing an earlier snapshot failed.
+    void write_frame(int64_t ticks, const PixMap& pix);
+
+    // Like `write_frame()`, but for pixels read back from OpenGL: 32-bit BGRA, with successive
+    // rows `row_bytes` apart.
+    void write_bgra_frame(int64_t ticks, const uint8_t* data, int32_t row_bytes);
+
+    // Waits for every queued snapshot to be written.
+    //
+    // @throws Exception if writing any snapshot failed.
+    void finish();
+
+  private:
+    struct Frame;
+
+    Frame* acquire();
+    void submit(Frame* frame);
+    void work();
+
+    const sfz::String _dir;
+    const Size _size;
+
+    std::mutex _mutex;
+    std::condition_variable _queued;    // signalled when `_pending` grows, or on shutdown.
+    std::condition_variable _written;   // signalled when a frame is written and freed.
+    std::vector<std::unique_ptr<Frame>> _frames;
+    std::vector<Frame*> _free;
+    std::deque<Frame*> _pending;
+    int64_t _next_sequence;
+    int64_t _next_written;
+    bool _stopping;
+    std::exception_ptr _error;
+    std::vector<std::thread> _threads;
+
+    DISALLOW_COPY_AND_ASSIGN(SnapshotWriter);
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_VIDEO_SNAPSHOT_WRITER_HPP_
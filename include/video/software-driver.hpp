@@ -0,0 +1,97 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_VIDEO_SOFTWARE_DRIVER_HPP_
+#define ANTARES_VIDEO_SOFTWARE_DRIVER_HPP_
+
+#include <stdint.h>
+#include <map>
+#include <sfz/sfz.hpp>
+
+#include "config/keys.hpp"
+#include "drawing/pix-map.hpp"
+#include "math/random.hpp"
+#include "ui/event-scheduler.hpp"
+#include "video/driver.hpp"
+
+namespace antares {
+
+// Renders into an ArrayPixMap on the CPU, without OpenGL, so that snapshots can be taken where
+// OffscreenVideoDriver can't run.  Each primitive follows the fragment shader of
+// OpenGlVideoDriver, pixel center by pixel center, so the images agree with those of the
+// OpenGL drivers except along diagonal lines, whose rasterization OpenGL leaves open.
+class SoftwareVideoDriver : public VideoDriver {
+  public:
+    SoftwareVideoDriver(
+            Size screen_size, EventScheduler& scheduler,
+            const sfz::Optional<sfz::String>& output_dir);
+
+    virtual bool button(int which) { return _scheduler.button(which); }
+    virtual Point get_mouse() { return _scheduler.get_mouse(); }
+    virtual void get_keys(KeyMap* k) { _scheduler.get_keys(k); }
+
+    virtual int ticks() const { return _scheduler.ticks(); }
+    virtual int usecs() const { return _scheduler.usecs(); }
+    virtual int64_t double_click_interval_usecs() const { return 0.5e6; }
+
+    virtual std::unique_ptr<antares::Sprite> new_sprite(sfz::PrintItem name, const PixMap& content);
+    virtual void fill_rect(const Rect& rect, const RgbColor& color);
+    virtual void dither_rect(const Rect& rect, const RgbColor& color);
+    virtual void draw_point(const Point& at, const RgbColor& color);
+    virtual void draw_line(const Point& from, const Point& to, const RgbColor& color);
+    virtual void draw_triangle(const Rect& rect, const RgbColor& color);
+    virtual void draw_diamond(const Rect& rect, const RgbColor& color);
+    virtual void draw_plus(const Rect& rect, const RgbColor& color);
+
+    // Writes snapshots into a single stream at `path` (see MovieWriter), instead of as PNGs in
+    // the output directory.
+    void write_movie(const sfz::StringSlice& path);
+
+    void loop(Card* initial);
+
+  private:
+    class MainLoop;
+    class Sprite;
+
+    // Blends `color` over the pixel at (x, y), if it is on the screen.
+    void blend(int32_t x, int32_t y, const RgbColor& color);
+
+    // The alpha of the static texel that covers (x, y) in the current frame.
+    uint8_t static_at(int32_t x, int32_t y) const;
+
+    Rect screen_rect() const { return Rect(Point(0, 0), _screen.size()); }
+
+    EventScheduler& _scheduler;
+    const sfz::Optional<sfz::String> _output_dir;
+    sfz::String _movie_path;
+
+    ArrayPixMap _screen;
+    std::unique_ptr<uint8_t[]> _static;
+    Random _static_seed;
+    int32_t _seed;
+
+    std::map<size_t, std::unique_ptr<antares::Sprite>> _triangles;
+    std::map<size_t, std::unique_ptr<antares::Sprite>> _diamonds;
+    std::map<size_t, std::unique_ptr<antares::Sprite>> _pluses;
+
+    DISALLOW_COPY_AND_ASSIGN(SoftwareVideoDriver);
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_VIDEO_SOFTWARE_DRIVER_HPP_
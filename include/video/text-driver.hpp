@@ -23,6 +23,7 @@
 
 #include "config/keys.hpp"
 #include "ui/event-scheduler.hpp"
+#include "video/draw-log.hpp"
 #include "video/driver.hpp"
 
 namespace antares {
@@ -50,6 +51,10 @@ class TextVideoDriver : public VideoDriver {
     virtual void draw_diamond(const Rect& rect, const RgbColor& color);
     virtual void draw_plus(const Rect& rect, const RgbColor& color);
 
+    // Writes snapshots into a single binary stream at `path` (see DrawLogWriter), instead of as
+    // text files in the output directory.
+    void write_draw_log(const sfz::StringSlice& path);
+
     void loop(Card* initial);
 
   private:
@@ -69,6 +74,7 @@ class TextVideoDriver : public VideoDriver {
 
     sfz::String _log;
     std::vector<std::pair<size_t, size_t>> _last_args;
+    std::unique_ptr<DrawLogWriter> _draw_log;
 
     DISALLOW_COPY_AND_ASSIGN(TextVideoDriver);
 };
@@ -0,0 +1,134 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <algorithm>
+#include <sfz/sfz.hpp>
+
+#include "video/draw-log.hpp"
+
+using sfz::MappedFile;
+using sfz::Optional;
+using sfz::String;
+using sfz::StringSlice;
+using sfz::args::help;
+using sfz::args::store;
+using sfz::format;
+using std::max;
+using std::vector;
+
+namespace args = sfz::args;
+namespace io = sfz::io;
+
+namespace antares {
+namespace {
+
+vector<DrawLogFrame> read_frames(const String& path, const String& program) {
+    MappedFile file(path);
+    vector<DrawLogFrame> frames;
+    if (!read_draw_log(file.data(), frames)) {
+        print(io::err, format("{0}: {1}: not a draw log\n", program, path));
+        exit(1);
+    }
+    return frames;
+}
+
+// Prints each frame as "frame <ticks>", followed by its commands.
+void print_frames(const vector<DrawLogFrame>& frames) {
+    for (const DrawLogFrame& frame: frames) {
+        print(io::out, format("frame {0}\n", frame.ticks));
+        for (const String& command: frame.commands) {
+            print(io::out, format("{0}\n", command));
+        }
+    }
+}
+
+// Reports the first differing command of each frame that differs.  Frames are matched up in
+// order, and both logs must have snapshots at the same ticks.
+bool diff_frames(const vector<DrawLogFrame>& a, const vector<DrawLogFrame>& b) {
+    int differing = 0;
+    for (size_t i = 0; i < std::min(a.size(), b.size()); ++i) {
+        if (a[i].ticks != b[i].ticks) {
+            print(io::out, format("frame {0} is at tick {1} in a but {2} in b\n",
+                        i, a[i].ticks, b[i].ticks));
+            return false;
+        }
+        const vector<String>& x = a[i].commands;
+        const vector<String>& y = b[i].commands;
+        for (size_t j = 0; j < max(x.size(), y.size()); ++j) {
+            if ((j < x.size()) && (j < y.size()) && (x[j] == y[j])) {
+                continue;
+            }
+            print(io::out, format("tick {0}, command {1}:\n", a[i].ticks, j));
+            const StringSlice end = "(end of frame)";
+            print(io::out, format("  a: {0}\n", (j < x.size()) ? StringSlice(x[j]) : end));
+            print(io::out, format("  b: {0}\n", (j < y.size()) ? StringSlice(y[j]) : end));
+            ++differing;
+            break;
+        }
+    }
+    if (a.size() != b.size()) {
+        const vector<DrawLogFrame>& shorter = (a.size() < b.size()) ? a : b;
+        print(io::out, format("{0} ends after tick {1}\n",
+                    (a.size() < b.size()) ? "a" : "b",
+                    shorter.empty() ? 0 : shorter.back().ticks));
+        return false;
+    }
+    if (differing) {
+        print(io::out, format("{0} of {1} frames differ\n", differing, a.size()));
+        return false;
+    }
+    print(io::out, format("no difference in {0} frames\n", a.size()));
+    return true;
+}
+
+void main(int argc, char** argv) {
+    args::Parser parser(argv[0], "Prints a draw log, or compares two frame by frame");
+
+    String a_path;
+    Optional<String> b_path;
+    parser.add_argument("log", store(a_path))
+        .help("a draw log from \"antares/replay --text --draw-log\"")
+        .required();
+    parser.add_argument("other", store(b_path))
+        .help("a second draw log, to compare with the first");
+    parser.add_argument("-h", "--help", help(parser, 0))
+        .help("display this help screen");
+
+    String error;
+    if (!parser.parse_args(argc - 1, argv + 1, error)) {
+        print(io::err, format("{0}: {1}\n", parser.name(), error));
+        exit(1);
+    }
+
+    const String program(parser.name());
+    const vector<DrawLogFrame> a = read_frames(a_path, program);
+    if (!b_path.has()) {
+        print_frames(a);
+        return;
+    }
+    const vector<DrawLogFrame> b = read_frames(*b_path, program);
+    exit(diff_frames(a, b) ? 0 : 1);
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char** argv) {
+    antares::main(argc, argv);
+    return 0;
+}
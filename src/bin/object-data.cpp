@@ -24,6 +24,7 @@
 #include "data/space-object.hpp"
 #include "drawing/color.hpp"
 #include "drawing/text.hpp"
+#include "game/globals.hpp"
 #include "game/space-object.hpp"
 #include "ui/interface-handling.hpp"
 
@@ -91,7 +92,7 @@ int main(int argc, char** argv) {
     SpaceObjectHandlingInit();
 
     ObjectDataBuilder builder(output_dir);
-    for (int id = 0; id < globals()->maxBaseObject; ++id) {
+    for (int id = 0; id < plugin()->maxBaseObject; ++id) {
         const int pict_id = mGetBaseObjectPtr(id)->pictPortraitResID;
         if (pict_id <= 0) {
             continue;
@@ -28,6 +28,7 @@
 #include "ui/flows/master.hpp"
 #include "video/driver.hpp"
 #include "video/offscreen-driver.hpp"
+#include "video/software-driver.hpp"
 #include "video/text-driver.hpp"
 
 using sfz::Bytes;
@@ -71,10 +72,14 @@ void main(int argc, char* const* argv) {
 
     Optional<String> output_dir;
     bool text = false;
-    parser.add_argument("-o", "--output", store(output_dir))
+XX, "--output", store(output_dir))
         .help("place output in this directory");
     parser.add_argument("-t", "--text", store_const(text, true))
         .help("produce text output");
+    parser.add_argument("--software", store_const(software, true))
+        .help("render on the CPU instead of with OpenGL");
+    parser.add_argument("--draw-log", store_const(draw_log, true))
+        .help("with --text, write snapshots to screens.drawlog instead of text files");
     parser.add_argument("-h", "--help", help(parser, 0))
         .help("display this help screen");
 
@@ -84,6 +89,10 @@ void main(int argc, char* const* argv) {
         exit(1);
     }
 
+    if (draw_log && (!output_dir.has() || !text)) {
+        print(io::err, format("{0}: --draw-log requires --output and --text\n", parser.name()));
+        exit(1);
+    }
     if (output_dir.has()) {
         makedirs(*output_dir, 0755);
     }
@@ -114,6 +123,12 @@ void main(int argc, char* const* argv) {
 
     if (text) {
         TextVideoDriver video(Preferences::preferences()->screen_size(), scheduler, output_dir);
+        if (draw_log) {
+            video.write_draw_log(String(format("{0}/screens.drawlog", *output_dir)));
+        }
+        video.loop(new Master(14586));
+    } else if (software) {
+        SoftwareVideoDriver video(Preferences::preferences()->screen_size(), scheduler, output_dir);
         video.loop(new Master(14586));
     } else {
         OffscreenVideoDriver video(Preferences::preferences()->screen_size(), scheduler, output_dir);
@@ -0,0 +1,132 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <sys/time.h>
+#include <vector>
+#include <sfz/sfz.hpp>
+
+#include "drawing/color.hpp"
+#include "drawing/pix-kernels.hpp"
+#include "math/random.hpp"
+
+using sfz::String;
+using sfz::args::help;
+using sfz::args::store;
+using sfz::format;
+using std::vector;
+
+namespace args = sfz::args;
+namespace io = sfz::io;
+
+namespace antares {
+namespace {
+
+int64_t usecs() {
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000ll + tv.tv_usec;
+}
+
+// A sprite-like image: an opaque shape on a clear background, with a soft edge.
+vector<RgbColor> sprite_pixels(Random& r, size_t count) {
+    vector<RgbColor> result;
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t alpha;
+        switch ((i / 32) % 8) {
+          case 0: case 1: case 2: alpha = 0x00; break;
+          case 3: alpha = r.next(256); break;
+          default: alpha = 0xff; break;
+        }
+        result.push_back(RgbColor(alpha, r.next(256), r.next(256), r.next(256)));
+    }
+    return result;
+}
+
+void report(const char* kernels, const char* op, int64_t elapsed, size_t pixels, int rounds) {
+    print(io::out, format(
+                "{0} {1}: {2} ns/frame, {3} Mpixel/s\n", kernels, op,
+                elapsed * 1000 / rounds, (pixels * rounds) / (elapsed ? elapsed : 1)));
+}
+
+void main(int argc, char** argv) {
+    args::Parser parser(argv[0], "Times the pixel kernels on each instruction set");
+
+    int32_t width = 640;
+    int32_t height = 480;
+    int rounds = 1000;
+    parser.add_argument("-x", "--width", store(width))
+        .help("width of the frame (default: 640)");
+    parser.add_argument("-y", "--height", store(height))
+        .help("height of the frame (default: 480)");
+    parser.add_argument("-r", "--rounds", store(rounds))
+        .help("number of frames to process per kernel (default: 1000)");
+    parser.add_argument("-h", "--help", help(parser, 0))
+        .help("display this help screen");
+
+    String error;
+    if (!parser.parse_args(argc - 1, argv + 1, error)) {
+        print(io::err, format("{0}: {1}\n", parser.name(), error));
+        exit(1);
+    }
+    if ((width < 1) || (height < 1) || (rounds < 1)) {
+        print(io::err, format("{0}: --width, --height and --rounds must be positive\n",
+                    parser.name()));
+        exit(1);
+    }
+
+    const size_t pixels = width * height;
+    Random r = {0};
+    const vector<RgbColor> sprite = sprite_pixels(r, pixels);
+    vector<uint8_t> bgra(4 * pixels);
+    for (uint8_t& byte: bgra) {
+        byte = r.next(256);
+    }
+    vector<RgbColor> frame(pixels);
+
+    print(io::out, format("selected: {0}\n", pix_kernels().name));
+    for (const PixKernels* kernels: available_pix_kernels()) {
+        int64_t start = usecs();
+        for (int i = 0; i < rounds; ++i) {
+            kernels->fill(frame.data(), pixels, RgbColor(i, i, i));
+        }
+        report(kernels->name, "fill", usecs() - start, pixels, rounds);
+
+        int64_t elapsed = 0;
+        for (int i = 0; i < rounds; ++i) {
+            kernels->fill(frame.data(), pixels, RgbColor::kBlack);
+            start = usecs();
+            kernels->composite(frame.data(), sprite.data(), pixels);
+            elapsed += usecs() - start;
+        }
+        report(kernels->name, "composite", elapsed, pixels, rounds);
+
+        start = usecs();
+        for (int i = 0; i < rounds; ++i) {
+            kernels->convert_bgra(frame.data(), bgra.data(), pixels);
+        }
+        report(kernels->name, "convert-bgra", usecs() - start, pixels, rounds);
+    }
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char** argv) {
+    antares::main(argc, argv);
+    return 0;
+}
@@ -0,0 +1,280 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <fcntl.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <map>
+#include <sfz/sfz.hpp>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "data/replay.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/headless.hpp"
+#include "game/input-source.hpp"
+#include "game/scenario-maker.hpp"
+#include "lang/glob.hpp"
+#include "math/random.hpp"
+#include "sound/driver.hpp"
+
+using sfz::Bytes;
+using sfz::BytesSlice;
+using sfz::CString;
+using sfz::Exception;
+using sfz::MappedFile;
+using sfz::Optional;
+using sfz::ScopedFd;
+using sfz::String;
+using sfz::StringSlice;
+using sfz::args::help;
+using sfz::args::store;
+using sfz::format;
+using sfz::hex;
+using sfz::read;
+using sfz::write;
+using std::map;
+using std::vector;
+
+namespace args = sfz::args;
+namespace io = sfz::io;
+namespace path = sfz::path;
+namespace utf8 = sfz::utf8;
+
+namespace antares {
+namespace {
+
+int64_t usecs() {
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000ll + tv.tv_usec;
+}
+
+// What a worker reports back about one replay.
+struct Outcome {
+    int32_t result;
+    int64_t ticks;
+    uint32_t synch;
+    Bytes debriefing;
+};
+
+void write_to(sfz::WriteTarget out, const Outcome& outcome) {
+    write(out, outcome.result);
+    write(out, outcome.ticks);
+    write(out, outcome.synch);
+    write<uint32_t>(out, outcome.debriefing.size());
+    write(out, outcome.debriefing);
+}
+
+void read_from(sfz::ReadSource in, Outcome& outcome) {
+    read(in, outcome.result);
+    read(in, outcome.ticks);
+    read(in, outcome.synch);
+    outcome.debriefing.resize(read<uint32_t>(in));
+    in.shift(outcome.debriefing.data(), outcome.debriefing.size());
+}
+
+// Runs in a forked worker, which inherits the data HeadlessInit() loaded in the parent.
+Outcome play(StringSlice replay_path) {
+    MappedFile file(replay_path);
+    ReplayData replay_data(file.data());
+    Randomize(4);  // For the decision to replay intro.
+    globals()->gRandomSeed.seed = replay_data.global_seed;
+    globals()->gInputSource.reset(new ReplayInputSource(&replay_data));
+
+    HeadlessGame game(GetScenarioPtrFromChapter(replay_data.chapter_id));
+    while (game.step()) { }
+
+    Outcome outcome;
+    outcome.result = game.result();
+    outcome.ticks = game.ticks();
+    outcome.synch = globals()->gSynchValue;
+    outcome.debriefing = replay_debriefing(game.result(), game.seconds());
+    globals()->gInputSource.reset();
+    return outcome;
+}
+
+struct Worker {
+    size_t replay;
+    pid_t pid;
+    int fd;  // read end of the pipe the worker reports on
+};
+
+// Starts a worker for `replay_path`, which writes its Outcome to a pipe and exits.
+Worker start_worker(size_t replay, StringSlice replay_path) {
+    int fds[2];
+    if (pipe(fds) < 0) {
+        throw Exception("pipe() failed");
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        throw Exception("fork() failed");
+    } else if (pid == 0) {
+        close(fds[0]);
+        ScopedFd out(fds[1]);
+        write(out, play(replay_path));
+        _exit(0);
+    }
+    close(fds[1]);
+    Worker worker = {replay, pid, fds[0]};
+    return worker;
+}
+
+Bytes read_all(int fd) {
+    Bytes bytes;
+    uint8_t buffer[4096];
+    ssize_t size;
+    while ((size = ::read(fd, buffer, sizeof(buffer))) > 0) {
+        bytes.push(BytesSlice(buffer, size_t(size)));
+    }
+    return bytes;
+}
+
+StringSlice result_name(int32_t result) {
+    switch (result) {
+      case WIN_GAME:    return "win";
+      case LOSE_GAME:   return "loss";
+      default:          return "quit";
+    }
+}
+
+void main(int argc, char** argv) {
+    args::Parser parser(argv[0], "Plays a directory of replays in parallel and checks them");
+
+    String replay_dir;
+    Optional<String> expected_dir;
+    int jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    parser.add_argument("directory", store(replay_dir))
+        .help("a directory of .NLRP replays")
+        .required();
+    parser.add_argument("-e", "--expected", store(expected_dir))
+        .help("compare each debriefing against NAME/debriefing.txt in this directory");
+    parser.add_argument("-j", "--jobs", store(jobs))
+        .help("number of replays to play at once (default: one per CPU)");
+    parser.add_argument("-h", "--help", help(parser, 0))
+        .help("display this help screen");
+
+    String error;
+    if (!parser.parse_args(argc - 1, argv + 1, error)) {
+        print(io::err, format("{0}: {1}\n", parser.name(), error));
+        exit(1);
+    }
+    if (jobs < 1) {
+        print(io::err, format("{0}: --jobs must be positive\n", parser.name()));
+        exit(1);
+    }
+
+    vector<String> replays;
+    {
+        ScopedGlob g;
+        String pattern(format("{0}/*.NLRP", replay_dir));
+        CString c_pattern(pattern);
+        glob(c_pattern.data(), 0, NULL, &g.data);
+        for (size_t i = 0; i < g.data.gl_pathc; ++i) {
+            replays.push_back(String(utf8::decode(g.data.gl_pathv[i])));
+        }
+    }
+
+    NullPrefsDriver prefs;
+    NullSoundDriver sound;
+    NullLedger ledger;
+    HeadlessInit();
+
+    const int64_t start = usecs();
+    map<int, Worker> running;
+    size_t next = 0;
+    int failures = 0;
+    int64_t ticks = 0;
+    while ((next < replays.size()) || !running.empty()) {
+        while ((next < replays.size()) && (running.size() < size_t(jobs))) {
+            Worker worker = start_worker(next, replays[next]);
+            running[worker.fd] = worker;
+            ++next;
+        }
+
+        // Workers report before exiting, so read whichever pipe has data first.
+        fd_set fds;
+        FD_ZERO(&fds);
+        int max_fd = -1;
+        for (const auto& it: running) {
+            FD_SET(it.first, &fds);
+            max_fd = std::max(max_fd, it.first);
+        }
+        if (select(max_fd + 1, &fds, NULL, NULL, NULL) < 0) {
+            throw Exception("select() failed");
+        }
+        for (auto it = running.begin(); it != running.end(); ) {
+            if (!FD_ISSET(it->first, &fds)) {
+                ++it;
+                continue;
+            }
+            const Worker worker = it->second;
+            running.erase(it++);
+            Bytes report = read_all(worker.fd);
+            close(worker.fd);
+            int exit_status;
+            waitpid(worker.pid, &exit_status, 0);
+
+            StringSlice name = path::basename(replays[worker.replay]);
+            name = name.slice(0, name.size() - 5);  // ".NLRP"
+            if (!WIFEXITED(exit_status) || (WEXITSTATUS(exit_status) != 0) || report.empty()) {
+                print(io::out, format("FAIL {0}: crashed\n", name));
+                ++failures;
+                continue;
+            }
+            Outcome outcome;
+            BytesSlice in(report);
+            read(in, outcome);
+            ticks += outcome.ticks;
+
+            const char* status = "ok";
+            if (expected_dir.has()) {
+                String expected_path(format("{0}/{1}/debriefing.txt", *expected_dir, name));
+                if (!path::isfile(expected_path)
+                        || (MappedFile(expected_path).data() != outcome.debriefing)) {
+                    status = "FAIL";
+                    ++failures;
+                }
+            }
+            print(io::out, format("{0} {1}: {2} in {3} ticks, synch {4}\n",
+                        status, name, result_name(outcome.result), outcome.ticks,
+                        hex(outcome.synch, 8)));
+        }
+    }
+
+    const double seconds = (usecs() - start) / 1e6;
+    print(io::out, format("replays: {0}\n", replays.size()));
+    print(io::out, format("failures: {0}\n", failures));
+    print(io::out, format("jobs: {0}\n", jobs));
+    print(io::out, format("seconds: {0}\n", seconds));
+    if (seconds > 0) {
+        print(io::out, format("replays/second: {0}\n", replays.size() / seconds));
+        print(io::out, format("ticks/second: {0}\n", int64_t(ticks / seconds)));
+    }
+    exit(failures ? 1 : 0);
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char** argv) {
+    antares::main(argc, argv);
+    return 0;
+}
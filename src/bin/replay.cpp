@@ -30,6 +30,7 @@
 #include "game/cheat.hpp"
 #include "game/cursor.hpp"
 #include "game/globals.hpp"
+#include "game/headless.hpp"
 #include "game/input-source.hpp"
 #include "game/instruments.hpp"
 #include "game/labels.hpp"
@@ -37,15 +38,18 @@
 #include "game/messages.hpp"
 #include "game/motion.hpp"
 #include "game/scenario-maker.hpp"
+#include "game/sync.hpp"
+#include "game/time.hpp"
 #include "math/random.hpp"
 #include "math/rotation.hpp"
+#include "math/units.hpp"
 #include "sound/driver.hpp"
 #include "sound/music.hpp"
 #include "ui/card.hpp"
 #include "ui/interface-handling.hpp"
-#include "ui/screens/debriefing.hpp"
 #include "video/driver.hpp"
 #include "video/offscreen-driver.hpp"
+#include "video/software-driver.hpp"
 #include "video/text-driver.hpp"
 
 using sfz::BytesSlice;
@@ -59,6 +63,7 @@ using sfz::args::store_const;
 using sfz::format;
 using sfz::mkdir;
 using sfz::open;
+using sfz::read;
 using std::unique_ptr;
 
 namespace args = sfz::args;
@@ -70,12 +75,20 @@ namespace antares {
 
 class ReplayMaster : public Card {
   public:
-    ReplayMaster(BytesSlice data, Optional<String> output_path):
+    ReplayMaster(
+            BytesSlice data, Optional<String> output_path, const ReplayIndex::Keyframe* keyframe,
+            Optional<int64_t> to):
             _state(NEW),
             _output_path(output_path),
             _replay_data(data),
+            _keyframe(keyframe),
             _random_seed(_replay_data.global_seed),
-            _game_result(NO_GAME) { }
+            _game_result(NO_GAME) {
+        if (to.has()) {
+            _replay_data.duration = std::min<uint64_t>(
+                    _replay_data.duration, *to / kDecideEveryCycles);
+        }
+    }
 
     virtual void become_front() {
         switch (_state) {
@@ -84,11 +97,11 @@ class ReplayMaster : public Card {
             init();
             Randomize(4);  // For the decision to replay intro.
             _game_result = NO_GAME;
-            gRandomSeed.seed = _random_seed;
+            globals()->gRandomSeed.seed = _random_seed;
             globals()->gInputSource.reset(new ReplayInputSource(&_replay_data));
             stack()->push(new MainPlay(
                         GetScenarioPtrFromChapter(_replay_data.chapter_id), true, false,
-                        &_game_result, &_seconds));
+                        _keyframe, &_game_result, &_seconds));
             break;
 
           case REPLAY:
@@ -96,19 +109,7 @@ class ReplayMaster : public Card {
                 String path(format("{0}/debriefing.txt", *_output_path));
                 makedirs(path::dirname(path), 0755);
                 ScopedFd outcome(open(path, O_WRONLY | O_CREAT, 0644));
-                if ((globals()->gScenarioWinner.text >= 0)) {
-                    Resource rsrc("text", "txt", globals()->gScenarioWinner.text);
-                    sfz::write(outcome, rsrc.data());
-                    if (_game_result == WIN_GAME) {
-                        sfz::write(outcome, "\n\n");
-                        String text = DebriefingScreen::build_score_text(
-                                _seconds, gThisScenario->parTime,
-                                GetAdmiralLoss(0), gThisScenario->parLosses,
-                                GetAdmiralKill(0), gThisScenario->parKills);
-                        sfz::write(outcome, utf8::encode(text));
-                    }
-                    sfz::write(outcome, "\n");
-                }
+                sfz::write(outcome, replay_debriefing(_game_result, _seconds));
             }
             stack()->pop(this);
             break;
@@ -126,6 +127,7 @@ class ReplayMaster : public Card {
 
     Optional<String> _output_path;
     ReplayData _replay_data;
+    const ReplayIndex::Keyframe* const _keyframe;
     const int32_t _random_seed;
     GameResult _game_result;
     int32_t _seconds;
@@ -160,6 +162,103 @@ void ReplayMaster::init() {
     Beams::init();
 }
 
+// Replays without a VideoDriver, printing the outcome, the final sync value, and the length and
+// score of the game.  The outcome is the same as that of a rendered replay of the same file.  If
+// `keyframe` is given, play begins there; if `to` is given, play stops there.  If `sync_path` is
+// given, a sync stream is written there; if `dump_at` is given, the state at that tick is
+// written to `output_dir`.  If `output_dir` is given, the outcome and sync value are also
+// written there, as sim.txt, along with the same debriefing.txt that a rendered replay writes.
+void sim_only(
+        BytesSlice data, const ReplayIndex::Keyframe* keyframe, Optional<int64_t> to,
+        const Optional<String>& sync_path, Optional<int64_t> dump_at,
+        const Optional<String>& output_dir) {
+    ReplayData replay_data(data);
+    HeadlessInit();
+    Randomize(4);  // For the decision to replay intro.
+    globals()->gRandomSeed.seed = replay_data.global_seed;
+    globals()->gInputSource.reset(new ReplayInputSource(&replay_data));
+
+    HeadlessGame game(GetScenarioPtrFromChapter(replay_data.chapter_id));
+    if (keyframe) {
+        advance_headless_clock(keyframe->at);
+        game.restore_state(keyframe->state);
+    }
+    unique_ptr<SyncRecorder> sync;
+    if (sync_path.has()) {
+        sync.reset(new SyncRecorder(*sync_path));
+        game.set_sync_recorder(sync.get());
+    }
+    while ((!to.has() || (game.ticks() < *to)) && game.step()) {
+        if (dump_at.has() && (game.ticks() == *dump_at)) {
+            String dump;
+            dump_state(dump);
+            String path(format("{0}/state-{1}.txt", *output_dir, *dump_at));
+            ScopedFd file(open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644));
+            sfz::write(file, utf8::encode(dump));
+        }
+    }
+
+    StringSlice outcome = "quit";
+    if (game.result() == WIN_GAME) {
+        outcome = "win";
+    } else if (game.result() == LOSE_GAME) {
+        outcome = "loss";
+    }
+    // Only the outcome and the sync value go in sim.txt: those are all that a rendered replay
+    // before the rework can report (see scripts/record-sim-tests).
+    String summary;
+    print(summary, format("outcome: {0}\n", outcome));
+    print(summary, format("synch: {0}\n", globals()->gSynchValue));
+    print(io::out, summary);
+    print(io::out, format("ticks: {0}\n", game.ticks()));
+    print(io::out, format("seconds: {0}\n", game.seconds()));
+    print(io::out, format("kills: {0}\n", GetAdmiralKill(0)));
+    print(io::out, format("losses: {0}\n", GetAdmiralLoss(0)));
+    if (globals()->gDroppedSpaceObjects > 0) {
+        print(io::err, format("{0} objects dropped for want of a slot\n",
+                    globals()->gDroppedSpaceObjects));
+    }
+    if (output_dir.has()) {
+        String sim_path(format("{0}/sim.txt", *output_dir));
+        ScopedFd sim_file(open(sim_path, O_WRONLY | O_CREAT | O_TRUNC, 0644));
+        sfz::write(sim_file, utf8::encode(summary));
+        String debriefing_path(format("{0}/debriefing.txt", *output_dir));
+        ScopedFd debriefing_file(open(debriefing_path, O_WRONLY | O_CREAT | O_TRUNC, 0644));
+        sfz::write(debriefing_file, replay_debriefing(game.result(), game.seconds()));
+    }
+
+    globals()->gInputSource.reset();
+}
+
+// Plays the replay through once without a VideoDriver, saving a keyframe every `interval`
+// ticks, and writes the keyframes to the replay's index.
+void build_index(BytesSlice data, StringSlice replay_path, int64_t interval) {
+    ReplayData replay_data(data);
+    HeadlessInit();
+    Randomize(4);  // For the decision to replay intro.
+    globals()->gRandomSeed.seed = replay_data.global_seed;
+    globals()->gInputSource.reset(new ReplayInputSource(&replay_data));
+
+    ReplayIndex index;
+    index.chapter_id = replay_data.chapter_id;
+    index.global_seed = replay_data.global_seed;
+    index.interval = interval;
+
+    HeadlessGame game(GetScenarioPtrFromChapter(replay_data.chapter_id));
+    while (game.step()) {
+        if ((game.ticks() % interval) == 0) {
+            index.keyframes.emplace_back();
+            index.keyframes.back().at = game.ticks();
+            index.keyframes.back().state = game.save_state();
+        }
+    }
+    globals()->gInputSource.reset();
+
+    ScopedFd file(open(replay_index_path(replay_path), O_WRONLY | O_CREAT | O_TRUNC, 0644));
+    sfz::write(file, index);
+    print(io::out, format("keyframes: {0}\n", index.keyframes.size()));
+}
+
 void usage(StringSlice program_name) {
     print(io::err, format("usage: {0} replay_path output_dir\n", program_name));
     exit(1);
@@ -181,7 +280,17 @@ void main(int argc, char** argv) {
     int width = 640;
     int height = 480;
     bool text = false;
+    bool software = false;
+    bool movie = false;
+    bool draw_log = false;
     bool smoke = false;
+    bool sim = false;
+    Optional<int> index_seconds;
+    Optional<int64_t> from;
+    Optional<int64_t> to;
+    Optional<String> sync_path;
+    Optional<int64_t> dump_at;
+    int32_t objects = 0;
     parser.add_argument("-i", "--interval", store(interval))
         .help("take one screenshot per this many ticks (default: 60)");
     parser.add_argument("-w", "--width", store(width))
@@ -190,8 +299,28 @@ void main(int argc, char** argv) {
         .help("screen height (default: 480)");
     parser.add_argument("-t", "--text", store_const(text, true))
         .help("produce text output");
+    parser.add_argument("--software", store_const(software, true))
+        .help("render on the CPU instead of with OpenGL");
+    parser.add_argument("--movie", store_const(movie, true))
+        .help("write every tick to screens.y4m instead of taking screenshots");
+    parser.add_argument("--draw-log", store_const(draw_log, true))
+        .help("with --text, write snapshots to screens.drawlog instead of text files");
     parser.add_argument("-s", "--smoke", store_const(smoke, true))
         .help("run as smoke text");
+    parser.add_argument("--sim-only", store_const(sim, true))
+        .help("run the simulation without rendering; print the outcome, and write it to --output");
+    parser.add_argument("--index", store(index_seconds))
+        .help("write a keyframe index beside the replay, one keyframe per this many seconds");
+    parser.add_argument("--from", store(from))
+        .help("begin at the last indexed keyframe at or before this tick");
+    parser.add_argument("--to", store(to))
+        .help("stop at this tick");
+    parser.add_argument("--sync", store(sync_path))
+        .help("with --sim-only, write a sync stream to this file");
+    parser.add_argument("--dump", store(dump_at))
+        .help("with --sim-only, write the state at this tick into the output directory");
+    parser.add_argument("--objects", store(objects))
+        .help("object slots per game (default and minimum: 250)");
 
     parser.add_argument("--help", help(parser, 0))
         .help("display this help screen");
@@ -202,6 +331,23 @@ void main(int argc, char** argv) {
         exit(1);
     }
 
+    if ((sync_path.has() || dump_at.has()) && !sim) {
+        print(io::err, format("{0}: --sync and --dump require --sim-only\n", parser.name()));
+        exit(1);
+    }
+    if (dump_at.has() && !output_dir.has()) {
+        print(io::err, format("{0}: --dump requires --output\n", parser.name()));
+        exit(1);
+    }
+    if (movie && (!output_dir.has() || text || smoke || sim)) {
+        print(io::err, format("{0}: --movie requires --output and an image driver\n",
+                    parser.name()));
+        exit(1);
+    }
+    if (draw_log && (!output_dir.has() || !text || smoke)) {
+        print(io::err, format("{0}: --draw-log requires --output and --text\n", parser.name()));
+        exit(1);
+    }
     if (output_dir.has()) {
         makedirs(*output_dir, 0755);
     }
@@ -209,17 +355,50 @@ void main(int argc, char** argv) {
     Preferences preferences;
     preferences.set_screen_size(Size(width, height));
     preferences.set_play_music_in_game(true);
+    preferences.set_object_capacity(objects);
     NullPrefsDriver prefs(preferences);
 
+    MappedFile replay_file(replay_path);
+    if (index_seconds.has()) {
+        if (*index_seconds <= 0) {
+            print(io::err, format("{0}: --index must be positive\n", parser.name()));
+            exit(1);
+        }
+        NullSoundDriver sound;
+        NullLedger ledger;
+        build_index(replay_file.data(), replay_path, *index_seconds * 60);
+        return;
+    }
+
+    // Without an index, --from only limits which snapshots are taken.
+    ReplayIndex index;
+    const ReplayIndex::Keyframe* keyframe = NULL;
+    if (from.has() && path::isfile(replay_index_path(replay_path))) {
+        MappedFile index_file(replay_index_path(replay_path));
+        BytesSlice in(index_file.data());
+        read(in, index);
+        ReplayData replay_data(replay_file.data());
+        if ((index.chapter_id != replay_data.chapter_id)
+                || (index.global_seed != replay_data.global_seed)) {
+            print(io::err, format("{0}: index does not match replay\n", parser.name()));
+            exit(1);
+        }
+        keyframe = index.find(*from);
+    }
+    const int64_t start = keyframe ? keyframe->at : 0;
+
     EventScheduler scheduler;
-    scheduler.schedule_event(unique_ptr<Event>(new MouseMoveEvent(0, Point(320, 240))));
+    scheduler.start_at(start);
+    scheduler.schedule_event(unique_ptr<Event>(new MouseMoveEvent(start, Point(320, 240))));
     // TODO(sfiera): add recurring snapshots to OffscreenVideoDriver.
-    for (int64_t i = 1; i < 72000; i += interval) {
+    const int64_t first_snapshot = from.has() ? *from : 1;
+    const int64_t last_snapshot = to.has() ? *to : 72000;
+    for (int64_t i = first_snapshot; i < last_snapshot; i += (movie ? 1 : interval)) {
         scheduler.schedule_snapshot(i);
     }
 
     unique_ptr<SoundDriver> sound;
-    if (!smoke && output_dir.has()) {
+    if (!smoke && !sim && output_dir.has()) {
         String out(format("{0}/sound.log", *output_dir));
         sound.reset(new LogSoundDriver(out));
     } else {
@@ -228,16 +407,29 @@ void main(int argc, char** argv) {
     NullLedger ledger;
 
     Size screen_size = Preferences::preferences()->screen_size();
-    MappedFile replay_file(replay_path);
-    if (smoke) {
+    if (sim) {
+        sim_only(replay_file.data(), keyframe, to, sync_path, dump_at, output_dir);
+    } else if (smoke) {
         TextVideoDriver video(screen_size, scheduler, Optional<String>());
-        video.loop(new ReplayMaster(replay_file.data(), output_dir));
+        video.loop(new ReplayMaster(replay_file.data(), output_dir, keyframe, to));
     } else if (text) {
         TextVideoDriver video(screen_size, scheduler, output_dir);
-        video.loop(new ReplayMaster(replay_file.data(), output_dir));
+        if (draw_log) {
+            video.write_draw_log(String(format("{0}/screens.drawlog", *output_dir)));
+        }
+        video.loop(new ReplayMaster(replay_file.data(), output_dir, keyframe, to));
+    } else if (software) {
+        SoftwareVideoDriver video(screen_size, scheduler, output_dir);
+        if (movie) {
+            video.write_movie(String(format("{0}/screens.y4m", *output_dir)));
+        }
+        video.loop(new ReplayMaster(replay_file.data(), output_dir, keyframe, to));
     } else {
         OffscreenVideoDriver video(screen_size, scheduler, output_dir);
-        video.loop(new ReplayMaster(replay_file.data(), output_dir));
+        if (movie) {
+            video.write_movie(String(format("{0}/screens.y4m", *output_dir)));
+        }
+        video.loop(new ReplayMaster(replay_file.data(), output_dir, keyframe, to));
     }
 }
 
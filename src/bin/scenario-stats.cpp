@@ -0,0 +1,260 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <sfz/sfz.hpp>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "data/scenario.hpp"
+#include "data/space-object.hpp"
+#include "game/admiral.hpp"
+#include "game/globals.hpp"
+#include "game/headless.hpp"
+#include "game/player-ship.hpp"
+#include "game/scenario-maker.hpp"
+#include "game/space-object.hpp"
+#include "math/units.hpp"
+#include "sound/driver.hpp"
+
+using sfz::Exception;
+using sfz::String;
+using sfz::args::help;
+using sfz::args::store;
+using sfz::format;
+using std::atomic;
+using std::min;
+using std::sort;
+using std::thread;
+using std::vector;
+
+namespace args = sfz::args;
+namespace io = sfz::io;
+
+namespace antares {
+namespace {
+
+int64_t usecs() {
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000ll + tv.tv_usec;
+}
+
+// What one simulated game came to.  `result` is NO_GAME if the game was cut off at the limit.
+struct Outcome {
+    int32_t result;
+    int64_t ticks;
+    int8_t winner;
+    int32_t kills[kMaxPlayerNum];
+    int32_t losses[kMaxPlayerNum];
+    int32_t dropped;  // objects not created because every slot was in use
+};
+
+// Hands the player's side to the computer: its admiral builds and picks targets like any other
+// computer admiral, and its flagship flies on autopilot.
+void automate_player() {
+    SetAdmiralAttributes(globals()->gPlayerAdmiralNumber, kAIsComputer);
+}
+
+// Reaching a destination, or losing a target, turns autopilot off, and a new flagship starts
+// without it, so this is checked after every tick.
+void keep_flagship_on_autopilot() {
+    spaceObjectType* flagship = GetAdmiralFlagship(globals()->gPlayerAdmiralNumber);
+    if (flagship && (flagship->active == kObjectInUse)
+            && !(flagship->attributes & kOnAutoPilot)) {
+        TogglePlayerAutoPilot(flagship);
+    }
+}
+
+// Plays `scenario` from `seed` in a fresh game of its own, so that the outcome depends only on
+// the seed, and not on which thread played it or what that thread played before.  Games share
+// the scenario, base objects and actions, but only read them; everything play writes, down to
+// which objects the scenario's initials became and which conditions have fired, is in `context`.
+Outcome play(const Scenario* scenario, int32_t seed, int64_t tick_limit) {
+    aresGlobalType context;
+    ScopedGlobals scoped(&context);
+    HeadlessInitGame();
+    globals()->gRandomSeed.seed = seed;
+
+    HeadlessGame game(scenario);
+    automate_player();
+    keep_flagship_on_autopilot();
+    while ((game.ticks() < tick_limit) && game.step()) {
+        keep_flagship_on_autopilot();
+    }
+
+    Outcome outcome;
+    outcome.result = game.result();
+    outcome.ticks = game.ticks();
+    outcome.winner = -1;
+    if ((game.result() == WIN_GAME) || (game.result() == LOSE_GAME)) {
+        outcome.winner = globals()->gScenarioWinner.player;
+    }
+    for (int i = 0; i < kMaxPlayerNum; ++i) {
+        outcome.kills[i] = GetAdmiralKill(i);
+        outcome.losses[i] = GetAdmiralLoss(i);
+    }
+    outcome.dropped = globals()->gDroppedSpaceObjects;
+    return outcome;
+}
+
+double game_minutes(int64_t ticks) {
+    return ticks_to_usecs(ticks) / 60e6;
+}
+
+double percentile(const vector<int64_t>& sorted, int percent) {
+    return game_minutes(sorted[(sorted.size() - 1) * percent / 100]);
+}
+
+void main(int argc, char** argv) {
+    args::Parser parser(argv[0], "Plays a scenario from many seeds with the computer on all sides");
+
+    int32_t chapter;
+    int32_t first_seed = 0;
+    int count = 100;
+    int minutes = 60;
+    int jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    int32_t objects = 0;
+    parser.add_argument("chapter", store(chapter))
+        .help("chapter of the scenario to play")
+        .required();
+    parser.add_argument("-s", "--seed", store(first_seed))
+        .help("first seed to play (default: 0)");
+    parser.add_argument("-n", "--count", store(count))
+        .help("number of seeds to play, counting up from --seed (default: 100)");
+    parser.add_argument("-m", "--minutes", store(minutes))
+        .help("stop a game after this many minutes of game time (default: 60)");
+    parser.add_argument("-j", "--jobs", store(jobs))
+        .help("number of games to play at once (default: one per CPU)");
+    parser.add_argument("--objects", store(objects))
+        .help("object slots per game (default and minimum: 250)");
+    parser.add_argument("-h", "--help", help(parser, 0))
+        .help("display this help screen");
+
+    String error;
+    if (!parser.parse_args(argc - 1, argv + 1, error)) {
+        print(io::err, format("{0}: {1}\n", parser.name(), error));
+        exit(1);
+    }
+    if ((count < 1) || (minutes < 1) || (jobs < 1)) {
+        print(io::err, format("{0}: --count, --minutes and --jobs must be positive\n",
+                    parser.name()));
+        exit(1);
+    }
+
+    Preferences preferences;
+    preferences.set_object_capacity(objects);
+    NullPrefsDriver prefs(preferences);
+    NullSoundDriver sound;
+    NullLedger ledger;
+    HeadlessInit();
+
+    const Scenario* scenario = GetScenarioPtrFromChapter(chapter);
+    if (scenario == NULL) {
+        throw Exception(format("{0}: no such chapter", chapter));
+    }
+    const int64_t tick_limit = usecs_to_ticks(minutes * 60000000ll);
+
+    // Each thread takes the next unplayed seed until there are none left.  Outcomes are stored
+    // by seed, so the report is the same whatever order the games finish in.
+    const int64_t start = usecs();
+    vector<Outcome> outcomes(count);
+    atomic<int> next(0);
+    vector<thread> threads;
+    for (int i = 0; i < min(jobs, count); ++i) {
+        threads.push_back(thread([&] {
+            for (int game = next++; game < count; game = next++) {
+                outcomes[game] = play(scenario, first_seed + game, tick_limit);
+            }
+        }));
+    }
+    for (thread& t: threads) {
+        t.join();
+    }
+    const double seconds = (usecs() - start) / 1e6;
+
+    int wins = 0;
+    int unfinished = 0;
+    int64_t ticks = 0;
+    int64_t dropped = 0;
+    int short_games = 0;
+    vector<int64_t> lengths;
+    for (const Outcome& outcome: outcomes) {
+        ticks += outcome.ticks;
+        dropped += outcome.dropped;
+        if (outcome.dropped > 0) {
+            ++short_games;
+        }
+        if (outcome.result == WIN_GAME) {
+            ++wins;
+        }
+        if (outcome.result == NO_GAME) {
+            ++unfinished;
+        } else {
+            lengths.push_back(outcome.ticks);
+        }
+    }
+    sort(lengths.begin(), lengths.end());
+
+    print(io::out, format("chapter: {0}\n", chapter));
+    print(io::out, format("seeds: {0} to {1}\n", first_seed, first_seed + count - 1));
+    print(io::out, format("win rate: {0}% ({1} of {2})\n", 100.0 * wins / count, wins, count));
+    print(io::out, format("unfinished: {0} (over {1} minutes)\n", unfinished, minutes));
+    if (!lengths.empty()) {
+        print(io::out, format("minutes: min {0}, 25% {1}, median {2}, 75% {3}, max {4}\n",
+                    percentile(lengths, 0), percentile(lengths, 25), percentile(lengths, 50),
+                    percentile(lengths, 75), percentile(lengths, 100)));
+    }
+    for (int i = 0; i < scenario->playerNum; ++i) {
+        int won = 0;
+        int64_t kills = 0;
+        int64_t losses = 0;
+        for (const Outcome& outcome: outcomes) {
+            if (outcome.winner == i) {
+                ++won;
+            }
+            kills += outcome.kills[i];
+            losses += outcome.losses[i];
+        }
+        print(io::out, format("admiral {0}: won {1}, {2} kills and {3} losses per game\n",
+                    i, won, double(kills) / count, double(losses) / count));
+    }
+    if (dropped > 0) {
+        print(io::out, format("dropped objects: {0} in {1} games (try a larger --objects)\n",
+                    dropped, short_games));
+    }
+    print(io::out, format("jobs: {0}\n", jobs));
+    print(io::out, format("seconds: {0}\n", seconds));
+    if (seconds > 0) {
+        print(io::out, format("sims/second: {0}\n", count / seconds));
+        print(io::out, format("ticks/second: {0}\n", int64_t(ticks / seconds)));
+    }
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char** argv) {
+    antares::main(argc, argv);
+    return 0;
+}
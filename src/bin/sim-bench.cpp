@@ -0,0 +1,243 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <sys/time.h>
+#include <sfz/sfz.hpp>
+
+#include "config/ledger.hpp"
+#include "config/preferences.hpp"
+#include "data/space-object.hpp"
+#include "drawing/sprite-handling.hpp"
+#include "game/beam.hpp"
+#include "game/globals.hpp"
+#include "game/headless.hpp"
+#include "game/motion.hpp"
+#include "game/scenario-maker.hpp"
+#include "game/space-object.hpp"
+#include "math/fixed.hpp"
+#include "math/random.hpp"
+#include "math/rotation.hpp"
+#include "math/units.hpp"
+#include "sound/driver.hpp"
+
+using sfz::Exception;
+using sfz::Optional;
+using sfz::String;
+using sfz::StringSlice;
+using sfz::args::help;
+using sfz::args::store;
+using sfz::args::store_const;
+using sfz::format;
+using std::max;
+using std::vector;
+
+namespace args = sfz::args;
+namespace io = sfz::io;
+
+namespace antares {
+namespace {
+
+const uint32_t kBenchSkipAttributes = kIsBeam | kIsDestination;
+
+int64_t usecs() {
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000ll + tv.tv_usec;
+}
+
+int32_t random_offset(int32_t spread) {
+    return (int64_t(globals()->gRandomSeed.next(0x4000)) * spread / 0x4000) - (spread / 2);
+}
+
+// Fills the world with `count` drifting objects, cycling through `bases`, scattered over a
+// square `spread` units across.  All are neutral, so they never damage each other.
+void populate(const vector<int32_t>& bases, int count, int32_t spread) {
+    for (int32_t base: bases) {
+        AddBaseObjectMedia(base, 0);
+    }
+    for (int i = 0; i < count; ++i) {
+        coordPointType location;
+        location.h = kUniversalCenter + random_offset(spread);
+        location.v = kUniversalCenter + random_offset(spread);
+        fixedPointType velocity;
+        velocity.h = globals()->gRandomSeed.next(mLongToFixed(2)) - mLongToFixed(1);
+        velocity.v = globals()->gRandomSeed.next(mLongToFixed(2)) - mLongToFixed(1);
+        const int32_t base = bases[i % bases.size()];
+        if (CreateAnySpaceObject(
+                    base, &velocity, &location, globals()->gRandomSeed.next(ROT_POS), -1, 0, -1) < 0) {
+            throw Exception(format("couldn't create object {0} of {1}", i + 1, count));
+        }
+    }
+}
+
+int count_live_objects() {
+    int count = 0;
+    for (int32_t i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i)) {
+        if (mGetSpaceObjectPtr(i)->active == kObjectInUse) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+// What one run of the benchmark came to.  Times are per call.
+struct Timing {
+    int live;
+    int64_t move_ns;
+    int64_t collide_ns;
+    int64_t occupied;  // collision units holding objects, per collide
+};
+
+// Plays `ticks` ticks of a fresh crowd of `count` objects spread over `spread` units.  With
+// `rebuild`, every collide clears and visits the whole grid, as it did before occupied units were
+// tracked.  Every run starts from the same seed, so two runs that differ only in `rebuild` move
+// and collide the same objects in the same way.
+Timing run(const vector<int32_t>& bases, int count, int32_t spread, int ticks, bool rebuild) {
+    SetSpaceObjectCapacity(max(kMinSpaceObjectCapacity, count));
+    ResetActionQueueData();
+    Beams::reset();
+    ResetAllSprites();
+    ResetMotionGlobals();
+    globals()->gRandomSeed.seed = 0;
+    populate(bases, count, spread);
+
+    int64_t move_usecs = 0;
+    int64_t collide_usecs = 0;
+    int collide_calls = 0;
+    int64_t occupied_units = 0;
+    for (int tick = 0; tick < ticks; ++tick) {
+        int64_t start = usecs();
+        MoveSpaceObjects(1);
+        move_usecs += usecs() - start;
+        if ((tick % kDecideEveryCycles) == 0) {
+            if (rebuild) {
+                MarkAllProximityUnitsOccupied();
+            }
+            start = usecs();
+            CollideSpaceObjects();
+            collide_usecs += usecs() - start;
+            ++collide_calls;
+            occupied_units += CountOccupiedProximityUnits();
+        }
+    }
+
+    Timing timing;
+    timing.live = count_live_objects();
+    timing.move_ns = move_usecs * 1000 / ticks;
+    timing.collide_ns = collide_usecs * 1000 / collide_calls;
+    timing.occupied = occupied_units / collide_calls;
+    return timing;
+}
+
+// A sparse scene leaves most of the collision grid empty, as the large maps of most scenarios
+// do; a dense one crowds a few collision units.
+struct Scene {
+    StringSlice name;
+    int count;
+    int32_t spread;
+};
+const Scene kScenes[] = {
+    {"sparse", 25, 65536},
+    {"dense", 1000, 1024},
+};
+
+void main(int argc, char** argv) {
+    args::Parser parser(argv[0], "Times the motion and collision passes over a crowd of objects");
+
+    int count = kMinSpaceObjectCapacity;
+    int ticks = 3000;
+    int32_t spread = 16384;
+    Optional<int32_t> base;
+    bool rebuild = false;
+    bool compare = false;
+    parser.add_argument("-n", "--objects", store(count))
+        .help("number of objects to create (default: 250)");
+    parser.add_argument("-t", "--ticks", store(ticks))
+        .help("number of ticks to simulate (default: 3000)");
+    parser.add_argument("-s", "--spread", store(spread))
+        .help("width of the square the objects start in (default: 16384)");
+    parser.add_argument("-b", "--base", store(base))
+        .help("base object to create (default: cycle through all ships)");
+    parser.add_argument("--rebuild", store_const(rebuild, true))
+        .help("clear and visit every collision unit on every collide");
+    parser.add_argument("--compare", store_const(compare, true))
+        .help("time a sparse and a dense scene, with and without --rebuild");
+    parser.add_argument("-h", "--help", help(parser, 0))
+        .help("display this help screen");
+
+    String error;
+    if (!parser.parse_args(argc - 1, argv + 1, error)) {
+        print(io::err, format("{0}: {1}\n", parser.name(), error));
+        exit(1);
+    }
+    if ((count < 1) || (ticks < 1)) {
+        print(io::err, format("{0}: --objects and --ticks must be positive\n", parser.name()));
+        exit(1);
+    }
+
+    NullPrefsDriver prefs;
+    NullSoundDriver sound;
+    NullLedger ledger;
+    HeadlessInit();
+
+    vector<int32_t> bases;
+    if (base.has()) {
+        bases.push_back(*base);
+    } else {
+        for (int32_t i = 0; i < plugin()->maxBaseObject; ++i) {
+            const baseObjectType* b = mGetBaseObjectPtr(i);
+            if ((b->attributes & kCanThink) && !(b->attributes & kBenchSkipAttributes)
+                    && (b->pixResID != kNoSpriteTable)) {
+                bases.push_back(i);
+            }
+        }
+    }
+    if (bases.empty()) {
+        throw Exception("no base objects to create");
+    }
+
+    if (compare) {
+        print(io::out, format("ticks: {0}\n", ticks));
+        for (const Scene& scene: kScenes) {
+            const Timing incremental = run(bases, scene.count, scene.spread, ticks, false);
+            const Timing full = run(bases, scene.count, scene.spread, ticks, true);
+            print(io::out, format("{0}: {1} objects over {2}, {3} units occupied\n",
+                        scene.name, scene.count, scene.spread, incremental.occupied));
+            print(io::out, format("  rebuild: collide {0} ns/call\n", full.collide_ns));
+            print(io::out, format("  incremental: collide {0} ns/call\n",
+                        incremental.collide_ns));
+        }
+        return;
+    }
+
+    const Timing timing = run(bases, count, spread, ticks, rebuild);
+    print(io::out, format("objects: {0}\n", count));
+    print(io::out, format("live: {0}\n", timing.live));
+    print(io::out, format("ticks: {0}\n", ticks));
+    print(io::out, format("move: {0} ns/call\n", timing.move_ns));
+    print(io::out, format("collide: {0} ns/call\n", timing.collide_ns));
+    print(io::out, format("occupied: {0} units/call\n", timing.occupied));
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char** argv) {
+    antares::main(argc, argv);
+    return 0;
+}
@@ -0,0 +1,178 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include <algorithm>
+#include <sfz/sfz.hpp>
+
+#include "game/sync.hpp"
+
+using sfz::BytesSlice;
+using sfz::MappedFile;
+using sfz::String;
+using sfz::StringSlice;
+using sfz::args::help;
+using sfz::args::store;
+using sfz::format;
+using std::min;
+using std::vector;
+
+namespace args = sfz::args;
+namespace io = sfz::io;
+namespace utf8 = sfz::utf8;
+
+namespace antares {
+namespace {
+
+// Prints how `a` and `b`, which are records for the same tick, differ.  Objects are compared in
+// slot order, and only the first difference is reported.
+void print_record_difference(const SyncRecord& a, const SyncRecord& b) {
+    print(io::out, format("first divergence at tick {0}\n", a.at));
+    size_t i = 0, j = 0;
+    while ((i < a.objects.size()) || (j < b.objects.size())) {
+        const SyncRecord::Object* x = (i < a.objects.size()) ? &a.objects[i] : NULL;
+        const SyncRecord::Object* y = (j < b.objects.size()) ? &b.objects[j] : NULL;
+        if (!y || (x && (x->slot < y->slot))) {
+            print(io::out, format("object {0} (id {1}) exists only in a\n", x->slot, x->id));
+            return;
+        } else if (!x || (y->slot < x->slot)) {
+            print(io::out, format("object {0} (id {1}) exists only in b\n", y->slot, y->id));
+            return;
+        } else if (x->id != y->id) {
+            print(io::out, format("object {0} is id {1} in a but id {2} in b\n",
+                        x->slot, x->id, y->id));
+            return;
+        } else if (x->hash != y->hash) {
+            print(io::out, format("object {0} (id {1}) differs\n", x->slot, x->id));
+            return;
+        }
+        ++i;
+        ++j;
+    }
+    print(io::out, format("synch differs ({0} vs {1}), but every object matches\n",
+                a.synch, b.synch));
+}
+
+bool diff_streams(const vector<SyncRecord>& a, const vector<SyncRecord>& b) {
+    for (size_t i = 0; i < min(a.size(), b.size()); ++i) {
+        if (a[i].at != b[i].at) {
+            print(io::out, format("decide cycle {0} is at tick {1} in a but {2} in b\n",
+                        i, a[i].at, b[i].at));
+            return false;
+        }
+        if ((a[i].synch != b[i].synch) || (a[i].objects.size() != b[i].objects.size())
+                || !std::equal(a[i].objects.begin(), a[i].objects.end(), b[i].objects.begin(),
+                    [](const SyncRecord::Object& x, const SyncRecord::Object& y) {
+                        return (x.slot == y.slot) && (x.id == y.id) && (x.hash == y.hash);
+                    })) {
+            print_record_difference(a[i], b[i]);
+            print(io::out, format(
+                        "to find the field, run each build with "
+                        "\"antares/replay --sim-only --dump={0} -o DIR\"\n"
+                        "and compare the two state-{0}.txt files with this tool\n", a[i].at));
+            return false;
+        }
+    }
+    if (a.size() != b.size()) {
+        const vector<SyncRecord>& shorter = (a.size() < b.size()) ? a : b;
+        print(io::out, format("{0} ends after tick {1}\n",
+                    (a.size() < b.size()) ? "a" : "b",
+                    shorter.empty() ? 0 : shorter.back().at));
+        return false;
+    }
+    print(io::out, format("no divergence in {0} decide cycles\n", a.size()));
+    return true;
+}
+
+StringSlice next_line(StringSlice& text) {
+    size_t newline = text.find('\n');
+    if (newline == StringSlice::npos) {
+        StringSlice line = text;
+        text = StringSlice();
+        return line;
+    }
+    StringSlice line = text.slice(0, newline);
+    text = text.slice(newline + 1);
+    return line;
+}
+
+// Compares two dumps from dump_state(), line by line.
+bool diff_dumps(BytesSlice a_data, BytesSlice b_data) {
+    String a_string(utf8::decode(a_data));
+    String b_string(utf8::decode(b_data));
+    StringSlice a_text = a_string;
+    StringSlice b_text = b_string;
+    while (!a_text.empty() || !b_text.empty()) {
+        StringSlice a_line = next_line(a_text);
+        StringSlice b_line = next_line(b_text);
+        if (a_line != b_line) {
+            print(io::out, format("a: {0}\nb: {1}\n", a_line, b_line));
+            return false;
+        }
+    }
+    print(io::out, "no difference in dumped fields; the difference is in a field not dumped\n");
+    return true;
+}
+
+void main(int argc, char** argv) {
+    args::Parser parser(argv[0], "Reports where two runs of a replay first diverge");
+
+    String a_path;
+    String b_path;
+    parser.add_argument("a", store(a_path))
+        .help("a sync stream or state dump from \"antares/replay --sim-only\"")
+        .required();
+    parser.add_argument("b", store(b_path))
+        .help("the same, from the run to compare")
+        .required();
+    parser.add_argument("-h", "--help", help(parser, 0))
+        .help("display this help screen");
+
+    String error;
+    if (!parser.parse_args(argc - 1, argv + 1, error)) {
+        print(io::err, format("{0}: {1}\n", parser.name(), error));
+        exit(1);
+    }
+
+    MappedFile a_file(a_path);
+    MappedFile b_file(b_path);
+    vector<SyncRecord> a;
+    vector<SyncRecord> b;
+    const bool a_is_stream = read_sync_stream(a_file.data(), a);
+    const bool b_is_stream = read_sync_stream(b_file.data(), b);
+    if (a_is_stream != b_is_stream) {
+        print(io::err, format("{0}: can't compare a sync stream with a state dump\n",
+                    parser.name()));
+        exit(1);
+    }
+
+    bool same;
+    if (a_is_stream) {
+        same = diff_streams(a, b);
+    } else {
+        same = diff_dumps(a_file.data(), b_file.data());
+    }
+    exit(same ? 0 : 1);
+}
+
+}  // namespace
+}  // namespace antares
+
+int main(int argc, char** argv) {
+    antares::main(argc, argv);
+    return 0;
+}
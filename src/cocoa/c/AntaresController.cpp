@@ -24,8 +24,10 @@
 #include "cocoa/core-foundation.hpp"
 #include "cocoa/prefs-driver.hpp"
 #include "cocoa/video-driver.hpp"
+#include "config/dirs.hpp"
 #include "config/ledger.hpp"
 #include "config/preferences.hpp"
+#include "drawing/pix-table.hpp"
 #include "game/globals.hpp"
 #include "sound/openal-driver.hpp"
 #include "ui/card.hpp"
@@ -42,12 +44,14 @@ using antares::CoreFoundationPrefsDriver;
 using antares::DirectoryLedger;
 using antares::Ledger;
 using antares::Master;
+using antares::NatePixTable;
 using antares::NullLedger;
 using antares::OpenAlSoundDriver;
 using antares::Preferences;
 using antares::PrefsDriver;
 using antares::SoundDriver;
 using antares::VideoDriver;
+using antares::dirs;
 using antares::world;
 
 namespace utf8 = sfz::utf8;
@@ -67,6 +71,7 @@ struct AntaresDrivers {
 namespace antares {
 
 extern "C" AntaresDrivers* antares_controller_create_drivers(CFStringRef* error_message) {
+    NatePixTable::set_cache_dir(dirs().cache);
     return new AntaresDrivers();
 }
 
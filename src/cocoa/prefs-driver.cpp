@@ -44,6 +44,7 @@ static const char kFullscreenPreference[]      = "Fullscreen";
 static const char kScreenWidthPreference[]     = "ScreenWidth";
 static const char kScreenHeightPreference[]    = "ScreenHeight";
 static const char kScenarioPreference[]        = "Scenario";
+static const char kObjectCapacityPreference[]  = "ObjectCapacity";
 
 template <typename T>
 T clamp(T value, T min, T max) {
@@ -140,6 +141,14 @@ void CoreFoundationPrefsDriver::load(Preferences* preferences) {
         preferences->set_screen_size(screen_size);
     }
 
+    {
+        cf::Number cfnum;
+        int32_t val;
+        if (cf::get_preference(kObjectCapacityPreference, cfnum) && cf::unwrap(cfnum, val)) {
+            preferences->set_object_capacity(val);
+        }
+    }
+
     cf::String cfstr;
     String id;
     if (cf::get_preference(kScenarioPreference, cfstr) && cf::unwrap(cfstr, id)) {
@@ -164,6 +173,7 @@ void CoreFoundationPrefsDriver::save(const Preferences& preferences) {
     cf::set_preference(kScreenWidthPreference, cf::wrap(screen_size.width));
     cf::set_preference(kScreenHeightPreference, cf::wrap(screen_size.height));
     cf::set_preference(kScenarioPreference, cf::wrap(preferences.scenario_identifier()));
+    cf::set_preference(kObjectCapacityPreference, cf::wrap(preferences.object_capacity()));
     CFPreferencesAppSynchronize(kCFPreferencesCurrentApplication);
 }
 
@@ -24,6 +24,10 @@
 #include "game/globals.hpp"
 #include "video/driver.hpp"
 
+using sfz::ReadSource;
+using sfz::WriteTarget;
+using sfz::write;
+
 namespace antares {
 
 KeyMap::KeyMap(): _data{} {}
@@ -55,6 +59,14 @@ void KeyMap::clear() {
     bzero(_data, kDataSize);
 }
 
+void read_from(ReadSource in, KeyMap& keys) {
+    in.shift(keys._data, KeyMap::kDataSize);
+}
+
+void write_to(WriteTarget out, const KeyMap& keys) {
+    write(out, keys._data, KeyMap::kDataSize);
+}
+
 bool operator==(const KeyMap& a, const KeyMap& b) {
     return a.equals(b);
 }
@@ -40,6 +40,7 @@ Directories mac_dirs() {
     }
     directories.root.append("/Library/Application Support/Antares");
 
+    directories.cache.assign(format("{0}/Cache", directories.root));
     directories.downloads.assign(format("{0}/Downloads", directories.root));
     directories.registry.assign(format("{0}/Registry", directories.root));
     directories.replays.assign(format("{0}/Replays", directories.root));
@@ -119,6 +119,7 @@ Preferences::Preferences() {
     set_screen_size(Size(640, 480));
 
     _scenario_identifier.assign("com.biggerplanet.ares");
+    set_object_capacity(0);
 }
 
 Preferences::Preferences(const Preferences& other) {
@@ -147,6 +148,7 @@ void Preferences::copy(const Preferences& preferences) {
     set_fullscreen(preferences.fullscreen());
     set_screen_size(preferences.screen_size());
     set_scenario_identifier(preferences.scenario_identifier());
+    set_object_capacity(preferences.object_capacity());
 }
 
 uint32_t Preferences::key(size_t index) const {
@@ -181,6 +183,10 @@ StringSlice Preferences::scenario_identifier() const {
     return _scenario_identifier;
 }
 
+int32_t Preferences::object_capacity() const {
+    return _object_capacity;
+}
+
 void Preferences::set_key(size_t index, uint32_t key) {
     _key_map[index] = key;
 }
@@ -213,6 +219,10 @@ void Preferences::set_scenario_identifier(StringSlice id) {
     _scenario_identifier.assign(id);
 }
 
+void Preferences::set_object_capacity(int32_t capacity) {
+    _object_capacity = max(capacity, 0);
+}
+
 PrefsDriver::PrefsDriver() {
     if (antares::prefs_driver) {
         throw Exception("PrefsDriver is a singleton");
@@ -18,10 +18,10 @@
 
 #include "data/replay-list.hpp"
 
-#include <glob.h>
 #include <sfz/sfz.hpp>
 #include "config/dirs.hpp"
 #include "config/preferences.hpp"
+#include "lang/glob.hpp"
 
 using sfz::CString;
 using sfz::MappedFile;
@@ -36,16 +36,6 @@ namespace path = sfz::path;
 
 namespace antares {
 
-namespace {
-
-struct ScopedGlob {
-    glob_t data;
-    ScopedGlob() { memset(&data, sizeof(data), 0); }
-    ~ScopedGlob() { globfree(&data); }
-};
-
-}  // namespace
-
 ReplayList::ReplayList() {
     ScopedGlob g;
     const StringSlice scenario = Preferences::preferences()->scenario_identifier();
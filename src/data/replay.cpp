@@ -19,13 +19,13 @@
 #include "data/replay.hpp"
 
 #include <fcntl.h>
-#include <glob.h>
 #include <unistd.h>
 #include <sfz/sfz.hpp>
 
 #include "config/dirs.hpp"
 #include "config/keys.hpp"
 #include "config/preferences.hpp"
+#include "lang/glob.hpp"
 
 using sfz::Bytes;
 using sfz::BytesSlice;
@@ -92,6 +92,14 @@ enum {
     ACTION_AT            = (0x01 << 3) | VARINT,
     ACTION_KEY_DOWN      = (0x02 << 3) | VARINT,
     ACTION_KEY_UP        = (0x03 << 3) | VARINT,
+
+    INDEX_CHAPTER        = (0x01 << 3) | VARINT,
+    INDEX_GLOBAL_SEED    = (0x02 << 3) | VARINT,
+    INDEX_INTERVAL       = (0x03 << 3) | VARINT,
+    INDEX_KEYFRAME       = (0x04 << 3) | LENGTH_DELIMITED,
+
+    KEYFRAME_AT          = (0x01 << 3) | VARINT,
+    KEYFRAME_STATE       = (0x02 << 3) | LENGTH_DELIMITED,
 };
 
 static void write_varint(WriteTarget out, uint64_t value) {
@@ -160,10 +168,20 @@ static void tag_string(WriteTarget out, uint64_t tag, const String& s) {
     write(out, utf8::encode(s));
 }
 
-static String read_string(ReadSource in) {
+static void tag_bytes(WriteTarget out, uint64_t tag, const BytesSlice& bytes) {
+    write_varint(out, tag);
+    write_varint(out, bytes.size());
+    write(out, bytes);
+}
+
+static Bytes read_bytes(ReadSource in) {
     Bytes bytes(read_varint<size_t>(in), '\0');
     in.shift(bytes.data(), bytes.size());
-    return String(utf8::decode(bytes));
+    return bytes;
+}
+
+static String read_string(ReadSource in) {
+    return String(utf8::decode(read_bytes(in)));
 }
 
 template <typename T>
@@ -261,18 +279,78 @@ void write_to(WriteTarget out, const ReplayData::Action& action) {
     }
 }
 
-ReplayBuilder::ReplayBuilder() { }
+ReplayIndex::ReplayIndex():
+        chapter_id(-1),
+        global_seed(0),
+        interval(0) { }
 
-namespace {
+ReplayIndex::ReplayIndex(sfz::BytesSlice in):
+        ReplayIndex() {
+    read(in, *this);
+}
 
-// TODO(sfiera): put globbing in a central location.
-struct ScopedGlob {
-    glob_t data;
-    ScopedGlob() { memset(&data, sizeof(data), 0); }
-    ~ScopedGlob() { globfree(&data); }
-};
+const ReplayIndex::Keyframe* ReplayIndex::find(uint64_t at) const {
+    const Keyframe* result = NULL;
+    for (const Keyframe& keyframe: keyframes) {
+        if (keyframe.at > at) {
+            break;
+        }
+        result = &keyframe;
+    }
+    return result;
+}
 
-}  // namespace
+void read_from(ReadSource in, ReplayIndex& index) {
+    while (!in.empty()) {
+        switch (read_varint<uint64_t>(in)) {
+          case INDEX_CHAPTER:
+            index.chapter_id = read_varint<int32_t>(in);
+            break;
+          case INDEX_GLOBAL_SEED:
+            index.global_seed = read_varint<int32_t>(in);
+            break;
+          case INDEX_INTERVAL:
+            index.interval = read_varint<uint64_t>(in);
+            break;
+          case INDEX_KEYFRAME:
+            index.keyframes.push_back(read_message<ReplayIndex::Keyframe>(in));
+            break;
+        }
+    }
+}
+
+void read_from(ReadSource in, ReplayIndex::Keyframe& keyframe) {
+    while (!in.empty()) {
+        switch (read_varint<uint64_t>(in)) {
+          case KEYFRAME_AT:
+            keyframe.at = read_varint<uint64_t>(in);
+            break;
+          case KEYFRAME_STATE:
+            keyframe.state = read_bytes(in);
+            break;
+        }
+    }
+}
+
+void write_to(WriteTarget out, const ReplayIndex& index) {
+    tag_varint(out, INDEX_CHAPTER, index.chapter_id);
+    tag_varint(out, INDEX_GLOBAL_SEED, index.global_seed);
+    tag_varint(out, INDEX_INTERVAL, index.interval);
+    for (const ReplayIndex::Keyframe& keyframe: index.keyframes) {
+        tag_message(out, INDEX_KEYFRAME, keyframe);
+    }
+}
+
+void write_to(WriteTarget out, const ReplayIndex::Keyframe& keyframe) {
+    tag_varint(out, KEYFRAME_AT, keyframe.at);
+    tag_bytes(out, KEYFRAME_STATE, keyframe.state);
+}
+
+String replay_index_path(StringSlice replay_path) {
+    return String(format("{0}.index", replay_path));
+}
+
+ReplayBuilder::ReplayBuilder() { }
 
 // Deletes the oldest replay until there are fewer than `count` in the replays folder.
 static void cull_replays(size_t count) {
@@ -0,0 +1,211 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "data/resource-archive.hpp"
+
+#include <fcntl.h>
+#include <fts.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <sfz/sfz.hpp>
+
+using sfz::Bytes;
+using sfz::BytesSlice;
+using sfz::CString;
+using sfz::Exception;
+using sfz::MappedFile;
+using sfz::ScopedFd;
+using sfz::String;
+using sfz::StringSlice;
+using sfz::format;
+using sfz::quote;
+using sfz::read;
+using sfz::write;
+using std::min;
+using std::unique_ptr;
+using std::vector;
+
+namespace utf8 = sfz::utf8;
+
+namespace antares {
+
+const char kResourceArchiveName[] = "resources.nlpk";
+
+namespace {
+
+// Layout of an archive:
+//
+//   magic                  kArchiveMagic, including the trailing NUL
+//   count                  uint32 number of entries
+//   index                  for each entry, in order of name, four uint32s: the offset and size of
+//                          its name, then the offset and size of its data
+//   names, data            the names and contents of the entries, at the offsets in the index
+//
+// Integers are big-endian, and offsets are from the start of the file.
+const char kArchiveMagic[] = "antares-archive-1";
+const size_t kEntrySize = 4 * sizeof(uint32_t);
+
+struct Entry {
+    uint32_t name_offset;
+    uint32_t name_size;
+    uint32_t data_offset;
+    uint32_t data_size;
+};
+
+BytesSlice magic_bytes() {
+    return BytesSlice(reinterpret_cast<const uint8_t*>(kArchiveMagic), sizeof(kArchiveMagic));
+}
+
+Entry read_entry(BytesSlice index, uint32_t i) {
+    BytesSlice in = index.slice(i * kEntrySize, kEntrySize);
+    Entry entry;
+    entry.name_offset = read<uint32_t>(in);
+    entry.name_size = read<uint32_t>(in);
+    entry.data_offset = read<uint32_t>(in);
+    entry.data_size = read<uint32_t>(in);
+    return entry;
+}
+
+BytesSlice slice_of(BytesSlice file, uint32_t offset, uint32_t size) {
+    if ((offset > file.size()) || (size > (file.size() - offset))) {
+        throw Exception("corrupt resource archive");
+    }
+    return file.slice(offset, size);
+}
+
+// Orders names by their bytes, as std::string does when the archive is written.
+int compare_names(BytesSlice a, BytesSlice b) {
+    int result = memcmp(a.data(), b.data(), min(a.size(), b.size()));
+    if (result != 0) {
+        return result;
+    } else if (a.size() != b.size()) {
+        return (a.size() < b.size()) ? -1 : 1;
+    }
+    return 0;
+}
+
+uint32_t checked_offset(size_t offset) {
+    if (offset > UINT32_MAX) {
+        throw Exception("too much data for a resource archive");
+    }
+    return offset;
+}
+
+}  // namespace
+
+ResourceArchive::ResourceArchive(const StringSlice& path):
+        _file(path) {
+    BytesSlice in = _file.data();
+    if ((in.size() < sizeof(kArchiveMagic))
+            || (in.slice(0, sizeof(kArchiveMagic)) != magic_bytes())) {
+        throw Exception(format("{0} is not a resource archive", quote(path)));
+    }
+    in.shift(sizeof(kArchiveMagic));
+    _count = read<uint32_t>(in);
+    if ((in.size() / kEntrySize) < _count) {
+        throw Exception("corrupt resource archive");
+    }
+    _index = in.slice(0, _count * kEntrySize);
+}
+
+ResourceArchive::~ResourceArchive() { }
+
+bool ResourceArchive::find(const StringSlice& resource_path, BytesSlice& data) const {
+    const Bytes name(utf8::encode(resource_path));
+    uint32_t low = 0;
+    uint32_t high = _count;
+    while (low < high) {
+        const uint32_t mid = low + ((high - low) / 2);
+        const Entry entry = read_entry(_index, mid);
+        const int order = compare_names(
+                slice_of(_file.data(), entry.name_offset, entry.name_size), name);
+        if (order < 0) {
+            low = mid + 1;
+        } else if (order > 0) {
+            high = mid;
+        } else {
+            data = slice_of(_file.data(), entry.data_offset, entry.data_size);
+            return true;
+        }
+    }
+    return false;
+}
+
+void write_resource_archive(const StringSlice& root, const StringSlice& path) {
+    vector<std::string> names;
+    {
+        CString c_root(root);
+        char* const roots[] = {c_root.data(), NULL};
+        FTS* fts = fts_open(roots, FTS_PHYSICAL | FTS_NOCHDIR, NULL);
+        if (fts == NULL) {
+            throw Exception(format("couldn't read {0}", quote(root)));
+        }
+        // fts joins `root` and the names below it with a single slash.
+        size_t prefix = strlen(c_root.data());
+        if ((prefix > 0) && (c_root.data()[prefix - 1] == '/')) {
+            --prefix;
+        }
+        ++prefix;
+        for (FTSENT* ent = fts_read(fts); ent != NULL; ent = fts_read(fts)) {
+            if ((ent->fts_info == FTS_F) && (strcmp(ent->fts_name, kResourceArchiveName) != 0)) {
+                names.push_back(ent->fts_path + prefix);
+            }
+        }
+        fts_close(fts);
+    }
+    std::sort(names.begin(), names.end());
+
+    vector<unique_ptr<MappedFile>> files;
+    for (const std::string& name: names) {
+        String file_path(format("{0}/{1}", root, utf8::decode(BytesSlice(name.c_str()))));
+        files.emplace_back(new MappedFile(file_path));
+    }
+
+    // Lay out the names after the index, and the data after the names.
+    size_t name_offset = sizeof(kArchiveMagic) + sizeof(uint32_t) + (names.size() * kEntrySize);
+    size_t data_offset = name_offset;
+    for (const std::string& name: names) {
+        data_offset += name.size();
+    }
+    Bytes header;
+    header.push(magic_bytes());
+    write<uint32_t>(header, checked_offset(names.size()));
+    for (size_t i = 0; i < names.size(); ++i) {
+        write<uint32_t>(header, checked_offset(name_offset));
+        write<uint32_t>(header, names[i].size());
+        write<uint32_t>(header, checked_offset(data_offset));
+        write<uint32_t>(header, checked_offset(files[i]->data().size()));
+        name_offset += names[i].size();
+        data_offset += files[i]->data().size();
+    }
+    checked_offset(data_offset);
+    for (const std::string& name: names) {
+        header.push(BytesSlice(reinterpret_cast<const uint8_t*>(name.data()), name.size()));
+    }
+
+    ScopedFd fd(open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644));
+    write(fd, header);
+    for (const unique_ptr<MappedFile>& file: files) {
+        write(fd, file->data());
+    }
+}
+
+}  // namespace antares
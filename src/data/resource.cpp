@@ -19,17 +19,22 @@
 #include "data/resource.hpp"
 
 #include <stdio.h>
+#include <mutex>
 #include <sfz/sfz.hpp>
 #include "config/dirs.hpp"
 #include "config/preferences.hpp"
+#include "data/resource-archive.hpp"
 
 using sfz::BytesSlice;
 using sfz::Exception;
 using sfz::MappedFile;
 using sfz::PrintItem;
 using sfz::String;
+using sfz::StringMap;
 using sfz::StringSlice;
 using sfz::format;
+using std::lock_guard;
+using std::mutex;
 using std::unique_ptr;
 
 namespace path = sfz::path;
@@ -41,35 +46,84 @@ static const char kFactoryScenarioIdentifier[] = "com.biggerplanet.ares";
 
 const sfz::String application_path();
 
-static unique_ptr<MappedFile> load_first(sfz::StringSlice resource_path,
-                                         const std::initializer_list<PrintItem>& dirs) {
+// Archives are opened the first time a resource is looked up in their directory, and stay open,
+// since resources loaded from them point into their mappings.  Directories without an archive
+// map to NULL.
+static mutex archives_mutex;
+static StringMap<unique_ptr<ResourceArchive>> archives;
+
+static const ResourceArchive* archive_in(const StringSlice& dir) {
+    lock_guard<mutex> lock(archives_mutex);
+    auto it = archives.find(dir);
+    if (it != archives.end()) {
+        return it->second.get();
+    }
+    unique_ptr<ResourceArchive>& archive = archives[dir];
+    String path(format("{0}/{1}", dir, kResourceArchiveName));
+    if (path::isfile(path)) {
+        archive.reset(new ResourceArchive(path));
+    }
+    return archive.get();
+}
+
+// Looks for `resource_path` in each of `dirs` in turn.  A directory with an archive is
+// represented by it entirely: the loose files beside it aren't consulted.  Sets `source` to the
+// file holding the resource.  If that's an archive, it is returned, and `data` is set to the
+// resource's contents; otherwise, NULL is returned, and the loose file is left for the caller to
+// map.
+static const ResourceArchive* find_first(
+        sfz::StringSlice resource_path, const std::initializer_list<PrintItem>& dirs,
+        String& source, BytesSlice& data) {
     for (const auto& dir: dirs) {
-        String path(sfz::format("{0}/{1}", dir, resource_path));
+        String dir_path(dir);
+        const ResourceArchive* archive = archive_in(dir_path);
+        if (archive != NULL) {
+            if (archive->find(resource_path, data)) {
+                source.assign(format("{0}/{1}", dir_path, kResourceArchiveName));
+                return archive;
+            }
+            continue;
+        }
+        String path(sfz::format("{0}/{1}", dir_path, resource_path));
         if (path::isfile(path)) {
-            return unique_ptr<MappedFile>(new MappedFile(path));
+            source.assign(path);
+            return NULL;
         }
     }
     throw Exception(format("couldn't find resource {0}", quote(resource_path)));
 }
 
-static unique_ptr<MappedFile> load(sfz::StringSlice resource_path) {
-    return load_first(resource_path, {
+static const ResourceArchive* find_resource(
+        const PrintItem& resource_path, String& source, BytesSlice& data) {
+    return find_first(String(resource_path), {
         format("{0}/{1}", dirs().scenarios, Preferences::preferences()->scenario_identifier()),
         format("{0}/{1}", dirs().scenarios, kFactoryScenarioIdentifier),
         application_path(),
-    });
+    }, source, data);
 }
 
 Resource::Resource(const StringSlice& type, const StringSlice& extension, int id):
         Resource(format("{0}/{1}.{2}", type, id, extension)) { }
 
-Resource::Resource(const sfz::PrintItem& resource_path):
-        _file(load(String(resource_path))) { }
+Resource::Resource(const sfz::PrintItem& resource_path) {
+    String source;
+    if (find_resource(resource_path, source, _data) == NULL) {
+        _file.reset(new MappedFile(source));
+        _data = _file->data();
+    }
+}
 
 Resource::~Resource() { }
 
 BytesSlice Resource::data() const {
-    return _file->data();
+    return _data;
+}
+
+String resource_source(const PrintItem& resource_path) {
+    String source;
+    BytesSlice data;
+    find_resource(resource_path, source, data);
+    return source;
 }
 
 }  // namespace antares
@@ -18,10 +18,10 @@
 
 #include "data/scenario-list.hpp"
 
-#include <glob.h>
 #include <sfz/sfz.hpp>
 #include "config/dirs.hpp"
 #include "data/scenario.hpp"
+#include "lang/glob.hpp"
 
 using sfz::BytesSlice;
 using sfz::CString;
@@ -36,16 +36,6 @@ namespace utf8 = sfz::utf8;
 
 namespace antares {
 
-namespace {
-
-struct ScopedGlob {
-    glob_t data;
-    ScopedGlob() { memset(&data, sizeof(data), 0); }
-    ~ScopedGlob() { globfree(&data); }
-};
-
-}  // namespace
-
 Version u32_to_version(uint32_t in) {
     using std::swap;
     vector<int> components;
@@ -177,8 +177,7 @@ void read_from(ReadSource in, Scenario::BriefPoint::AbsoluteBrief& absolute_brie
 void read_from(ReadSource in, Scenario::InitialObject& scenario_initial) {
     read(in, scenario_initial.type);
     read(in, scenario_initial.owner);
-    read(in, scenario_initial.realObjectNumber);
-    read(in, scenario_initial.realObjectID);
+    in.shift(8);  // realObjectNumber and realObjectID; see aresGlobalType.
     read(in, scenario_initial.location);
     read(in, scenario_initial.earning);
     read(in, scenario_initial.distanceRange);
@@ -211,7 +211,7 @@ void GetInitialObjectSpriteData(
     if (sObject != NULL) {
         const NatePixTable::Frame* frame = NULL;
         GetRealObjectSpriteData(
-                &(sObject->location), sObject->baseType, sObject->owner, sObject->pixResID,
+                &(sObject->motion->location), sObject->baseType, sObject->owner, sObject->pixResID,
                 maxSize, bounds, corner, scale, thisScale, &frame, where, spriteRect);
 
         if ( sBounds == NULL) return;
@@ -341,12 +341,12 @@ static void render_briefing_with(
         delete[] gBriefingSpriteBounds;
     }
 
-    gBriefingSpriteBounds = new briefingSpriteBoundsType[kMaxSpaceObject];
+    gBriefingSpriteBounds = new briefingSpriteBoundsType[globals()->maxSpaceObject + 1];
 
     if ( gBriefingSpriteBounds == NULL) return;
     sBounds = gBriefingSpriteBounds;
 
-    for ( count = 0; count < kMaxSpaceObject; count++)
+    for ( count = NextSpaceObjectSlot(-1); count >= 0; count = NextSpaceObjectSlot(count))
     {
         spaceObjectType *anObject = mGetSpaceObjectPtr(count);
         if (( anObject->active == kObjectInUse) && ( anObject->sprite != NULL))
@@ -354,7 +354,7 @@ static void render_briefing_with(
             baseObject = anObject->baseType;
             if (baseObject->maxVelocity == 0) {
                 const NatePixTable::Frame* frame = NULL;
-                GetRealObjectSpriteData( &(anObject->location),
+                GetRealObjectSpriteData( &(anObject->motion->location),
                     anObject->baseType, anObject->owner,
                     anObject->pixResID, maxSize, bounds, corner, scale,
                     &thisScale, &frame, &where, &spriteRect);
@@ -389,7 +389,7 @@ static void render_briefing_with(
             } else {
                 const NatePixTable::Frame* frame = NULL;
                 GetRealObjectSpriteData(
-                        &(anObject->location), anObject->baseType, anObject->owner,
+                        &(anObject->motion->location), anObject->baseType, anObject->owner,
                         anObject->pixResID, maxSize / 2, bounds, corner, scale, &thisScale,
                         &frame, &where, &spriteRect);
                 if (frame != NULL) {
@@ -490,7 +490,7 @@ void BriefPoint_Data_Get(
     Point           where;
     Rect        spriteRect;
     int32_t            thisScale;
-    Scenario::BriefPoint* brief = scenario->brief_point(whichPoint);
+    const Scenario::BriefPoint* brief = scenario->brief_point(whichPoint);
 
 #pragma unused( minSectorSize)
     hiliteBounds->right = hiliteBounds->left = 0;
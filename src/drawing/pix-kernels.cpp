@@ -0,0 +1,436 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "drawing/pix-kernels.hpp"
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#define ANTARES_PIX_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define ANTARES_PIX_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define ANTARES_PIX_NEON 1
+#include <arm_neon.h>
+#endif
+
+// The vector kernels for composite() do the same double-precision arithmetic as the scalar one,
+// operation by operation, so none of it may be fused into multiply-adds.  (GCC doesn't contract
+// across statements in ISO mode, and doesn't know the pragma.)
+#ifdef __clang__
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+using std::vector;
+
+namespace antares {
+
+namespace {
+
+// The alpha of a pixel, as a 32-bit word.  RgbColor is stored alpha first, so on the
+// little-endian machines that have vector kernels, alpha is the low byte.
+const uint32_t kAlphaMask = 0x000000ff;
+
+inline uint32_t pixel_bits(const RgbColor& color) {
+    uint32_t bits;
+    memcpy(&bits, &color, sizeof(bits));
+    return bits;
+}
+
+inline void set_pixel_bits(RgbColor* dst, uint32_t bits) {
+    memcpy(static_cast<void*>(dst), &bits, sizeof(bits));
+}
+
+// Scalar kernels.  These are the reference for all others.
+
+void scalar_fill(RgbColor* dst, size_t count, const RgbColor& color) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = color;
+    }
+}
+
+// TODO(sfiera): if we're going to do anything like this in the long run, we should require that
+// alpha be pre-multiplied with the color components.  We should probably also use integral
+// arithmetic.
+inline void scalar_composite_pixel(RgbColor* under_ptr, const RgbColor& over) {
+    const double oa = over.alpha / 255.0;
+    const RgbColor& under = *under_ptr;
+    const double ua = under.alpha / 255.0;
+
+    double red   = (over.red   * oa) + ((under.red   * ua) * (1.0 - oa));
+    double green = (over.green * oa) + ((under.green * ua) * (1.0 - oa));
+    double blue  = (over.blue  * oa) + ((under.blue  * ua) * (1.0 - oa));
+    double alpha = oa + (ua * (1.0 - oa));
+    if (alpha == 0) {
+        *under_ptr = RgbColor(0, 0, 0, 0);
+        return;
+    }
+    *under_ptr = RgbColor(alpha * 255, red / alpha, green / alpha, blue / alpha);
+}
+
+void scalar_composite(RgbColor* dst, const RgbColor* src, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        scalar_composite_pixel(dst + i, src[i]);
+    }
+}
+
+void scalar_convert_bgra(RgbColor* dst, const uint8_t* src, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = RgbColor(src[2], src[1], src[0]);
+        src += 4;
+    }
+}
+
+const PixKernels kScalarKernels = {
+    "scalar",
+    scalar_fill,
+    scalar_composite,
+    scalar_convert_bgra,
+};
+
+// The vector kernels check alphas a vector at a time.  Where every pixel drawn is opaque, the
+// result is the source; where every pixel drawn is clear and every pixel under it is opaque, the
+// result is the destination.  The arithmetic of scalar_composite_pixel() gives exactly those
+// results in both cases.  Otherwise, each pixel's channels go through the arithmetic together,
+// as lanes (alpha, red, green, blue), with 1.0 standing in for the color of the alpha lane, so
+// that `1.0 * oa + (1.0 * ua) * (1.0 - oa)` gives the composite alpha.
+
+#ifdef ANTARES_PIX_SSE2
+
+void sse2_fill(RgbColor* dst, size_t count, const RgbColor& color) {
+    const __m128i v = _mm_set1_epi32(pixel_bits(color));
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+    }
+    scalar_fill(dst + i, count - i, color);
+}
+
+inline __m128i sse2_widen(const RgbColor& color) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bytes = _mm_cvtsi32_si128(pixel_bits(color));
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero);
+}
+
+inline void sse2_composite_pixel(RgbColor* under_ptr, const RgbColor& over) {
+    const double oa = over.alpha / 255.0;
+    const double ua = under_ptr->alpha / 255.0;
+    const __m128d voa = _mm_set1_pd(oa);
+    const __m128d vua = _mm_set1_pd(ua);
+    const __m128d vinv = _mm_set1_pd(1.0 - oa);
+    const __m128d one = _mm_set_sd(1.0);
+
+    const __m128i over_wide = sse2_widen(over);
+    const __m128i under_wide = sse2_widen(*under_ptr);
+    const __m128d over_lo = _mm_move_sd(_mm_cvtepi32_pd(over_wide), one);
+    const __m128d over_hi = _mm_cvtepi32_pd(_mm_srli_si128(over_wide, 8));
+    const __m128d under_lo = _mm_move_sd(_mm_cvtepi32_pd(under_wide), one);
+    const __m128d under_hi = _mm_cvtepi32_pd(_mm_srli_si128(under_wide, 8));
+
+    const __m128d lo = _mm_add_pd(
+            _mm_mul_pd(over_lo, voa), _mm_mul_pd(_mm_mul_pd(under_lo, vua), vinv));
+    const __m128d hi = _mm_add_pd(
+            _mm_mul_pd(over_hi, voa), _mm_mul_pd(_mm_mul_pd(under_hi, vua), vinv));
+    const double alpha = _mm_cvtsd_f64(lo);
+    if (alpha == 0) {
+        *under_ptr = RgbColor(0, 0, 0, 0);
+        return;
+    }
+
+    const __m128d valpha = _mm_set1_pd(alpha);
+    const __m128d out_lo = _mm_move_sd(_mm_div_pd(lo, valpha), _mm_set_sd(alpha * 255));
+    const __m128d out_hi = _mm_div_pd(hi, valpha);
+    __m128i out = _mm_unpacklo_epi64(_mm_cvttpd_epi32(out_lo), _mm_cvttpd_epi32(out_hi));
+    out = _mm_packs_epi32(out, out);
+    out = _mm_packus_epi16(out, out);
+    set_pixel_bits(under_ptr, _mm_cvtsi128_si32(out));
+}
+
+void sse2_composite(RgbColor* dst, const RgbColor* src, size_t count) {
+    const __m128i alpha_mask = _mm_set1_epi32(kAlphaMask);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4) {
+        const __m128i over = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i over_alpha = _mm_and_si128(over, alpha_mask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(over_alpha, alpha_mask)) == 0xffff) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), over);
+            continue;
+        }
+        const __m128i under = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i under_alpha = _mm_and_si128(under, alpha_mask);
+        if ((_mm_movemask_epi8(_mm_cmpeq_epi32(over_alpha, zero)) == 0xffff)
+                && (_mm_movemask_epi8(_mm_cmpeq_epi32(under_alpha, alpha_mask)) == 0xffff)) {
+            continue;
+        }
+        for (size_t j = i; j < i + 4; ++j) {
+            sse2_composite_pixel(dst + j, src[j]);
+        }
+    }
+    for ( ; i < count; ++i) {
+        sse2_composite_pixel(dst + i, src[i]);
+    }
+}
+
+// Reverses the bytes of each BGRA word, giving ARGB in memory, and makes alpha opaque.
+void sse2_convert_bgra(RgbColor* dst, const uint8_t* src, size_t count) {
+    const __m128i alpha = _mm_set1_epi32(kAlphaMask);
+    const __m128i green = _mm_set1_epi32(0x00ff0000);
+    const __m128i red = _mm_set1_epi32(0x0000ff00);
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (4 * i)));
+        __m128i out = _mm_or_si128(alpha, _mm_slli_epi32(in, 24));
+        out = _mm_or_si128(out, _mm_and_si128(_mm_slli_epi32(in, 8), green));
+        out = _mm_or_si128(out, _mm_and_si128(_mm_srli_epi32(in, 8), red));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), out);
+    }
+    scalar_convert_bgra(dst + i, src + (4 * i), count - i);
+}
+
+const PixKernels kSse2Kernels = {
+    "sse2",
+    sse2_fill,
+    sse2_composite,
+    sse2_convert_bgra,
+};
+
+#endif  // ANTARES_PIX_SSE2
+
+#ifdef ANTARES_PIX_AVX2
+
+#define ANTARES_AVX2 __attribute__((target("avx2")))
+
+ANTARES_AVX2 void avx2_fill(RgbColor* dst, size_t count, const RgbColor& color) {
+    const __m256i v = _mm256_set1_epi32(pixel_bits(color));
+    size_t i = 0;
+    for ( ; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+    }
+    scalar_fill(dst + i, count - i, color);
+}
+
+ANTARES_AVX2 inline void avx2_composite_pixel(RgbColor* under_ptr, const RgbColor& over) {
+    const double oa = over.alpha / 255.0;
+    const double ua = under_ptr->alpha / 255.0;
+    const __m256d voa = _mm256_set1_pd(oa);
+    const __m256d vua = _mm256_set1_pd(ua);
+    const __m256d vinv = _mm256_set1_pd(1.0 - oa);
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    const __m256d over_color = _mm256_blend_pd(_mm256_cvtepi32_pd(
+                _mm_cvtepu8_epi32(_mm_cvtsi32_si128(pixel_bits(over)))), one, 0x1);
+    const __m256d under_color = _mm256_blend_pd(_mm256_cvtepi32_pd(
+                _mm_cvtepu8_epi32(_mm_cvtsi32_si128(pixel_bits(*under_ptr)))), one, 0x1);
+
+    const __m256d color = _mm256_add_pd(
+            _mm256_mul_pd(over_color, voa), _mm256_mul_pd(_mm256_mul_pd(under_color, vua), vinv));
+    const double alpha = _mm_cvtsd_f64(_mm256_castpd256_pd128(color));
+    if (alpha == 0) {
+        *under_ptr = RgbColor(0, 0, 0, 0);
+        return;
+    }
+
+    const __m256d out_color = _mm256_blend_pd(
+            _mm256_div_pd(color, _mm256_set1_pd(alpha)), _mm256_set1_pd(alpha * 255), 0x1);
+    __m128i out = _mm256_cvttpd_epi32(out_color);
+    out = _mm_packs_epi32(out, out);
+    out = _mm_packus_epi16(out, out);
+    set_pixel_bits(under_ptr, _mm_cvtsi128_si32(out));
+}
+
+ANTARES_AVX2 void avx2_composite(RgbColor* dst, const RgbColor* src, size_t count) {
+    const __m256i alpha_mask = _mm256_set1_epi32(kAlphaMask);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for ( ; i + 8 <= count; i += 8) {
+        const __m256i over = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i over_alpha = _mm256_and_si256(over, alpha_mask);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(over_alpha, alpha_mask)) == -1) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), over);
+            continue;
+        }
+        const __m256i under = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i under_alpha = _mm256_and_si256(under, alpha_mask);
+        if ((_mm256_movemask_epi8(_mm256_cmpeq_epi32(over_alpha, zero)) == -1)
+                && (_mm256_movemask_epi8(_mm256_cmpeq_epi32(under_alpha, alpha_mask)) == -1)) {
+            continue;
+        }
+        for (size_t j = i; j < i + 8; ++j) {
+            avx2_composite_pixel(dst + j, src[j]);
+        }
+    }
+    for ( ; i < count; ++i) {
+        avx2_composite_pixel(dst + i, src[i]);
+    }
+}
+
+ANTARES_AVX2 void avx2_convert_bgra(RgbColor* dst, const uint8_t* src, size_t count) {
+    const __m256i alpha = _mm256_set1_epi32(kAlphaMask);
+    const __m256i order = _mm256_setr_epi8(
+            -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12,
+            -1, 2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12);
+    size_t i = 0;
+    for ( ; i + 8 <= count; i += 8) {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + (4 * i)));
+        const __m256i out = _mm256_or_si256(_mm256_shuffle_epi8(in, order), alpha);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), out);
+    }
+    scalar_convert_bgra(dst + i, src + (4 * i), count - i);
+}
+
+#undef ANTARES_AVX2
+
+const PixKernels kAvx2Kernels = {
+    "avx2",
+    avx2_fill,
+    avx2_composite,
+    avx2_convert_bgra,
+};
+
+#endif  // ANTARES_PIX_AVX2
+
+#ifdef ANTARES_PIX_NEON
+
+void neon_fill(RgbColor* dst, size_t count, const RgbColor& color) {
+    const uint32x4_t v = vdupq_n_u32(pixel_bits(color));
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4) {
+        vst1q_u8(reinterpret_cast<uint8_t*>(dst + i), vreinterpretq_u8_u32(v));
+    }
+    scalar_fill(dst + i, count - i, color);
+}
+
+inline float64x2_t neon_lanes(uint32x4_t wide, int half) {
+    const uint64x2_t pair = half ? vmovl_u32(vget_high_u32(wide)) : vmovl_u32(vget_low_u32(wide));
+    return vcvtq_f64_u64(pair);
+}
+
+inline uint32x4_t neon_widen(const RgbColor& color) {
+    const uint8x8_t bytes = vcreate_u8(pixel_bits(color));
+    return vmovl_u16(vget_low_u16(vmovl_u8(bytes)));
+}
+
+inline void neon_composite_pixel(RgbColor* under_ptr, const RgbColor& over) {
+    const double oa = over.alpha / 255.0;
+    const double ua = under_ptr->alpha / 255.0;
+    const float64x2_t voa = vdupq_n_f64(oa);
+    const float64x2_t vua = vdupq_n_f64(ua);
+    const float64x2_t vinv = vdupq_n_f64(1.0 - oa);
+
+    const uint32x4_t over_wide = neon_widen(over);
+    const uint32x4_t under_wide = neon_widen(*under_ptr);
+    const float64x2_t over_lo = vsetq_lane_f64(1.0, neon_lanes(over_wide, 0), 0);
+    const float64x2_t over_hi = neon_lanes(over_wide, 1);
+    const float64x2_t under_lo = vsetq_lane_f64(1.0, neon_lanes(under_wide, 0), 0);
+    const float64x2_t under_hi = neon_lanes(under_wide, 1);
+
+    const float64x2_t lo = vaddq_f64(
+            vmulq_f64(over_lo, voa), vmulq_f64(vmulq_f64(under_lo, vua), vinv));
+    const float64x2_t hi = vaddq_f64(
+            vmulq_f64(over_hi, voa), vmulq_f64(vmulq_f64(under_hi, vua), vinv));
+    const double alpha = vgetq_lane_f64(lo, 0);
+    if (alpha == 0) {
+        *under_ptr = RgbColor(0, 0, 0, 0);
+        return;
+    }
+
+    const float64x2_t valpha = vdupq_n_f64(alpha);
+    const float64x2_t out_lo = vsetq_lane_f64(alpha * 255, vdivq_f64(lo, valpha), 0);
+    const float64x2_t out_hi = vdivq_f64(hi, valpha);
+    const uint32x4_t out = vcombine_u32(
+            vmovn_u64(vcvtq_u64_f64(out_lo)), vmovn_u64(vcvtq_u64_f64(out_hi)));
+    const uint8x8_t bytes = vmovn_u16(vcombine_u16(vmovn_u32(out), vmovn_u32(out)));
+    set_pixel_bits(under_ptr, vget_lane_u32(vreinterpret_u32_u8(bytes), 0));
+}
+
+void neon_composite(RgbColor* dst, const RgbColor* src, size_t count) {
+    const uint32x4_t alpha_mask = vdupq_n_u32(kAlphaMask);
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4) {
+        const uint8x16_t over = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+        const uint32x4_t over_alpha = vandq_u32(vreinterpretq_u32_u8(over), alpha_mask);
+        if (vminvq_u32(over_alpha) == kAlphaMask) {
+            vst1q_u8(reinterpret_cast<uint8_t*>(dst + i), over);
+            continue;
+        }
+        const uint8x16_t under = vld1q_u8(reinterpret_cast<const uint8_t*>(dst + i));
+        const uint32x4_t under_alpha = vandq_u32(vreinterpretq_u32_u8(under), alpha_mask);
+        if ((vmaxvq_u32(over_alpha) == 0) && (vminvq_u32(under_alpha) == kAlphaMask)) {
+            continue;
+        }
+        for (size_t j = i; j < i + 4; ++j) {
+            neon_composite_pixel(dst + j, src[j]);
+        }
+    }
+    for ( ; i < count; ++i) {
+        neon_composite_pixel(dst + i, src[i]);
+    }
+}
+
+void neon_convert_bgra(RgbColor* dst, const uint8_t* src, size_t count) {
+    const uint32x4_t alpha = vdupq_n_u32(kAlphaMask);
+    size_t i = 0;
+    for ( ; i + 4 <= count; i += 4) {
+        const uint8x16_t in = vrev32q_u8(vld1q_u8(src + (4 * i)));
+        const uint32x4_t out = vorrq_u32(vreinterpretq_u32_u8(in), alpha);
+        vst1q_u8(reinterpret_cast<uint8_t*>(dst + i), vreinterpretq_u8_u32(out));
+    }
+    scalar_convert_bgra(dst + i, src + (4 * i), count - i);
+}
+
+const PixKernels kNeonKernels = {
+    "neon",
+    neon_fill,
+    neon_composite,
+    neon_convert_bgra,
+};
+
+#endif  // ANTARES_PIX_NEON
+
+}  // namespace
+
+vector<const PixKernels*> available_pix_kernels() {
+    vector<const PixKernels*> result;
+    result.push_back(&kScalarKernels);
+#ifdef ANTARES_PIX_SSE2
+    result.push_back(&kSse2Kernels);
+#endif
+#ifdef ANTARES_PIX_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        result.push_back(&kAvx2Kernels);
+    }
+#endif
+#ifdef ANTARES_PIX_NEON
+    result.push_back(&kNeonKernels);
+#endif
+    return result;
+}
+
+const PixKernels& pix_kernels() {
+    static const PixKernels* const kernels = available_pix_kernels().back();
+    return *kernels;
+}
+
+}  // namespace antares
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <sfz/sfz.hpp>
 
+#include "drawing/pix-kernels.hpp"
 #include "lang/casts.hpp"
 
 using sfz::Exception;
@@ -49,13 +50,9 @@ void PixMap::set(int x, int y, const RgbColor& color) {
 }
 
 void PixMap::fill(const RgbColor& color) {
-    if (size().height > 0) {
-        for (int x = 0; x < size().width; ++x) {
-            set(x, 0, color);
-        }
-        for (int y = 1; y < size().height; ++y) {
-            memcpy(mutable_row(y), row(y - 1), size().width * sizeof(RgbColor));
-        }
+    const PixKernels& kernels = pix_kernels();
+    for (int y = 0; y < size().height; ++y) {
+        kernels.fill(mutable_row(y), size().width, color);
     }
 }
 
@@ -72,22 +69,9 @@ void PixMap::composite(const PixMap& pix) {
     if (size() != pix.size()) {
         throw Exception("Mismatch in PixMap sizes");
     }
+    const PixKernels& kernels = pix_kernels();
     for (int y = 0; y < size().height; ++y) {
-        for (int x = 0; x < size().width; ++x) {
-            const RgbColor& over = pix.get(x, y);
-            const double oa = over.alpha / 255.0;
-            const RgbColor& under = get(x, y);
-            const double ua = under.alpha / 255.0;
-
-            // TODO(sfiera): if we're going to do anything like this in the long run, we should
-            // require that alpha be pre-multiplied with the color components.  We should probably
-            // also use integral arithmetic.
-            double red   = (over.red   * oa) + ((under.red   * ua) * (1.0 - oa));
-            double green = (over.green * oa) + ((under.green * ua) * (1.0 - oa));
-            double blue  = (over.blue  * oa) + ((under.blue  * ua) * (1.0 - oa));
-            double alpha = oa + (ua * (1.0 - oa));
-            set(x, y, RgbColor(alpha * 255, red / alpha, green / alpha, blue / alpha));
-        }
+        kernels.composite(mutable_row(y), pix.row(y), size().width);
     }
 }
 
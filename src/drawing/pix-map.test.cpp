@@ -0,0 +1,174 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "drawing/pix-map.hpp"
+
+#include <gmock/gmock.h>
+#include <vector>
+#include <sfz/sfz.hpp>
+
+#include "drawing/pix-kernels.hpp"
+#include "math/random.hpp"
+
+using std::vector;
+
+namespace antares {
+namespace {
+
+typedef testing::Test PixMapTest;
+
+// Enough pixels that every vector kernel runs both its vector loop and its scalar tail, and starts
+// off an aligned boundary.
+const size_t kCount = 1027;
+
+uint8_t random_byte(Random& r) {
+    return r.next(256);
+}
+
+// Mostly random pixels, with runs of clear and opaque ones so that the vector kernels take their
+// shortcuts too.
+vector<RgbColor> random_pixels(Random& r, size_t count) {
+    vector<RgbColor> result;
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t alpha = random_byte(r);
+        switch ((i / 16) % 4) {
+          case 0: alpha = 0x00; break;
+          case 1: alpha = 0xff; break;
+        }
+        result.push_back(RgbColor(alpha, random_byte(r), random_byte(r), random_byte(r)));
+    }
+    return result;
+}
+
+const PixKernels& scalar() {
+    return *available_pix_kernels().front();
+}
+
+TEST_F(PixMapTest, FillKernels) {
+    const RgbColor color(0x12, 0x34, 0x56, 0x78);
+    for (const PixKernels* kernels: available_pix_kernels()) {
+        SCOPED_TRACE(kernels->name);
+        for (size_t start: {0, 1, 3}) {
+            vector<RgbColor> pixels(kCount + 1, RgbColor::kWhite);
+            kernels->fill(pixels.data() + start, kCount - start, color);
+            for (size_t i = 0; i < pixels.size(); ++i) {
+                if ((start <= i) && (i < kCount)) {
+                    EXPECT_EQ(color, pixels[i]) << i;
+                } else {
+                    EXPECT_EQ(RgbColor::kWhite, pixels[i]) << i;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(PixMapTest, CompositeKernels) {
+    Random r = {0};
+    const vector<RgbColor> over = random_pixels(r, kCount);
+    const vector<RgbColor> under = random_pixels(r, kCount);
+    vector<RgbColor> expected = under;
+    scalar().composite(expected.data(), over.data(), kCount);
+
+    for (const PixKernels* kernels: available_pix_kernels()) {
+        SCOPED_TRACE(kernels->name);
+        for (size_t start: {0, 1, 3}) {
+            vector<RgbColor> actual = under;
+            kernels->composite(actual.data() + start, over.data() + start, kCount - start);
+            for (size_t i = start; i < kCount; ++i) {
+                EXPECT_EQ(expected[i], actual[i]) << i;
+            }
+        }
+    }
+}
+
+// Every pair of alphas, with a few colors each.
+TEST_F(PixMapTest, CompositeAlphas) {
+    Random r = {0};
+    vector<RgbColor> over;
+    vector<RgbColor> under;
+    for (int over_alpha = 0; over_alpha < 256; ++over_alpha) {
+        for (int under_alpha = 0; under_alpha < 256; ++under_alpha) {
+            over.push_back(RgbColor(over_alpha, random_byte(r), random_byte(r), random_byte(r)));
+            under.push_back(RgbColor(under_alpha, random_byte(r), random_byte(r), random_byte(r)));
+        }
+    }
+    vector<RgbColor> expected = under;
+    scalar().composite(expected.data(), over.data(), over.size());
+
+    for (const PixKernels* kernels: available_pix_kernels()) {
+        SCOPED_TRACE(kernels->name);
+        vector<RgbColor> actual = under;
+        kernels->composite(actual.data(), over.data(), over.size());
+        for (size_t i = 0; i < actual.size(); ++i) {
+            EXPECT_EQ(expected[i], actual[i]) << i;
+        }
+    }
+}
+
+TEST_F(PixMapTest, ConvertBgraKernels) {
+    Random r = {0};
+    vector<uint8_t> bgra;
+    for (size_t i = 0; i < 4 * kCount; ++i) {
+        bgra.push_back(random_byte(r));
+    }
+    vector<RgbColor> expected(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+        expected[i] = RgbColor(bgra[(4 * i) + 2], bgra[(4 * i) + 1], bgra[4 * i]);
+    }
+
+    for (const PixKernels* kernels: available_pix_kernels()) {
+        SCOPED_TRACE(kernels->name);
+        for (size_t start: {0, 1, 3}) {
+            vector<RgbColor> actual(kCount);
+            kernels->convert_bgra(
+                    actual.data() + start, bgra.data() + (4 * start), kCount - start);
+            for (size_t i = start; i < kCount; ++i) {
+                EXPECT_EQ(expected[i], actual[i]) << i;
+            }
+        }
+    }
+}
+
+// Views have rows that are not contiguous, so the kernels must only touch the pixels inside.
+TEST_F(PixMapTest, ViewFillAndComposite) {
+    ArrayPixMap pix(9, 7);
+    pix.fill(RgbColor::kBlack);
+    const Rect bounds(2, 1, 8, 5);
+    pix.view(bounds).fill(RgbColor::kWhite);
+
+    ArrayPixMap over(bounds.width(), bounds.height());
+    over.fill(RgbColor::kClear);
+    over.set(1, 1, RgbColor(0xff, 0x00, 0x80, 0xff));
+    pix.view(bounds).composite(over);
+
+    for (int y = 0; y < pix.size().height; ++y) {
+        for (int x = 0; x < pix.size().width; ++x) {
+            const Point p(x, y);
+            if (p == Point(bounds.left + 1, bounds.top + 1)) {
+                EXPECT_EQ(RgbColor(0xff, 0x00, 0x80, 0xff), pix.get(x, y));
+            } else if (bounds.contains(p)) {
+                EXPECT_EQ(RgbColor::kWhite, pix.get(x, y)) << x << ", " << y;
+            } else {
+                EXPECT_EQ(RgbColor::kBlack, pix.get(x, y)) << x << ", " << y;
+            }
+        }
+    }
+}
+
+}  // namespace
+}  // namespace antares
@@ -18,27 +18,41 @@
 
 #include "drawing/pix-table.hpp"
 
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <sfz/sfz.hpp>
 
+#include "config/preferences.hpp"
 #include "data/resource.hpp"
 #include "drawing/color.hpp"
 #include "video/driver.hpp"
 
+using sfz::Bytes;
 using sfz::BytesSlice;
+using sfz::CString;
 using sfz::Exception;
 using sfz::Json;
 using sfz::JsonDefaultVisitor;
+using sfz::MappedFile;
+using sfz::PrintItem;
 using sfz::ReadSource;
+using sfz::ScopedFd;
+using sfz::Sha1;
 using sfz::String;
 using sfz::StringMap;
 using sfz::StringSlice;
 using sfz::format;
+using sfz::makedirs;
 using sfz::range;
 using sfz::read;
 using sfz::string_to_json;
+using sfz::write;
 using std::unique_ptr;
 using std::vector;
 
+namespace path = sfz::path;
 namespace utf8 = sfz::utf8;
 
 namespace antares {
@@ -60,6 +74,7 @@ struct PixTableVisitor : public JsonDefaultVisitor {
         Rect frame;
         StateEnum state;
         ArrayPixMap image, overlay;
+        String image_path, overlay_path;
         State(): state(NEW), image(0, 0), overlay(0, 0) { }
     };
     State& state;
@@ -188,8 +203,10 @@ struct PixTableVisitor : public JsonDefaultVisitor {
     virtual void visit_string(const StringSlice& value) const {
         switch (state.state) {
           case IMAGE:
+            state.image_path.assign(value);
             return load_image(state.image, value);
           case OVERLAY:
+            state.overlay_path.assign(value);
             return load_image(state.overlay, value);
           default:
             return visit_default("string");
@@ -216,9 +233,89 @@ struct PixTableVisitor : public JsonDefaultVisitor {
     }
 };
 
+// Cached tables start with this magic number, which changes whenever the format does.
+const char kCacheMagic[] = "antares-sprites-2";
+
+String cache_dir;
+
+// The cached pixels are copied straight out of memory.  They are in the machine's own layout,
+// since the cache is never shared between machines.
+static_assert(sizeof(RgbColor) == 4, "RgbColor must be packed for the sprite cache");
+
+// A digest of everything a table is decoded from.  If any of it changes, the cached copy of the
+// table is stale.
+Sha1::Digest content_digest(int id, const StringSlice& image, const StringSlice& overlay) {
+    Sha1 sha;
+    write(sha, Resource("sprites", "json", id).data());
+    write(sha, Resource(image).data());
+    if (!overlay.empty()) {
+        write(sha, Resource(overlay).data());
+    }
+    return sha.digest();
+}
+
+void stamp_source(String& stamp, const PrintItem& resource_path) {
+    const String source(resource_source(resource_path));
+    struct stat st;
+    if (stat(CString(source).data(), &st) < 0) {
+        throw Exception(format("{0}: couldn't stat", source));
+    }
+    print(stamp, format("{0} {1} {2}\n", source, int64_t(st.st_size), int64_t(st.st_mtime)));
+}
+
+// The size and modification time of each file that the table's resources are read from.  These
+// are checked on every load; content_digest(), which maps and hashes the resources, is only
+// computed again when they change.
+String source_stamp(int id, const StringSlice& image, const StringSlice& overlay) {
+    String stamp;
+    stamp_source(stamp, format("sprites/{0}.json", id));
+    stamp_source(stamp, image);
+    if (!overlay.empty()) {
+        stamp_source(stamp, overlay);
+    }
+    return stamp;
+}
+
+BytesSlice magic_bytes() {
+    return BytesSlice(reinterpret_cast<const uint8_t*>(kCacheMagic), sizeof(kCacheMagic));
+}
+
+BytesSlice digest_bytes(const Sha1::Digest& digest) {
+    return BytesSlice(reinterpret_cast<const uint8_t*>(&digest), sizeof(digest));
+}
+
+BytesSlice read_bytes(BytesSlice& in, size_t size) {
+    if (in.size() < size) {
+        throw Exception("truncated sprite cache");
+    }
+    BytesSlice result = in.slice(0, size);
+    in.shift(size);
+    return result;
+}
+
+void write_string(Bytes& out, const StringSlice& string) {
+    Bytes bytes(utf8::encode(string));
+    write<uint32_t>(out, bytes.size());
+    out.push(bytes);
+}
+
+String read_string(BytesSlice& in) {
+    return String(utf8::decode(read_bytes(in, read<uint32_t>(in))));
+}
+
 }  // namespace
 
-NatePixTable::NatePixTable(int id, uint8_t color) {
+NatePixTable::NatePixTable(int id, uint8_t color):
+        _id(id) {
+    String cache_path;
+    if (!cache_dir.empty()) {
+        cache_path.assign(format("{0}/{1}/sprites/{2}-{3}.bin",
+                    cache_dir, Preferences::preferences()->scenario_identifier(), id, color));
+        if (load_cache(cache_path, id)) {
+            return;
+        }
+    }
+
     Resource rsrc("sprites", "json", id);
     String data(utf8::decode(rsrc.data()));
     Json json;
@@ -227,10 +324,132 @@ NatePixTable::NatePixTable(int id, uint8_t color) {
     }
     PixTableVisitor::State state;
     json.accept(PixTableVisitor(state, id, color, _frames));
+
+    if (!cache_path.empty()) {
+        save_cache(cache_path, id, state.image_path, state.overlay_path,
+                   content_digest(id, state.image_path, state.overlay_path));
+    }
+}
+
+void NatePixTable::set_cache_dir(const StringSlice& dir) {
+    cache_dir.assign(dir);
+}
+
+// Layout of a cached table:
+//
+//   magic                  kCacheMagic, including the trailing NUL
+//   image, overlay         resource paths, each a uint32 length and UTF-8 data
+//   stamp                  source_stamp() of the resources, as a uint32 length and UTF-8 data
+//   digest                 content_digest() of the resources the table was decoded from
+//   count                  uint32 number of frames
+//   frames                 for each frame, its bounds as four int32s (left, top, right, bottom),
+//                          followed by width * height RgbColors
+//
+// Integers are big-endian, as written by sfz::write().
+bool NatePixTable::load_cache(const StringSlice& path, int id) {
+    unique_ptr<MappedFile> file;
+    try {
+        file.reset(new MappedFile(path));
+    } catch (Exception& e) {
+        return false;
+    }
+
+    try {
+        BytesSlice in = file->data();
+        if (read_bytes(in, sizeof(kCacheMagic)) != magic_bytes()) {
+            return false;
+        }
+        String image(read_string(in));
+        String overlay(read_string(in));
+        String stamp(read_string(in));
+        Sha1::Digest digest;
+        memcpy(&digest, read_bytes(in, sizeof(digest)).data(), sizeof(digest));
+
+        // If the files were only touched, the table is still good, but stamp it again so that
+        // the next load doesn't have to hash them.
+        bool restamp = false;
+        if (stamp != source_stamp(id, image, overlay)) {
+            if (digest_bytes(digest) != digest_bytes(content_digest(id, image, overlay))) {
+                return false;
+            }
+            restamp = true;
+        }
+
+        vector<Frame> frames;
+        const uint32_t count = read<uint32_t>(in);
+        for (int frame: range<int>(count)) {
+            Rect bounds;
+            bounds.left = read<int32_t>(in);
+            bounds.top = read<int32_t>(in);
+            bounds.right = read<int32_t>(in);
+            bounds.bottom = read<int32_t>(in);
+            if ((bounds.width() < 0) || (bounds.height() < 0)) {
+                return false;
+            }
+            BytesSlice pixels = read_bytes(in, bounds.area() * sizeof(RgbColor));
+            frames.emplace_back(bounds, pixels, id, frame);
+        }
+        if (!in.empty()) {
+            return false;
+        }
+        _frames.swap(frames);
+        if (restamp) {
+            save_cache(path, id, image, overlay, digest);
+        }
+        return true;
+    } catch (Exception& e) {
+        return false;
+    }
+}
+
+void NatePixTable::save_cache(
+        const StringSlice& path, int id, const StringSlice& image, const StringSlice& overlay,
+        const Sha1::Digest& digest) const {
+    Bytes out;
+    out.push(magic_bytes());
+    write_string(out, image);
+    write_string(out, overlay);
+    write_string(out, source_stamp(id, image, overlay));
+    out.push(digest_bytes(digest));
+    write<uint32_t>(out, _frames.size());
+    for (const Frame& frame: _frames) {
+        const PixMap& pix = frame.pix_map();
+        const Rect bounds(frame.center(), Size(frame.width(), frame.height()));
+        write<int32_t>(out, bounds.left);
+        write<int32_t>(out, bounds.top);
+        write<int32_t>(out, bounds.right);
+        write<int32_t>(out, bounds.bottom);
+        for (int32_t y: range(pix.size().height)) {
+            out.push(BytesSlice(
+                        reinterpret_cast<const uint8_t*>(pix.row(y)),
+                        pix.size().width * sizeof(RgbColor)));
+        }
+    }
+
+    // Write to a temporary file first, so that a partly-written table is never read back.  The
+    // cache is only an optimization, so failing to write it isn't an error.
+    try {
+        const String tmp_path(format("{0}.tmp", path));
+        makedirs(path::dirname(path), 0755);
+        {
+            ScopedFd fd(open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644));
+            write(fd, out);
+        }
+        CString c_tmp_path(tmp_path);
+        CString c_path(path);
+        rename(c_tmp_path.data(), c_path.data());
+    } catch (Exception& e) {
+    }
 }
 
 NatePixTable::~NatePixTable() { }
 
+void NatePixTable::build() {
+    for (size_t i: range(_frames.size())) {
+        _frames[i].build(_id, i);
+    }
+}
+
 const NatePixTable::Frame& NatePixTable::at(size_t index) const {
     return _frames[index];
 }
@@ -246,7 +465,6 @@ NatePixTable::Frame::Frame(
         _pix_map(bounds.width(), bounds.height()) {
     load_image(image);
     load_overlay(overlay, color);
-    build(id, frame);
 }
 
 NatePixTable::Frame::Frame(
@@ -254,7 +472,13 @@ NatePixTable::Frame::Frame(
         _bounds(bounds),
         _pix_map(bounds.width(), bounds.height()) {
     load_image(image);
-    build(id, frame);
+}
+
+NatePixTable::Frame::Frame(
+        Rect bounds, const BytesSlice& pixels, int16_t id, int frame):
+        _bounds(bounds),
+        _pix_map(bounds.width(), bounds.height()) {
+    load_pixels(pixels);
 }
 
 NatePixTable::Frame::~Frame() { }
@@ -281,6 +505,13 @@ void NatePixTable::Frame::load_overlay(const PixMap& pix, uint8_t color) {
     }
 }
 
+void NatePixTable::Frame::load_pixels(const BytesSlice& pixels) {
+    const size_t row_size = width() * sizeof(RgbColor);
+    for (auto y: range(height())) {
+        memcpy(_pix_map.mutable_row(y), pixels.data() + (y * row_size), row_size);
+    }
+}
+
 uint16_t NatePixTable::Frame::width() const { return _bounds.width(); }
 uint16_t NatePixTable::Frame::height() const { return _bounds.height(); }
 Point NatePixTable::Frame::center() const { return _bounds.origin(); }
@@ -288,8 +519,10 @@ const PixMap& NatePixTable::Frame::pix_map() const { return _pix_map; }
 const Sprite& NatePixTable::Frame::sprite() const { return *_sprite; }
 
 void NatePixTable::Frame::build(int16_t id, int frame) {
-    _sprite = VideoDriver::driver()->new_sprite(
-            format("/sprites/{0}.SMIV/{1}", id, frame), _pix_map);
+    if (VideoDriver::driver()) {
+        _sprite = VideoDriver::driver()->new_sprite(
+                format("/sprites/{0}.SMIV/{1}", id, frame), _pix_map);
+    }
 }
 
 }  // namespace antares
@@ -18,7 +18,13 @@
 
 #include "drawing/sprite-handling.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <numeric>
+#include <thread>
+#include <vector>
 
 #include "drawing/color.hpp"
 #include "drawing/pix-table.hpp"
@@ -30,19 +36,28 @@
 #include "video/driver.hpp"
 
 using sfz::Exception;
-using sfz::Range;
+using sfz::ReadSource;
 using sfz::StringSlice;
+using sfz::WriteTarget;
 using sfz::format;
 using sfz::range;
+using sfz::read;
+using sfz::write;
+using std::atomic;
+using std::exception_ptr;
+using std::lock_guard;
 using std::map;
+using std::max;
+using std::min;
+using std::mutex;
+using std::thread;
 using std::unique_ptr;
+using std::vector;
 
 namespace antares {
 
 namespace {
 
-const size_t kMaxSpriteNum = 500;
-
 const size_t kMinVolatilePixTable = 1;  // sound 0 is always there; 1+ is volatile
 
 const uint32_t kSolidSquareBlip     = 0x00000000;
@@ -61,9 +76,45 @@ void zero(T* t) {
     *t = T();
 }
 
-template <typename T>
-Range<T*> slice(T* array, size_t start, size_t end) {
-    return Range<T*>(array + start, array + end);
+// The table grows by this many sprites at a time when AddSprite() finds it full.
+const size_t kSpriteBlockSize = 256;
+
+spriteType* sprite_at(size_t index) {
+    return &globals()->gSpriteBlocks[index / kSpriteBlockSize][index % kSpriteBlockSize];
+}
+
+// Makes room for `count` sprites in all.  The new slots are empty, and the sprites already in the
+// table don't move.
+void grow_sprites(size_t count) {
+    while ((globals()->gSpriteBlocks.size() * kSpriteBlockSize) < count) {
+        globals()->gSpriteBlocks.emplace_back(new spriteType[kSpriteBlockSize]);
+    }
+    globals()->gSpriteNum = count;
+    globals()->gSpriteSlots.resize((count + 63) / 64, 0);
+}
+
+// Returns the lowest empty slot, as the linear scan this replaces did, or -1 if all are full.
+int32_t find_open_sprite_slot() {
+    size_t& word = globals()->gFirstOpenSpriteWord;
+    for ( ; word < globals()->gSpriteSlots.size(); ++word) {
+        const uint64_t open = ~globals()->gSpriteSlots[word];
+        if (open) {
+            const size_t slot = (word * 64) + __builtin_ctzll(open);
+            return (slot < globals()->gSpriteNum) ? slot : -1;
+        }
+    }
+    return -1;
+}
+
+// Calls `fn` on each sprite with a table, in slot order, skipping empty slots a word at a time.
+template <typename Function>
+void for_each_sprite(Function fn) {
+    const vector<uint64_t>& slots = globals()->gSpriteSlots;
+    for (size_t word = 0; word < slots.size(); ++word) {
+        for (uint64_t used = slots[word]; used; used &= (used - 1)) {
+            fn(sprite_at((word * 64) + __builtin_ctzll(used)));
+        }
+    }
 }
 
 static void draw_tiny_square(const Rect& rect, const RgbColor& color) {
@@ -98,6 +149,16 @@ draw_tiny_t draw_tiny_function(uint8_t id) {
     }
 }
 
+// draw_tiny functions, in the order they are numbered in saved states.
+const draw_tiny_t kDrawTinyFunctions[] = {
+    NULL,
+    draw_tiny_square,
+    draw_tiny_triangle,
+    draw_tiny_diamond,
+    draw_tiny_plus,
+};
+const int32_t kDrawTinyFunctionCount = sizeof(kDrawTinyFunctions) / sizeof(kDrawTinyFunctions[0]);
+
 }  // namespace
 
 struct pixTableType {
@@ -107,14 +168,44 @@ struct pixTableType {
 };
 static pixTableType gPixTable[kMaxPixTableEntry];
 
-int32_t gAbsoluteScale = MIN_SCALE;
-static unique_ptr<spriteType[]> gSpriteTable;
+// The sprite tables are shared by every game in the process, so they're only touched with this
+// held, and unused ones are only released when no other game might be using them.
+static mutex gPixTableMutex;
+
+static NatePixTable* FindPixTable(int16_t resource_id) {
+    for (pixTableType* entry: range(gPixTable, gPixTable + kMaxPixTableEntry)) {
+        if (entry->resID == resource_id) {
+            return entry->resource.get();
+        }
+    }
+    return NULL;
+}
+
+// Decodes the table for `resource_id`, which may carry a color in kSpriteTableColorIDMask.  The
+// table has no sprites until it is built.
+static unique_ptr<NatePixTable> decode_pix_table(int16_t resource_id) {
+    int16_t real_resource_id = resource_id & ~kSpriteTableColorIDMask;
+    int16_t color = (resource_id & kSpriteTableColorIDMask) >> kSpriteTableColorShift;
+    return unique_ptr<NatePixTable>(new NatePixTable(real_resource_id, color));
+}
+
+// Moves a decoded table into an open entry, building its sprites.  gPixTableMutex must be held.
+static NatePixTable* insert_pix_table(int16_t resource_id, unique_ptr<NatePixTable> table) {
+    for (pixTableType* entry: range(gPixTable, gPixTable + kMaxPixTableEntry)) {
+        if (entry->resource.get() == NULL) {
+            table->build();
+            entry->resID = resource_id;
+            entry->resource = std::move(table);
+            return entry->resource.get();
+        }
+    }
+    throw Exception("Can't manage any more sprite tables");
+}
 
 void SpriteHandlingInit() {
     ResetAllPixTables();
 
-    gSpriteTable.reset(new spriteType[kMaxSpriteNum]);
-    ResetAllSprites();
+    SetSpriteCapacity(kMinSpriteNum);
 
     for (int i = 0; i < 4000; ++i) {
         Randomize(256);
@@ -132,12 +223,26 @@ spriteType::spriteType()
           draw_tiny(NULL) { }
 
 void ResetAllSprites() {
-    for (int i: range(kMaxSpriteNum)) {
-        zero(&gSpriteTable[i]);
+    for (size_t i: range(globals()->gSpriteNum)) {
+        zero(sprite_at(i));
+    }
+    globals()->gSpriteSlots.assign(globals()->gSpriteSlots.size(), 0);
+    globals()->gFirstOpenSpriteWord = 0;
+}
+
+// AddSprite() grows the table past `count` as needed; this only sets where it starts.
+void SetSpriteCapacity(size_t count) {
+    count = max(count, kMinSpriteNum);
+    if (count != globals()->gSpriteNum) {
+        globals()->gSpriteBlocks.clear();
+        globals()->gSpriteSlots.clear();
+        grow_sprites(count);
     }
+    ResetAllSprites();
 }
 
 void ResetAllPixTables() {
+    lock_guard<mutex> lock(gPixTableMutex);
     for (pixTableType* entry: range(gPixTable, gPixTable + kMaxPixTableEntry)) {
         entry->resource.reset();
         entry->keepMe = false;
@@ -146,22 +251,29 @@ void ResetAllPixTables() {
 }
 
 void SetAllPixTablesNoKeep() {
+    lock_guard<mutex> lock(gPixTableMutex);
     for (pixTableType* entry:
             range(gPixTable + kMinVolatilePixTable, gPixTable + kMaxPixTableEntry)) {
         entry->keepMe = false;
     }
 }
 
-void KeepPixTable(int16_t resID) {
+bool KeepPixTable(int16_t resID) {
+    lock_guard<mutex> lock(gPixTableMutex);
     for (pixTableType* entry: range(gPixTable, gPixTable + kMaxPixTableEntry)) {
         if (entry->resID == resID) {
             entry->keepMe = true;
-            return;
+            return true;
         }
     }
+    return false;
 }
 
 void RemoveAllUnusedPixTables() {
+    lock_guard<mutex> lock(gPixTableMutex);
+    if (globals_count() > 1) {
+        return;
+    }
     for (pixTableType* entry:
             range(gPixTable + kMinVolatilePixTable, gPixTable + kMaxPixTableEntry)) {
         if (!entry->keepMe) {
@@ -172,66 +284,120 @@ void RemoveAllUnusedPixTables() {
 }
 
 NatePixTable* AddPixTable(int16_t resource_id) {
-    NatePixTable* result = GetPixTable(resource_id);
+    lock_guard<mutex> lock(gPixTableMutex);
+    NatePixTable* result = FindPixTable(resource_id);
     if (result != NULL) {
         return result;
     }
+    return insert_pix_table(resource_id, decode_pix_table(resource_id));
+}
 
-    int16_t real_resource_id = resource_id & ~kSpriteTableColorIDMask;
-    int16_t color = (resource_id & kSpriteTableColorIDMask) >> kSpriteTableColorShift;
-    for (pixTableType* entry: range(gPixTable, gPixTable + kMaxPixTableEntry)) {
-        if (entry->resource.get() == NULL) {
-            entry->resID = resource_id;
-            entry->resource.reset(new NatePixTable(real_resource_id, color));
-            return entry->resource.get();
+void LoadPixTables(vector<int16_t> resource_ids) {
+    std::sort(resource_ids.begin(), resource_ids.end());
+    resource_ids.erase(std::unique(resource_ids.begin(), resource_ids.end()), resource_ids.end());
+    {
+        lock_guard<mutex> lock(gPixTableMutex);
+        resource_ids.erase(
+                std::remove_if(resource_ids.begin(), resource_ids.end(), [](int16_t id) {
+                    return FindPixTable(id) != NULL;
+                }),
+                resource_ids.end());
+    }
+
+    // Each thread takes the next undecoded table until there are none left.  Errors are handed
+    // back to this thread, and the first is rethrown once all threads are done.
+    vector<unique_ptr<NatePixTable>> tables(resource_ids.size());
+    vector<exception_ptr> errors(resource_ids.size());
+    atomic<size_t> next(0);
+    const size_t jobs = min<size_t>(max(thread::hardware_concurrency(), 1u), resource_ids.size());
+    vector<thread> threads;
+    while (threads.size() < jobs) {
+        threads.push_back(thread([&] {
+            for (size_t i = next++; i < resource_ids.size(); i = next++) {
+                try {
+                    tables[i] = decode_pix_table(resource_ids[i]);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        }));
+    }
+    for (thread& t: threads) {
+        t.join();
+    }
+    for (const exception_ptr& error: errors) {
+        if (error) {
+            std::rethrow_exception(error);
         }
     }
 
-    throw Exception("Can't manage any more sprite tables");
+    lock_guard<mutex> lock(gPixTableMutex);
+    for (size_t i: range(resource_ids.size())) {
+        if (FindPixTable(resource_ids[i]) == NULL) {
+            insert_pix_table(resource_ids[i], std::move(tables[i]));
+        }
+    }
 }
 
 NatePixTable* GetPixTable(int16_t resource_id) {
-    for (pixTableType* entry: range(gPixTable, gPixTable + kMaxPixTableEntry)) {
-        if (entry->resID == resource_id) {
-            return entry->resource.get();
-        }
-    }
-    return NULL;
+    lock_guard<mutex> lock(gPixTableMutex);
+    return FindPixTable(resource_id);
 }
 
 spriteType *AddSprite(
         Point where, NatePixTable* table, int16_t resID, int16_t whichShape, int32_t scale, int32_t size,
         int16_t layer, const RgbColor& color, int32_t *whichSprite) {
-    for (spriteType* sprite: range(gSpriteTable.get(), gSpriteTable.get() + kMaxSpriteNum)) {
-        if (sprite->table == NULL) {
-            *whichSprite = sprite - gSpriteTable.get();
-
-            sprite->where = where;
-            sprite->table = table;
-            sprite->resID = resID;
-            sprite->whichShape = whichShape;
-            sprite->scale = scale;
-            sprite->whichLayer = layer;
-            sprite->tinySize = size;
-            sprite->tinyColor = color;
-            sprite->draw_tiny = draw_tiny_function(size);
-            sprite->killMe = false;
-            sprite->style = spriteNormal;
-            sprite->styleColor = RgbColor::kWhite;
-            sprite->styleData = 0;
-
-            return sprite;
-        }
+    int32_t index = find_open_sprite_slot();
+    if (index < 0) {
+        index = globals()->gSpriteNum;
+        grow_sprites(globals()->gSpriteNum + kSpriteBlockSize);
     }
-
-    *whichSprite = kNoSprite;
-    return NULL;
+    globals()->gSpriteSlots[index / 64] |= (1ull << (index % 64));
+    *whichSprite = index;
+
+    spriteType* sprite = sprite_at(index);
+    sprite->where = where;
+    sprite->table = table;
+    sprite->resID = resID;
+    sprite->whichShape = whichShape;
+    sprite->scale = scale;
+    sprite->whichLayer = layer;
+    sprite->tinySize = size;
+    sprite->tinyColor = color;
+    sprite->draw_tiny = draw_tiny_function(size);
+    sprite->killMe = false;
+    sprite->style = spriteNormal;
+    sprite->styleColor = RgbColor::kWhite;
+    sprite->styleData = 0;
+
+    return sprite;
 }
 
 void RemoveSprite(spriteType *aSprite) {
     aSprite->killMe = false;
     aSprite->table = NULL;
     aSprite->resID = -1;
+
+    const int32_t index = GetSpriteIndex(aSprite);
+    globals()->gSpriteSlots[index / 64] &= ~(1ull << (index % 64));
+    globals()->gFirstOpenSpriteWord = min<size_t>(globals()->gFirstOpenSpriteWord, index / 64);
+}
+
+int32_t GetSpriteIndex(const spriteType* sprite) {
+    if (sprite == NULL) {
+        return -1;
+    }
+    for (size_t block: range(globals()->gSpriteBlocks.size())) {
+        const spriteType* start = globals()->gSpriteBlocks[block].get();
+        if ((start <= sprite) && (sprite < (start + kSpriteBlockSize))) {
+            return (block * kSpriteBlockSize) + (sprite - start);
+        }
+    }
+    throw Exception("sprite is not in the sprite table");
+}
+
+spriteType* GetSpriteAtIndex(int32_t index) {
+    return (index >= 0) ? sprite_at(index) : NULL;
 }
 
 int32_t scale_by(int32_t value, int32_t scale) {
@@ -251,50 +417,54 @@ Rect scale_sprite_rect(const NatePixTable::Frame& frame, Point where, int32_t sc
     return draw_rect;
 }
 
+// Sprites are drawn layer by layer, and in slot order within a layer.  Rather than walking the
+// table once per layer, the live sprites are sorted into their layers in a single walk.
 void draw_sprites() {
-    if (gAbsoluteScale >= kBlipThreshhold) {
+    static vector<spriteType*> layers[kLastSpriteLayer + 1];
+    for (vector<spriteType*>& layer: layers) {
+        layer.clear();
+    }
+    for_each_sprite([](spriteType* sprite) {
+        if (!sprite->killMe
+                && (sprite->whichLayer >= kFirstSpriteLayer)
+                && (sprite->whichLayer <= kLastSpriteLayer)) {
+            layers[sprite->whichLayer].push_back(sprite);
+        }
+    });
+
+    if (globals()->gAbsoluteScale >= kBlipThreshhold) {
         for (int layer: range<int>(kFirstSpriteLayer, kLastSpriteLayer + 1)) {
-            for (int i: range(kMaxSpriteNum)) {
-                spriteType* aSprite = &gSpriteTable[i];
-                if ((aSprite->table != NULL)
-                        && !aSprite->killMe
-                        && (aSprite->whichLayer == layer)) {
-                    int32_t trueScale = evil_scale_by(aSprite->scale, gAbsoluteScale);
-                    const NatePixTable::Frame& frame = aSprite->table->at(aSprite->whichShape);
-
-                    const int32_t map_width = evil_scale_by(frame.width(), trueScale);
-                    const int32_t map_height = evil_scale_by(frame.height(), trueScale);
-                    const int32_t scaled_h = evil_scale_by(frame.center().h, trueScale);
-                    const int32_t scaled_v = evil_scale_by(frame.center().v, trueScale);
-                    const Point scaled_center(scaled_h, scaled_v);
-
-                    Rect draw_rect(0, 0, map_width, map_height);
-                    draw_rect.offset(aSprite->where.h - scaled_h, aSprite->where.v - scaled_v);
-
-                    switch (aSprite->style) {
-                      case spriteNormal:
-                        frame.sprite().draw(draw_rect);
-                        break;
-
-                      case spriteColor:
-                        Randomize(63);
-                        frame.sprite().draw_static(
-                                draw_rect, aSprite->styleColor, aSprite->styleData);
-                        break;
-                    }
+            for (spriteType* aSprite: layers[layer]) {
+                int32_t trueScale = evil_scale_by(aSprite->scale, globals()->gAbsoluteScale);
+                const NatePixTable::Frame& frame = aSprite->table->at(aSprite->whichShape);
+
+                const int32_t map_width = evil_scale_by(frame.width(), trueScale);
+                const int32_t map_height = evil_scale_by(frame.height(), trueScale);
+                const int32_t scaled_h = evil_scale_by(frame.center().h, trueScale);
+                const int32_t scaled_v = evil_scale_by(frame.center().v, trueScale);
+                const Point scaled_center(scaled_h, scaled_v);
+
+                Rect draw_rect(0, 0, map_width, map_height);
+                draw_rect.offset(aSprite->where.h - scaled_h, aSprite->where.v - scaled_v);
+
+                switch (aSprite->style) {
+                  case spriteNormal:
+                    frame.sprite().draw(draw_rect);
+                    break;
+
+                  case spriteColor:
+                    Randomize(63);
+                    frame.sprite().draw_static(
+                            draw_rect, aSprite->styleColor, aSprite->styleData);
+                    break;
                 }
             }
         }
     } else {
         for (int layer: range<int>(kFirstSpriteLayer, kLastSpriteLayer + 1)) {
-            for (int i: range(kMaxSpriteNum)) {
-                spriteType* aSprite = &gSpriteTable[i];
+            for (spriteType* aSprite: layers[layer]) {
                 int tinySize = aSprite->tinySize & kBlipSizeMask;
-                if ((aSprite->table != NULL)
-                        && !aSprite->killMe
-                        && tinySize
-                        && (aSprite->draw_tiny != NULL)
-                        && (aSprite->whichLayer == layer)) {
+                if (tinySize && (aSprite->draw_tiny != NULL)) {
                     Rect tiny_rect(-tinySize, -tinySize, tinySize, tinySize);
                     tiny_rect.offset(aSprite->where.h, aSprite->where.v);
                     aSprite->draw_tiny(tiny_rect, aSprite->tinyColor);
@@ -309,13 +479,83 @@ void draw_sprites() {
 // Asteroids before the player actually starts.
 
 void CullSprites() {
-    for (int i: range(kMaxSpriteNum)) {
-        spriteType* aSprite = &gSpriteTable[i];
-        if (aSprite->table != NULL) {
-            if (aSprite->killMe) {
-                RemoveSprite(aSprite);
+    for_each_sprite([](spriteType* aSprite) {
+        if (aSprite->killMe) {
+            RemoveSprite(aSprite);
+        }
+    });
+}
+
+// A sprite's table is written as the resource ID it was loaded under.  Those tables are loaded
+// while the scenario is constructed, so they are already there when a state is restored.
+void write_sprites(WriteTarget out) {
+    write<int32_t>(out, globals()->gSpriteNum);
+    for (size_t i: range(globals()->gSpriteNum)) {
+        const spriteType* sprite = sprite_at(i);
+        int32_t table_id = kNoSpriteTable;
+        if (sprite->table != NULL) {
+            for (const pixTableType& entry: gPixTable) {
+                if (entry.resource.get() == sprite->table) {
+                    table_id = entry.resID;
+                }
             }
         }
+        write(out, table_id);
+        if (table_id == kNoSpriteTable) {
+            continue;
+        }
+        int32_t draw_tiny = 0;
+        while ((draw_tiny < kDrawTinyFunctionCount)
+                && (kDrawTinyFunctions[draw_tiny] != sprite->draw_tiny)) {
+            ++draw_tiny;
+        }
+        write(out, sprite->where);
+        write(out, sprite->resID);
+        write<int32_t>(out, sprite->whichShape);
+        write(out, sprite->scale);
+        write<int32_t>(out, sprite->style);
+        write(out, sprite->styleColor);
+        write(out, sprite->styleData);
+        write(out, sprite->tinySize);
+        write(out, sprite->whichLayer);
+        write(out, sprite->tinyColor);
+        write<uint8_t>(out, sprite->killMe);
+        write(out, draw_tiny);
+    }
+}
+
+void read_sprites(ReadSource in) {
+    // The saved game may have grown its table further than this one has.
+    const size_t count = read<int32_t>(in);
+    if (count > globals()->gSpriteNum) {
+        grow_sprites(count);
+    }
+    ResetAllSprites();
+    for (size_t i: range(count)) {
+        spriteType* sprite = sprite_at(i);
+        const int32_t table_id = read<int32_t>(in);
+        if (table_id == kNoSpriteTable) {
+            continue;
+        }
+        globals()->gSpriteSlots[i / 64] |= (1ull << (i % 64));
+        sprite->table = GetPixTable(table_id);
+        if (sprite->table == NULL) {
+            throw Exception(format("saved state uses unloaded sprite table {0}", table_id));
+        }
+        read(in, sprite->where);
+        read(in, sprite->resID);
+        sprite->whichShape = read<int32_t>(in);
+        read(in, sprite->scale);
+        sprite->style = static_cast<spriteStyleType>(read<int32_t>(in));
+        read(in, sprite->styleColor);
+        read(in, sprite->styleData);
+        read(in, sprite->tinySize);
+        read(in, sprite->whichLayer);
+        read(in, sprite->tinyColor);
+        sprite->killMe = read<uint8_t>(in);
+        const int32_t draw_tiny = read<int32_t>(in);
+        sprite->draw_tiny = (draw_tiny < kDrawTinyFunctionCount)
+            ? kDrawTinyFunctions[draw_tiny] : NULL;
     }
 }
 
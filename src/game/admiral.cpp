@@ -22,7 +22,9 @@
 #include "data/string-list.hpp"
 #include "game/cheat.hpp"
 #include "game/globals.hpp"
+#include "game/scenario-maker.hpp"
 #include "game/space-object.hpp"
+#include "game/state.hpp"
 #include "lang/casts.hpp"
 #include "math/macros.hpp"
 #include "math/random.hpp"
@@ -31,10 +33,13 @@
 
 using sfz::Bytes;
 using sfz::Exception;
+using sfz::ReadSource;
 using sfz::String;
 using sfz::StringSlice;
+using sfz::WriteTarget;
+using sfz::read;
+using sfz::write;
 using std::min;
-using std::unique_ptr;
 
 namespace antares {
 
@@ -54,20 +59,18 @@ const Fixed kImportantTarget            = 0x00000140;
 const Fixed kSomewhatImportantTarget    = 0x00000120;
 const Fixed kAbsolutelyEssential        = 0x00008000;
 
-unique_ptr<destBalanceType[]> gDestBalanceData;
-
 }  // namespace
 
 void AdmiralInit() {
     globals()->gAdmiralData.reset(new admiralType[kMaxPlayerNum]);
     ResetAllAdmirals();
-    gDestBalanceData.reset(new destBalanceType[kMaxDestObject]);
+    globals()->gDestBalanceData.reset(new destBalanceType[kMaxDestObject]);
     ResetAllDestObjectData();
 }
 
 void AdmiralCleanup() {
     globals()->gAdmiralData.reset();
-    gDestBalanceData.reset();
+    globals()->gDestBalanceData.reset();
 }
 
 void ResetAllAdmirals() {
@@ -120,13 +123,111 @@ void ResetAllDestObjectData() {
 }
 
 destBalanceType* mGetDestObjectBalancePtr(int32_t whichObject) {
-    return gDestBalanceData.get() + whichObject;
+    return globals()->gDestBalanceData.get() + whichObject;
 }
 
 admiralType* mGetAdmiralPtr(int32_t mwhichAdmiral) {
     return globals()->gAdmiralData.get() + mwhichAdmiral;
 }
 
+void write_admirals(WriteTarget out) {
+    for (int32_t i = 0; i < kMaxPlayerNum; ++i) {
+        const admiralType& a = globals()->gAdmiralData[i];
+        write(out, a.attributes);
+        write(out, a.destinationObject);
+        write(out, a.destinationObjectID);
+        write(out, a.flagship);
+        write(out, a.flagshipID);
+        write(out, a.considerShip);
+        write(out, a.considerShipID);
+        write(out, a.considerDestination);
+        write(out, a.buildAtObject);
+        write(out, a.race);
+        write<int32_t>(out, a.destType);
+        write(out, a.cash);
+        write(out, a.saveGoal);
+        write(out, a.earningPower);
+        write(out, a.kills);
+        write(out, a.losses);
+        write(out, a.shipsLeft);
+        write(out, a.score, kAdmiralScoreNum);
+        write(out, a.blitzkrieg);
+        write(out, a.lastFreeEscortStrength);
+        write(out, a.thisFreeEscortStrength);
+        for (int32_t j = 0; j < kMaxNumAdmiralCanBuild; ++j) {
+            write<int32_t>(out, GetBaseObjectIndex(a.canBuildType[j].base));
+            write(out, a.canBuildType[j].baseNum);
+            write(out, a.canBuildType[j].chanceRange);
+        }
+        write(out, a.totalBuildChance);
+        write(out, a.hopeToBuild);
+        write(out, a.color);
+        write<uint8_t>(out, a.active);
+        write_state_string(out, a.name);
+    }
+
+    for (int32_t i = 0; i < kMaxDestObject; ++i) {
+        const destBalanceType& d = globals()->gDestBalanceData[i];
+        write(out, d.whichObject);
+        write(out, d.canBuildType, kMaxTypeBaseCanBuild);
+        write(out, d.occupied, kMaxPlayerNum);
+        write(out, d.earn);
+        write(out, d.buildTime);
+        write(out, d.totalBuildTime);
+        write(out, d.buildObjectBaseNum);
+        write_state_string(out, d.name);
+    }
+}
+
+void read_admirals(ReadSource in) {
+    for (int32_t i = 0; i < kMaxPlayerNum; ++i) {
+        admiralType& a = globals()->gAdmiralData[i];
+        read(in, a.attributes);
+        read(in, a.destinationObject);
+        read(in, a.destinationObjectID);
+        read(in, a.flagship);
+        read(in, a.flagshipID);
+        read(in, a.considerShip);
+        read(in, a.considerShipID);
+        read(in, a.considerDestination);
+        read(in, a.buildAtObject);
+        read(in, a.race);
+        a.destType = static_cast<destinationType>(read<int32_t>(in));
+        read(in, a.cash);
+        read(in, a.saveGoal);
+        read(in, a.earningPower);
+        read(in, a.kills);
+        read(in, a.losses);
+        read(in, a.shipsLeft);
+        read(in, a.score, kAdmiralScoreNum);
+        read(in, a.blitzkrieg);
+        read(in, a.lastFreeEscortStrength);
+        read(in, a.thisFreeEscortStrength);
+        for (int32_t j = 0; j < kMaxNumAdmiralCanBuild; ++j) {
+            a.canBuildType[j].base = mGetBaseObjectPtr(read<int32_t>(in));
+            read(in, a.canBuildType[j].baseNum);
+            read(in, a.canBuildType[j].chanceRange);
+        }
+        read(in, a.totalBuildChance);
+        read(in, a.hopeToBuild);
+        read(in, a.color);
+        a.active = read<uint8_t>(in);
+        a.name.assign(read_state_string(in));
+    }
+
+    for (int32_t i = 0; i < kMaxDestObject; ++i) {
+        destBalanceType& d = globals()->gDestBalanceData[i];
+        read(in, d.whichObject);
+        read(in, d.canBuildType, kMaxTypeBaseCanBuild);
+        read(in, d.occupied, kMaxPlayerNum);
+        read(in, d.earn);
+        read(in, d.buildTime);
+        read(in, d.totalBuildTime);
+        read(in, d.buildObjectBaseNum);
+        d.name.assign(read_state_string(in));
+    }
+}
+
 int32_t MakeNewAdmiral(
         int32_t flagship, int32_t destinationObject, destinationType dType, uint32_t attributes,
         int32_t race, int16_t nameResID, int16_t nameStrNum, Fixed earningPower) {
@@ -608,7 +709,7 @@ void SetObjectLocationDestination(spaceObjectType *o, coordPointType *where) {
         o->destinationLocation.h = o->destinationLocation.v = kNoDestinationCoord;
         o->timeFromOrigin = 0;
         o->idealLocationCalc.h = o->idealLocationCalc.v = 0;
-        o->originLocation = o->location;
+        o->originLocation = o->motion->location;
         return;
     }
 
@@ -637,7 +738,7 @@ void SetObjectLocationDestination(spaceObjectType *o, coordPointType *where) {
         o->destinationLocation.h = o->destinationLocation.v = kNoDestinationCoord;
         o->timeFromOrigin = 0;
         o->idealLocationCalc.h = o->idealLocationCalc.v = 0;
-        o->originLocation = o->location;
+        o->originLocation = o->motion->location;
     } else {
         // the object is OK, the admiral is OK, then go about setting its destination
         if (o->attributes & kCanAcceptDestination) {
@@ -671,7 +772,7 @@ void SetObjectDestination(spaceObjectType* o, spaceObjectType* overrideObject) {
         o->destinationLocation.h = o->destinationLocation.v = kNoDestinationCoord;
         o->timeFromOrigin = 0;
         o->idealLocationCalc.h = o->idealLocationCalc.v = 0;
-        o->originLocation = o->location;
+        o->originLocation = o->motion->location;
         return;
     }
 
@@ -705,7 +806,7 @@ void SetObjectDestination(spaceObjectType* o, spaceObjectType* overrideObject) {
         o->destinationLocation.h = o->destinationLocation.v = kNoDestinationCoord;
         o->timeFromOrigin = 0;
         o->idealLocationCalc.h = o->idealLocationCalc.v = 0;
-        o->originLocation = o->location;
+        o->originLocation = o->motion->location;
     } else {
         // the object is OK, the admiral is OK, then go about setting its destination
 
@@ -767,7 +868,7 @@ void SetObjectDestination(spaceObjectType* o, spaceObjectType* overrideObject) {
                 o->destinationLocation.h = o->destinationLocation.v = kNoDestinationCoord;
                 o->timeFromOrigin = 0;
                 o->idealLocationCalc.h = o->idealLocationCalc.v = 0;
-                o->originLocation = o->location;
+                o->originLocation = o->motion->location;
             }
         } else {
             o->destinationObject = kNoDestinationObject;
@@ -776,7 +877,7 @@ void SetObjectDestination(spaceObjectType* o, spaceObjectType* overrideObject) {
             o->destinationLocation.h = o->destinationLocation.v = kNoDestinationCoord;
             o->timeFromOrigin = 0;
             o->idealLocationCalc.h = o->idealLocationCalc.v = 0;
-            o->originLocation = o->location;
+            o->originLocation = o->motion->location;
         }
     }
 }
@@ -838,31 +939,25 @@ void AdmiralThink() {
                 a->blitzkrieg--;
                 if (a->blitzkrieg <= 0) {
                     // Really 48:
-                    a->blitzkrieg = 0 - (gRandomSeed.next(1200) + 1200);
-                    for (int j = 0; j < kMaxSpaceObject; j++) {
-                        anObject = mGetSpaceObjectPtr(j);
-                        if (anObject->owner == i) {
-                            anObject->currentTargetValue = 0x00000000;
-                        }
+                    a->blitzkrieg = 0 - (globals()->gRandomSeed.next(1200) + 1200);
+                    for (int32_t j: ObjectsOfOwner(i)) {
+                        mGetSpaceObjectPtr(j)->currentTargetValue = 0x00000000;
                     }
                 }
             } else {
                 a->blitzkrieg++;
                 if (a->blitzkrieg >= 0) {
                     // Really 48:
-                    a->blitzkrieg = gRandomSeed.next(1200) + 1200;
-                    for (int j = 0; j < kMaxSpaceObject; j++) {
-                        anObject = mGetSpaceObjectPtr(j);
-                        if (anObject->owner == i) {
-                            anObject->currentTargetValue = 0x00000000;
-                        }
+                    a->blitzkrieg = globals()->gRandomSeed.next(1200) + 1200;
+                    for (int32_t j: ObjectsOfOwner(i)) {
+                        mGetSpaceObjectPtr(j)->currentTargetValue = 0x00000000;
                     }
                 }
             }
 
             // get the current object
             if (a->considerShip < 0) {
-                a->considerShip = gRootObjectNumber;
+                a->considerShip = globals()->gRootObjectNumber;
                 anObject = mGetSpaceObjectPtr(a->considerShip);
                 a->considerShipID = anObject->id;
             } else {
@@ -870,11 +965,11 @@ void AdmiralThink() {
             }
 
             if (a->destinationObject < 0) {
-                a->destinationObject = gRootObjectNumber;
+                a->destinationObject = globals()->gRootObjectNumber;
             }
 
             if (anObject->active != kObjectInUse) {
-                a->considerShip = gRootObjectNumber;
+                a->considerShip = globals()->gRootObjectNumber;
                 anObject = mGetSpaceObjectPtr(a->considerShip);
                 a->considerShipID = anObject->id;
             }
@@ -882,8 +977,8 @@ void AdmiralThink() {
             if (a->destinationObject >= 0) {
                 destObject = mGetSpaceObjectPtr(a->destinationObject);
                 if (destObject->active != kObjectInUse) {
-                    destObject = gRootObject;
-                    a->destinationObject = gRootObjectNumber;
+                    destObject = globals()->gRootObject;
+                    a->destinationObject = globals()->gRootObjectNumber;
                 }
                 origDest = a->destinationObject;
                 do {
@@ -925,22 +1020,22 @@ void AdmiralThink() {
 
                         anObject->bestConsideredTargetValue = 0xffffffff;
                         // start back with 1st ship
-                        a->destinationObject = gRootObjectNumber;
-                        destObject = gRootObject;
+                        a->destinationObject = globals()->gRootObjectNumber;
+                        destObject = globals()->gRootObject;
 
                         // >>> INCREASE CONSIDER SHIP
                         origObject = a->considerShip;
                         anObject = mGetSpaceObjectPtr(a->considerShip);
                         if (anObject->active != kObjectInUse) {
-                            anObject = gRootObject;
-                            a->considerShip = gRootObjectNumber;
+                            anObject = globals()->gRootObject;
+                            a->considerShip = globals()->gRootObjectNumber;
                             a->considerShipID = anObject->id;
                         }
                         do {
                             a->considerShip = anObject->nextObjectNumber;
                             if (a->considerShip < 0) {
-                                a->considerShip = gRootObjectNumber;
-                                anObject = gRootObject;
+                                a->considerShip = globals()->gRootObjectNumber;
+                                anObject = globals()->gRootObject;
                                 a->considerShipID = anObject->id;
                                 a->lastFreeEscortStrength = a->thisFreeEscortStrength;
                                 a->thisFreeEscortStrength = 0;
@@ -1119,11 +1214,11 @@ void AdmiralThink() {
                     }
                 }
 
-                difference = ABS(implicit_cast<int32_t>(destObject->location.h)
-                        - implicit_cast<int32_t>(anObject->location.h));
+                difference = ABS(implicit_cast<int32_t>(destObject->motion->location.h)
+                        - implicit_cast<int32_t>(anObject->motion->location.h));
                 gridLoc.h = difference;
-                difference =  ABS(implicit_cast<int32_t>(destObject->location.v)
-                        - implicit_cast<int32_t>(anObject->location.v));
+                difference =  ABS(implicit_cast<int32_t>(destObject->motion->location.v)
+                        - implicit_cast<int32_t>(anObject->motion->location.v));
                 gridLoc.v = difference;
 
                 if ((gridLoc.h < kMaximumRelevantDistance)
@@ -1198,7 +1293,7 @@ void AdmiralThink() {
                             while ((a->hopeToBuild < 0) && (k < 7)) {
                                 k++;
                                 // choose something to build
-                                thisValue = gRandomSeed.next(a->totalBuildChance);
+                                thisValue = globals()->gRandomSeed.next(a->totalBuildChance);
                                 friendValue = 0xffffffff; // equals the highest qualifying object
                                 for (int j = 0; j < kMaxNumAdmiralCanBuild; ++j) {
                                     if ((a->canBuildType[j].chanceRange <= thisValue)
@@ -1211,22 +1306,22 @@ void AdmiralThink() {
                                     mGetBaseObjectFromClassRace(
                                             baseObject, baseNum, a->hopeToBuild, a->race);
                                     if (baseObject->buildFlags & kSufficientEscortsExist) {
-                                        for (int j = 0; j < kMaxSpaceObject; ++j) {
+                                        for (int32_t j: ObjectsOfOwner(i)) {
                                             anObject = mGetSpaceObjectPtr(j);
                                             if ((anObject->active)
-                                                    && (anObject->owner == i)
                                                     && (anObject->whichBaseObject == baseNum)
                                                     && (anObject->escortStrength <
                                                         baseObject->friendDefecit)) {
                                                 a->hopeToBuild = -1;
-                                                j = kMaxSpaceObject;
+                                                break;
                                             }
                                         }
                                     }
 
                                     if (baseObject->buildFlags & kMatchingFoeExists) {
                                         thisValue = 0;
-                                        for (int j = 0; j < kMaxSpaceObject; j++) {
+                                        for (int j = NextSpaceObjectSlot(-1); j >= 0;
+                                                j = NextSpaceObjectSlot(j)) {
                                             anObject = mGetSpaceObjectPtr(j);
                                             if ((anObject->active)
                                                     && (anObject->owner != i)
@@ -1301,7 +1396,7 @@ void AdmiralBuildAtObject(int32_t whichAdmiral, int32_t baseTypeNum, int32_t whi
 
     if ((baseTypeNum >= 0) && (admiral->buildAtObject >= 0)) {
         buildAtObject = mGetSpaceObjectPtr(buildAtDest->whichObject);
-        coord = buildAtObject->location;
+        coord = buildAtObject->motion->location;
 
         newObject = CreateAnySpaceObject(baseTypeNum, &v, &coord, 0, whichAdmiral, 0, -1);
 
@@ -1377,6 +1472,9 @@ void AlterAdmiralScore(int32_t whichAdmiral, int32_t whichScore, int32_t amount)
     if ((whichAdmiral >= 0) && (whichAdmiral < kMaxPlayerNum)
             && (whichScore >= 0) && (whichScore < kAdmiralScoreNum)) {
         admiral->score[whichScore] += amount;
+        if (amount != 0) {
+            MarkCounterConditionsDirty(whichAdmiral, whichScore);
+        }
     }
 }
 
@@ -24,6 +24,7 @@
 
 #include "data/space-object.hpp"
 #include "drawing/color.hpp"
+#include "game/globals.hpp"
 #include "game/motion.hpp"
 #include "game/space-object.hpp"
 #include "lang/casts.hpp"
@@ -32,7 +33,11 @@
 #include "math/units.hpp"
 #include "video/driver.hpp"
 
+using sfz::ReadSource;
+using sfz::WriteTarget;
 using sfz::range;
+using sfz::read;
+using sfz::write;
 using std::abs;
 using std::max;
 
@@ -68,18 +73,16 @@ int32_t scale(int32_t value, int32_t scale) {
 
 }  // namespace
 
-std::unique_ptr<beamType[]> Beams::_data;
-
 beamType::beamType():
         killMe(false),
         active(false) { }
 
 void Beams::init() {
-    _data.reset(new beamType[kBeamNum]);
+    globals()->gBeamData.reset(new beamType[kBeamNum]);
 }
 
 void Beams::reset() {
-    beamType* const beams = _data.get();
+    beamType* const beams = globals()->gBeamData.get();
     for (beamType* beam: range(beams, beams + kBeamNum)) {
         clear(*beam);
     }
@@ -88,7 +91,7 @@ void Beams::reset() {
 beamType* Beams::add(
         coordPointType* location, uint8_t color, beamKindType kind, int32_t accuracy,
         int32_t beam_range, int32_t* whichBeam) {
-    beamType* const beams = _data.get();
+    beamType* const beams = globals()->gBeamData.get();
     for (beamType* beam: range(beams, beams + kBeamNum)) {
         if (!beam->active) {
             beam->lastGlobalLocation = *location;
@@ -98,8 +101,8 @@ beamType* Beams::add(
             beam->active = true;
             beam->color = color;
 
-            const int32_t h = scale(location->h - gGlobalCorner.h, gAbsoluteScale);
-            const int32_t v = scale(location->v - gGlobalCorner.v, gAbsoluteScale);
+            const int32_t h = scale(location->h - globals()->gGlobalCorner.h, globals()->gAbsoluteScale);
+            const int32_t v = scale(location->v - globals()->gGlobalCorner.v, globals()->gAbsoluteScale);
             beam->thisLocation = Rect(0, 0, 0, 0);
             beam->thisLocation.offset(h + viewport.left, v + viewport.top);
 
@@ -137,9 +140,9 @@ void Beams::set_attributes(spaceObjectType* beamObject, spaceObjectType* sourceO
 
         if ((target->active) && (target->id == sourceObject->targetObjectID)) {
             const int32_t h = abs(implicit_cast<int32_t>(
-                        target->location.h - beamObject->location.h));
+                        target->motion->location.h - beamObject->motion->location.h));
             const int32_t v = abs(implicit_cast<int32_t>(
-                        target->location.v - beamObject->location.v));
+                        target->motion->location.v - beamObject->motion->location.v));
 
             if ((((h * h) + (v * v)) > (beam.range * beam.range))
                     || (h > kMaximumRelevantDistance)
@@ -153,10 +156,10 @@ void Beams::set_attributes(spaceObjectType* beamObject, spaceObjectType* sourceO
             } else {
                 if ((beam.beamKind == eStaticObjectToRelativeCoordKind)
                         || (beam.beamKind == eBoltObjectToRelativeCoordKind)) {
-                    beam.toRelativeCoord.h = target->location.h - sourceObject->location.h
+                    beam.toRelativeCoord.h = target->motion->location.h - sourceObject->motion->location.h
                         - beam.accuracy
                         + beamObject->randomSeed.next(beam.accuracy << 1);
-                    beam.toRelativeCoord.v = target->location.v - sourceObject->location.v
+                    beam.toRelativeCoord.v = target->motion->location.v - sourceObject->motion->location.v
                         - beam.accuracy
                         + beamObject->randomSeed.next(beam.accuracy << 1);
                 } else {
@@ -171,7 +174,7 @@ void Beams::set_attributes(spaceObjectType* beamObject, spaceObjectType* sourceO
             } else if (beam.beamKind == eBoltObjectToObjectKind) {
                 beam.beamKind = eBoltObjectToRelativeCoordKind;
             }
-            DetermineBeamRelativeCoordFromAngle(beamObject, sourceObject->direction);
+            DetermineBeamRelativeCoordFromAngle(beamObject, sourceObject->motion->direction);
         }
     } else { // target not valid
         if (beam.beamKind == eStaticObjectToObjectKind) {
@@ -179,20 +182,20 @@ void Beams::set_attributes(spaceObjectType* beamObject, spaceObjectType* sourceO
         } else if (beam.beamKind == eBoltObjectToObjectKind) {
             beam.beamKind = eBoltObjectToRelativeCoordKind;
         }
-        DetermineBeamRelativeCoordFromAngle(beamObject, sourceObject->direction);
+        DetermineBeamRelativeCoordFromAngle(beamObject, sourceObject->motion->direction);
     }
 }
 
 void Beams::update() {
-    beamType* const beams = _data.get();
+    beamType* const beams = globals()->gBeamData.get();
     for (beamType* beam: range(beams, beams + kBeamNum)) {
         if (beam->active) {
             if (beam->lastApparentLocation != beam->objectLocation) {
                 beam->thisLocation = Rect(
-                        scale(beam->objectLocation.h - gGlobalCorner.h, gAbsoluteScale),
-                        scale(beam->objectLocation.v - gGlobalCorner.v, gAbsoluteScale),
-                        scale(beam->lastApparentLocation.h - gGlobalCorner.h, gAbsoluteScale),
-                        scale(beam->lastApparentLocation.v - gGlobalCorner.v, gAbsoluteScale));
+                        scale(beam->objectLocation.h - globals()->gGlobalCorner.h, globals()->gAbsoluteScale),
+                        scale(beam->objectLocation.v - globals()->gGlobalCorner.v, globals()->gAbsoluteScale),
+                        scale(beam->lastApparentLocation.h - globals()->gGlobalCorner.h, globals()->gAbsoluteScale),
+                        scale(beam->lastApparentLocation.v - globals()->gGlobalCorner.v, globals()->gAbsoluteScale));
                 beam->thisLocation.offset(viewport.left, viewport.top);
                 beam->lastApparentLocation = beam->objectLocation;
             }
@@ -242,7 +245,7 @@ void Beams::update() {
 }
 
 void Beams::draw() {
-    beamType* const beams = _data.get();
+    beamType* const beams = globals()->gBeamData.get();
     for (beamType* beam: range(beams, beams + kBeamNum)) {
         if (beam->active) {
             if ((!beam->killMe) && (beam->active != kObjectToBeFreed)) {
@@ -267,7 +270,7 @@ void Beams::draw() {
 }
 
 void Beams::show_all() {
-    beamType* const beams = _data.get();
+    beamType* const beams = globals()->gBeamData.get();
     for (beamType* beam: range(beams, beams + kBeamNum)) {
         if (beam->active) {
             if ((beam->killMe) || (beam->active == kObjectToBeFreed)) {
@@ -287,7 +290,7 @@ void Beams::show_all() {
 }
 
 void Beams::cull() {
-    beamType* const beams = _data.get();
+    beamType* const beams = globals()->gBeamData.get();
     for (beamType* beam: range(beams, beams + kBeamNum)) {
         if (beam->active) {
                 if ((beam->killMe) || (beam->active == kObjectToBeFreed)) {
@@ -298,4 +301,85 @@ void Beams::cull() {
     }
 }
 
+int32_t Beams::index_of(const beamType* beam) {
+    return (beam == NULL) ? -1 : (beam - globals()->gBeamData.get());
+}
+
+beamType* Beams::at(int32_t index) {
+    return (index >= 0) ? (globals()->gBeamData.get() + index) : NULL;
+}
+
+// Only beams in use are written out in full; Beams::add() sets up any others before use.
+void Beams::write_to(WriteTarget out) {
+    beamType* const beams = globals()->gBeamData.get();
+    for (const beamType* beam: range(beams, beams + kBeamNum)) {
+        write<uint8_t>(out, beam->active);
+        if (!beam->active) {
+            continue;
+        }
+        write(out, beam->beamKind);
+        write(out, beam->thisLocation);
+        write(out, beam->lastLocation);
+        write(out, beam->lastGlobalLocation);
+        write(out, beam->objectLocation);
+        write(out, beam->lastApparentLocation);
+        write(out, beam->endLocation);
+        write(out, beam->color);
+        write<uint8_t>(out, beam->killMe);
+        write(out, beam->fromObjectNumber);
+        write(out, beam->fromObjectID);
+        write<int32_t>(out, GetSpaceObjectIndex(beam->fromObject));
+        write(out, beam->toObjectNumber);
+        write(out, beam->toObjectID);
+        write<int32_t>(out, GetSpaceObjectIndex(beam->toObject));
+        write(out, beam->toRelativeCoord);
+        write(out, beam->boltRandomSeed);
+        write(out, beam->lastBoldRandomSeed);
+        write(out, beam->boltCycleTime);
+        write(out, beam->boltState);
+        write(out, beam->accuracy);
+        write(out, beam->range);
+        for (int i = 0; i < kBoltPointNum; ++i) {
+            write(out, beam->thisBoltPoint[i]);
+            write(out, beam->lastBoltPoint[i]);
+        }
+    }
+}
+
+void Beams::read_from(ReadSource in) {
+    beamType* const beams = globals()->gBeamData.get();
+    for (beamType* beam: range(beams, beams + kBeamNum)) {
+        beam->active = read<uint8_t>(in);
+        if (!beam->active) {
+            continue;
+        }
+        read(in, beam->beamKind);
+        read(in, beam->thisLocation);
+        read(in, beam->lastLocation);
+        read(in, beam->lastGlobalLocation);
+        read(in, beam->objectLocation);
+        read(in, beam->lastApparentLocation);
+        read(in, beam->endLocation);
+        read(in, beam->color);
+        beam->killMe = read<uint8_t>(in);
+        read(in, beam->fromObjectNumber);
+        read(in, beam->fromObjectID);
+        beam->fromObject = mGetSpaceObjectPtr(read<int32_t>(in));
+        read(in, beam->toObjectNumber);
+        read(in, beam->toObjectID);
+        beam->toObject = mGetSpaceObjectPtr(read<int32_t>(in));
+        read(in, beam->toRelativeCoord);
+        read(in, beam->boltRandomSeed);
+        read(in, beam->lastBoldRandomSeed);
+        read(in, beam->boltCycleTime);
+        read(in, beam->boltState);
+        read(in, beam->accuracy);
+        read(in, beam->range);
+        for (int i = 0; i < kBoltPointNum; ++i) {
+            read(in, beam->thisBoltPoint[i]);
+            read(in, beam->lastBoltPoint[i]);
+        }
+    }
+}
+
 }  // namespace antares
@@ -18,19 +18,27 @@
 
 #include "game/globals.hpp"
 
+#include <atomic>
+
 #include "data/string-list.hpp"
 #include "drawing/color.hpp"
 #include "drawing/sprite-handling.hpp"
 #include "game/admiral.hpp"
+#include "game/beam.hpp"
 #include "game/input-source.hpp"
+#include "game/labels.hpp"
+#include "game/messages.hpp"
 #include "game/minicomputer.hpp"
 #include "game/motion.hpp"
+#include "game/space-object.hpp"
 #include "game/starfield.hpp"
 #include "sound/driver.hpp"
 
 namespace antares {
 
-static aresGlobalType* gAresGlobal;
+static thread_local aresGlobalType* gAresGlobal;
+static std::atomic<int32_t> gAresGlobalCount(0);
+static aresPluginType gAresPlugin;
 
 aresGlobalType* globals() {
     return gAresGlobal;
@@ -40,7 +48,25 @@ void init_globals() {
     gAresGlobal = new aresGlobalType;
 }
 
+int32_t globals_count() {
+    return gAresGlobalCount;
+}
+
+aresPluginType* plugin() {
+    return &gAresPlugin;
+}
+
+ScopedGlobals::ScopedGlobals(aresGlobalType* game):
+        _saved(gAresGlobal) {
+    gAresGlobal = game;
+}
+
+ScopedGlobals::~ScopedGlobals() {
+    gAresGlobal = _saved;
+}
+
 aresGlobalType::aresGlobalType() {
+    ++gAresGlobalCount;
     for (int player = 0; player < kMaxPlayerNum; player++) {
         gActiveCheats[player] = 0;
     }
@@ -74,9 +100,34 @@ aresGlobalType::aresGlobalType() {
     gSerialDenominator = 0;
 
     hotKeyDownTime = -1;
+
+    gRandomSeed.seed = 14586;
+    headless_ticks = 0;
+    gThisScenario = NULL;
+    gScenarioRotation = 0;
+    gNextTimeCondition = 0;
+    gRootObject = NULL;
+    gRootObjectNumber = -1;
+    gScrollStarObject = NULL;
+    maxSpaceObject = 0;
+    gFirstOpenSlotWord = 0;
+    gSpaceObjectHighWater = 0;
+    gDroppedSpaceObjects = 0;
+    gFreeActionQueue = NULL;
+    gActionQueueTime = 0;
+    gProximityIndexBuilt = false;
+    gAbsoluteScale = MIN_SCALE;
+    gSpriteNum = 0;
+    gFirstOpenSpriteWord = 0;
+    gDestKeyTime = 0;
+    gDestinationLabel = -1;
+    gAlarmCount = -1;
+    gSendMessageLabel = -1;
 }
 
 aresGlobalType::~aresGlobalType() {
+    delete[] gKeyMapBuffer;
+    --gAresGlobalCount;
 }
 
 }  // namespace antares
@@ -0,0 +1,228 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+#include "game/headless.hpp"
+
+#include "config/preferences.hpp"
+#include "data/resource.hpp"
+#include "drawing/sprite-handling.hpp"
+#include "drawing/text.hpp"
+#include "game/admiral.hpp"
+#include "game/beam.hpp"
+#include "game/cheat.hpp"
+#include "game/globals.hpp"
+#include "game/input-source.hpp"
+#include "game/instruments.hpp"
+#include "game/labels.hpp"
+#include "game/messages.hpp"
+#include "game/minicomputer.hpp"
+#include "game/motion.hpp"
+#include "game/non-player-ship.hpp"
+#include "game/scenario-maker.hpp"
+#include "game/space-object.hpp"
+#include "game/state.hpp"
+#include "game/sync.hpp"
+#include "game/time.hpp"
+#include "math/rotation.hpp"
+#include "math/units.hpp"
+#include "sound/fx.hpp"
+#include "ui/screens/debriefing.hpp"
+
+using sfz::Bytes;
+using sfz::BytesSlice;
+using sfz::String;
+using sfz::write;
+
+namespace utf8 = sfz::utf8;
+
+namespace antares {
+
+void HeadlessInit() {
+    init_globals();
+
+    world = Rect(Point(0, 0), Preferences::preferences()->screen_size());
+    play_screen = Rect(
+        world.left + kLeftPanelWidth, world.top,
+        world.right - kRightPanelWidth, world.bottom);
+    viewport = play_screen;
+
+    RotationInit();
+    InitDirectText();
+    SpriteHandlingInit();
+    ScenarioMakerInit();
+    HeadlessInitGame();
+}
+
+void HeadlessInitGame() {
+    Labels::init();
+    Messages::init();
+    InstrumentInit();
+    SetSpriteCapacity(kMinSpriteNum);
+    AresCheatInit();
+    SpaceObjectHandlingInit();  // MUST be after ScenarioMakerInit()
+    InitSoundFX();
+    InitMotion();
+    AdmiralInit();
+    Beams::init();
+}
+
+Bytes replay_debriefing(GameResult result, int32_t seconds) {
+    Bytes debriefing;
+    if (globals()->gScenarioWinner.text >= 0) {
+        Resource rsrc("text", "txt", globals()->gScenarioWinner.text);
+        write(debriefing, rsrc.data());
+        if (result == WIN_GAME) {
+            write(debriefing, "\n\n");
+            String text = DebriefingScreen::build_score_text(
+                    seconds, globals()->gThisScenario->parTime,
+                    GetAdmiralLoss(0), globals()->gThisScenario->parLosses,
+                    GetAdmiralKill(0), globals()->gThisScenario->parKills);
+            write(debriefing, utf8::encode(text));
+        }
+        write(debriefing, "\n");
+    }
+    return debriefing;
+}
+
+HeadlessGame::HeadlessGame(const Scenario* scenario):
+        _scenario_start_time(add_ticks(
+                    0,
+                    (scenario->startTime & kScenario_StartTimeMask) * kScenarioTimeMultiple)),
+        _decide_cycle(0),
+        _scenario_check_time(0),
+        _ticks(0),
+        _game_result(NO_GAME),
+        _seconds(0),
+        _sync_recorder(NULL) {
+    RemoveAllSpaceObjects();
+    globals()->gGameOver = 0;
+
+    int32_t max;
+    int32_t current = 0;
+    if (!start_construct_scenario(scenario, &max)) {
+        _game_result = QUIT_GAME;
+        return;
+    }
+    while (current < max) {
+        construct_scenario(scenario, &current);
+    }
+
+    ResetInstruments();
+    globals()->gLastTime = now_usecs();
+
+    _cursor.show = false;
+    CheckScenarioConditions(0);
+}
+
+Bytes HeadlessGame::save_state() const {
+    GameLoopState loop = {_decide_cycle, _scenario_check_time, _ticks};
+    return save_game(loop, _player_ship);
+}
+
+void HeadlessGame::restore_state(BytesSlice state) {
+    GameLoopState loop;
+    restore_game(state, loop, _player_ship);
+    _decide_cycle = loop.decide_cycle;
+    _scenario_check_time = loop.scenario_check_time;
+    _ticks = loop.ticks;
+}
+
+bool HeadlessGame::step() {
+    if (_game_result != NO_GAME) {
+        return false;
+    }
+
+    advance_headless_clock(1);
+    ++_ticks;
+
+    const int64_t newGameTime = (now_usecs() - globals()->gLastTime) + _scenario_start_time;
+    int unitsPassed = usecs_to_ticks(newGameTime - globals()->gGameTime);
+    const int unitsDone = unitsPassed;
+    if (unitsPassed <= 0) {
+        return true;
+    }
+
+    if (globals()->gGameOver < 0) {
+        globals()->gGameOver += unitsPassed;
+        if (globals()->gGameOver == 0) {
+            globals()->gGameOver = 1;
+        }
+    }
+
+    while (unitsPassed > 0) {
+        int unitsToDo = unitsPassed;
+        if (unitsToDo > kMaxTimePerCycle) {
+            unitsToDo = kMaxTimePerCycle;
+        }
+        if ((_decide_cycle + unitsToDo) > kDecideEveryCycles) {
+            unitsToDo = kDecideEveryCycles - _decide_cycle;
+        }
+        _decide_cycle += unitsToDo;
+
+        if (unitsToDo > 0) {
+            MoveSpaceObjects(unitsToDo);
+        }
+
+        globals()->gGameTime = add_ticks(globals()->gGameTime, unitsToDo);
+
+        if (_decide_cycle == kDecideEveryCycles) {
+            NonplayerShipThink(kDecideEveryCycles);
+            AdmiralThink();
+            ExecuteActionQueue(kDecideEveryCycles);
+
+            if (globals()->gInputSource && !globals()->gInputSource->next(_player_ship)) {
+                globals()->gGameOver = 1;
+            }
+            _player_ship.update(kDecideEveryCycles, _cursor, false);
+
+            CollideSpaceObjects();
+            _decide_cycle = 0;
+            _scenario_check_time++;
+            if (_scenario_check_time == 30) {
+                _scenario_check_time = 0;
+                CheckScenarioConditions(0);
+            }
+            if (_sync_recorder) {
+                _sync_recorder->record(_ticks);
+            }
+        }
+        unitsPassed -= unitsToDo;
+    }
+
+    // Of the per-frame bookkeeping, only the mini-computer poll, the long message, and the
+    // release of dead sprites and beams feed back into the simulation.  draw_long_message()
+    // re-checks the scenario conditions whenever the long message changes, and
+    // kCurrentMessageCondition reads which one is showing.
+    MiniComputerHandleNull(unitsDone);
+    Messages::clip_headless();
+    Messages::draw_long_message(unitsDone);
+    Beams::cull();
+    CullSprites();
+
+    if (globals()->gGameOver > 0) {
+        _seconds = (now_usecs() - globals()->gLastTime) / 1000000;
+        if (globals()->gScenarioWinner.player == globals()->gPlayerAdmiralNumber) {
+            _game_result = WIN_GAME;
+        } else {
+            _game_result = LOSE_GAME;
+        }
+        return false;
+    }
+    return true;
+}
+
+}  // namespace antares
@@ -26,12 +26,19 @@
 #include "game/time.hpp"
 
 using sfz::BytesSlice;
+using sfz::ReadSource;
+using sfz::WriteTarget;
 using sfz::read;
+using sfz::write;
 
 namespace antares {
 
 InputSource::~InputSource() { }
 
+void InputSource::save(WriteTarget out) const { }
+
+void InputSource::restore(ReadSource in) { }
+
 ReplayInputSource::ReplayInputSource(ReplayData* data):
         _data(data),
         _data_index(0),
@@ -47,6 +54,16 @@ bool ReplayInputSource::next(EventReceiver& receiver) {
     return true;
 }
 
+void ReplayInputSource::save(WriteTarget out) const {
+    write<uint64_t>(out, _data_index);
+    write(out, _at);
+}
+
+void ReplayInputSource::restore(ReadSource in) {
+    _data_index = read<uint64_t>(in);
+    read(in, _at);
+}
+
 bool ReplayInputSource::advance(EventReceiver& receiver) {
     if (_at >= _data->duration) {
         return false;
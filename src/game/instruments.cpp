@@ -121,12 +121,8 @@ const int32_t kSectorLineBrightness = DARKER;
 
 namespace {
 
-static coordPointType          gLastGlobalCorner;
 static unique_ptr<Sprite> left_instrument_sprite;
 static unique_ptr<Sprite> right_instrument_sprite;
-static unique_ptr<Point[]> gRadarBlipData;
-static unique_ptr<int32_t[]> gScaleList;
-static unique_ptr<int32_t[]> gSectorLineData;
 static bool should_draw_sector_lines = false;
 static Rect view_range;
 
@@ -135,6 +131,9 @@ struct SiteData {
     Point a, b, c;
     RgbColor light, dark;
 };
+// Only the rendered game updates and draws the site, and there is only ever one of those, so
+// unlike most game state it isn't kept in globals().  InstrumentInit() runs for headless games
+// too, so it mustn't write here.
 static SiteData site;
 
 template <typename T>
@@ -157,45 +156,44 @@ static void draw_build_time_bar(int32_t value);
 void InstrumentInit() {
     globals()->gInstrumentTop = (world.height() / 2) - ( kPanelHeight / 2);
 
-    gRadarBlipData.reset(new Point[kRadarBlipNum]);
-    gScaleList.reset(new int32_t[kScaleListNum]);
-    gSectorLineData.reset(new int32_t[kMaxSectorLine * 4]);
+    globals()->gRadarBlipData.reset(new Point[kRadarBlipNum]);
+    globals()->gScaleList.reset(new int32_t[kScaleListNum]);
+    globals()->gSectorLineData.reset(new int32_t[kMaxSectorLine * 4]);
     ResetInstruments();
 
     // Initialize and crop left and right instrument picts.
-    {
-        Picture pict(kInstLeftPictID);
-        ArrayPixMap pix_map(128, min(world.height(), pict.size().height));
-        Rect from(Point(0, 0), pix_map.size());
-        Rect to(Point(0, 0), pix_map.size());
-        if (pict.size().height > world.height()) {
-            from.offset(0, (pict.size().height - world.height()) / 2);
+    if (VideoDriver::driver()) {
+        {
+            Picture pict(kInstLeftPictID);
+            ArrayPixMap pix_map(128, min(world.height(), pict.size().height));
+            Rect from(Point(0, 0), pix_map.size());
+            Rect to(Point(0, 0), pix_map.size());
+            if (pict.size().height > world.height()) {
+                from.offset(0, (pict.size().height - world.height()) / 2);
+            }
+            pix_map.view(to).copy(pict.view(from));
+            left_instrument_sprite = VideoDriver::driver()->new_sprite(
+                    format("/pictures/{0}.png", kInstLeftPictID), pix_map);
         }
-        pix_map.view(to).copy(pict.view(from));
-        left_instrument_sprite = VideoDriver::driver()->new_sprite(
-                format("/pictures/{0}.png", kInstLeftPictID), pix_map);
-    }
-    {
-        Picture pict(kInstRightPictID);
-        ArrayPixMap pix_map(32, min(world.height(), pict.size().height));
-        Rect from(Point(0, 0), pix_map.size());
-        Rect to(Point(0, 0), pix_map.size());
-        if (pict.size().height > world.height()) {
-            from.offset(0, (pict.size().height - world.height()) / 2);
+        {
+            Picture pict(kInstRightPictID);
+            ArrayPixMap pix_map(32, min(world.height(), pict.size().height));
+            Rect from(Point(0, 0), pix_map.size());
+            Rect to(Point(0, 0), pix_map.size());
+            if (pict.size().height > world.height()) {
+                from.offset(0, (pict.size().height - world.height()) / 2);
+            }
+            pix_map.view(to).copy(pict.view(from));
+            right_instrument_sprite = VideoDriver::driver()->new_sprite(
+                    format("/pictures/{0}.png", kInstRightPictID), pix_map);
         }
-        pix_map.view(to).copy(pict.view(from));
-        right_instrument_sprite = VideoDriver::driver()->new_sprite(
-                format("/pictures/{0}.png", kInstRightPictID), pix_map);
     }
 
-    site.light = GetRGBTranslateColorShade(PALE_GREEN, MEDIUM);
-    site.dark = GetRGBTranslateColorShade(PALE_GREEN, DARKER + kSlightlyDarkerColor);
-
     MiniScreenInit();
 }
 
 void InstrumentCleanup() {
-    gRadarBlipData.reset();
+    globals()->gRadarBlipData.reset();
     MiniScreenCleanup();
 }
 
@@ -206,10 +204,10 @@ void ResetInstruments() {
     globals()->gRadarCount = 0;
     globals()->gRadarSpeed = 30;
     globals()->gRadarRange = kRadarSize * 50;
-    globals()->gLastScale = gAbsoluteScale = SCALE_SCALE;
+    globals()->gLastScale = globals()->gAbsoluteScale = SCALE_SCALE;
     globals()->gWhichScaleNum = 0;
-    gLastGlobalCorner.h = gLastGlobalCorner.v = 0;
-    l = gScaleList.get();
+    globals()->gLastGlobalCorner.h = globals()->gLastGlobalCorner.v = 0;
+    l = globals()->gScaleList.get();
     for (i = 0; i < kScaleListNum; i++) {
         *l = SCALE_SCALE;
         l++;
@@ -229,14 +227,14 @@ void ResetInstruments() {
     globals()->gBarIndicator[kBatteryBar].top = 103 + globals()->gInstrumentTop;
     globals()->gBarIndicator[kBatteryBar].color = SALMON;
 
-    lp = gRadarBlipData.get();
+    lp = globals()->gRadarBlipData.get();
     for ( i = 0; i < kRadarBlipNum; i++)
     {
         lp->h = -1;
         lp++;
     }
 
-    l = gSectorLineData.get();
+    l = globals()->gSectorLineData.get();
     for (int count: range(kMaxSectorLine)) {
         static_cast<void>(count);
         *l = -1;
@@ -251,12 +249,12 @@ void ResetInstruments() {
 }
 
 void UpdateRadar(int32_t unitsDone) {
-    if (gScrollStarObject == NULL) {
+    if (globals()->gScrollStarObject == NULL) {
         globals()->radar_is_functioning = false;
-    } else if (gScrollStarObject->offlineTime <= 0) {
+    } else if (globals()->gScrollStarObject->offlineTime <= 0) {
         globals()->radar_is_functioning = true;
     } else {
-        globals()->radar_is_functioning = (Randomize(gScrollStarObject->offlineTime) < 5);
+        globals()->radar_is_functioning = (Randomize(globals()->gScrollStarObject->offlineTime) < 5);
     }
 
     if (unitsDone < 0) {
@@ -264,7 +262,7 @@ void UpdateRadar(int32_t unitsDone) {
     }
     globals()->gRadarCount -= unitsDone;
 
-    if ((gScrollStarObject == NULL) || !gScrollStarObject->active) {
+    if ((globals()->gScrollStarObject == NULL) || !globals()->gScrollStarObject->active) {
         return;
     }
 
@@ -277,7 +275,7 @@ void UpdateRadar(int32_t unitsDone) {
             Rect radar = bounds;
             radar.inset(1, 1);
 
-            int32_t dx = gScrollStarObject->location.h - gGlobalCorner.h;
+            int32_t dx = globals()->gScrollStarObject->motion->location.h - globals()->gGlobalCorner.h;
             dx = dx * kRadarSize / globals()->gRadarRange;
             view_range = Rect(-dx, -dx, dx, dx);
             view_range.center_in(bounds);
@@ -285,22 +283,23 @@ void UpdateRadar(int32_t unitsDone) {
             view_range.clip_to(radar);
 
             for (int i = 0; i < kRadarBlipNum; ++i) {
-                Point* lp = gRadarBlipData.get() + i;
+                Point* lp = globals()->gRadarBlipData.get() + i;
                 lp->h = -1;
             }
 
-            Point* lp = gRadarBlipData.get();
+            Point* lp = globals()->gRadarBlipData.get();
             Point* end = lp + kRadarBlipNum;
             globals()->gRadarCount = globals()->gRadarSpeed;
 
             const int32_t rrange = globals()->gRadarRange >> 1L;
-            for (int oCount = 0; oCount < kMaxSpaceObject; oCount++) {
+            for (int oCount = NextSpaceObjectSlot(-1); oCount >= 0;
+                    oCount = NextSpaceObjectSlot(oCount)) {
                 spaceObjectType *anObject = mGetSpaceObjectPtr(oCount);
-                if (!anObject->active || (anObject == gScrollStarObject)) {
+                if (!anObject->active || (anObject == globals()->gScrollStarObject)) {
                     continue;
                 }
-                int x = anObject->location.h - gScrollStarObject->location.h;
-                int y = anObject->location.v - gScrollStarObject->location.v;
+                int x = anObject->motion->location.h - globals()->gScrollStarObject->motion->location.h;
+                int y = anObject->motion->location.v - globals()->gScrollStarObject->motion->location.v;
                 if ((x < -rrange) || (x >= rrange) || (y < -rrange) || (y >= rrange)) {
                     continue;
                 }
@@ -328,8 +327,8 @@ void UpdateRadar(int32_t unitsDone) {
             spaceObjectType* anObject = mGetSpaceObjectPtr(globals()->gClosestObject);
             uint64_t hugeDistance = anObject->distanceFromPlayer;
             if (hugeDistance == 0) { // if this is true, then we haven't calced its distance
-                uint64_t x_distance = ABS<int32_t>(gScrollStarObject->location.h - anObject->location.h);
-                uint64_t y_distance = ABS<int32_t>(gScrollStarObject->location.v - anObject->location.v);
+                uint64_t x_distance = ABS<int32_t>(globals()->gScrollStarObject->motion->location.h - anObject->motion->location.h);
+                uint64_t y_distance = ABS<int32_t>(globals()->gScrollStarObject->motion->location.v - anObject->motion->location.v);
 
                 hugeDistance = y_distance * y_distance + x_distance * x_distance;
             }
@@ -376,7 +375,7 @@ void UpdateRadar(int32_t unitsDone) {
 
     int32_t* scaleval;
     for (int x = 0; x < unitsDone; x++) {
-        scaleval = gScaleList.get() + globals()->gWhichScaleNum;
+        scaleval = globals()->gScaleList.get() + globals()->gWhichScaleNum;
         *scaleval = bestScale;
         globals()->gWhichScaleNum++;
         if (globals()->gWhichScaleNum == kScaleListNum) {
@@ -384,14 +383,14 @@ void UpdateRadar(int32_t unitsDone) {
         }
     }
 
-    scaleval = gScaleList.get();
+    scaleval = globals()->gScaleList.get();
     int absolute_scale = 0;
     for (int oCount = 0; oCount < kScaleListNum; oCount++) {
         absolute_scale += *scaleval++;
     }
     absolute_scale >>= kScaleListShift;
 
-    gAbsoluteScale = absolute_scale;
+    globals()->gAbsoluteScale = absolute_scale;
 }
 
 void draw_radar() {
@@ -419,7 +418,7 @@ void draw_radar() {
         }
 
         for (int rcount = 0; rcount < kRadarBlipNum; rcount++) {
-            Point* lp = gRadarBlipData.get() + rcount;
+            Point* lp = globals()->gRadarBlipData.get() + rcount;
             if (lp->h >= 0) {
                 VideoDriver::driver()->draw_point(*lp, color);
             }
@@ -550,10 +549,10 @@ void draw_instruments() {
         }
     }
 
-    baseObjectType* base = gScrollStarObject->baseType;
-    draw_bar_indicator(kShieldBar, gScrollStarObject->health, base->health);
-    draw_bar_indicator(kEnergyBar, gScrollStarObject->energy, base->energy);
-    draw_bar_indicator(kBatteryBar, gScrollStarObject->battery, base->energy * 5);
+    baseObjectType* base = globals()->gScrollStarObject->baseType;
+    draw_bar_indicator(kShieldBar, globals()->gScrollStarObject->health, base->health);
+    draw_bar_indicator(kEnergyBar, globals()->gScrollStarObject->energy, base->energy);
+    draw_bar_indicator(kBatteryBar, globals()->gScrollStarObject->battery, base->energy * 5);
     draw_build_time_bar(globals()->gMiniScreenData.buildTimeBarValue);
     draw_money();
     draw_radar();
@@ -573,7 +572,7 @@ static void update_triangle(SiteData& site, int32_t direction, int32_t distance,
     fb = mMultiplyFixed(fc, fb);
 
     Point a(mFixedToLong(fa), mFixedToLong(fb));
-    a.offset(gScrollStarObject->sprite->where.h, gScrollStarObject->sprite->where.v);
+    a.offset(globals()->gScrollStarObject->sprite->where.h, globals()->gScrollStarObject->sprite->where.v);
     site.a = a;
 
     count = direction;
@@ -598,18 +597,20 @@ static void update_triangle(SiteData& site, int32_t direction, int32_t distance,
 }
 
 void update_site(bool replay) {
-    if (gScrollStarObject == NULL) {
+    if (globals()->gScrollStarObject == NULL) {
         site.should_draw = false;
-    } else if (!(gScrollStarObject->active && (gScrollStarObject->sprite != NULL))) {
+    } else if (!(globals()->gScrollStarObject->active && (globals()->gScrollStarObject->sprite != NULL))) {
         site.should_draw = false;
-    } else if (gScrollStarObject->offlineTime <= 0) {
+    } else if (globals()->gScrollStarObject->offlineTime <= 0) {
         site.should_draw = true;
     } else {
-        site.should_draw = (Randomize(gScrollStarObject->offlineTime) < 5);
+        site.should_draw = (Randomize(globals()->gScrollStarObject->offlineTime) < 5);
     }
 
     if (site.should_draw) {
-        update_triangle(site, gScrollStarObject->direction, kSiteDistance, kSiteSize);
+        site.light = GetRGBTranslateColorShade(PALE_GREEN, MEDIUM);
+        site.dark = GetRGBTranslateColorShade(PALE_GREEN, DARKER + kSlightlyDarkerColor);
+        update_triangle(site, globals()->gScrollStarObject->motion->direction, kSiteDistance, kSiteSize);
     }
 }
 
@@ -641,20 +642,20 @@ void draw_site(const PlayerShip& player) {
 
 void update_sector_lines() {
     should_draw_sector_lines = false;
-    if (gScrollStarObject != NULL) {
-        if (gScrollStarObject->offlineTime <= 0) {
+    if (globals()->gScrollStarObject != NULL) {
+        if (globals()->gScrollStarObject->offlineTime <= 0) {
             should_draw_sector_lines = true;
-        } else if (Randomize(gScrollStarObject->offlineTime) < 5) {
+        } else if (Randomize(globals()->gScrollStarObject->offlineTime) < 5) {
             should_draw_sector_lines = true;
         }
     }
 
-    if ((globals()->gLastScale < kBlipThreshhold) != (gAbsoluteScale < kBlipThreshhold)) {
+    if ((globals()->gLastScale < kBlipThreshhold) != (globals()->gAbsoluteScale < kBlipThreshhold)) {
         PlayVolumeSound(kComputerBeep4, kMediumVolume, kMediumPersistence, kLowPrioritySound);
     }
 
-    globals()->gLastScale = gAbsoluteScale;
-    gLastGlobalCorner = gGlobalCorner;
+    globals()->gLastScale = globals()->gAbsoluteScale;
+    globals()->gLastGlobalCorner = globals()->gGlobalCorner;
 }
 
 void draw_sector_lines() {
@@ -672,11 +673,11 @@ void draw_sector_lines() {
     level /= 2;
     level *= level;
 
-    x = size - (gLastGlobalCorner.h & (size - 1));
-    division = ((gLastGlobalCorner.h + x) >> kSubSectorShift) & 0x0000000f;
+    x = size - (globals()->gLastGlobalCorner.h & (size - 1));
+    division = ((globals()->gLastGlobalCorner.h + x) >> kSubSectorShift) & 0x0000000f;
     x = ((x * globals()->gLastScale) >> SHIFT_SCALE) + viewport.left;
 
-    l = gSectorLineData.get();
+    l = globals()->gSectorLineData.get();
     if (should_draw_sector_lines) {
         while ((x < implicit_cast<uint32_t>(viewport.right)) && (h > 0)) {
             RgbColor color;
@@ -697,11 +698,11 @@ void draw_sector_lines() {
         }
     }
 
-    x = size - (gLastGlobalCorner.v & (size - 1));
-    division = ((gLastGlobalCorner.v + x) >> kSubSectorShift) & 0x0000000f;
+    x = size - (globals()->gLastGlobalCorner.v & (size - 1));
+    division = ((globals()->gLastGlobalCorner.v + x) >> kSubSectorShift) & 0x0000000f;
     x = ((x * globals()->gLastScale) >> SHIFT_SCALE) + viewport.top;
 
-    l = gSectorLineData.get() + (kMaxSectorLine * 2);
+    l = globals()->gSectorLineData.get() + (kMaxSectorLine * 2);
     if (should_draw_sector_lines) {
         while ((x < implicit_cast<uint32_t>(viewport.bottom)) && (h > 0)) {
             RgbColor color;
@@ -49,39 +49,12 @@ const int32_t kLabelTotalInnerSpace = kLabelInnerSpace << 1;
 
 }  // namespace
 
-struct Labels::screenLabelType {
-    Point               where;
-    Point               offset;
-    Rect                thisRect;
-    int32_t             width;
-    int32_t             height;
-    int32_t             age;
-    sfz::String         text;
-    uint8_t             color;
-    bool                active;
-    bool                killMe;
-    bool                visible;
-    int32_t             whichObject;
-    spaceObjectType*    object;
-    bool                objectLink;     // true if label requires an object to be seen
-    int32_t             lineNum;
-    int32_t             lineHeight;
-    bool                keepOnScreenAnyway; // if not attached to object, keep on screen if it's off
-    bool                attachedHintLine;
-    Point               attachedToWhere;
-    int32_t             retroCount;
-
-    screenLabelType();
-};
-
 // local function prototypes
 static int32_t String_Count_Lines(const StringSlice& s);
 static StringSlice String_Get_Nth_Line(const StringSlice& source, int32_t nth);
 static void Auto_Animate_Line( Point *source, Point *dest);
 
-Labels::screenLabelType* Labels::data = nullptr;
-
-void Labels::zero(Labels::screenLabelType& label) {
+void Labels::zero(screenLabelType& label) {
     label.thisRect = Rect(0, 0, -1, -1);
     label.text.clear();
     label.active = false;
@@ -97,18 +70,22 @@ void Labels::zero(Labels::screenLabelType& label) {
     label.retroCount = -1;
 }
 
+screenLabelType* Labels::data() {
+    return globals()->gLabelData.get();
+}
+
 void Labels::init() {
-    data = new screenLabelType[kMaxLabelNum];
+    globals()->gLabelData.reset(new screenLabelType[kMaxLabelNum]);
 }
 
 void Labels::reset() {
     for (int i = 0; i < kMaxLabelNum; ++i) {
-        zero(data[i]);
+        zero(data()[i]);
     }
 }
 
-Labels::screenLabelType::screenLabelType() {
-    zero(*this);
+screenLabelType::screenLabelType() {
+    Labels::zero(*this);
 }
 
 int16_t Labels::add(
@@ -117,15 +94,15 @@ int16_t Labels::add(
     screenLabelType* label = NULL;
 
     for (int i = 0; i < kMaxLabelNum; ++i) {
-        if (!data[i].active) {
-            label = data + i;
+        if (!data()[i].active) {
+            label = data() + i;
             break;
         }
     }
     if (label == NULL) {
         return -1;  // no free label
     }
-    int label_num = label - data;
+    int label_num = label - data();
 
     label->active = true;
     label->killMe = false;
@@ -153,7 +130,7 @@ int16_t Labels::add(
 }
 
 void Labels::remove(int32_t which) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     label->thisRect = Rect(0, 0, -1, -1);
     label->text.clear();
     label->active = false;
@@ -164,7 +141,7 @@ void Labels::remove(int32_t which) {
 
 void Labels::draw() {
     for (int i = 0; i < kMaxLabelNum; ++i) {
-        screenLabelType* const label = data + i;
+        screenLabelType* const label = data() + i;
 
         // We anchor the image at the corner of the rect instead of label->where.  In some cases,
         // label->where is changed between update_all_label_contents() and draw time, but the rect
@@ -209,7 +186,7 @@ void Labels::draw() {
 void Labels::update_contents(int32_t units_done) {
     Rect clip = viewport;
     for (int i = 0; i < kMaxLabelNum; ++i) {
-        screenLabelType* const label = data + i;
+        screenLabelType* const label = data() + i;
         if (!label->active || label->killMe || (label->text.empty()) || !label->visible) {
             label->thisRect.left = label->thisRect.right = 0;
             continue;
@@ -239,7 +216,7 @@ void Labels::update_contents(int32_t units_done) {
 
 void Labels::show_all() {
     for (int i = 0; i < kMaxLabelNum; i++) {
-        screenLabelType *label = data + i;
+        screenLabelType *label = data() + i;
         if (label->active && label->visible) {
             if (label->killMe) {
                 label->active = false;
@@ -249,7 +226,7 @@ void Labels::show_all() {
 }
 
 void Labels::set_position(int32_t which, int16_t h, int16_t v) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     label->where = label->offset;
     label->where.offset(h, v);
 }
@@ -260,7 +237,7 @@ void Labels::update_positions(int32_t units_done) {
             viewport.right - kLabelBuffer, viewport.bottom - kLabelBuffer);
 
     for (int i = 0; i < kMaxLabelNum; i++) {
-        screenLabelType *label = data + i;
+        screenLabelType *label = data() + i;
         bool isOffScreen = false;
         if ((label->active) && (!label->killMe)) {
             if ((label->object != NULL) && (label->object->sprite != NULL)) {
@@ -365,7 +342,7 @@ void Labels::update_positions(int32_t units_done) {
 }
 
 void Labels::set_object(int32_t which, spaceObjectType *object) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     label->object = object;
 
     if (label->object != NULL) {
@@ -380,36 +357,36 @@ void Labels::set_object(int32_t which, spaceObjectType *object) {
 }
 
 void Labels::set_age(int32_t which, int32_t age) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     label->age = age;
     label->visible = true;
 }
 
 void Labels::set_string(int32_t which, const StringSlice& string) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     label->text.assign(string);
     Labels::recalc_size( which);
 }
 
 void Labels::clear_string(int32_t which) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     label->text.clear();
     label->width = label->height = 0;
 }
 
 void Labels::set_color(int32_t which, uint8_t color) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     label->color = color;
 }
 
 void Labels::set_keep_on_screen_anyway(int32_t which, bool keepOnScreenAnyway) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     label->keepOnScreenAnyway = keepOnScreenAnyway;
     label->retroCount = 0;
 }
 
 void Labels::set_attached_hint_line(int32_t which, bool attachedHintLine, Point toWhere) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     if (label->attachedHintLine) {
         HintLine::hide();
     }
@@ -419,24 +396,24 @@ void Labels::set_attached_hint_line(int32_t which, bool attachedHintLine, Point
 }
 
 void Labels::set_offset(int32_t which, int32_t hoff, int32_t voff) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     label->offset.h = hoff;
     label->offset.v = voff;
 }
 
 int32_t Labels::get_width(int32_t which) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     return label->width;
 }
 
 String* Labels::get_string( int32_t which) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     return &label->text;
 }
 
 // do this if you mess with its string
 void Labels::recalc_size(int32_t which) {
-    screenLabelType *label = data + which;
+    screenLabelType *label = data() + which;
     int lineNum = String_Count_Lines(label->text);
 
     if (lineNum > 1) {
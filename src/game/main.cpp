@@ -46,6 +46,7 @@
 #include "game/player-ship.hpp"
 #include "game/scenario-maker.hpp"
 #include "game/starfield.hpp"
+#include "game/state.hpp"
 #include "game/time.hpp"
 #include "math/units.hpp"
 #include "sound/driver.hpp"
@@ -83,7 +84,8 @@ Rect viewport;
 class GamePlay : public Card {
   public:
     GamePlay(
-            bool replay, ReplayBuilder& replay_builder, GameResult* game_result, int32_t* seconds);
+            bool replay, ReplayBuilder& replay_builder, const ReplayIndex::Keyframe* keyframe,
+            GameResult* game_result, int32_t* seconds);
 
     virtual void become_front();
     virtual void resign_front();
@@ -135,15 +137,17 @@ class GamePlay : public Card {
     PlayAgainScreen::Item _play_again;
     PlayerShip _player_ship;
     ReplayBuilder& _replay_builder;
+    const ReplayIndex::Keyframe* _keyframe;
 };
 
 MainPlay::MainPlay(
         const Scenario* scenario, bool replay, bool show_loading_screen,
-        GameResult* game_result, int32_t* seconds):
+        const ReplayIndex::Keyframe* keyframe, GameResult* game_result, int32_t* seconds):
     _state(NEW),
     _scenario(scenario),
     _replay(replay),
     _show_loading_screen(show_loading_screen),
+    _keyframe(keyframe),
     _cancelled(false),
     _game_result(game_result),
     _seconds(seconds) { }
@@ -158,9 +162,9 @@ void MainPlay::become_front() {
 
             _replay_builder.init(
                     Preferences::preferences()->scenario_identifier(),
-                    String(u32_to_version(globals()->scenarioFileInfo.version)),
+                    String(u32_to_version(plugin()->scenarioFileInfo.version)),
                     _scenario->chapter_number(),
-                    gRandomSeed.seed);
+                    globals()->gRandomSeed.seed);
 
             if (Preferences::preferences()->play_idle_music()) {
                 LoadSong(3000);
@@ -219,7 +223,7 @@ void MainPlay::become_front() {
             DrawInstrumentPanel();
 
             if (Preferences::preferences()->play_music_in_game()) {
-                LoadSong(gThisScenario->songID);
+                LoadSong(globals()->gThisScenario->songID);
                 SetSongVolume(kMusicVolume);
                 PlaySong();
             }
@@ -228,7 +232,8 @@ void MainPlay::become_front() {
             if (!_replay) {
                 _replay_builder.start();
             }
-            stack()->push(new GamePlay(_replay, _replay_builder, _game_result, _seconds));
+            stack()->push(new GamePlay(
+                        _replay, _replay_builder, _keyframe, _game_result, _seconds));
         }
         break;
 
@@ -251,7 +256,8 @@ int new_replay_file() {
 }
 
 GamePlay::GamePlay(
-        bool replay, ReplayBuilder& replay_builder, GameResult* game_result, int32_t* seconds):
+        bool replay, ReplayBuilder& replay_builder, const ReplayIndex::Keyframe* keyframe,
+        GameResult* game_result, int32_t* seconds):
         _state(PLAYING),
         _replay(replay),
         _game_result(game_result),
@@ -260,7 +266,7 @@ GamePlay::GamePlay(
         _play_area(viewport.left, viewport.top, viewport.right, viewport.bottom),
         _scenario_start_time(add_ticks(
                     0,
-                    (gThisScenario->startTime & kScenario_StartTimeMask)
+                    (globals()->gThisScenario->startTime & kScenario_StartTimeMask)
                     * kScenarioTimeMultiple)),
         _command_and_q(BothCommandAndQ()),
         _left_mouse_down(false),
@@ -270,7 +276,8 @@ GamePlay::GamePlay(
         _decide_cycle(0),
         _last_click_time(0),
         _scenario_check_time(0),
-        _replay_builder(replay_builder) { }
+        _replay_builder(replay_builder),
+        _keyframe(keyframe) { }
 
 class PauseScreen : public Card {
   public:
@@ -375,6 +382,14 @@ void GamePlay::become_front() {
         HintLine::reset();
 
         CheckScenarioConditions(0);
+        if (_keyframe) {
+            // Restoring overwrites everything since construction, including the check above.
+            GameLoopState loop;
+            restore_game(_keyframe->state, loop, _player_ship);
+            _decide_cycle = loop.decide_cycle;
+            _scenario_check_time = loop.scenario_check_time;
+            _keyframe = NULL;
+        }
         break;
 
       case PAUSED:
@@ -408,7 +423,7 @@ void GamePlay::become_front() {
             *_game_result = WIN_GAME;
             globals()->gGameOver = 1;
             globals()->gScenarioWinner.player = globals()->gPlayerAdmiralNumber;
-            globals()->gScenarioWinner.next = gThisScenario->chapter_number() + 1;
+            globals()->gScenarioWinner.next = globals()->gThisScenario->chapter_number() + 1;
             globals()->gScenarioWinner.text = -1;
             stack()->pop(this);
             break;
@@ -655,9 +670,9 @@ void GamePlay::fire_timer() {
         } else {
             _state = DEBRIEFING;
             stack()->push(new DebriefingScreen(
-                        globals()->gScenarioWinner.text, *_seconds, gThisScenario->parTime,
-                        GetAdmiralLoss(0), gThisScenario->parLosses,
-                        GetAdmiralKill(0), gThisScenario->parKills));
+                        globals()->gScenarioWinner.text, *_seconds, globals()->gThisScenario->parTime,
+                        GetAdmiralLoss(0), globals()->gThisScenario->parLosses,
+                        GetAdmiralKill(0), globals()->gThisScenario->parKills));
         }
         break;
 
@@ -694,7 +709,7 @@ void GamePlay::key_down(const KeyDownEvent& event) {
         {
             _state = PLAY_AGAIN;
             _player_paused = true;
-            bool is_training = gThisScenario->startTime & kScenario_IsTraining_Bit;
+            bool is_training = globals()->gThisScenario->startTime & kScenario_IsTraining_Bit;
             stack()->push(new PlayAgainScreen(true, is_training, &_play_again));
         }
         break;
@@ -745,7 +760,7 @@ void GamePlay::gamepad_button_down(const GamepadButtonDownEvent& event) {
         {
             _state  = PLAY_AGAIN;
             _player_paused = true;
-            bool is_training = gThisScenario->startTime & kScenario_IsTraining_Bit;
+            bool is_training = globals()->gThisScenario->startTime & kScenario_IsTraining_Bit;
             stack()->push(new PlayAgainScreen(true, is_training, &_play_again));
         }
         break;
@@ -28,14 +28,19 @@
 #include "game/globals.hpp"
 #include "game/labels.hpp"
 #include "game/scenario-maker.hpp"
+#include "game/state.hpp"
 #include "ui/interface-handling.hpp"
 #include "video/driver.hpp"
 
 using sfz::Bytes;
 using sfz::BytesSlice;
 using sfz::Exception;
+using sfz::ReadSource;
 using sfz::String;
 using sfz::StringSlice;
+using sfz::WriteTarget;
+using sfz::read;
+using sfz::write;
 using std::unique_ptr;
 
 namespace utf8 = sfz::utf8;
@@ -89,72 +94,29 @@ void clear(T& t) {
     swap(t, u);
 }
 
-enum longMessageStageType {
-    kNoStage = 0,
-    kStartStage = 1,
-    kClipStage = 2,
-    kShowStage = 3,
-    kEndStage = 4
-};
-
 }  // namespace
 
-struct Messages::longMessageType {
-    longMessageStageType    stage;
-    int32_t                 charDelayCount;
-    Rect                    pictBounds;
-    int32_t                 pictDelayCount;
-    int32_t                 pictCurrentLeft;
-    int32_t                 pictCurrentTop;
-    int32_t                 time;
-    int32_t                 textHeight;
-    int16_t                 startResID;
-    int16_t                 endResID;
-    int16_t                 currentResID;
-    int16_t                 lastResID;
-    int16_t                 previousStartResID;
-    int16_t                 previousEndResID;
-    int16_t                 pictID;
-    uint8_t                 backColor;
-    sfz::String             stringMessage;
-    sfz::String             lastStringMessage;
-    bool                 newStringMessage;
-    sfz::String             text;
-    std::unique_ptr<StyledText> retro_text;
-    Point                   retro_origin;
-    int32_t                 at_char;
-    bool                 labelMessage;
-    bool                 lastLabelMessage;
-    int16_t                 labelMessageID;
-};
-
-std::queue<sfz::String> Messages::message_data;
-Messages::longMessageType* Messages::long_message_data;
-int32_t Messages::time_count;
-int32_t Messages::message_label_num;
-int32_t Messages::status_label_num;
-
 void MessageLabel_Set_Special(int16_t id, const StringSlice& text);
 
 void Messages::init() {
     longMessageType *tmessage = NULL;
 
-    antares::clear(message_data);
-    long_message_data = new longMessageType;
+    antares::clear(globals()->gMessageData);
+    globals()->gLongMessageData.reset(new longMessageType);
 
-    message_label_num = Labels::add(
+    globals()->gMessageLabelNum = Labels::add(
             kMessageScreenLeft, kMessageScreenTop, 0, 0, NULL, false, kMessageColor);
 
-    if (message_label_num < 0) {
+    if (globals()->gMessageLabelNum < 0) {
         throw Exception("Couldn't add a screen label.");
     }
-    status_label_num = Labels::add(
+    globals()->gStatusLabelNum = Labels::add(
             kStatusLabelLeft, kStatusLabelTop, 0, 0, NULL, false, kStatusLabelColor);
-    if (status_label_num < 0) {
+    if (globals()->gStatusLabelNum < 0) {
         throw Exception("Couldn't add a screen label.");
     }
 
-    tmessage = long_message_data;
+    tmessage = globals()->gLongMessageData.get();
     tmessage->startResID =  tmessage->endResID = tmessage->lastResID = tmessage->currentResID =
         -1;
     tmessage->time = 0;
@@ -177,22 +139,22 @@ void Messages::init() {
 void Messages::clear() {
     longMessageType *tmessage;
 
-    time_count = 0;
+    globals()->gMessageTimeCount = 0;
     std::queue<sfz::String> empty;
-    swap(message_data, empty);
-    message_label_num = Labels::add(
+    swap(globals()->gMessageData, empty);
+    globals()->gMessageLabelNum = Labels::add(
             kMessageScreenLeft, kMessageScreenTop, 0, 0, NULL, false, kMessageColor);
-    status_label_num = Labels::add(
+    globals()->gStatusLabelNum = Labels::add(
             kStatusLabelLeft, kStatusLabelTop, 0, 0, NULL, false, kStatusLabelColor);
 
-    tmessage = long_message_data;
+    tmessage = globals()->gLongMessageData.get();
     tmessage->startResID = -1;
     tmessage->endResID = -1;
     tmessage->currentResID = -1;
     tmessage->lastResID = -1;
     tmessage->textHeight = 0;
     tmessage->previousStartResID = tmessage->previousEndResID = -1;
-    tmessage = long_message_data;
+    tmessage = globals()->gLongMessageData.get();
     tmessage->stringMessage.clear();
     tmessage->lastStringMessage.clear();
     tmessage->newStringMessage = false;
@@ -205,13 +167,13 @@ void Messages::clear() {
 }
 
 void Messages::add(const sfz::PrintItem& message) {
-    message_data.emplace(message);
+    globals()->gMessageData.emplace(message);
 }
 
 void Messages::start(int16_t startResID, int16_t endResID) {
     longMessageType *tmessage;
 
-    tmessage = long_message_data;
+    tmessage = globals()->gLongMessageData.get();
 
     if ( tmessage->currentResID != -1)
     {
@@ -239,17 +201,20 @@ void Messages::start(int16_t startResID, int16_t endResID) {
     }
 }
 
-void Messages::clip( void)
+namespace {
 
-{
+// Moves the long message from kClipStage to kShowStage, where draw_long_message() picks it up.
+// Without `layout`, the text is read (to tell label messages from the rest) but not laid out,
+// and the viewport is left alone, so a game with no VideoDriver goes through the same stages.
+void clip_long_message(bool layout) {
     longMessageType *tmessage;
     unique_ptr<String> textData;
 
-    tmessage = long_message_data;
+    tmessage = globals()->gLongMessageData.get();
     if (( tmessage->currentResID != tmessage->lastResID) || ( tmessage->newStringMessage))
     {
 
-        if ( tmessage->lastResID >= 0)
+        if (layout && ( tmessage->lastResID >= 0))
         {
             viewport.bottom = play_screen.bottom;
         }
@@ -268,14 +233,17 @@ void Messages::clip( void)
             {
                 Resource rsrc("text", "txt", tmessage->currentResID);
                 textData.reset(new String(utf8::decode(rsrc.data())));
-                Replace_KeyCode_Strings_With_Actual_Key_Names(textData.get(), KEY_LONG_NAMES, 0);
+                if (layout) {
+                    Replace_KeyCode_Strings_With_Actual_Key_Names(
+                            textData.get(), KEY_LONG_NAMES, 0);
+                }
                 if (textData->at(0) == '#') {
                     tmessage->labelMessage = true;
                 }
                 else tmessage->labelMessage = false;
 
             }
-            if (textData.get() != NULL) {
+            if ((textData.get() != NULL) && layout) {
                 const RgbColor& light_blue = GetRGBTranslateColorShade(SKY_BLUE, VERY_LIGHT);
                 const RgbColor& dark_blue = GetRGBTranslateColorShade(SKY_BLUE, DARKEST);
                 tmessage->text.assign(*textData);
@@ -298,39 +266,36 @@ void Messages::clip( void)
                 } else {
                     viewport.bottom = play_screen.bottom;
                 }
+            }
+            if (textData.get() != NULL) {
                 tmessage->stage = kShowStage;
-
-                /*
-                tmessage->retroTextSpec.topBuffer = kMessageCharTopBuffer;
-                tmessage->retroTextSpec.bottomBuffer = kMessageCharBottomBuffer;
-                tmessage->retroTextSpec.thisPosition = 0;
-                tmessage->retroTextSpec.lineCount = 0;
-                tmessage->retroTextSpec.linePosition = 0;
-                tmessage->retroTextSpec.xpos = viewport.left + kHBuffer;
-                tmessage->retroTextSpec.ypos = viewport.bottom + mDirectFontAscent() + kLongMessageVPad + tmessage->retroTextSpec.topBuffer;
-                tmessage->retroTextSpec.tabSize = 60;
-                tmessage->retroTextSpec.color = GetRGBTranslateColorShade(SKY_BLUE, VERY_LIGHT);
-                tmessage->retroTextSpec.backColor = GetRGBTranslateColorShade(SKY_BLUE, DARKEST);
-                tmessage->retroTextSpec.nextColor = tmessage->retroTextSpec.color;
-                tmessage->retroTextSpec.nextBackColor = tmessage->retroTextSpec.backColor;
-                tmessage->retroTextSpec.originalColor = tmessage->retroTextSpec.color;
-                tmessage->retroTextSpec.originalBackColor = tmessage->retroTextSpec.backColor;
-                */
             }
         } else {
-            viewport.bottom = play_screen.bottom;
+            if (layout) {
+                viewport.bottom = play_screen.bottom;
+            }
             tmessage->stage = kClipStage;
         }
     }
 }
 
+}  // namespace
+
+void Messages::clip() {
+    clip_long_message(true);
+}
+
+void Messages::clip_headless() {
+    clip_long_message(false);
+}
+
 void Messages::draw_long_message(int32_t time_pass) {
     Rect            tRect, uRect;
     Rect            lRect, cRect;
     longMessageType *tmessage;
     RgbColor        color;
 
-    tmessage = long_message_data;
+    tmessage = globals()->gLongMessageData.get();
     if ((tmessage->currentResID != tmessage->lastResID)
             || (tmessage->newStringMessage)) {
         // TODO(sfiera): figure out what this meant.
@@ -386,7 +351,7 @@ void Messages::draw_long_message(int32_t time_pass) {
 void Messages::end() {
     longMessageType *tmessage;
 
-    tmessage = long_message_data;
+    tmessage = globals()->gLongMessageData.get();
     tmessage->previousStartResID = tmessage->startResID;
     tmessage->previousEndResID = tmessage->endResID;
     tmessage->startResID = -1;
@@ -400,7 +365,7 @@ void Messages::end() {
 void Messages::advance() {
     longMessageType *tmessage;
 
-    tmessage = long_message_data;
+    tmessage = globals()->gLongMessageData.get();
     if ( tmessage->currentResID != -1)
     {
         if ( tmessage->currentResID < tmessage->endResID)
@@ -418,7 +383,7 @@ void Messages::advance() {
 void Messages::previous() {
     longMessageType *tmessage;
 
-    tmessage = long_message_data;
+    tmessage = globals()->gLongMessageData.get();
     if ( tmessage->currentResID != -1)
     {
         if ( tmessage->currentResID > tmessage->startResID)
@@ -432,7 +397,7 @@ void Messages::previous() {
 void Messages::replay() {
     longMessageType *tmessage;
 
-    tmessage = long_message_data;
+    tmessage = globals()->gLongMessageData.get();
     if (( tmessage->previousStartResID >= 0) && ( tmessage->currentResID < 0))
     {
         tmessage->stringMessage.assign(tmessage->lastStringMessage);
@@ -444,44 +409,85 @@ void Messages::replay() {
 
 void Messages::draw_message_screen(int32_t by_units) {
     // increase the amount of time current message has been shown
-    time_count += by_units;
+    globals()->gMessageTimeCount += by_units;
 
     // if it's been shown for too long, then get the next message
-    if (time_count > kMessageDisplayTime) {
-        time_count = 0;
-        if (!message_data.empty()) {
-            message_data.pop();
+    if (globals()->gMessageTimeCount > kMessageDisplayTime) {
+        globals()->gMessageTimeCount = 0;
+        if (!globals()->gMessageData.empty()) {
+            globals()->gMessageData.pop();
         }
     }
 
-    if (!message_data.empty()) {
-        const String& message = message_data.front();
+    if (!globals()->gMessageData.empty()) {
+        const String& message = globals()->gMessageData.front();
 
-        if (time_count < kRaiseTime) {
+        if (globals()->gMessageTimeCount < kRaiseTime) {
             Labels::set_position(
-                    message_label_num, kMessageScreenLeft,
-                    viewport.bottom - time_count);
-        } else if (time_count > kLowerTime) {
+                    globals()->gMessageLabelNum, kMessageScreenLeft,
+                    viewport.bottom - globals()->gMessageTimeCount);
+        } else if (globals()->gMessageTimeCount > kLowerTime) {
             Labels::set_position(
-                    message_label_num, kMessageScreenLeft,
-                    viewport.bottom - (kMessageDisplayTime - time_count));
+                    globals()->gMessageLabelNum, kMessageScreenLeft,
+                    viewport.bottom - (kMessageDisplayTime - globals()->gMessageTimeCount));
         }
 
-        Labels::set_string(message_label_num, message);
+        Labels::set_string(globals()->gMessageLabelNum, message);
     } else {
-        Labels::clear_string(message_label_num);
-        time_count = 0;
+        Labels::clear_string(globals()->gMessageLabelNum);
+        globals()->gMessageTimeCount = 0;
     }
 }
 
 void Messages::set_status(const StringSlice& status, uint8_t color) {
-    Labels::set_color(status_label_num, color);
-    Labels::set_string(status_label_num, status);
-    Labels::set_age(status_label_num, kStatusLabelAge);
+    Labels::set_color(globals()->gStatusLabelNum, color);
+    Labels::set_string(globals()->gStatusLabelNum, status);
+    Labels::set_age(globals()->gStatusLabelNum, kStatusLabelAge);
 }
 
 int16_t Messages::current() {
-    return long_message_data->currentResID;
+    return globals()->gLongMessageData.get()->currentResID;
+}
+
+void Messages::write_to(WriteTarget out) {
+    const longMessageType* tmessage = globals()->gLongMessageData.get();
+    write<int32_t>(out, tmessage->stage);
+    write(out, tmessage->time);
+    write(out, tmessage->startResID);
+    write(out, tmessage->endResID);
+    write(out, tmessage->currentResID);
+    write(out, tmessage->lastResID);
+    write(out, tmessage->previousStartResID);
+    write(out, tmessage->previousEndResID);
+    write_state_string(out, tmessage->stringMessage);
+    write_state_string(out, tmessage->lastStringMessage);
+    write<uint8_t>(out, tmessage->newStringMessage);
+    write<uint8_t>(out, tmessage->labelMessage);
+    write<uint8_t>(out, tmessage->lastLabelMessage);
+}
+
+void Messages::read_from(ReadSource in) {
+    longMessageType* tmessage = globals()->gLongMessageData.get();
+    tmessage->stage = static_cast<longMessageStageType>(read<int32_t>(in));
+    read(in, tmessage->time);
+    read(in, tmessage->startResID);
+    read(in, tmessage->endResID);
+    read(in, tmessage->currentResID);
+    read(in, tmessage->lastResID);
+    read(in, tmessage->previousStartResID);
+    read(in, tmessage->previousEndResID);
+    tmessage->stringMessage.assign(read_state_string(in));
+    tmessage->lastStringMessage.assign(read_state_string(in));
+    tmessage->newStringMessage = read<uint8_t>(in);
+    tmessage->labelMessage = read<uint8_t>(in);
+    tmessage->lastLabelMessage = read<uint8_t>(in);
+
+    // The text of the message isn't saved; it's laid out again when the next one starts.
+    tmessage->text.clear();
+    tmessage->retro_text.reset();
+    tmessage->textHeight = 0;
+    tmessage->at_char = 0;
+    tmessage->charDelayCount = 0;
 }
 
 //
@@ -583,7 +589,8 @@ void MessageLabel_Set_Special(int16_t id, const StringSlice& text) {
 }
 
 void Messages::draw_message() {
-    if ((viewport.bottom == play_screen.bottom) || (long_message_data->currentResID < 0)) {
+    const longMessageType* tmessage = globals()->gLongMessageData.get();
+    if ((viewport.bottom == play_screen.bottom) || (tmessage->currentResID < 0)) {
         return;
     }
 
@@ -597,13 +604,12 @@ void Messages::draw_message() {
     Rect bounds(viewport.left, viewport.bottom, viewport.right, play_screen.bottom);
     bounds.inset(kHBuffer, 0);
     bounds.top += kLongMessageVPad;
-    for (int i = 0; i < long_message_data->at_char; ++i) {
-        long_message_data->retro_text->draw_char(bounds, i);
+    for (int i = 0; i < tmessage->at_char; ++i) {
+        tmessage->retro_text->draw_char(bounds, i);
     }
     // The final char is a newline; don't display a cursor rect for it.
-    if ((0 < long_message_data->at_char)
-            && (long_message_data->at_char < (long_message_data->retro_text->size() - 1))) {
-        long_message_data->retro_text->draw_cursor(bounds, long_message_data->at_char);
+    if ((0 < tmessage->at_char) && (tmessage->at_char < (tmessage->retro_text->size() - 1))) {
+        tmessage->retro_text->draw_cursor(bounds, tmessage->at_char);
     }
 }
 
@@ -36,17 +36,22 @@
 #include "game/scenario-maker.hpp"
 #include "game/space-object.hpp"
 #include "game/starfield.hpp"
+#include "game/state.hpp"
 #include "math/fixed.hpp"
 #include "sound/fx.hpp"
 #include "video/driver.hpp"
 
 using sfz::Bytes;
+using sfz::ReadSource;
 using sfz::Rune;
 using sfz::String;
 using sfz::StringSlice;
+using sfz::WriteTarget;
 using sfz::bin;
 using sfz::range;
+using sfz::read;
 using sfz::string_to_int;
+using sfz::write;
 using std::max;
 
 namespace antares {
@@ -226,7 +231,6 @@ inline void mCopyMiniSpaceObject(
     (mdestobject).whichBaseObject = (msourceobject).whichBaseObject;
     (mdestobject).pixResID = (msourceobject).pixResID;
     (mdestobject).attributes = (msourceobject).attributes;
-    (mdestobject).location = (msourceobject).location;
     (mdestobject).owner = (msourceobject).owner;
     (mdestobject).nextFarObject = (msourceobject).nextFarObject;
     (mdestobject).distanceGrid = (msourceobject).distanceGrid;
@@ -268,7 +272,9 @@ void MiniScreenInit() {
     ClearMiniScreenLines();
     ClearMiniObjectData();
 
-    mini_data_strings = new StringList(kMiniDataStringID);
+    if (mini_data_strings == NULL) {
+        mini_data_strings = new StringList(kMiniDataStringID);
+    }
 }
 
 void MiniScreenCleanup() {
@@ -1089,7 +1095,7 @@ void MiniComputerExecute( int32_t whichPage, int32_t whichLine, int32_t whichAdm
             if ( whichLine != kMiniScreenNoLineSelected)
             {
                 if ( CountObjectsOfBaseType( -1, -1) <
-                    (kMaxSpaceObject - kMaxShipBuffer))
+                    (globals()->maxSpaceObject - kMaxShipBuffer))
                 {
                     if (AdmiralScheduleBuild( whichAdmiral,
                         whichLine - kBuildScreenFirstTypeLine) == false)
@@ -1184,7 +1190,7 @@ void MiniComputerExecute( int32_t whichPage, int32_t whichLine, int32_t whichAdm
                     if (( l != kNoShip))
                     {
                         anObject = mGetSpaceObjectPtr(l);
-                        SetObjectLocationDestination( anObject, &(anObject->location));
+                        SetObjectLocationDestination( anObject, &(anObject->motion->location));
                     }
                     break;
 
@@ -1194,7 +1200,7 @@ void MiniComputerExecute( int32_t whichPage, int32_t whichLine, int32_t whichAdm
                     {
                         anObject = mGetSpaceObjectPtr(l);
                         anotherObject = GetAdmiralFlagship( whichAdmiral);
-                        SetObjectLocationDestination( anObject, &(anotherObject->location));
+                        SetObjectLocationDestination( anObject, &(anotherObject->motion->location));
                     }
                     break;
 
@@ -1554,7 +1560,7 @@ int32_t MiniComputerGetStatusValue( int32_t whichLine)
             break;
 
         case kTrueFalseCondition:
-            if (gThisScenario->condition(line->whichStatus)->true_yet()) {
+            if (ConditionTrueYet(line->whichStatus)) {
                 return 1;
             } else {
                 return 0;
@@ -1930,4 +1936,62 @@ void MiniComputer_SetScreenAndLineHack( int32_t whichScreen, int32_t whichLine)
     MiniComputerHandleClick( w);    // what an atrocious hack! oh well
 }
 
+void write_mini_screen(WriteTarget out) {
+    const miniComputerDataType& mini = globals()->gMiniScreenData;
+    write(out, mini.selectLine);
+    write(out, mini.pollTime);
+    write(out, mini.buildTimeBarValue);
+    write(out, mini.currentScreen);
+    write(out, mini.clickLine);
+    for (int32_t i = 0; i < kMiniScreenTrueLineNum; ++i) {
+        const miniScreenLineType& line = mini.lineData[i];
+        write_state_string(out, line.string);
+        write_state_string(out, line.statusFalse);
+        write_state_string(out, line.statusTrue);
+        write_state_string(out, line.statusString);
+        write_state_string(out, line.postString);
+        write(out, line.hiliteLeft);
+        write(out, line.hiliteRight);
+        write(out, line.whichButton);
+        write<int32_t>(out, line.selectable);
+        write<uint8_t>(out, line.underline);
+        write<int32_t>(out, line.lineKind);
+        write(out, line.value);
+        write(out, line.statusType);
+        write(out, line.whichStatus);
+        write(out, line.statusPlayer);
+        write(out, line.negativeValue);
+        write<int32_t>(out, GetBaseObjectIndex(line.sourceData));
+    }
+}
+
+void read_mini_screen(ReadSource in) {
+    miniComputerDataType& mini = globals()->gMiniScreenData;
+    read(in, mini.selectLine);
+    read(in, mini.pollTime);
+    read(in, mini.buildTimeBarValue);
+    read(in, mini.currentScreen);
+    read(in, mini.clickLine);
+    for (int32_t i = 0; i < kMiniScreenTrueLineNum; ++i) {
+        miniScreenLineType& line = mini.lineData[i];
+        line.string.assign(read_state_string(in));
+        line.statusFalse.assign(read_state_string(in));
+        line.statusTrue.assign(read_state_string(in));
+        line.statusString.assign(read_state_string(in));
+        line.postString.assign(read_state_string(in));
+        read(in, line.hiliteLeft);
+        read(in, line.hiliteRight);
+        read(in, line.whichButton);
+        line.selectable = static_cast<lineSelectType>(read<int32_t>(in));
+        line.underline = read<uint8_t>(in);
+        line.lineKind = static_cast<lineKindType>(read<int32_t>(in));
+        read(in, line.value);
+        read(in, line.statusType);
+        read(in, line.whichStatus);
+        read(in, line.statusPlayer);
+        read(in, line.negativeValue);
+        line.sourceData = mGetBaseObjectPtr(read<int32_t>(in));
+    }
+}
+
 }  // namespace antares
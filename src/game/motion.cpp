@@ -18,6 +18,8 @@
 
 #include "game/motion.hpp"
 
+#include <string.h>
+#include <algorithm>
 #include <sfz/sfz.hpp>
 
 #include "data/space-object.hpp"
@@ -36,7 +38,12 @@
 #include "sound/fx.hpp"
 
 using sfz::Exception;
+using std::fill;
+using std::lower_bound;
+using std::min;
+using std::pair;
 using std::unique_ptr;
+using std::vector;
 
 namespace antares {
 
@@ -71,8 +78,7 @@ static Point            cAdjacentUnits[] = {
     Point(1, 1)
 };
 
-coordPointType          gGlobalCorner;
-static unique_ptr<proximityUnitType[]> gProximityGrid;
+const int32_t kProximityUnitWords = kProximityGridDataLength / 64;
 
 // for the macro mRanged, time is assumed to be a int32_t game ticks, velocity a fixed, result int32_t, scratch fixed
 inline void mRange(int32_t& result, int32_t time, Fixed velocity, Fixed& scratch) {
@@ -81,6 +87,216 @@ inline void mRange(int32_t& result, int32_t time, Fixed velocity, Fixed& scratch
     result = mFixedToLong( scratch);
 }
 
+// Returns the first occupied unit after `unit`, or -1.  Units come back in ascending order,
+// which is the order the collision passes have always visited them in.
+static int32_t NextOccupiedUnit(const vector<uint64_t>& units, int32_t unit) {
+    ++unit;
+    int32_t word = unit / 64;
+    if (word >= kProximityUnitWords) {
+        return -1;
+    }
+    uint64_t used = units[word] & (~0ull << (unit % 64));
+    while (used == 0) {
+        if (++word == kProximityUnitWords) {
+            return -1;
+        }
+        used = units[word];
+    }
+    return (word * 64) + __builtin_ctzll(used);
+}
+
+// Empties the chains of the occupied units only; the rest are already empty.
+static void ClearProximityGrid() {
+    proximityUnitType* grid = globals()->gProximityGrid.get();
+    vector<uint64_t>& near_units = globals()->gNearUnits;
+    vector<uint64_t>& far_units = globals()->gFarUnits;
+    for (int32_t i = NextOccupiedUnit(near_units, -1); i >= 0; i = NextOccupiedUnit(near_units, i)) {
+        grid[i].nearObject = NULL;
+    }
+    for (int32_t i = NextOccupiedUnit(far_units, -1); i >= 0; i = NextOccupiedUnit(far_units, i)) {
+        grid[i].farObject = NULL;
+    }
+    fill(near_units.begin(), near_units.end(), 0);
+    fill(far_units.begin(), far_units.end(), 0);
+}
+
+void MarkAllProximityUnitsOccupied() {
+    fill(globals()->gNearUnits.begin(), globals()->gNearUnits.end(), ~0ull);
+    fill(globals()->gFarUnits.begin(), globals()->gFarUnits.end(), ~0ull);
+}
+
+int32_t CountOccupiedProximityUnits() {
+    int32_t count = 0;
+    for (int32_t i = 0; i < kProximityUnitWords; ++i) {
+        count += __builtin_popcountll(globals()->gNearUnits[i]);
+    }
+    return count;
+}
+
+typedef pair<uint64_t, spaceObjectType*> ProximityEntry;
+
+// Distance units are numbered row by row, so each row of them is a contiguous run of the index.
+static uint64_t ProximityKey(uint32_t h, uint32_t v) {
+    return (uint64_t(v >> kDistanceUnitBitShift) << 32) | (h >> kDistanceUnitBitShift);
+}
+
+static bool ProximityEntryBefore(const ProximityEntry& x, const ProximityEntry& y) {
+    return x.first < y.first;
+}
+
+static bool ProximityEntryBeforeKey(const ProximityEntry& entry, uint64_t key) {
+    return entry.first < key;
+}
+
+// Indexes the objects that the distance grid would hold, where they are now.  Queries build the
+// index the first time they need it after objects move, collide, or are added, so cycles without
+// queries don't pay for the sort.
+static const vector<ProximityEntry>& ProximityIndex() {
+    vector<ProximityEntry>& index = globals()->gProximityIndex;
+    if (globals()->gProximityIndexBuilt) {
+        return index;
+    }
+    index.clear();
+    for (int32_t i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i)) {
+        spaceObjectType* anObject = mGetSpaceObjectPtr(i);
+        if (anObject->active && (anObject->attributes & kConsiderDistanceAttributes)) {
+            const coordPointType& location = anObject->motion->location;
+            index.push_back(ProximityEntry(ProximityKey(location.h, location.v), anObject));
+        }
+    }
+    std::stable_sort(index.begin(), index.end(), ProximityEntryBefore);
+    globals()->gProximityIndexBuilt = true;
+    return index;
+}
+
+void InvalidateProximityIndex() {
+    globals()->gProximityIndexBuilt = false;
+}
+
+static bool ProximityMatches(
+        const spaceObjectType* asker, const spaceObjectType* candidate,
+        const ProximityFilter& filter) {
+    if ((candidate == asker) || !candidate->active) {
+        return false;
+    }
+    switch (filter.owner) {
+      case ProximityFilter::kAnyOwner:
+        break;
+      case ProximityFilter::kSameOwner:
+        if (candidate->owner != asker->owner) {
+            return false;
+        }
+        break;
+      case ProximityFilter::kOtherOwner:
+        if (candidate->owner == asker->owner) {
+            return false;
+        }
+        break;
+    }
+    if ((candidate->attributes & filter.allAttributes) != filter.allAttributes) {
+        return false;
+    }
+    if (filter.anyAttributes && !(candidate->attributes & filter.anyAttributes)) {
+        return false;
+    }
+    return (filter.accept == NULL) || filter.accept(asker, candidate);
+}
+
+// Calls `visit(object, distance)` on each object that matches `filter` and is closer than
+// `radius` to `asker`.  Only the distance units the radius overlaps are visited, so the cost
+// follows the number of objects nearby, not the number in the scenario.
+template <typename Visit>
+static void ForEachNearbyObject(
+        const spaceObjectType* asker, int32_t radius, const ProximityFilter& filter,
+        Visit visit) {
+    radius = min(radius, kMaximumRelevantDistance);
+    if (radius <= 0) {
+        return;
+    }
+    const vector<ProximityEntry>& index = ProximityIndex();
+    const coordPointType& at = asker->motion->location;
+    const uint32_t left = at.h - min<uint32_t>(at.h, radius);
+    const uint32_t top = at.v - min<uint32_t>(at.v, radius);
+    const uint32_t right = at.h + radius;
+    const uint32_t bottom = at.v + radius;
+    const uint32_t limit = uint32_t(radius) * uint32_t(radius);
+    for (uint64_t row = top >> kDistanceUnitBitShift; row <= (bottom >> kDistanceUnitBitShift);
+            ++row) {
+        const uint64_t first = (row << 32) | (left >> kDistanceUnitBitShift);
+        const uint64_t last = (row << 32) | (right >> kDistanceUnitBitShift);
+        auto it = lower_bound(index.begin(), index.end(), first, ProximityEntryBeforeKey);
+        for ( ; (it != index.end()) && (it->first <= last); ++it) {
+            spaceObjectType* candidate = it->second;
+            if (!ProximityMatches(asker, candidate, filter)) {
+                continue;
+            }
+            const uint32_t dh = ABS<int>(candidate->motion->location.h - at.h);
+            const uint32_t dv = ABS<int>(candidate->motion->location.v - at.v);
+            if ((dh >= uint32_t(radius)) || (dv >= uint32_t(radius))) {
+                continue;
+            }
+            const uint32_t distance = (dh * dh) + (dv * dv);
+            if (distance < limit) {
+                visit(candidate, distance);
+            }
+        }
+    }
+}
+
+static bool ProximityResultBefore(const ProximityResult& x, const ProximityResult& y) {
+    if (x.distance != y.distance) {
+        return x.distance < y.distance;
+    }
+    return x.object->entryNumber < y.object->entryNumber;
+}
+
+void FindObjectsInRadius(
+        const spaceObjectType* asker, int32_t radius, const ProximityFilter& filter,
+        vector<ProximityResult>& found) {
+    found.clear();
+    ForEachNearbyObject(asker, radius, filter,
+            [&found](spaceObjectType* object, uint32_t distance) {
+        ProximityResult result = {object, distance};
+        found.push_back(result);
+    });
+    std::sort(found.begin(), found.end(), ProximityResultBefore);
+}
+
+void FindNearestObjects(
+        const spaceObjectType* asker, size_t count, int32_t radius, const ProximityFilter& filter,
+        vector<ProximityResult>& found) {
+    found.clear();
+    ForEachNearbyObject(asker, radius, filter,
+            [&found](spaceObjectType* object, uint32_t distance) {
+        ProximityResult result = {object, distance};
+        found.push_back(result);
+    });
+    if (found.size() > count) {
+        std::partial_sort(
+                found.begin(), found.begin() + count, found.end(), ProximityResultBefore);
+        found.resize(count);
+    } else {
+        std::sort(found.begin(), found.end(), ProximityResultBefore);
+    }
+}
+
+spaceObjectType* FindNearestObject(
+        const spaceObjectType* asker, int32_t radius, const ProximityFilter& filter,
+        uint32_t* distance) {
+    ProximityResult nearest = {NULL, 0};
+    ForEachNearbyObject(asker, radius, filter,
+            [&nearest](spaceObjectType* object, uint32_t distance) {
+        ProximityResult result = {object, distance};
+        if ((nearest.object == NULL) || ProximityResultBefore(result, nearest)) {
+            nearest = result;
+        }
+    });
+    if (nearest.object != NULL) {
+        *distance = nearest.distance;
+    }
+    return nearest.object;
+}
+
 void InitMotion() {
     int16_t                 x, y, i;
     proximityUnitType       *p;
@@ -89,10 +305,12 @@ void InitMotion() {
     globals()->gCenterScaleH = (play_screen.width() / 2) * SCALE_SCALE;
     globals()->gCenterScaleV = (play_screen.height() / 2) * SCALE_SCALE;
 
-    gProximityGrid.reset(new proximityUnitType[kProximityGridDataLength]);
+    globals()->gProximityGrid.reset(new proximityUnitType[kProximityGridDataLength]);
+    globals()->gNearUnits.assign(kProximityUnitWords, 0);
+    globals()->gFarUnits.assign(kProximityUnitWords, 0);
 
     // initialize the proximityGrid & set up the needed lookups (see Notebook 2 p.34)
-    p = gProximityGrid.get();
+    p = globals()->gProximityGrid.get();
     for ( y = 0; y < kProximitySuperSize; y++)
     {
         for ( x = 0; x < kProximitySuperSize; x++)
@@ -145,346 +363,370 @@ void ResetMotionGlobals( void)
     proximityUnitType   *proximityObject;
     int32_t                i;
 
-    gGlobalCorner.h = gGlobalCorner.v = 0;
+    globals()->gGlobalCorner.h = globals()->gGlobalCorner.v = 0;
     globals()->gClosestObject = 0;
     globals()->gFarthestObject = 0;
 
-    proximityObject = gProximityGrid.get();
+    proximityObject = globals()->gProximityGrid.get();
     for ( i = 0; i < kProximityGridDataLength; i++)
     {
         proximityObject->nearObject = proximityObject->farObject = NULL;
         proximityObject++;
     }
+    fill(globals()->gNearUnits.begin(), globals()->gNearUnits.end(), 0);
+    fill(globals()->gFarUnits.begin(), globals()->gFarUnits.end(), 0);
+    globals()->gProximityIndex.clear();
+    InvalidateProximityIndex();
 }
 
 void MotionCleanup() {
-    gProximityGrid.reset();
+    globals()->gProximityGrid.reset();
+    globals()->gProximityIndex.clear();
+    InvalidateProximityIndex();
 }
 
-void MoveSpaceObjects(const int32_t unitsToDo) {
-    int32_t                    i, h, v, jl;
+// Advances a single object by one unit.  Apart from beams, which follow the objects at their
+// ends, this reads and writes only the object's own state.
+static void MoveSpaceObject(spaceObjectType* anObject, spaceObjectMotionType* motion) {
+    int32_t                 i, h, v;
     Fixed                   fh, fv, fa, fb, useThrust;
     Fixed                   aFixed;
     int16_t                 angle;
-    uint32_t                shortDist, thisDist, longDist;
-    spaceObjectType         *anObject;
-    baseObjectType          *baseObject;
+    baseObjectType          *baseObject = anObject->baseType;
 
-    if ( unitsToDo == 0) return;
-
-    for ( jl = 0; jl < unitsToDo; jl++)
+//              if  ( !( anObject->attributes & kIsStationary))
+    if (( motion->maxVelocity != 0) || ( anObject->attributes & kCanTurn))
     {
-        anObject = gRootObject;
-        while ( anObject != NULL)
+        if ( anObject->attributes & kCanTurn)
+        {
+            motion->turnFraction += motion->turnVelocity;
+
+            if ( motion->turnFraction >= 0)
+                h = more_evil_fixed_to_long(motion->turnFraction + mFloatToFixed(0.5));
+            else
+                h = more_evil_fixed_to_long(motion->turnFraction - mFloatToFixed(0.5)) + 1;
+            motion->direction += h;
+            motion->turnFraction -= mLongToFixed(h);
+
+            while ( motion->direction >= ROT_POS)
+                motion->direction -= ROT_POS;
+            while ( motion->direction < 0)
+                motion->direction += ROT_POS;
+        }
+
+        if ( motion->thrust != 0)
         {
-            if ( anObject->active == kObjectInUse)
+            if ( motion->thrust > 0)
             {
-                baseObject = anObject->baseType;
+                // get the goal dh & dv
 
-//              if  ( !( anObject->attributes & kIsStationary))
-                if (( anObject->maxVelocity != 0) || ( anObject->attributes & kCanTurn))
+                GetRotPoint(&fa, &fb, motion->direction);
+
+                // multiply by max velocity
+
+                if (/*( anObject->presenceState == kWarpInPresence) ||*/
+                    ( anObject->presenceState == kWarpingPresence) ||
+                    ( anObject->presenceState == kWarpOutPresence))
                 {
-                    if ( anObject->attributes & kCanTurn)
-                    {
-                        anObject->turnFraction += anObject->turnVelocity;
+                    fa = mMultiplyFixed( fa, anObject->presenceData);
+                    fb = mMultiplyFixed( fb, anObject->presenceData);
+                } else
+                {
+                    fa = mMultiplyFixed( motion->maxVelocity, fa);
+                    fb = mMultiplyFixed( motion->maxVelocity, fb);
+                }
 
-                        if ( anObject->turnFraction >= 0)
-                            h = more_evil_fixed_to_long(anObject->turnFraction + mFloatToFixed(0.5));
-                        else
-                            h = more_evil_fixed_to_long(anObject->turnFraction - mFloatToFixed(0.5)) + 1;
-                        anObject->direction += h;
-                        anObject->turnFraction -= mLongToFixed(h);
-
-                        while ( anObject->direction >= ROT_POS)
-                            anObject->direction -= ROT_POS;
-                        while ( anObject->direction < 0)
-                            anObject->direction += ROT_POS;
-                    }
+                // the difference between our actual vector and our goal vector is our new vector
 
-                    if ( anObject->thrust != 0)
-                    {
-                        if ( anObject->thrust > 0)
-                        {
-                            // get the goal dh & dv
+                fa = fa - motion->velocity.h;
+                fb = fb - motion->velocity.v;
 
-                            GetRotPoint(&fa, &fb, anObject->direction);
+                useThrust = motion->thrust;
+            } else
+            {
+                fa = -motion->velocity.h;
+                fb = -motion->velocity.v;
+//                              useThrust = -(anObject->thrust>>1L);
+                useThrust = -motion->thrust;
+            }
 
-                            // multiply by max velocity
+            // get the angle of our new vector
 
-                            if (/*( anObject->presenceState == kWarpInPresence) ||*/
-                                ( anObject->presenceState == kWarpingPresence) ||
-                                ( anObject->presenceState == kWarpOutPresence))
-                            {
-                                fa = mMultiplyFixed( fa, anObject->presenceData);
-                                fb = mMultiplyFixed( fb, anObject->presenceData);
-                            } else
-                            {
-                                fa = mMultiplyFixed( anObject->maxVelocity, fa);
-                                fb = mMultiplyFixed( anObject->maxVelocity, fb);
-                            }
+            if ( fa == 0)
+            {
+                if ( fb < 0)
+                    angle = 180;
+                else angle = 0;
+            } else
+            {
+                aFixed = MyFixRatio(fa, fb);
 
-                            // the difference between our actual vector and our goal vector is our new vector
+                angle = AngleFromSlope( aFixed);
+                if ( fa > 0) angle += 180;
+                if ( angle >= 360) angle -= 360;
+            }
 
-                            fa = fa - anObject->velocity.h;
-                            fb = fb - anObject->velocity.v;
+            // get the maxthrust of new vector
 
-                            useThrust = anObject->thrust;
-                        } else
-                        {
-                            fa = -anObject->velocity.h;
-                            fb = -anObject->velocity.v;
-//                              useThrust = -(anObject->thrust>>1L);
-                            useThrust = -anObject->thrust;
-                        }
+            GetRotPoint(&fh, &fv, angle);
 
-                        // get the angle of our new vector
+            fh = mMultiplyFixed( useThrust, fh);
+            fv = mMultiplyFixed( useThrust, fv);
 
-                        if ( fa == 0)
-                        {
-                            if ( fb < 0)
-                                angle = 180;
-                            else angle = 0;
-                        } else
-                        {
-                            aFixed = MyFixRatio(fa, fb);
+            // if our new vector excedes our max thrust, it must be limited
 
-                            angle = AngleFromSlope( aFixed);
-                            if ( fa > 0) angle += 180;
-                            if ( angle >= 360) angle -= 360;
-                        }
+            if ( fh < 0)
+            {
+                if ( fa < fh)
+                    fa = fh;
+            } else
+            {
+                if ( fa > fh)
+                    fa = fh;
+            }
 
-                        // get the maxthrust of new vector
+            if ( fv < 0)
+            {
+                if ( fb < fv)
+                    fb = fv;
+            } else
+            {
+                if ( fb > fv)
+                    fb = fv;
+            }
 
-                        GetRotPoint(&fh, &fv, angle);
+            motion->velocity.h += fa;
+            motion->velocity.v += fb;
 
-                        fh = mMultiplyFixed( useThrust, fh);
-                        fv = mMultiplyFixed( useThrust, fv);
+        }
 
-                        // if our new vector excedes our max thrust, it must be limited
+        motion->motionFraction.h += motion->velocity.h;
+        motion->motionFraction.v += motion->velocity.v;
 
-                        if ( fh < 0)
-                        {
-                            if ( fa < fh)
-                                fa = fh;
-                        } else
-                        {
-                            if ( fa > fh)
-                                fa = fh;
-                        }
+        if ( motion->motionFraction.h >= 0)
+            h = more_evil_fixed_to_long(motion->motionFraction.h + mFloatToFixed(0.5));
+        else
+            h = more_evil_fixed_to_long(motion->motionFraction.h - mFloatToFixed(0.5)) + 1;
+        motion->location.h -= h;
+        motion->motionFraction.h -= mLongToFixed(h);
 
-                        if ( fv < 0)
-                        {
-                            if ( fb < fv)
-                                fb = fv;
-                        } else
-                        {
-                            if ( fb > fv)
-                                fb = fv;
-                        }
+        if ( motion->motionFraction.v >= 0)
+            v = more_evil_fixed_to_long(motion->motionFraction.v + mFloatToFixed(0.5));
+        else
+            v = more_evil_fixed_to_long(motion->motionFraction.v - mFloatToFixed(0.5)) + 1;
+        motion->location.v -= v;
+        motion->motionFraction.v -= mLongToFixed(v);
 
-                        anObject->velocity.h += fa;
-                        anObject->velocity.v += fb;
+    } // if ( object is not stationary)
 
-                    }
+//              if ( anObject->attributes & kIsPlayerShip)
+    if ( anObject == globals()->gScrollStarObject)
+    {
+        globals()->gGlobalCorner.h = motion->location.h - (globals()->gCenterScaleH / globals()->gAbsoluteScale);
+        globals()->gGlobalCorner.v = motion->location.v - (globals()->gCenterScaleV / globals()->gAbsoluteScale);
+    }
 
-                    anObject->motionFraction.h += anObject->velocity.h;
-                    anObject->motionFraction.v += anObject->velocity.v;
+    // check to see if it's out of bounds
 
-                    if ( anObject->motionFraction.h >= 0)
-                        h = more_evil_fixed_to_long(anObject->motionFraction.h + mFloatToFixed(0.5));
-                    else
-                        h = more_evil_fixed_to_long(anObject->motionFraction.h - mFloatToFixed(0.5)) + 1;
-                    anObject->location.h -= h;
-                    anObject->motionFraction.h -= mLongToFixed(h);
+    {
+        if ( !(anObject->attributes & kDoesBounce))
+        {
+            if (( motion->location.h < kThinkiverseTopLeft) ||
+                ( motion->location.v < kThinkiverseTopLeft) ||
+                ( motion->location.h > kThinkiverseBottomRight) ||
+                ( motion->location.v > kThinkiverseBottomRight))
+            {
+                anObject->active = kObjectToBeFreed;
+            }
+        } else
+        {
+            if ( motion->location.h < kThinkiverseTopLeft)
+            {
+                motion->location.h = kThinkiverseTopLeft;
+                motion->velocity.h = -motion->velocity.h;
+            } else if ( motion->location.h > kThinkiverseBottomRight)
+            {
+                motion->location.h = kThinkiverseBottomRight;
+                motion->velocity.h = -motion->velocity.h;
+            }
+            if ( motion->location.v < kThinkiverseTopLeft)
+            {
+                motion->location.v = kThinkiverseTopLeft;
+                motion->velocity.v = -motion->velocity.v;
+            } else if ( motion->location.v > kThinkiverseBottomRight)
+            {
+                motion->location.v = kThinkiverseBottomRight;
+                motion->velocity.v = -motion->velocity.v;
+            }
 
-                    if ( anObject->motionFraction.v >= 0)
-                        v = more_evil_fixed_to_long(anObject->motionFraction.v + mFloatToFixed(0.5));
-                    else
-                        v = more_evil_fixed_to_long(anObject->motionFraction.v - mFloatToFixed(0.5)) + 1;
-                    anObject->location.v -= v;
-                    anObject->motionFraction.v -= mLongToFixed(v);
+        }
+    }
 
-                } // if ( object is not stationary)
+    // deal with self-animating shapes
+    if ( anObject->attributes & kIsSelfAnimated)
+    {
+        if ( baseObject->frame.animation.frameSpeed != 0)
+        {
+            anObject->frame.animation.thisShape +=
+                anObject->frame.animation.frameDirection *
+                anObject->frame.animation.frameSpeed;// * unitsToDo;
+
+            i = 1;
+            while (( anObject->frame.animation.thisShape >
+                baseObject->frame.animation.lastShape) &&
+                ( anObject->frame.animation.frameDirection > 0) &&
+                ( i))
+            {
+                if ( anObject->attributes & kAnimationCycle)
+                {
+                    anObject->frame.animation.thisShape -=
+                        ( baseObject->frame.animation.lastShape -
+                        baseObject->frame.animation.firstShape) +
+                        1;
 
-//              if ( anObject->attributes & kIsPlayerShip)
-                if ( anObject == gScrollStarObject)
+                } else
                 {
-                    gGlobalCorner.h = anObject->location.h - (globals()->gCenterScaleH / gAbsoluteScale);
-                    gGlobalCorner.v = anObject->location.v - (globals()->gCenterScaleV / gAbsoluteScale);
+                    i = 0;
+                    anObject->active = kObjectToBeFreed;
+                    anObject->frame.animation.thisShape =
+                        baseObject->frame.animation.lastShape;
                 }
+            }
 
-                // check to see if it's out of bounds
+            while (( anObject->frame.animation.thisShape <
+                baseObject->frame.animation.firstShape) &&
+                ( anObject->frame.animation.frameDirection < 0) &&
+                ( i))
+            {
+                if ( anObject->attributes & kAnimationCycle)
+                {
+                    anObject->frame.animation.thisShape +=
+                        ( baseObject->frame.animation.lastShape -
+                        baseObject->frame.animation.firstShape) + 1;
 
+                } else
+                {
+                    i = 0;
+                    anObject->active = kObjectToBeFreed;
+                    anObject->frame.animation.thisShape = baseObject->frame.animation.lastShape;
+                }
+            }
+        }
+    } else if ( anObject->attributes & kIsBeam)
+    {
+        if ( anObject->frame.beam.beam != NULL)
+        {
+            anObject->frame.beam.beam->objectLocation =
+                motion->location;
+            if (( anObject->frame.beam.beam->beamKind ==
+                    eStaticObjectToObjectKind) ||
+                    ( anObject->frame.beam.beam->beamKind ==
+                    eBoltObjectToObjectKind))
+            {
+                if ( anObject->frame.beam.beam->toObject != NULL)
                 {
-                    if ( !(anObject->attributes & kDoesBounce))
+                    spaceObjectType *target =
+                        anObject->frame.beam.beam->toObject;
+
+                    if ((target->active) &&
+                        (target->id == anObject->frame.beam.beam->toObjectID))
                     {
-                        if (( anObject->location.h < kThinkiverseTopLeft) ||
-                            ( anObject->location.v < kThinkiverseTopLeft) ||
-                            ( anObject->location.h > kThinkiverseBottomRight) ||
-                            ( anObject->location.v > kThinkiverseBottomRight))
-                        {
-                            anObject->active = kObjectToBeFreed;
-                        }
+                        motion->location =
+                            anObject->frame.beam.beam->objectLocation =
+                                target->motion->location;
                     } else
                     {
-                        if ( anObject->location.h < kThinkiverseTopLeft)
-                        {
-                            anObject->location.h = kThinkiverseTopLeft;
-                            anObject->velocity.h = -anObject->velocity.h;
-                        } else if ( anObject->location.h > kThinkiverseBottomRight)
-                        {
-                            anObject->location.h = kThinkiverseBottomRight;
-                            anObject->velocity.h = -anObject->velocity.h;
-                        }
-                        if ( anObject->location.v < kThinkiverseTopLeft)
-                        {
-                            anObject->location.v = kThinkiverseTopLeft;
-                            anObject->velocity.v = -anObject->velocity.v;
-                        } else if ( anObject->location.v > kThinkiverseBottomRight)
-                        {
-                            anObject->location.v = kThinkiverseBottomRight;
-                            anObject->velocity.v = -anObject->velocity.v;
-                        }
-
+                        anObject->active = kObjectToBeFreed;
                     }
                 }
 
-                // deal with self-animating shapes
-                if ( anObject->attributes & kIsSelfAnimated)
+                if ( anObject->frame.beam.beam->fromObject != NULL)
                 {
-                    if ( baseObject->frame.animation.frameSpeed != 0)
-                    {
-                        anObject->frame.animation.thisShape +=
-                            anObject->frame.animation.frameDirection *
-                            anObject->frame.animation.frameSpeed;// * unitsToDo;
-
-                        i = 1;
-                        while (( anObject->frame.animation.thisShape >
-                            baseObject->frame.animation.lastShape) &&
-                            ( anObject->frame.animation.frameDirection > 0) &&
-                            ( i))
-                        {
-                            if ( anObject->attributes & kAnimationCycle)
-                            {
-                                anObject->frame.animation.thisShape -=
-                                    ( baseObject->frame.animation.lastShape -
-                                    baseObject->frame.animation.firstShape) +
-                                    1;
-
-                            } else
-                            {
-                                i = 0;
-                                anObject->active = kObjectToBeFreed;
-                                anObject->frame.animation.thisShape =
-                                    baseObject->frame.animation.lastShape;
-                            }
-                        }
+                    spaceObjectType *target =
+                        anObject->frame.beam.beam->fromObject;
 
-                        while (( anObject->frame.animation.thisShape <
-                            baseObject->frame.animation.firstShape) &&
-                            ( anObject->frame.animation.frameDirection < 0) &&
-                            ( i))
-                        {
-                            if ( anObject->attributes & kAnimationCycle)
-                            {
-                                anObject->frame.animation.thisShape +=
-                                    ( baseObject->frame.animation.lastShape -
-                                    baseObject->frame.animation.firstShape) + 1;
+                    if ((target->active) &&
+                        ( target->id == anObject->frame.beam.beam->fromObjectID))
 
-                            } else
-                            {
-                                i = 0;
-                                anObject->active = kObjectToBeFreed;
-                                anObject->frame.animation.thisShape = baseObject->frame.animation.lastShape;
-                            }
-                        }
+                    {
+                        anObject->frame.beam.beam->lastGlobalLocation =
+                            anObject->frame.beam.beam->lastApparentLocation =
+                                target->motion->location;
+                    } else
+                    {
+                        anObject->active = kObjectToBeFreed;
                     }
-                } else if ( anObject->attributes & kIsBeam)
+                }
+            } else if (( anObject->frame.beam.beam->beamKind ==
+                    eStaticObjectToRelativeCoordKind) ||
+                    ( anObject->frame.beam.beam->beamKind ==
+                    eBoltObjectToRelativeCoordKind))
+            {
+                if ( anObject->frame.beam.beam->fromObject != NULL)
                 {
-                    if ( anObject->frame.beam.beam != NULL)
-                    {
-                        anObject->frame.beam.beam->objectLocation =
-                            anObject->location;
-                        if (( anObject->frame.beam.beam->beamKind ==
-                                eStaticObjectToObjectKind) ||
-                                ( anObject->frame.beam.beam->beamKind ==
-                                eBoltObjectToObjectKind))
-                        {
-                            if ( anObject->frame.beam.beam->toObject != NULL)
-                            {
-                                spaceObjectType *target =
-                                    anObject->frame.beam.beam->toObject;
+                    spaceObjectType *target =
+                        anObject->frame.beam.beam->fromObject;
 
-                                if ((target->active) &&
-                                    (target->id == anObject->frame.beam.beam->toObjectID))
-                                {
-                                    anObject->location =
-                                        anObject->frame.beam.beam->objectLocation =
-                                            target->location;
-                                } else
-                                {
-                                    anObject->active = kObjectToBeFreed;
-                                }
-                            }
+                    if (( target->active) &&
+                        ( target->id == anObject->frame.beam.beam->fromObjectID))
+                    {
+                        anObject->frame.beam.beam->lastGlobalLocation =
+                            anObject->frame.beam.beam->lastApparentLocation =
+                                target->motion->location;
+
+                        motion->location.h =
+                            anObject->frame.beam.beam->objectLocation.h =
+                            target->motion->location.h +
+                            anObject->frame.beam.beam->toRelativeCoord.h;
+
+                        motion->location.v =
+                            anObject->frame.beam.beam->objectLocation.v =
+                            target->motion->location.v +
+                            anObject->frame.beam.beam->toRelativeCoord.v;
+                    } else
+                    {
+                        anObject->active = kObjectToBeFreed;
+                    }
+                }
+            } else
+            {
+//              anObject->frame.beam.beam->endLocation
+            }
+        } else {
+            throw Exception( "Unexpected error: a beam appears to be missing.");
+        }
+    }
+}
 
-                            if ( anObject->frame.beam.beam->fromObject != NULL)
-                            {
-                                spaceObjectType *target =
-                                    anObject->frame.beam.beam->fromObject;
+void MoveSpaceObjects(const int32_t unitsToDo) {
+    int32_t                    i, h, jl;
+    int16_t                 angle;
+    uint32_t                shortDist, thisDist, longDist;
+    spaceObjectType         *anObject;
+    baseObjectType          *baseObject;
 
-                                if ((target->active) &&
-                                    ( target->id == anObject->frame.beam.beam->fromObjectID))
+    if ( unitsToDo == 0) return;
+    InvalidateProximityIndex();
 
-                                {
-                                    anObject->frame.beam.beam->lastGlobalLocation =
-                                        anObject->frame.beam.beam->lastApparentLocation =
-                                            target->location;
-                                } else
-                                {
-                                    anObject->active = kObjectToBeFreed;
-                                }
-                            }
-                        } else if (( anObject->frame.beam.beam->beamKind ==
-                                eStaticObjectToRelativeCoordKind) ||
-                                ( anObject->frame.beam.beam->beamKind ==
-                                eBoltObjectToRelativeCoordKind))
-                        {
-                            if ( anObject->frame.beam.beam->fromObject != NULL)
-                            {
-                                spaceObjectType *target =
-                                    anObject->frame.beam.beam->fromObject;
+    spaceObjectType* const objects = mGetSpaceObjectPtr(0);
+    spaceObjectMotionType* const motions = mGetSpaceObjectMotionPtr(0);
 
-                                if (( target->active) &&
-                                    ( target->id == anObject->frame.beam.beam->fromObjectID))
-                                {
-                                    anObject->frame.beam.beam->lastGlobalLocation =
-                                        anObject->frame.beam.beam->lastApparentLocation =
-                                            target->location;
-
-                                    anObject->location.h =
-                                        anObject->frame.beam.beam->objectLocation.h =
-                                        target->location.h +
-                                        anObject->frame.beam.beam->toRelativeCoord.h;
-
-                                    anObject->location.v =
-                                        anObject->frame.beam.beam->objectLocation.v =
-                                        target->location.v +
-                                        anObject->frame.beam.beam->toRelativeCoord.v;
-                                } else
-                                {
-                                    anObject->active = kObjectToBeFreed;
-                                }
-                            }
-                        } else
-                        {
-    //                      anObject->frame.beam.beam->endLocation
-                        }
-                    } else {
-                        throw Exception( "Unexpected error: a beam appears to be missing.");
-                    }
-                }
-            } // if (anObject->active)
-            anObject = anObject->nextObject;
+    for ( jl = 0; jl < unitsToDo; jl++)
+    {
+        // A beam is always newer than the objects at its ends, so it came before them in the
+        // (newest-first) object list and saw where they were before they moved.  Moving beams
+        // first keeps that, and leaves everything else free to move in slot order.
+        for ( i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i))
+        {
+            anObject = objects + i;
+            if (( anObject->active == kObjectInUse) && ( anObject->attributes & kIsBeam))
+                MoveSpaceObject( anObject, motions + i);
+        }
+        for ( i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i))
+        {
+            anObject = objects + i;
+            if (( anObject->active == kObjectInUse) && !( anObject->attributes & kIsBeam))
+                MoveSpaceObject( anObject, motions + i);
         }
     }
 
@@ -496,24 +738,24 @@ void MoveSpaceObjects(const int32_t unitsToDo) {
 //  globals()->gClosestObject = 0;
 //  globals()->gFarthestObject = 0;
     longDist = 0;
-    anObject = gRootObject;
 
-    while ( anObject != NULL)
+    for ( i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i))
     {
+        anObject = objects + i;
         if ( anObject->active == kObjectInUse)
         {
             baseObject = anObject->baseType;
 
             if ( !(anObject->attributes & kIsBeam) && ( anObject->sprite != NULL))
             {
-                h = ( anObject->location.h - gGlobalCorner.h) * gAbsoluteScale;
+                h = ( anObject->motion->location.h - globals()->gGlobalCorner.h) * globals()->gAbsoluteScale;
                 h >>= SHIFT_SCALE;
                 if (( h > -kSpriteMaxSize) && ( h < kSpriteMaxSize))
                     anObject->sprite->where.h = h + viewport.left;
                 else
                     anObject->sprite->where.h = -kSpriteMaxSize;
 
-                h = (anObject->location.v - gGlobalCorner.v) * gAbsoluteScale;
+                h = (anObject->motion->location.v - globals()->gGlobalCorner.v) * globals()->gAbsoluteScale;
                 h >>= SHIFT_SCALE; /*+ CLIP_TOP*/;
                 if (( h > -kSpriteMaxSize) && ( h < kSpriteMaxSize))
                     anObject->sprite->where.v = h;
@@ -582,25 +824,27 @@ void MoveSpaceObjects(const int32_t unitsToDo) {
                     }
                 } else if ( anObject->attributes & kShapeFromDirection)
                 {
-                    angle = anObject->direction;
+                    angle = anObject->motion->direction;
                     mAddAngle( angle, baseObject->frame.rotation.rotRes >> 1);
                     anObject->sprite->whichShape = angle / baseObject->frame.rotation.rotRes;
                 }
             }
         }
-        anObject = anObject->nextObject;
     }
 }
 
 void CollideSpaceObjects() {
     spaceObjectType         *sObject = NULL, *dObject = NULL, *aObject = NULL, *bObject = NULL,
                             *player = NULL, *taObject, *tbObject;
-    int32_t                    i = 0, j = 0, k, xs, xe, ys, ye, xd, yd, superx, supery, scaleCalc, difference;
+    int32_t                    i, k, unit, xs, xe, ys, ye, xd, yd, superx, supery, scaleCalc, difference;
     int16_t                 cs, ce;
     bool                 beamHit;
     uint32_t                distance, dcalc/*,
                             closestDist = kMaximumRelevantDistanceSquared + kMaximumRelevantDistanceSquared*/;
     proximityUnitType       *proximityObject, *currentProximity;
+    proximityUnitType* const grid = globals()->gProximityGrid.get();
+    vector<uint64_t>& near_units = globals()->gNearUnits;
+    vector<uint64_t>& far_units = globals()->gFarUnits;
 
     int32_t                    magicHack1 = 0, magicHack2 = 0, magicHack3 = 0;
     uint64_t                farthestDist, hugeDistance, wideScrap, closestDist;
@@ -615,14 +859,9 @@ void CollideSpaceObjects() {
     globals()->gFarthestObject = 0;
 
     // reset the collision grid
-    proximityObject = gProximityGrid.get();
-    for ( i = 0; i < kProximityGridDataLength; i++)
-    {
-        proximityObject->nearObject = proximityObject->farObject = NULL;
-        proximityObject++;
-    }
+    ClearProximityGrid();
 
-    aObject = gRootObject;
+    aObject = globals()->gRootObject;
     if ( aObject == NULL) {
         throw Exception("no objects");
     }
@@ -671,9 +910,9 @@ void CollideSpaceObjects() {
         {
             if (aObject->attributes & kAppearOnRadar)
             {
-                difference = ABS<int>( player->location.h - aObject->location.h);
+                difference = ABS<int>( player->motion->location.h - aObject->motion->location.h);
                 dcalc = difference;
-                difference =  ABS<int>( player->location.v - aObject->location.v);
+                difference =  ABS<int>( player->motion->location.v - aObject->motion->location.v);
                 distance = difference;
 
                 if (( dcalc > kMaximumRelevantDistance) ||
@@ -692,7 +931,7 @@ void CollideSpaceObjects() {
                     /*
                     if ( distance < closestDist)
                     {
-                        if (( aObject != gScrollStarObject) && (( globals()->gZoomMode != kNearestFoeZoom)
+                        if (( aObject != globals()->gScrollStarObject) && (( globals()->gZoomMode != kNearestFoeZoom)
                             || ( aObject->owner != player->owner)))
                         {
                             closestDist = distance;
@@ -703,7 +942,7 @@ void CollideSpaceObjects() {
                     */
                 }
                 if (closestDist > hugeDistance) {
-                    if (( aObject != gScrollStarObject) && (( globals()->gZoomMode != kNearestFoeZoom)
+                    if (( aObject != globals()->gScrollStarObject) && (( globals()->gZoomMode != kNearestFoeZoom)
                         || ( aObject->owner != player->owner)))
                     {
                         closestDist = hugeDistance;
@@ -729,19 +968,21 @@ void CollideSpaceObjects() {
             aObject->absoluteBounds.right = aObject->absoluteBounds.left = 0;
 
             // xs = collision unit, xe = super unit
-            xs = aObject->location.h;
+            xs = aObject->motion->location.h;
             xs >>= kCollisionUnitBitShift;
             xe = xs >> kCollisionSuperExtraShift;
             xs &= kProximityUnitAndModulo;
 
-            ys = aObject->location.v;
+            ys = aObject->motion->location.v;
             ys >>= kCollisionUnitBitShift;
             ye = ys >> kCollisionSuperExtraShift;
             ys &= kProximityUnitAndModulo;
 
-            proximityObject = gProximityGrid.get() + (ys << kProximityWidthMultiply) + xs;
+            unit = (ys << kProximityWidthMultiply) + xs;
+            proximityObject = grid + unit;
             aObject->nextNearObject = proximityObject->nearObject;
             proximityObject->nearObject = aObject;
+            near_units[unit / 64] |= 1ull << (unit % 64);
             aObject->collisionGrid.h = xe;
             aObject->collisionGrid.v = ye;
 
@@ -753,9 +994,11 @@ void CollideSpaceObjects() {
             ys = ye >> kDistanceSuperExtraShift;
             ye &= kProximityUnitAndModulo;
 
-            proximityObject = gProximityGrid.get() + (ye << kProximityWidthMultiply) + xe;
+            unit = (ye << kProximityWidthMultiply) + xe;
+            proximityObject = grid + unit;
             aObject->nextFarObject = proximityObject->farObject;
             proximityObject->farObject = aObject;
+            far_units[unit / 64] |= 1ull << (unit % 64);
             aObject->distanceGrid.h = xs;
             aObject->distanceGrid.v = ys;
 
@@ -786,406 +1029,398 @@ void CollideSpaceObjects() {
         aObject = aObject->nextObject;
     }
 
-    proximityObject = gProximityGrid.get();
-    for ( j = 0; j < kProximitySuperSize; j++)
+    for ( unit = NextOccupiedUnit(near_units, -1); unit >= 0; unit = NextOccupiedUnit(near_units, unit))
     {
-        for ( i = 0; i < kProximitySuperSize; i++)
+        proximityObject = grid + unit;
+        aObject = proximityObject->nearObject;
+        while ( aObject != NULL)
         {
-            aObject = proximityObject->nearObject;
-            while ( aObject != NULL)
+            taObject = aObject->nextNearObject;
+
+            // this hack is to get the current bounds of the object in question
+            // it could be sped up by accessing the sprite table directly
+            if ((aObject->absoluteBounds.left >= aObject->absoluteBounds.right)
+                    && (aObject->sprite != NULL)) {
+                const NatePixTable::Frame& frame
+                    = aObject->sprite->table->at(aObject->sprite->whichShape);
+
+                scaleCalc = (frame.width() * aObject->naturalScale);
+                scaleCalc >>= SHIFT_SCALE;
+                aObject->scaledSize.h = scaleCalc;
+                scaleCalc = (frame.height() * aObject->naturalScale);
+                scaleCalc >>= SHIFT_SCALE;
+                aObject->scaledSize.v = scaleCalc;
+
+                scaleCalc = frame.center().h * aObject->naturalScale;
+                scaleCalc >>= SHIFT_SCALE;
+                aObject->scaledCornerOffset.h = -scaleCalc;
+                scaleCalc = frame.center().v * aObject->naturalScale;
+                scaleCalc >>= SHIFT_SCALE;
+                aObject->scaledCornerOffset.v = -scaleCalc;
+
+                aObject->absoluteBounds.left = aObject->motion->location.h +
+                                            aObject->scaledCornerOffset.h;
+                aObject->absoluteBounds.right = aObject->absoluteBounds.left +
+                                            aObject->scaledSize.h;
+                aObject->absoluteBounds.top = aObject->motion->location.v +
+                                            aObject->scaledCornerOffset.v;
+                aObject->absoluteBounds.bottom = aObject->absoluteBounds.top +
+                                            aObject->scaledSize.v;
+            }
+
+            currentProximity = proximityObject;
+            for ( k = 0; k < kUnitsToCheckNumber; k++)
             {
-                taObject = aObject->nextNearObject;
-
-                // this hack is to get the current bounds of the object in question
-                // it could be sped up by accessing the sprite table directly
-                if ((aObject->absoluteBounds.left >= aObject->absoluteBounds.right)
-                        && (aObject->sprite != NULL)) {
-                    const NatePixTable::Frame& frame
-                        = aObject->sprite->table->at(aObject->sprite->whichShape);
-
-                    scaleCalc = (frame.width() * aObject->naturalScale);
-                    scaleCalc >>= SHIFT_SCALE;
-                    aObject->scaledSize.h = scaleCalc;
-                    scaleCalc = (frame.height() * aObject->naturalScale);
-                    scaleCalc >>= SHIFT_SCALE;
-                    aObject->scaledSize.v = scaleCalc;
-
-                    scaleCalc = frame.center().h * aObject->naturalScale;
-                    scaleCalc >>= SHIFT_SCALE;
-                    aObject->scaledCornerOffset.h = -scaleCalc;
-                    scaleCalc = frame.center().v * aObject->naturalScale;
-                    scaleCalc >>= SHIFT_SCALE;
-                    aObject->scaledCornerOffset.v = -scaleCalc;
-
-                    aObject->absoluteBounds.left = aObject->location.h +
-                                                aObject->scaledCornerOffset.h;
-                    aObject->absoluteBounds.right = aObject->absoluteBounds.left +
-                                                aObject->scaledSize.h;
-                    aObject->absoluteBounds.top = aObject->location.v +
-                                                aObject->scaledCornerOffset.v;
-                    aObject->absoluteBounds.bottom = aObject->absoluteBounds.top +
-                                                aObject->scaledSize.v;
+                if ( k == 0)
+                {
+                    bObject = aObject->nextNearObject;
+                    superx = aObject->collisionGrid.h;
+                    supery = aObject->collisionGrid.v;
                 }
-
-                currentProximity = proximityObject;
-                for ( k = 0; k < kUnitsToCheckNumber; k++)
+                else
                 {
-                    if ( k == 0)
+                    if (( proximityObject->unitsToCheck[k].adjacentUnit > 256) ||
+                        ( proximityObject->unitsToCheck[k].adjacentUnit < -256))
                     {
-                        bObject = aObject->nextNearObject;
-                        superx = aObject->collisionGrid.h;
-                        supery = aObject->collisionGrid.v;
+                        throw Exception(
+                                "Internal error occurred during processing of adjacent "
+                                "proximity units");
                     }
-                    else
-                    {
-                        if (( proximityObject->unitsToCheck[k].adjacentUnit > 256) ||
-                            ( proximityObject->unitsToCheck[k].adjacentUnit < -256))
-                        {
-                            throw Exception(
-                                    "Internal error occurred during processing of adjacent "
-                                    "proximity units");
-                        }
-                        currentProximity += proximityObject->unitsToCheck[k].adjacentUnit;
-                        bObject = currentProximity->nearObject;
-                        superx = aObject->collisionGrid.h + proximityObject->unitsToCheck[k].superOffset.h;
-                        supery = aObject->collisionGrid.v + proximityObject->unitsToCheck[k].superOffset.v;
-                    }
-                    if (( superx >= 0) && ( supery >= 0))
+                    currentProximity += proximityObject->unitsToCheck[k].adjacentUnit;
+                    bObject = currentProximity->nearObject;
+                    superx = aObject->collisionGrid.h + proximityObject->unitsToCheck[k].superOffset.h;
+                    supery = aObject->collisionGrid.v + proximityObject->unitsToCheck[k].superOffset.v;
+                }
+                if (( superx >= 0) && ( supery >= 0))
+                {
+                    while ( bObject != NULL)
                     {
-                        while ( bObject != NULL)
-                        {
 
-                            tbObject = bObject->nextNearObject;
-                            // this'll be true even ONLY if BOTH objects are not non-physical dest object
-                            if ((( (bObject->attributes | aObject->attributes) & kCanCollide) &&
-                                (( bObject->attributes | aObject->attributes) & kCanBeHit)) &&
-                                /*( bObject->owner != aObject->owner) &&*/ ( bObject->collisionGrid.h ==
-                                superx) && ( bObject->collisionGrid.v == supery))
+                        tbObject = bObject->nextNearObject;
+                        // this'll be true even ONLY if BOTH objects are not non-physical dest object
+                        if ((( (bObject->attributes | aObject->attributes) & kCanCollide) &&
+                            (( bObject->attributes | aObject->attributes) & kCanBeHit)) &&
+                            /*( bObject->owner != aObject->owner) &&*/ ( bObject->collisionGrid.h ==
+                            superx) && ( bObject->collisionGrid.v == supery))
+                        {
+                            // this hack is to get the current bounds of the object in question
+                            // it could be sped up by accessing the sprite table directly
+                            if ((bObject->absoluteBounds.left >= bObject->absoluteBounds.right)
+                                    && (bObject->sprite != NULL)) {
+                                const NatePixTable::Frame& frame
+                                    = bObject->sprite->table->at(bObject->sprite->whichShape);
+
+                                scaleCalc = (frame.width() * bObject->naturalScale);
+                                scaleCalc >>= SHIFT_SCALE;
+                                bObject->scaledSize.h = scaleCalc;
+                                scaleCalc = (frame.height() * bObject->naturalScale);
+                                scaleCalc >>= SHIFT_SCALE;
+                                bObject->scaledSize.v = scaleCalc;
+
+                                scaleCalc = frame.center().h * bObject->naturalScale;
+                                scaleCalc >>= SHIFT_SCALE;
+                                bObject->scaledCornerOffset.h = -scaleCalc;
+                                scaleCalc = frame.center().v * bObject->naturalScale;
+                                scaleCalc >>= SHIFT_SCALE;
+                                bObject->scaledCornerOffset.v = -scaleCalc;
+
+                                bObject->absoluteBounds.left = bObject->motion->location.h +
+                                                            bObject->scaledCornerOffset.h;
+                                bObject->absoluteBounds.right = bObject->absoluteBounds.left +
+                                                            bObject->scaledSize.h;
+                                bObject->absoluteBounds.top = bObject->motion->location.v +
+                                                            bObject->scaledCornerOffset.v;
+                                bObject->absoluteBounds.bottom = bObject->absoluteBounds.top +
+                                                            bObject->scaledSize.v;
+                            }
+                            if ( aObject->owner != bObject->owner)
                             {
-                                // this hack is to get the current bounds of the object in question
-                                // it could be sped up by accessing the sprite table directly
-                                if ((bObject->absoluteBounds.left >= bObject->absoluteBounds.right)
-                                        && (bObject->sprite != NULL)) {
-                                    const NatePixTable::Frame& frame
-                                        = bObject->sprite->table->at(bObject->sprite->whichShape);
-
-                                    scaleCalc = (frame.width() * bObject->naturalScale);
-                                    scaleCalc >>= SHIFT_SCALE;
-                                    bObject->scaledSize.h = scaleCalc;
-                                    scaleCalc = (frame.height() * bObject->naturalScale);
-                                    scaleCalc >>= SHIFT_SCALE;
-                                    bObject->scaledSize.v = scaleCalc;
-
-                                    scaleCalc = frame.center().h * bObject->naturalScale;
-                                    scaleCalc >>= SHIFT_SCALE;
-                                    bObject->scaledCornerOffset.h = -scaleCalc;
-                                    scaleCalc = frame.center().v * bObject->naturalScale;
-                                    scaleCalc >>= SHIFT_SCALE;
-                                    bObject->scaledCornerOffset.v = -scaleCalc;
-
-                                    bObject->absoluteBounds.left = bObject->location.h +
-                                                                bObject->scaledCornerOffset.h;
-                                    bObject->absoluteBounds.right = bObject->absoluteBounds.left +
-                                                                bObject->scaledSize.h;
-                                    bObject->absoluteBounds.top = bObject->location.v +
-                                                                bObject->scaledCornerOffset.v;
-                                    bObject->absoluteBounds.bottom = bObject->absoluteBounds.top +
-                                                                bObject->scaledSize.v;
-                                }
-                                if ( aObject->owner != bObject->owner)
-                                {
 //                                  bObject->foeStrength  += aObject->baseType->offenseValue;
-                                    if  (!(( bObject->attributes | aObject->attributes) & kIsBeam))
+                                if  (!(( bObject->attributes | aObject->attributes) & kIsBeam))
+                                {
+                                    dObject = aObject;
+                                    sObject = bObject;
+                                    if (!(( sObject->absoluteBounds.right < dObject->absoluteBounds.left) ||
+                                        ( sObject->absoluteBounds.left > dObject->absoluteBounds.right) ||
+                                        ( sObject->absoluteBounds.bottom < dObject->absoluteBounds.top) ||
+                                        ( sObject->absoluteBounds.top > dObject->absoluteBounds.bottom)))
+//                                  if ( aObject->entryNumber != 0)
+                                    {
+                                        if (( dObject->attributes & kCanBeHit) && ( sObject->attributes & kCanCollide))
+                                            HitObject( dObject, sObject);
+                                        if (( sObject->attributes & kCanBeHit) && ( dObject->attributes & kCanCollide))
+                                            HitObject( sObject, dObject);
+                                    }
+                                } else
+                                {
+                                    if ( bObject->attributes & kIsBeam)
                                     {
-                                        dObject = aObject;
                                         sObject = bObject;
-                                        if (!(( sObject->absoluteBounds.right < dObject->absoluteBounds.left) ||
-                                            ( sObject->absoluteBounds.left > dObject->absoluteBounds.right) ||
-                                            ( sObject->absoluteBounds.bottom < dObject->absoluteBounds.top) ||
-                                            ( sObject->absoluteBounds.top > dObject->absoluteBounds.bottom)))
-    //                                  if ( aObject->entryNumber != 0)
-                                        {
-                                            if (( dObject->attributes & kCanBeHit) && ( sObject->attributes & kCanCollide))
-                                                HitObject( dObject, sObject);
-                                            if (( sObject->attributes & kCanBeHit) && ( dObject->attributes & kCanCollide))
-                                                HitObject( sObject, dObject);
-                                        }
+                                        dObject = aObject;
                                     } else
                                     {
-                                        if ( bObject->attributes & kIsBeam)
-                                        {
-                                            sObject = bObject;
-                                            dObject = aObject;
-                                        } else
-                                        {
-                                            sObject = aObject;
-                                            dObject = bObject;
-                                        }
+                                        sObject = aObject;
+                                        dObject = bObject;
+                                    }
 
-                                        xs = sObject->location.h;
-                                        ys = sObject->location.v;
-                                        xe = sObject->frame.beam.beam->lastGlobalLocation.h;
-                                        ye = sObject->frame.beam.beam->lastGlobalLocation.v;
+                                    xs = sObject->motion->location.h;
+                                    ys = sObject->motion->location.v;
+                                    xe = sObject->frame.beam.beam->lastGlobalLocation.h;
+                                    ye = sObject->frame.beam.beam->lastGlobalLocation.v;
+
+                                    cs = mClipCode( xs, ys, dObject->absoluteBounds);
+                                    ce = mClipCode( xe, ye, dObject->absoluteBounds);
+                                    beamHit = true;
+                                    if ( sObject->active == kObjectToBeFreed)
+                                    {
+                                        cs = ce = 1;
+                                        beamHit = false;
+                                    }
 
-                                        cs = mClipCode( xs, ys, dObject->absoluteBounds);
-                                        ce = mClipCode( xe, ye, dObject->absoluteBounds);
-                                        beamHit = true;
-                                        if ( sObject->active == kObjectToBeFreed)
+                                    while ( cs | ce)
+                                    {
+                                        if ( cs & ce)
                                         {
-                                            cs = ce = 1;
                                             beamHit = false;
+                                            break;
                                         }
-
-                                        while ( cs | ce)
+                                        xd = xe - xs;
+                                        yd = ye - ys;
+                                        if ( cs)
                                         {
-                                            if ( cs & ce)
+                                            if ( cs & 8)
                                             {
-                                                beamHit = false;
-                                                break;
-                                            }
-                                            xd = xe - xs;
-                                            yd = ye - ys;
-                                            if ( cs)
+                                                ys += yd * ( dObject->absoluteBounds.left - xs) / xd;
+                                                xs = dObject->absoluteBounds.left;
+                                            } else
+                                            if ( cs & 4)
                                             {
-                                                if ( cs & 8)
-                                                {
-                                                    ys += yd * ( dObject->absoluteBounds.left - xs) / xd;
-                                                    xs = dObject->absoluteBounds.left;
-                                                } else
-                                                if ( cs & 4)
-                                                {
-                                                    ys += yd * ( dObject->absoluteBounds.right - 1 - xs) / xd;
-                                                    xs = dObject->absoluteBounds.right - 1;
-                                                } else
-                                                if ( cs & 2)
-                                                {
-                                                    xs += xd * ( dObject->absoluteBounds.top - ys) / yd;
-                                                    ys = dObject->absoluteBounds.top;
-                                                } else
-                                                if ( cs & 1)
-                                                {
-                                                    xs += xd * ( dObject->absoluteBounds.bottom - 1 - ys) / yd;
-                                                    ys = dObject->absoluteBounds.bottom - 1;
-                                                }
-                                                cs = mClipCode( xs, ys, dObject->absoluteBounds);
-                                            } else if ( ce)
+                                                ys += yd * ( dObject->absoluteBounds.right - 1 - xs) / xd;
+                                                xs = dObject->absoluteBounds.right - 1;
+                                            } else
+                                            if ( cs & 2)
                                             {
-                                                if ( ce & 8)
-                                                {
-                                                    ye += yd * ( dObject->absoluteBounds.left - xe) / xd;
-                                                    xe = dObject->absoluteBounds.left;
-                                                } else
-                                                if ( ce & 4)
-                                                {
-                                                    ye += yd * ( dObject->absoluteBounds.right - 1 - xe) / xd;
-                                                    xe = dObject->absoluteBounds.right - 1;
-                                                } else
-                                                if ( ce & 2)
-                                                {
-                                                    xe += xd * ( dObject->absoluteBounds.top - ye) / yd;
-                                                    ye = dObject->absoluteBounds.top;
-                                                } else
-                                                if ( ce & 1)
-                                                {
-                                                    xe += xd * ( dObject->absoluteBounds.bottom - 1 - ye) / yd;
-                                                    ye = dObject->absoluteBounds.bottom - 1;
-                                                }
-                                                ce = mClipCode( xe, ye, dObject->absoluteBounds);
+                                                xs += xd * ( dObject->absoluteBounds.top - ys) / yd;
+                                                ys = dObject->absoluteBounds.top;
+                                            } else
+                                            if ( cs & 1)
+                                            {
+                                                xs += xd * ( dObject->absoluteBounds.bottom - 1 - ys) / yd;
+                                                ys = dObject->absoluteBounds.bottom - 1;
                                             }
-                                        }
-                                        if ( beamHit)
+                                            cs = mClipCode( xs, ys, dObject->absoluteBounds);
+                                        } else if ( ce)
                                         {
-                                            HitObject( dObject, sObject);
+                                            if ( ce & 8)
+                                            {
+                                                ye += yd * ( dObject->absoluteBounds.left - xe) / xd;
+                                                xe = dObject->absoluteBounds.left;
+                                            } else
+                                            if ( ce & 4)
+                                            {
+                                                ye += yd * ( dObject->absoluteBounds.right - 1 - xe) / xd;
+                                                xe = dObject->absoluteBounds.right - 1;
+                                            } else
+                                            if ( ce & 2)
+                                            {
+                                                xe += xd * ( dObject->absoluteBounds.top - ye) / yd;
+                                                ye = dObject->absoluteBounds.top;
+                                            } else
+                                            if ( ce & 1)
+                                            {
+                                                xe += xd * ( dObject->absoluteBounds.bottom - 1 - ye) / yd;
+                                                ye = dObject->absoluteBounds.bottom - 1;
+                                            }
+                                            ce = mClipCode( xe, ye, dObject->absoluteBounds);
                                         }
                                     }
-                                } else
-                                {
-//                                  bObject->friendStrength += aObject->baseType->offenseValue;
-//                                  bObject->friendStrength += kFixedOne;
-                                }
-
-                                // check to see if the 2 objects occupy same physical space
-                                if  (((bObject->attributes & aObject->attributes) & kOccupiesSpace) &&
-                                    ( bObject->owner != aObject->owner))
-                                {
-                                    dObject = aObject;
-                                    sObject = bObject;
-                                    if (!(( sObject->absoluteBounds.right < dObject->absoluteBounds.left) ||
-                                        ( sObject->absoluteBounds.left > dObject->absoluteBounds.right) ||
-                                        ( sObject->absoluteBounds.bottom < dObject->absoluteBounds.top) ||
-                                        ( sObject->absoluteBounds.top > dObject->absoluteBounds.bottom)))
+                                    if ( beamHit)
                                     {
-                                        CorrectPhysicalSpace( aObject, bObject); // move them back till they don't touch
-                                    } else
-                                    {
-                                        aObject->collideObject = bObject->collideObject = NULL;
+                                        HitObject( dObject, sObject);
                                     }
                                 }
-                            // one or both objects is non-physical
-                            } else if (( bObject->collisionGrid.h ==
-                                superx) && ( bObject->collisionGrid.v == supery))
+                            } else
                             {
-                                if ( aObject->owner != bObject->owner)
+//                                  bObject->friendStrength += aObject->baseType->offenseValue;
+//                                  bObject->friendStrength += kFixedOne;
+                            }
+
+                            // check to see if the 2 objects occupy same physical space
+                            if  (((bObject->attributes & aObject->attributes) & kOccupiesSpace) &&
+                                ( bObject->owner != aObject->owner))
+                            {
+                                dObject = aObject;
+                                sObject = bObject;
+                                if (!(( sObject->absoluteBounds.right < dObject->absoluteBounds.left) ||
+                                    ( sObject->absoluteBounds.left > dObject->absoluteBounds.right) ||
+                                    ( sObject->absoluteBounds.bottom < dObject->absoluteBounds.top) ||
+                                    ( sObject->absoluteBounds.top > dObject->absoluteBounds.bottom)))
                                 {
-//                                  bObject->foeStrength  += aObject->baseType->offenseValue;
+                                    CorrectPhysicalSpace( aObject, bObject); // move them back till they don't touch
                                 } else
                                 {
+                                    aObject->collideObject = bObject->collideObject = NULL;
+                                }
+                            }
+                        // one or both objects is non-physical
+                        } else if (( bObject->collisionGrid.h ==
+                            superx) && ( bObject->collisionGrid.v == supery))
+                        {
+                            if ( aObject->owner != bObject->owner)
+                            {
+//                                  bObject->foeStrength  += aObject->baseType->offenseValue;
+                            } else
+                            {
 //                                  bObject->friendStrength += aObject->baseType->offenseValue;
 //                                  bObject->friendStrength += kFixedOne;
-                                }
                             }
-                            bObject = tbObject;
                         }
+                        bObject = tbObject;
                     }
                 }
-                aObject = taObject;
             }
-            proximityObject++;
+            aObject = taObject;
         }
     }
 
-    proximityObject = gProximityGrid.get();
-    for ( j = 0; j < kProximitySuperSize; j++)
+    for ( unit = NextOccupiedUnit(far_units, -1); unit >= 0; unit = NextOccupiedUnit(far_units, unit))
     {
-        for ( i = 0; i < kProximitySuperSize; i++)
+        proximityObject = grid + unit;
+        aObject = proximityObject->farObject;
+        while ( aObject != NULL)
         {
-            aObject = proximityObject->farObject;
-            while ( aObject != NULL)
-            {
 //              aObject->friendStrength += aObject->baseType->offenseValue;
 //              aObject->friendStrength += kFixedOne;
-                taObject = aObject->nextFarObject;
-                currentProximity = proximityObject;
-                for ( k = 0; k < kUnitsToCheckNumber; k++)
+            taObject = aObject->nextFarObject;
+            currentProximity = proximityObject;
+            for ( k = 0; k < kUnitsToCheckNumber; k++)
+            {
+                if ( k == 0)
                 {
-                    if ( k == 0)
-                    {
-                        bObject = aObject->nextFarObject;
-                        superx = aObject->distanceGrid.h;
-                        supery = aObject->distanceGrid.v;
-                    }
-                    else
-                    {
-                        currentProximity += proximityObject->unitsToCheck[k].adjacentUnit;
-                        bObject = currentProximity->farObject;
-                        superx = aObject->distanceGrid.h + proximityObject->unitsToCheck[k].superOffset.h;
-                        supery = aObject->distanceGrid.v + proximityObject->unitsToCheck[k].superOffset.v;
-                    }
-                    if (( superx >= 0) && ( supery >= 0))
+                    bObject = aObject->nextFarObject;
+                    superx = aObject->distanceGrid.h;
+                    supery = aObject->distanceGrid.v;
+                }
+                else
+                {
+                    currentProximity += proximityObject->unitsToCheck[k].adjacentUnit;
+                    bObject = currentProximity->farObject;
+                    superx = aObject->distanceGrid.h + proximityObject->unitsToCheck[k].superOffset.h;
+                    supery = aObject->distanceGrid.v + proximityObject->unitsToCheck[k].superOffset.v;
+                }
+                if (( superx >= 0) && ( supery >= 0))
+                {
+                    while ( bObject != NULL)
                     {
-                        while ( bObject != NULL)
+                        tbObject = bObject->nextFarObject;
+                        if (( bObject->owner != aObject->owner) && ( bObject->distanceGrid.h ==
+                            superx) && ( bObject->distanceGrid.v == supery) &&
+                            (( bObject->attributes & kCanThink) ||
+                            ( bObject->attributes & kRemoteOrHuman) ||
+                            ( bObject->attributes & kHated)) &&
+                            (( aObject->attributes & kCanThink) ||
+                            ( aObject->attributes & kRemoteOrHuman) ||
+                            ( aObject->attributes & kHated)) /*&&
+                            ( !(( aObject->attributes & bObject->attributes) & kIsGuided))*/)
                         {
-                            tbObject = bObject->nextFarObject;
-                            if (( bObject->owner != aObject->owner) && ( bObject->distanceGrid.h ==
-                                superx) && ( bObject->distanceGrid.v == supery) &&
-                                (( bObject->attributes & kCanThink) ||
-                                ( bObject->attributes & kRemoteOrHuman) ||
-                                ( bObject->attributes & kHated)) &&
-                                (( aObject->attributes & kCanThink) ||
-                                ( aObject->attributes & kRemoteOrHuman) ||
-                                ( aObject->attributes & kHated)) /*&&
-                                ( !(( aObject->attributes & bObject->attributes) & kIsGuided))*/)
+                            difference = ABS<int>( bObject->motion->location.h - aObject->motion->location.h);
+                            dcalc = difference;
+                            difference =  ABS<int>( bObject->motion->location.v - aObject->motion->location.v);
+                            distance = difference;
+                            if (( dcalc > kMaximumRelevantDistance) ||
+                                ( distance > kMaximumRelevantDistance))
+                                distance = kMaximumRelevantDistanceSquared;
+                            else distance = distance * distance + dcalc * dcalc;
+
+                            if ( distance < kMaximumRelevantDistanceSquared)
                             {
-                                difference = ABS<int>( bObject->location.h - aObject->location.h);
-                                dcalc = difference;
-                                difference =  ABS<int>( bObject->location.v - aObject->location.v);
-                                distance = difference;
-                                if (( dcalc > kMaximumRelevantDistance) ||
-                                    ( distance > kMaximumRelevantDistance))
-                                    distance = kMaximumRelevantDistanceSquared;
-                                else distance = distance * distance + dcalc * dcalc;
-
-                                if ( distance < kMaximumRelevantDistanceSquared)
-                                {
-                                    aObject->seenByPlayerFlags |= bObject->myPlayerFlag;
-                                    bObject->seenByPlayerFlags |= aObject->myPlayerFlag;
+                                aObject->seenByPlayerFlags |= bObject->myPlayerFlag;
+                                bObject->seenByPlayerFlags |= aObject->myPlayerFlag;
 
-                                    if ( bObject->attributes & kHideEffect)
-                                    {
-                                        aObject->runTimeFlags |= kIsHidden;
-                                    }
+                                if ( bObject->attributes & kHideEffect)
+                                {
+                                    aObject->runTimeFlags |= kIsHidden;
+                                }
 
-                                    if ( aObject->attributes & kHideEffect)
-                                    {
-                                        bObject->runTimeFlags |= kIsHidden;
-                                    }
+                                if ( aObject->attributes & kHideEffect)
+                                {
+                                    bObject->runTimeFlags |= kIsHidden;
                                 }
+                            }
 
-                                if  (
+                            if  (
+                                    (
+                                        (aObject->baseType->buildFlags & kCanOnlyEngage) ||
+                                        (bObject->baseType->buildFlags & kOnlyEngagedBy)
+                                    ) &&
+                                    (
                                         (
-                                            (aObject->baseType->buildFlags & kCanOnlyEngage) ||
-                                            (bObject->baseType->buildFlags & kOnlyEngagedBy)
-                                        ) &&
+                                            (aObject->baseType->buildFlags & kEngageKeyTagMask)
+                                            << kEngageKeyTagShift
+                                        ) !=
                                         (
-                                            (
-                                                (aObject->baseType->buildFlags & kEngageKeyTagMask)
-                                                << kEngageKeyTagShift
-                                            ) !=
-                                            (
-                                                bObject->baseType->buildFlags & kLevelKeyTagMask
-                                            )
+                                            bObject->baseType->buildFlags & kLevelKeyTagMask
                                         )
-                                    ) goto hackANoEngageMatch;
+                                    )
+                                ) goto hackANoEngageMatch;
 
-                                if (( distance < aObject->closestDistance) && (bObject->attributes & kPotentialTarget))
-                                {
-                                    aObject->closestDistance = distance;
-                                    aObject->closestObject = bObject->entryNumber;
-                                }
+                            if (( distance < aObject->closestDistance) && (bObject->attributes & kPotentialTarget))
+                            {
+                                aObject->closestDistance = distance;
+                                aObject->closestObject = bObject->entryNumber;
+                            }
 
-                            hackANoEngageMatch:
-                                if  (
+                        hackANoEngageMatch:
+                            if  (
+                                    (
+                                        (bObject->baseType->buildFlags & kCanOnlyEngage) ||
+                                        (aObject->baseType->buildFlags & kOnlyEngagedBy)
+                                    ) &&
+                                    (
                                         (
-                                            (bObject->baseType->buildFlags & kCanOnlyEngage) ||
-                                            (aObject->baseType->buildFlags & kOnlyEngagedBy)
-                                        ) &&
+                                            (bObject->baseType->buildFlags & kEngageKeyTagMask)
+                                            << kEngageKeyTagShift
+                                        ) !=
                                         (
-                                            (
-                                                (bObject->baseType->buildFlags & kEngageKeyTagMask)
-                                                << kEngageKeyTagShift
-                                            ) !=
-                                            (
-                                                aObject->baseType->buildFlags & kLevelKeyTagMask
-                                            )
+                                            aObject->baseType->buildFlags & kLevelKeyTagMask
                                         )
-                                    ) goto hackBNoEngageMatch;
+                                    )
+                                ) goto hackBNoEngageMatch;
 
-                                if (( distance < bObject->closestDistance) && ( aObject->attributes & kPotentialTarget))
-                                {
-                                    bObject->closestDistance = distance;
-                                    bObject->closestObject = aObject->entryNumber;
-                                }
-                            hackBNoEngageMatch:
+                            if (( distance < bObject->closestDistance) && ( aObject->attributes & kPotentialTarget))
+                            {
+                                bObject->closestDistance = distance;
+                                bObject->closestObject = aObject->entryNumber;
+                            }
+                        hackBNoEngageMatch:
+                            bObject->localFoeStrength += aObject->localFriendStrength;
+                            bObject->localFriendStrength += aObject->localFoeStrength;
+
+                        } else if (( bObject->distanceGrid.h ==
+                            superx) && ( bObject->distanceGrid.v == supery) && ( k == 0))
+                        {
+                            if ( aObject->owner != bObject->owner)
+                            {
                                 bObject->localFoeStrength += aObject->localFriendStrength;
                                 bObject->localFriendStrength += aObject->localFoeStrength;
-
-                            } else if (( bObject->distanceGrid.h ==
-                                superx) && ( bObject->distanceGrid.v == supery) && ( k == 0))
+                            } else
                             {
-                                if ( aObject->owner != bObject->owner)
-                                {
-                                    bObject->localFoeStrength += aObject->localFriendStrength;
-                                    bObject->localFriendStrength += aObject->localFoeStrength;
-                                } else
-                                {
-                                    bObject->localFoeStrength += aObject->localFoeStrength;
-                                    bObject->localFriendStrength += aObject->localFriendStrength;
-                                }
+                                bObject->localFoeStrength += aObject->localFoeStrength;
+                                bObject->localFriendStrength += aObject->localFriendStrength;
                             }
-                            bObject = tbObject;
                         }
+                        bObject = tbObject;
                     }
                 }
-                aObject = taObject;
             }
-            proximityObject++;
+            aObject = taObject;
         }
     }
 
 // here, it doesn't matter in what order we step through the table
     dcalc = 1ul << globals()->gPlayerAdmiralNumber;
 
-    for (i = 0; i < kMaxSpaceObject; i++) {
+    for (i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i)) {
         aObject = mGetSpaceObjectPtr(i);
         if (aObject->active == kObjectToBeFreed)
         {
@@ -1196,6 +1431,7 @@ void CollideSpaceObjects() {
                     aObject->frame.beam.beam->killMe = true;
                 }
                 aObject->active = kObjectAvailable;
+                ReleaseSpaceObjectSlot(i);
                 aObject->attributes = 0;
                 aObject->nextNearObject = aObject->nextFarObject = NULL;
                 if ( aObject->previousObject != NULL)
@@ -1210,10 +1446,10 @@ void CollideSpaceObjects() {
                     bObject->previousObject = aObject->previousObject;
                     bObject->previousObjectNumber = aObject->previousObjectNumber;
                 }
-                if ( gRootObject == aObject)
+                if ( globals()->gRootObject == aObject)
                 {
-                    gRootObject = aObject->nextObject;
-                    gRootObjectNumber = aObject->nextObjectNumber;
+                    globals()->gRootObject = aObject->nextObject;
+                    globals()->gRootObjectNumber = aObject->nextObjectNumber;
                 }
                 aObject->nextObject = NULL;
                 aObject->nextObjectNumber = -1;
@@ -1222,6 +1458,7 @@ void CollideSpaceObjects() {
             }else
             {
                 aObject->active = kObjectAvailable;
+                ReleaseSpaceObjectSlot(i);
                 if ( aObject->sprite != NULL)
                 {
                     aObject->sprite->killMe = true;
@@ -1240,10 +1477,10 @@ void CollideSpaceObjects() {
                     bObject->previousObject = aObject->previousObject;
                     bObject->previousObjectNumber = aObject->previousObjectNumber;
                 }
-                if ( gRootObject == aObject)
+                if ( globals()->gRootObject == aObject)
                 {
-                    gRootObject = aObject->nextObject;
-                    gRootObjectNumber = aObject->nextObjectNumber;
+                    globals()->gRootObject = aObject->nextObject;
+                    globals()->gRootObjectNumber = aObject->nextObjectNumber;
                 }
                 aObject->nextObject = NULL;
                 aObject->nextObjectNumber = -1;
@@ -1270,13 +1507,20 @@ void CollideSpaceObjects() {
             }
             if ( aObject->attributes & kIsBeam)
             {
-                aObject->frame.beam.beam->lastGlobalLocation = aObject->location;
+                aObject->frame.beam.beam->lastGlobalLocation = aObject->motion->location;
             }
         }
-        aObject->lastLocation = aObject->location;
-        aObject->lastDir = aObject->direction;
-        aObject++;
     }
+
+    for ( i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i))
+    {
+        spaceObjectMotionType* motion = mGetSpaceObjectMotionPtr(i);
+        motion->lastLocation = motion->location;
+        motion->lastDir = motion->direction;
+    }
+
+    // Collisions kill objects and push them apart.
+    InvalidateProximityIndex();
 }
 
 // CorrectPhysicalSpace-- takes 2 objects that are colliding and moves them back 1
@@ -1295,14 +1539,14 @@ void CorrectPhysicalSpace( spaceObjectType *aObject, spaceObjectType *bObject)
     Fixed           aFixed;
 
     // calculate the new velocities
-    force = ( bObject->velocity.h - aObject->velocity.h);
+    force = ( bObject->motion->velocity.h - aObject->motion->velocity.h);
     force = mMultiplyFixed( force, force);
-    totalMass = ( bObject->velocity.v - aObject->velocity.v);
+    totalMass = ( bObject->motion->velocity.v - aObject->motion->velocity.v);
     totalMass = mMultiplyFixed( totalMass, totalMass);
     force += totalMass;
     force = lsqrt( force);  // tvel = force
-    ah = bObject->location.h - aObject->location.h;
-    av = bObject->location.v - aObject->location.v;
+    ah = bObject->motion->location.h - aObject->motion->location.h;
+    av = bObject->motion->location.v - aObject->motion->location.v;
 
     if ( ah == 0)
     {
@@ -1325,14 +1569,14 @@ void CorrectPhysicalSpace( spaceObjectType *aObject, spaceObjectType *bObject)
     {
         tfix = mDivideFixed( tfix, totalMass);
     }
-    tfix += aObject->maxVelocity >> 1;
+    tfix += aObject->motion->maxVelocity >> 1;
     GetRotPoint(&tvel.h, &tvel.v, angle);
     tvel.h = mMultiplyFixed( tfix, tvel.h);
     tvel.v = mMultiplyFixed( tfix, tvel.v);
 //  tvel.h = mMultiplyFixed( aObject->baseType->maxVelocity, tvel.h);
 //  tvel.v = mMultiplyFixed( aObject->baseType->maxVelocity, tvel.v);
-    aObject->velocity.v = tvel.v;
-    aObject->velocity.h = tvel.h;
+    aObject->motion->velocity.v = tvel.v;
+    aObject->motion->velocity.h = tvel.h;
 
     mAddAngle( angle, 180);
     tfix = bObject->baseType->mass;
@@ -1342,76 +1586,76 @@ void CorrectPhysicalSpace( spaceObjectType *aObject, spaceObjectType *bObject)
     {
         tfix = mDivideFixed( tfix, totalMass);
     }
-    tfix += bObject->maxVelocity >> 1;
+    tfix += bObject->motion->maxVelocity >> 1;
     GetRotPoint(&tvel.h, &tvel.v, angle);
     tvel.h = mMultiplyFixed( tfix, tvel.h);
     tvel.v = mMultiplyFixed( tfix, tvel.v);
 //  tvel.h = mMultiplyFixed( bObject->baseType->maxVelocity, tvel.h);
 //  tvel.v = mMultiplyFixed( bObject->baseType->maxVelocity, tvel.v);
-    bObject->velocity.v = tvel.v;
-    bObject->velocity.h = tvel.h;
+    bObject->motion->velocity.v = tvel.v;
+    bObject->motion->velocity.h = tvel.h;
 
-    ah = aObject->location.h - aObject->absoluteBounds.left;
-    ad = aObject->absoluteBounds.right - aObject->location.h;
-    av = aObject->location.v - aObject->absoluteBounds.top;
-    adir = aObject->absoluteBounds.bottom - aObject->location.v;
+    ah = aObject->motion->location.h - aObject->absoluteBounds.left;
+    ad = aObject->absoluteBounds.right - aObject->motion->location.h;
+    av = aObject->motion->location.v - aObject->absoluteBounds.top;
+    adir = aObject->absoluteBounds.bottom - aObject->motion->location.v;
 
-    bh = bObject->location.h - bObject->absoluteBounds.left;
-    bd = bObject->absoluteBounds.right - bObject->location.h;
-    bv = bObject->location.v - bObject->absoluteBounds.top;
-    bdir = bObject->absoluteBounds.bottom - bObject->location.v;
+    bh = bObject->motion->location.h - bObject->absoluteBounds.left;
+    bd = bObject->absoluteBounds.right - bObject->motion->location.h;
+    bv = bObject->motion->location.v - bObject->absoluteBounds.top;
+    bdir = bObject->absoluteBounds.bottom - bObject->motion->location.v;
 
-    if ( (aObject->velocity.h || aObject->velocity.v || bObject->velocity.h ||
-        bObject->velocity.v))
+    if ( (aObject->motion->velocity.h || aObject->motion->velocity.v || bObject->motion->velocity.h ||
+        bObject->motion->velocity.v))
     {
         while ((!(( aObject->absoluteBounds.right   <   bObject->absoluteBounds.left) ||
                 (   aObject->absoluteBounds.left    >   bObject->absoluteBounds.right) ||
                 (   aObject->absoluteBounds.bottom  <   bObject->absoluteBounds.top) ||
                 (   aObject->absoluteBounds.top     >   bObject->absoluteBounds.bottom))))
         {
-            aObject->motionFraction.h += aObject->velocity.h;
-            aObject->motionFraction.v += aObject->velocity.v;
+            aObject->motion->motionFraction.h += aObject->motion->velocity.h;
+            aObject->motion->motionFraction.v += aObject->motion->velocity.v;
 
-            if ( aObject->motionFraction.h >= 0)
-                h = more_evil_fixed_to_long(aObject->motionFraction.h + mFloatToFixed(0.5));
+            if ( aObject->motion->motionFraction.h >= 0)
+                h = more_evil_fixed_to_long(aObject->motion->motionFraction.h + mFloatToFixed(0.5));
             else
-                h = more_evil_fixed_to_long(aObject->motionFraction.h - mFloatToFixed(0.5)) + 1;
-            aObject->location.h -= h;
-            aObject->motionFraction.h -= mLongToFixed(h);
+                h = more_evil_fixed_to_long(aObject->motion->motionFraction.h - mFloatToFixed(0.5)) + 1;
+            aObject->motion->location.h -= h;
+            aObject->motion->motionFraction.h -= mLongToFixed(h);
 
-            if ( aObject->motionFraction.v >= 0)
-                v = more_evil_fixed_to_long(aObject->motionFraction.v + mFloatToFixed(0.5));
+            if ( aObject->motion->motionFraction.v >= 0)
+                v = more_evil_fixed_to_long(aObject->motion->motionFraction.v + mFloatToFixed(0.5));
             else
-                v = more_evil_fixed_to_long(aObject->motionFraction.v - mFloatToFixed(0.5)) + 1;
-            aObject->location.v -= v;
-            aObject->motionFraction.v -= mLongToFixed(v);
+                v = more_evil_fixed_to_long(aObject->motion->motionFraction.v - mFloatToFixed(0.5)) + 1;
+            aObject->motion->location.v -= v;
+            aObject->motion->motionFraction.v -= mLongToFixed(v);
 
-            bObject->motionFraction.h += bObject->velocity.h;
-            bObject->motionFraction.v += bObject->velocity.v;
+            bObject->motion->motionFraction.h += bObject->motion->velocity.h;
+            bObject->motion->motionFraction.v += bObject->motion->velocity.v;
 
-            if ( bObject->motionFraction.h >= 0)
-                h = more_evil_fixed_to_long(bObject->motionFraction.h + mFloatToFixed(0.5));
+            if ( bObject->motion->motionFraction.h >= 0)
+                h = more_evil_fixed_to_long(bObject->motion->motionFraction.h + mFloatToFixed(0.5));
             else
-                h = more_evil_fixed_to_long(bObject->motionFraction.h - mFloatToFixed(0.5)) + 1;
-            bObject->location.h -= h;
-            bObject->motionFraction.h -= mLongToFixed(h);
+                h = more_evil_fixed_to_long(bObject->motion->motionFraction.h - mFloatToFixed(0.5)) + 1;
+            bObject->motion->location.h -= h;
+            bObject->motion->motionFraction.h -= mLongToFixed(h);
 
-            if ( bObject->motionFraction.v >= 0)
-                v = more_evil_fixed_to_long(bObject->motionFraction.v + mFloatToFixed(0.5));
+            if ( bObject->motion->motionFraction.v >= 0)
+                v = more_evil_fixed_to_long(bObject->motion->motionFraction.v + mFloatToFixed(0.5));
             else
-                v = more_evil_fixed_to_long(bObject->motionFraction.v - mFloatToFixed(0.5)) + 1;
-            bObject->location.v -= v;
-            bObject->motionFraction.v -= mLongToFixed(v);
-
-            aObject->absoluteBounds.left = aObject->location.h - ah;
-            aObject->absoluteBounds.right = aObject->location.h + ad;
-            aObject->absoluteBounds.top = aObject->location.v - av;
-            aObject->absoluteBounds.bottom = aObject->location.v + adir;
-
-            bObject->absoluteBounds.left = bObject->location.h - bh;
-            bObject->absoluteBounds.right = bObject->location.h + bd;
-            bObject->absoluteBounds.top = bObject->location.v - bv;
-            bObject->absoluteBounds.bottom = bObject->location.v + bdir;
+                v = more_evil_fixed_to_long(bObject->motion->motionFraction.v - mFloatToFixed(0.5)) + 1;
+            bObject->motion->location.v -= v;
+            bObject->motion->motionFraction.v -= mLongToFixed(v);
+
+            aObject->absoluteBounds.left = aObject->motion->location.h - ah;
+            aObject->absoluteBounds.right = aObject->motion->location.h + ad;
+            aObject->absoluteBounds.top = aObject->motion->location.v - av;
+            aObject->absoluteBounds.bottom = aObject->motion->location.v + adir;
+
+            bObject->absoluteBounds.left = bObject->motion->location.h - bh;
+            bObject->absoluteBounds.right = bObject->motion->location.h + bd;
+            bObject->absoluteBounds.top = bObject->motion->location.v - bv;
+            bObject->absoluteBounds.bottom = bObject->motion->location.v + bdir;
         }
     }
 }
@@ -0,0 +1,238 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/motion.hpp"
+
+#include <gmock/gmock.h>
+#include <vector>
+#include <sfz/sfz.hpp>
+
+#include "config/preferences.hpp"
+#include "data/space-object.hpp"
+#include "game/globals.hpp"
+#include "game/space-object.hpp"
+#include "math/units.hpp"
+
+using std::vector;
+
+namespace antares {
+namespace {
+
+const ProximityFilter kAnything = {ProximityFilter::kAnyOwner, 0, 0, NULL};
+
+// A game with no objects but the ones each test adds, and no sprites, so that it needs no data
+// beyond what the globals load.
+class ProximityTest : public testing::Test {
+  public:
+    ProximityTest():
+            _scoped(&_game) {
+        InitMotion();
+        SetSpaceObjectCapacity(kMinSpaceObjectCapacity);
+    }
+
+    // Adds an object `h` and `v` units from the center of the universe.
+    spaceObjectType* add(int32_t h, int32_t v, int32_t owner, uint32_t attributes = kCanBeHit) {
+        spaceObjectMotionType motion = spaceObjectMotionType();
+        motion.location.h = kUniversalCenter + h;
+        motion.location.v = kUniversalCenter + v;
+        spaceObjectType source = spaceObjectType();
+        source.attributes = attributes;
+        source.motion = &motion;
+        source.active = kObjectInUse;
+        source.whichBaseObject = -1;
+        source.owner = owner;
+        source.pixResID = kNoSpriteTable;
+        const int number = AddSpaceObject(&source);
+        EXPECT_LE(0, number);
+        return mGetSpaceObjectPtr(number);
+    }
+
+    void move(spaceObjectType* object, int32_t h, int32_t v) {
+        object->motion->location.h = kUniversalCenter + h;
+        object->motion->location.v = kUniversalCenter + v;
+        InvalidateProximityIndex();
+    }
+
+    vector<spaceObjectType*> objects(const vector<ProximityResult>& found) {
+        vector<spaceObjectType*> result;
+        for (const ProximityResult& r: found) {
+            result.push_back(r.object);
+        }
+        return result;
+    }
+
+  private:
+    NullPrefsDriver _prefs;
+    aresGlobalType _game;
+    ScopedGlobals _scoped;
+};
+
+TEST_F(ProximityTest, InRadius) {
+    spaceObjectType* asker = add(0, 0, 0);
+    spaceObjectType* a = add(100, 0, 1);
+    spaceObjectType* b = add(0, -50, 1);
+    spaceObjectType* c = add(-300, 300, 0);
+    spaceObjectType* d = add(0, 5000, 1);  // a few distance units down
+    add(8000, 0, 1);
+
+    vector<ProximityResult> found;
+    FindObjectsInRadius(asker, 6000, kAnything, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(b, a, c, d));
+    ASSERT_EQ(4, found.size());
+    EXPECT_EQ(50 * 50, found[0].distance);
+    EXPECT_EQ(100 * 100, found[1].distance);
+    EXPECT_EQ(2 * 300 * 300, found[2].distance);
+    EXPECT_EQ(5000 * 5000, found[3].distance);
+
+    FindObjectsInRadius(asker, 0, kAnything, found);
+    EXPECT_THAT(found, testing::IsEmpty());
+}
+
+TEST_F(ProximityTest, RadiusIsExclusive) {
+    spaceObjectType* asker = add(0, 0, 0);
+    spaceObjectType* inside = add(0, 999, 1);
+    add(1000, 0, 1);
+    add(-800, 800, 1);  // within the square, but not the circle
+
+    vector<ProximityResult> found;
+    FindObjectsInRadius(asker, 1000, kAnything, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(inside));
+}
+
+TEST_F(ProximityTest, RadiusIsCapped) {
+    spaceObjectType* asker = add(0, 0, 0);
+    spaceObjectType* near = add(kMaximumRelevantDistance - 1, 0, 1);
+    add(-kMaximumRelevantDistance - 100, 0, 1);
+
+    vector<ProximityResult> found;
+    FindObjectsInRadius(asker, 4 * kMaximumRelevantDistance, kAnything, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(near));
+}
+
+TEST_F(ProximityTest, TiesGoToLowerNumber) {
+    spaceObjectType* asker = add(0, 0, 0);
+    spaceObjectType* right = add(3000, 0, 1);
+    spaceObjectType* left = add(-3000, 0, 1);
+    spaceObjectType* up = add(0, -3000, 1);
+    ASSERT_LT(right->entryNumber, left->entryNumber);
+    ASSERT_LT(left->entryNumber, up->entryNumber);
+
+    vector<ProximityResult> found;
+    FindObjectsInRadius(asker, 4000, kAnything, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(right, left, up));
+
+    uint32_t distance = 0;
+    EXPECT_EQ(right, FindNearestObject(asker, 4000, kAnything, &distance));
+    EXPECT_EQ(3000 * 3000, distance);
+}
+
+bool odd(const spaceObjectType* asker, const spaceObjectType* candidate) {
+    return candidate->entryNumber % 2;
+}
+
+TEST_F(ProximityTest, Filter) {
+    spaceObjectType* asker = add(0, 0, 0);
+    spaceObjectType* friend1 = add(10, 0, 0, kCanBeHit | kCanBeEngaged);
+    spaceObjectType* foe2 = add(20, 0, 1, kCanBeHit | kCanBeEvaded);
+    spaceObjectType* foe3 = add(30, 0, 2, kCanBeHit | kCanBeEngaged | kCanBeEvaded);
+    spaceObjectType* friend4 = add(40, 0, 0, kCanCollide);
+
+    vector<ProximityResult> found;
+    ProximityFilter filter = kAnything;
+    filter.owner = ProximityFilter::kSameOwner;
+    FindObjectsInRadius(asker, 1000, filter, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(friend1, friend4));
+
+    filter.owner = ProximityFilter::kOtherOwner;
+    FindObjectsInRadius(asker, 1000, filter, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(foe2, foe3));
+
+    filter = kAnything;
+    filter.allAttributes = kCanBeHit | kCanBeEngaged;
+    FindObjectsInRadius(asker, 1000, filter, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(friend1, foe3));
+
+    filter = kAnything;
+    filter.anyAttributes = kCanBeEvaded | kCanCollide;
+    FindObjectsInRadius(asker, 1000, filter, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(foe2, foe3, friend4));
+
+    filter = kAnything;
+    filter.accept = odd;
+    FindObjectsInRadius(asker, 1000, filter, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(friend1, foe3));
+}
+
+TEST_F(ProximityTest, Nearest) {
+    spaceObjectType* asker = add(0, 0, 0);
+    spaceObjectType* far = add(0, 700, 1);
+    spaceObjectType* middle = add(-500, 0, 1);
+    spaceObjectType* near = add(300, 0, 1);
+
+    vector<ProximityResult> found;
+    FindNearestObjects(asker, 2, 1000, kAnything, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(near, middle));
+    FindNearestObjects(asker, 5, 1000, kAnything, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(near, middle, far));
+
+    uint32_t distance = 0;
+    EXPECT_EQ(near, FindNearestObject(asker, 1000, kAnything, &distance));
+    EXPECT_EQ(300 * 300, distance);
+
+    // Nothing found leaves `distance` alone.
+    EXPECT_TRUE(FindNearestObject(asker, 200, kAnything, &distance) == NULL);
+    EXPECT_EQ(300 * 300, distance);
+}
+
+TEST_F(ProximityTest, IgnoresInactiveAndUnconsidered) {
+    spaceObjectType* asker = add(0, 0, 0);
+    spaceObjectType* dead = add(10, 0, 1);
+    add(20, 0, 1, kAppearOnRadar);  // not in the distance grid
+    spaceObjectType* live = add(30, 0, 1);
+    dead->active = kObjectAvailable;
+
+    vector<ProximityResult> found;
+    FindObjectsInRadius(asker, 1000, kAnything, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(live));
+}
+
+TEST_F(ProximityTest, RebuiltAfterChanges) {
+    spaceObjectType* asker = add(0, 0, 0);
+    spaceObjectType* a = add(100, 0, 1);
+
+    vector<ProximityResult> found;
+    FindObjectsInRadius(asker, 1000, kAnything, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(a));
+
+    // Added objects are found without anything else to do.
+    spaceObjectType* b = add(0, 50, 1);
+    FindObjectsInRadius(asker, 1000, kAnything, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(b, a));
+
+    // So are moved ones, once the index is invalidated.  Moving `a` several distance units away
+    // and back checks that it is looked for where it is, not where it was.
+    move(a, 20000, 20000);
+    FindObjectsInRadius(asker, 1000, kAnything, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(b));
+    move(asker, 20000, 19990);
+    FindObjectsInRadius(asker, 1000, kAnything, found);
+    EXPECT_THAT(objects(found), testing::ElementsAre(a));
+}
+
+}  // namespace
+}  // namespace antares
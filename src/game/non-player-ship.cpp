@@ -101,7 +101,7 @@ void NonplayerShipThink( int32_t timePass)
     RgbColor        friendSick, foeSick, neutralSick;
     uint32_t        sickCount = usecs_to_ticks(globals()->gGameTime) / 9;
 
-    globals()->gSynchValue = gRandomSeed.seed;
+    globals()->gSynchValue = globals()->gRandomSeed.seed;
     sickCount &= 0x00000003;
     if ( sickCount == 0)
     {
@@ -136,14 +136,14 @@ void NonplayerShipThink( int32_t timePass)
 
 // it probably doesn't matter what order we do this in, but we'll do it in the "ideal" order anyway
 
-    anObject = gRootObject;
+    anObject = globals()->gRootObject;
 
     while ( anObject != NULL)
     {
         if (anObject->active)
         {
-            globals()->gSynchValue += anObject->location.h;
-            globals()->gSynchValue += anObject->location.v;
+            globals()->gSynchValue += anObject->motion->location.h;
+            globals()->gSynchValue += anObject->motion->location.v;
 
             keysDown = anObject->keysDown & kSpecialKeyMask;
 
@@ -175,7 +175,7 @@ void NonplayerShipThink( int32_t timePass)
             {
                 // get the object's base object
                 baseObject = anObject->baseType;
-                anObject->targetAngle = anObject->directionGoal = anObject->direction;
+                anObject->targetAngle = anObject->directionGoal = anObject->motion->direction;
                 // incremenent its admiral's # of ships
                 if ( anObject->owner > kNoOwner)
                 {
@@ -219,23 +219,23 @@ void NonplayerShipThink( int32_t timePass)
                             if (( anObject->attributes & kIsGuided) &&
                                 ( anObject->targetObjectNumber != kNoShip))
                             {
-                                difference = anObject->targetAngle - anObject->direction;
+                                difference = anObject->targetAngle - anObject->motion->direction;
                                 if (( difference < -60) || ( difference > 60))
                                 {
                                     anObject->targetObjectNumber = kNoShip;
                                     anObject->targetObjectID = kNoShip;
-                                    anObject->directionGoal = anObject->direction;
+                                    anObject->directionGoal = anObject->motion->direction;
                                 }
                             }
 
                             offset.h = mAngleDifference( anObject->directionGoal,
-                                        anObject->direction);
+                                        anObject->motion->direction);
                             offset.v = mFixedToLong( baseObject->frame.rotation.maxTurnRate << 1);
                             difference = ABS( offset.h);
                         } else
                         {
                             offset.h = mAngleDifference( anObject->directionGoal,
-                                        anObject->direction);
+                                        anObject->motion->direction);
                             offset.v = mFixedToLong( kDefaultTurnRate << 1);
                             difference = ABS( offset.h);
                         }
@@ -322,22 +322,22 @@ void NonplayerShipThink( int32_t timePass)
                         {
                             if ( anObject->keysDown & kLeftKey)
                             {
-                                anObject->turnVelocity =
+                                anObject->motion->turnVelocity =
                                     -baseObject->frame.rotation.maxTurnRate;
                             } else if ( anObject->keysDown & kRightKey)
                             {
-                                anObject->turnVelocity =
+                                anObject->motion->turnVelocity =
                                     baseObject->frame.rotation.maxTurnRate;
-                            } else anObject->turnVelocity = 0;
+                            } else anObject->motion->turnVelocity = 0;
                         } else
                         {
                             if ( anObject->keysDown & kLeftKey)
                             {
-                                anObject->turnVelocity = -kDefaultTurnRate;
+                                anObject->motion->turnVelocity = -kDefaultTurnRate;
                             } else if ( anObject->keysDown & kRightKey)
                             {
-                                anObject->turnVelocity = kDefaultTurnRate;
-                            } else anObject->turnVelocity = 0;
+                                anObject->motion->turnVelocity = kDefaultTurnRate;
+                            } else anObject->motion->turnVelocity = 0;
                         }
                 }
 
@@ -348,7 +348,7 @@ void NonplayerShipThink( int32_t timePass)
                         ( anObject->presenceState == kWarpingPresence) ||
                         ( anObject->presenceState == kWarpOutPresence)))
                     {
-                        anObject->thrust = baseObject->maxThrust;
+                        anObject->motion->thrust = baseObject->maxThrust;
                     }
                 } else if ( anObject->keysDown & kDownKey)
                 {
@@ -356,10 +356,10 @@ void NonplayerShipThink( int32_t timePass)
                         ( anObject->presenceState == kWarpingPresence) ||
                         ( anObject->presenceState == kWarpOutPresence)))
                     {
-                        anObject->thrust = -baseObject->maxThrust;
+                        anObject->motion->thrust = -baseObject->maxThrust;
                     }
-                    anObject->thrust = -baseObject->maxThrust;
-                } else anObject->thrust = 0;
+                    anObject->motion->thrust = -baseObject->maxThrust;
+                } else anObject->motion->thrust = 0;
 
                 if ( anObject->rechargeTime < kRechargeSpeed)
                 {
@@ -478,7 +478,7 @@ void NonplayerShipThink( int32_t timePass)
                         if ( anObject->pulsePosition >= baseObject->pulsePositionNum)
                             anObject->pulsePosition = 0;
 
-                        h = anObject->direction;
+                        h = anObject->motion->direction;
                         mAddAngle( h, -90);
                         GetRotPoint(&fcos, &fsin, h);
                         fcos = -fcos;
@@ -515,7 +515,7 @@ void NonplayerShipThink( int32_t timePass)
                         if ( anObject->beamPosition >= baseObject->beamPositionNum)
                             anObject->beamPosition = 0;
 
-                        h = anObject->direction;
+                        h = anObject->motion->direction;
                         mAddAngle( h, -90);
                         GetRotPoint(&fcos, &fsin, h);
                         fcos = -fcos;
@@ -552,7 +552,7 @@ void NonplayerShipThink( int32_t timePass)
                                 baseObject->specialPositionNum)
                             anObject->specialPosition = 0;
 
-                        h = anObject->direction;
+                        h = anObject->motion->direction;
                         mAddAngle( h, -90);
                         GetRotPoint(&fcos, &fsin, h);
                         fcos = -fcos;
@@ -586,7 +586,7 @@ void NonplayerShipThink( int32_t timePass)
                     if (( anObject->presenceState == kWarpingPresence) ||
                         ( anObject->presenceState == kWarpOutPresence))
                     {
-                        anObject->thrust = mMultiplyFixed( baseObject->maxThrust,
+                        anObject->motion->thrust = mMultiplyFixed( baseObject->maxThrust,
                             anObject->presenceData);
                     } else if (( anObject->presenceState == kNormalPresence) &&
                         ( anObject->energy > ( anObject->baseType->energy >> kWarpInEnergyFactor)))
@@ -604,7 +604,7 @@ void NonplayerShipThink( int32_t timePass)
                         anObject->presenceState = kWarpOutPresence;
                     } else if ( anObject->presenceState == kWarpOutPresence)
                     {
-                            anObject->thrust = mMultiplyFixed( baseObject->maxThrust,
+                            anObject->motion->thrust = mMultiplyFixed( baseObject->maxThrust,
                                 anObject->presenceData);
                     }
                 }
@@ -704,7 +704,7 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                         }
                     }
 
-                    anObject->directionGoal = targetObject->direction;
+                    anObject->directionGoal = targetObject->motion->direction;
 
                     if ( targetObject->attributes & kIsGuided)
                     {
@@ -718,14 +718,14 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                         } else
                         {
                             beta = 90;
-                            if ( anObject->location.h & 0x00000001)
+                            if ( anObject->motion->location.h & 0x00000001)
 //                          if (anObject->randomSeed.next(2))
                                 beta = -90;
                             mAddAngle( anObject->directionGoal, beta);
                         }
                         theta =
                             mAngleDifference( anObject->directionGoal,
-                            anObject->direction);
+                            anObject->motion->direction);
                         if ( ABS( theta) < 90)
                         {
                             keysDown |= kUpKey;
@@ -746,12 +746,12 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                         {
                             beta = kEvadeAngle;
 //                          if (anObject->randomSeed.next(2))
-                            if ( anObject->location.h & 0x00000001)
+                            if ( anObject->motion->location.h & 0x00000001)
                                 beta = -kEvadeAngle;
                             mAddAngle( anObject->directionGoal, beta);
                         }
                         theta = mAngleDifference( anObject->directionGoal,
-                            anObject->direction);
+                            anObject->motion->direction);
                         if ( ABS( theta) < kEvadeAngle)
                         {
                             keysDown |= kUpKey;
@@ -766,7 +766,7 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                     if (anObject->randomSeed.next(2)) {
                         beta = -kEvadeAngle;
                     }
-                    mAddAngle( anObject->direction, beta);
+                    mAddAngle( anObject->motion->direction, beta);
                     keysDown |= kUpKey;
                 }
 
@@ -895,7 +895,7 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                         }
 
                         anObject->directionGoal =
-                            targetObject->direction;
+                            targetObject->motion->direction;
 
                         if ( theta > 0)
                         {
@@ -908,12 +908,12 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                         {
                             beta = kEvadeAngle;
 //                          if (anObject->randomSeed.next(2))
-                            if ( anObject->location.h & 0x00000001)
+                            if ( anObject->motion->location.h & 0x00000001)
                                 beta = -kEvadeAngle;
                             mAddAngle( anObject->directionGoal, beta);
                         }
                         theta = mAngleDifference( anObject->directionGoal,
-                            anObject->direction);
+                            anObject->motion->direction);
                         if ( ABS( theta) < kEvadeAngle)
                         {
                             keysDown |= kUpKey;
@@ -927,7 +927,7 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                         if (anObject->randomSeed.next(2)) {
                             beta = -kEvadeAngle;
                         }
-                        mAddAngle( anObject->direction, beta);
+                        mAddAngle( anObject->motion->direction, beta);
                         keysDown |= kUpKey;
                     }
                 }
@@ -958,8 +958,8 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                             if ( targetObject->seenByPlayerFlags &
                                 anObject->myPlayerFlag)
                             {
-                                dest.h = targetObject->location.h;
-                                dest.v = targetObject->location.v;
+                                dest.h = targetObject->motion->location.h;
+                                dest.v = targetObject->motion->location.v;
                                 anObject->destinationLocation.h =
                                     dest.h;
                                 anObject->destinationLocation.v =
@@ -984,8 +984,8 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                             anObject->destObjectDest = kNoDestinationObject;
                             anObject->destinationObject =
                                 kNoDestinationObject;
-                            dest.h = anObject->location.h;
-                            dest.v = anObject->location.v;
+                            dest.h = anObject->motion->location.h;
+                            dest.v = anObject->motion->location.v;
                             if (anObject->attributes & kOnAutoPilot)
                             {
                                 TogglePlayerAutoPilot( anObject);
@@ -1009,8 +1009,8 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                                 anObject->destObjectDest =
                                     targetObject->destinationObject;
                                 anObject->destObjectDestID = targetObject->destObjectID;
-                                dest.h = targetObject->location.h;
-                                dest.v = targetObject->location.v;
+                                dest.h = targetObject->motion->location.h;
+                                dest.v = targetObject->motion->location.v;
                             } else
                             {
                                 anObject->duty = eNoDuty;
@@ -1019,8 +1019,8 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                                     kNoDestinationObject;
                                 anObject->destObjectDest = kNoDestinationObject;
                                 anObject->destObjectPtr = NULL;
-                                dest.h = anObject->location.h;
-                                dest.v = anObject->location.v;
+                                dest.h = anObject->motion->location.h;
+                                dest.v = anObject->motion->location.v;
                                 if (anObject->attributes & kOnAutoPilot)
                                 {
                                     TogglePlayerAutoPilot( anObject);
@@ -1049,12 +1049,12 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                         anObject->directionGoal = angle;
                     }
 
-                    theta = mAngleDifference( anObject->direction,
+                    theta = mAngleDifference( anObject->motion->direction,
                             anObject->directionGoal);
                     theta = ABS( theta);
                 } else
                 {
-                    anObject->direction = angle;
+                    anObject->motion->direction = angle;
                     theta = 0;
                 }
 
@@ -1093,11 +1093,11 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
                              anObject->attributes & kHasDirectionGoal))
                     {
                         anObject->directionGoal =
-                            targetObject->direction;
+                            targetObject->motion->direction;
                         if (( targetObject->keysDown & kWarpKey) &&
                             ( baseObject->warpSpeed > 0))
                         {
-                            theta = mAngleDifference( anObject->direction, targetObject->direction);
+                            theta = mAngleDifference( anObject->motion->direction, targetObject->motion->direction);
                             if ( ABS( theta) < kDirectionError)
                                 keysDown |= kWarpKey;
                         }
@@ -1209,16 +1209,16 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
 
                     dcalc = lsqrt( distance);
 
-                    calcv = targetObject->velocity.h -
-                        anObject->velocity.h;
+                    calcv = targetObject->motion->velocity.h -
+                        anObject->motion->velocity.h;
                     fdist = mLongToFixed( dcalc);
                     fdist = mMultiplyFixed( bestWeapon->frame.weapon.inverseSpeed, fdist);
                     calcv = mMultiplyFixed( calcv, fdist);
                     difference = mFixedToLong( calcv);
                     dest.h -= difference;
 
-                    calcv = targetObject->velocity.v -
-                        anObject->velocity.v;
+                    calcv = targetObject->motion->velocity.v -
+                        anObject->motion->velocity.v;
                     calcv = mMultiplyFixed( calcv, fdist);
                     difference = mFixedToLong( calcv);
                     dest.v -= difference;
@@ -1227,14 +1227,14 @@ uint32_t ThinkObjectNormalPresence( spaceObjectType *anObject, baseObjectType *b
 
             // this is human controlled--if it's too far away, tough nougies
             // find angle between me & dest
-            slope = MyFixRatio(anObject->location.h - dest.h,
-                        anObject->location.v - dest.v);
+            slope = MyFixRatio(anObject->motion->location.h - dest.h,
+                        anObject->motion->location.v - dest.v);
             angle = AngleFromSlope( slope);
 
-            if ( dest.h < anObject->location.h)
+            if ( dest.h < anObject->motion->location.h)
                 mAddAngle( angle, 180);
-            else if (( anObject->location.h == dest.h) &&
-                    ( dest.v < anObject->location.v))
+            else if (( anObject->motion->location.h == dest.h) &&
+                    ( dest.v < anObject->motion->location.v))
                 angle = 0;
 
             if ( targetObject->cloakState > 250)
@@ -1303,12 +1303,12 @@ uint32_t ThinkObjectWarpInPresence( spaceObjectType *anObject)
             anObject->attributes &= ~kOccupiesSpace;
             newVel.h = newVel.v = 0;
     /*
-            CreateAnySpaceObject( globals()->scenarioFileInfo.warpInFlareID, &(newVel),
+            CreateAnySpaceObject( plugin()->scenarioFileInfo.warpInFlareID, &(newVel),
                 &(anObject->location), anObject->direction, kNoOwner,
                 0, nil, -1, -1, -1);
     */
-            CreateAnySpaceObject( globals()->scenarioFileInfo.warpInFlareID, &(newVel),
-                &(anObject->location), anObject->direction, kNoOwner,
+            CreateAnySpaceObject( plugin()->scenarioFileInfo.warpInFlareID, &(newVel),
+                &(anObject->motion->location), anObject->motion->direction, kNoOwner,
                 0, -1);
         }
     }
@@ -1343,7 +1343,7 @@ uint32_t ThinkObjectWarpingPresence( spaceObjectType *anObject)
             }
         } else
         {
-            anObject->direction = angle;
+            anObject->motion->direction = angle;
         }
 
         if ( distance < anObject->baseType->warpOutDistance)
@@ -1371,7 +1371,7 @@ uint32_t ThinkObjectWarpOutPresence( spaceObjectType *anObject, baseObjectType *
     fixedPointType  newVel;
 
     anObject->presenceData -= mLongToFixed(kWarpAcceleration);
-    if ( anObject->presenceData < anObject->maxVelocity)
+    if ( anObject->presenceData < anObject->motion->maxVelocity)
     {
         AlterObjectBattery( anObject, anObject->warpEnergyCollected);
         anObject->warpEnergyCollected = 0;
@@ -1382,19 +1382,19 @@ uint32_t ThinkObjectWarpOutPresence( spaceObjectType *anObject, baseObjectType *
 
         // warp out
 
-        GetRotPoint(&fdist, &calcv, anObject->direction);
+        GetRotPoint(&fdist, &calcv, anObject->motion->direction);
 
         // multiply by max velocity
 
-        fdist = mMultiplyFixed( anObject->maxVelocity, fdist);
-        calcv = mMultiplyFixed( anObject->maxVelocity, calcv);
-        anObject->velocity.h = fdist;
-        anObject->velocity.v = calcv;
+        fdist = mMultiplyFixed( anObject->motion->maxVelocity, fdist);
+        calcv = mMultiplyFixed( anObject->motion->maxVelocity, calcv);
+        anObject->motion->velocity.h = fdist;
+        anObject->motion->velocity.v = calcv;
         newVel.h = newVel.v = 0;
 
 
-        CreateAnySpaceObject( globals()->scenarioFileInfo.warpOutFlareID, &(newVel),
-            &(anObject->location), anObject->direction, kNoOwner, 0,
+        CreateAnySpaceObject( plugin()->scenarioFileInfo.warpOutFlareID, &(newVel),
+            &(anObject->motion->location), anObject->motion->direction, kNoOwner, 0,
             -1);
     }
     return( keysDown);
@@ -1434,8 +1434,8 @@ uint32_t ThinkObjectLandingPresence( spaceObjectType *anObject)
                 if ( targetObject->seenByPlayerFlags &
                     anObject->myPlayerFlag)
                 {
-                    dest.h = targetObject->location.h;
-                    dest.v = targetObject->location.v;
+                    dest.h = targetObject->motion->location.h;
+                    dest.v = targetObject->motion->location.v;
                     anObject->destinationLocation.h = dest.h;
                     anObject->destinationLocation.v = dest.v;
                 } else
@@ -1455,8 +1455,8 @@ uint32_t ThinkObjectLandingPresence( spaceObjectType *anObject)
                     keysDown |= kDownKey;
                     anObject->destinationObject = kNoDestinationObject;
                     anObject->destObjectDest = kNoDestinationObject;
-                    dest.h = anObject->location.h;
-                    dest.v = anObject->location.v;
+                    dest.h = anObject->motion->location.h;
+                    dest.v = anObject->motion->location.v;
                 } else
                 {
                     anObject->destinationObject =
@@ -1474,8 +1474,8 @@ uint32_t ThinkObjectLandingPresence( spaceObjectType *anObject)
                         anObject->destObjectDest =
                             targetObject->destinationObject;
                         anObject->destObjectDestID = targetObject->destObjectID;
-                        dest.h = targetObject->location.h;
-                        dest.v = targetObject->location.v;
+                        dest.h = targetObject->motion->location.h;
+                        dest.v = targetObject->motion->location.v;
                     } else
                     {
                         keysDown |= kDownKey;
@@ -1483,8 +1483,8 @@ uint32_t ThinkObjectLandingPresence( spaceObjectType *anObject)
                             kNoDestinationObject;
                         anObject->destObjectDest = kNoDestinationObject;
                         anObject->destObjectPtr = NULL;
-                        dest.h = anObject->location.h;
-                        dest.v = anObject->location.v;
+                        dest.h = anObject->motion->location.h;
+                        dest.v = anObject->motion->location.v;
                     }
                 }
             }
@@ -1495,13 +1495,13 @@ uint32_t ThinkObjectLandingPresence( spaceObjectType *anObject)
                 TogglePlayerAutoPilot( anObject);
             }
             targetObject = NULL;
-            dest.h = anObject->location.h;
-            dest.v = anObject->location.v;
+            dest.h = anObject->motion->location.h;
+            dest.v = anObject->motion->location.v;
         }
 
-        difference = ABS<int>( dest.h - anObject->location.h);
+        difference = ABS<int>( dest.h - anObject->motion->location.h);
         dcalc = difference;
-        difference =  ABS<int>( dest.v - anObject->location.v);
+        difference =  ABS<int>( dest.v - anObject->motion->location.v);
         distance = difference;
         if (( dcalc > kMaximumAngleDistance) ||
             ( distance > kMaximumAngleDistance))
@@ -1514,8 +1514,8 @@ uint32_t ThinkObjectLandingPresence( spaceObjectType *anObject)
             {
                 distance = distance * distance + dcalc * dcalc;
             }
-            shortx = (anObject->location.h - dest.h) >> 4;
-            shorty = (anObject->location.v - dest.v) >> 4;
+            shortx = (anObject->motion->location.h - dest.h) >> 4;
+            shorty = (anObject->motion->location.v - dest.v) >> 4;
             // find angle between me & dest
             slope = MyFixRatio( shortx, shorty);
             angle = AngleFromSlope( slope);
@@ -1532,14 +1532,14 @@ uint32_t ThinkObjectLandingPresence( spaceObjectType *anObject)
             distance = distance * distance + dcalc * dcalc;
 
             // find angle between me & dest
-            slope = MyFixRatio(anObject->location.h - dest.h,
-                        anObject->location.v - dest.v);
+            slope = MyFixRatio(anObject->motion->location.h - dest.h,
+                        anObject->motion->location.v - dest.v);
             angle = AngleFromSlope( slope);
 
-            if ( dest.h < anObject->location.h)
+            if ( dest.h < anObject->motion->location.h)
                 mAddAngle( angle, 180);
-            else if (( anObject->location.h == dest.h) &&
-                    ( dest.v < anObject->location.v))
+            else if (( anObject->motion->location.h == dest.h) &&
+                    ( dest.v < anObject->motion->location.v))
                 angle = 0;
         }
 
@@ -1552,12 +1552,12 @@ uint32_t ThinkObjectLandingPresence( spaceObjectType *anObject)
 
             }
 
-            theta = mAngleDifference( anObject->direction,
+            theta = mAngleDifference( anObject->motion->direction,
                     anObject->directionGoal);
             theta = ABS( theta);
         } else
         {
-            anObject->direction = angle;
+            anObject->motion->direction = angle;
             theta = 0;
         }
 
@@ -1614,13 +1614,13 @@ void ThinkObjectGetCoordVector( spaceObjectType *anObject, coordPointType *dest,
     int16_t         shortx, shorty;
     Fixed           slope;
 
-    difference = ABS<int>( dest->h - anObject->location.h);
+    difference = ABS<int>( dest->h - anObject->motion->location.h);
     dcalc = difference;
-    difference =  ABS<int>( dest->v - anObject->location.v);
+    difference =  ABS<int>( dest->v - anObject->motion->location.v);
     *distance = difference;
     if (( *distance == 0) && ( dcalc == 0))
     {
-        *angle = anObject->direction;
+        *angle = anObject->motion->direction;
         return;
     }
 
@@ -1635,8 +1635,8 @@ void ThinkObjectGetCoordVector( spaceObjectType *anObject, coordPointType *dest,
         {
             *distance = *distance * *distance + dcalc * dcalc;
         }
-        shortx = (anObject->location.h - dest->h) >> 4;
-        shorty = (anObject->location.v - dest->v) >> 4;
+        shortx = (anObject->motion->location.h - dest->h) >> 4;
+        shorty = (anObject->motion->location.v - dest->v) >> 4;
         // find angle between me & dest
         slope = MyFixRatio( shortx, shorty);
         *angle = AngleFromSlope( slope);
@@ -1653,14 +1653,14 @@ void ThinkObjectGetCoordVector( spaceObjectType *anObject, coordPointType *dest,
         *distance = *distance * *distance + dcalc * dcalc;
 
         // find angle between me & dest
-        slope = MyFixRatio(anObject->location.h - dest->h,
-                    anObject->location.v - dest->v);
+        slope = MyFixRatio(anObject->motion->location.h - dest->h,
+                    anObject->motion->location.v - dest->v);
         *angle = AngleFromSlope( slope);
 
-        if ( dest->h < anObject->location.h)
+        if ( dest->h < anObject->motion->location.h)
             mAddAngle( *angle, 180);
-        else if (( anObject->location.h == dest->h) &&
-                ( dest->v < anObject->location.v))
+        else if (( anObject->motion->location.h == dest->h) &&
+                ( dest->v < anObject->motion->location.v))
             *angle = 0;
     }
 }
@@ -1670,9 +1670,9 @@ void ThinkObjectGetCoordDistance( spaceObjectType *anObject, coordPointType *des
     int32_t         difference;
     uint32_t        dcalc;
 
-    difference = ABS<int>( dest->h - anObject->location.h);
+    difference = ABS<int>( dest->h - anObject->motion->location.h);
     dcalc = difference;
-    difference =  ABS<int>( dest->v - anObject->location.v);
+    difference =  ABS<int>( dest->v - anObject->motion->location.v);
     *distance = difference;
     if (( *distance == 0) && ( dcalc == 0))
     {
@@ -1709,8 +1709,8 @@ void ThinkObjectResolveDestination( spaceObjectType *anObject, coordPointType *d
         {
             TogglePlayerAutoPilot( anObject);
         }
-        dest->h = anObject->location.h;
-        dest->v = anObject->location.v;
+        dest->h = anObject->motion->location.h;
+        dest->v = anObject->motion->location.v;
     } else
     {
         if ( anObject->destinationObject != kNoDestinationObject)
@@ -1722,8 +1722,8 @@ void ThinkObjectResolveDestination( spaceObjectType *anObject, coordPointType *d
                 if ( (*targetObject)->seenByPlayerFlags &
                     anObject->myPlayerFlag)
                 {
-                    dest->h = (*targetObject)->location.h;
-                    dest->v = (*targetObject)->location.v;
+                    dest->h = (*targetObject)->motion->location.h;
+                    dest->v = (*targetObject)->motion->location.v;
                     anObject->destinationLocation.h = dest->h;
                     anObject->destinationLocation.v = dest->v;
                 } else
@@ -1742,8 +1742,8 @@ void ThinkObjectResolveDestination( spaceObjectType *anObject, coordPointType *d
                 {
                     anObject->destinationObject = kNoDestinationObject;
                     anObject->destObjectDest = kNoDestinationObject;
-                    dest->h = anObject->location.h;
-                    dest->v = anObject->location.v;
+                    dest->h = anObject->motion->location.h;
+                    dest->v = anObject->motion->location.v;
                 } else
                 {
                     anObject->destinationObject =
@@ -1761,8 +1761,8 @@ void ThinkObjectResolveDestination( spaceObjectType *anObject, coordPointType *d
                         anObject->destObjectDest =
                             (*targetObject)->destinationObject;
                         anObject->destObjectDestID = (*targetObject)->destObjectID;
-                        dest->h = (*targetObject)->location.h;
-                        dest->v = (*targetObject)->location.v;
+                        dest->h = (*targetObject)->motion->location.h;
+                        dest->v = (*targetObject)->motion->location.v;
                     } else
                     {
                         anObject->duty = eNoDuty;
@@ -1770,8 +1770,8 @@ void ThinkObjectResolveDestination( spaceObjectType *anObject, coordPointType *d
                             kNoDestinationObject;
                         anObject->destObjectDest = kNoDestinationObject;
                         anObject->destObjectPtr = NULL;
-                        dest->h = anObject->location.h;
-                        dest->v = anObject->location.v;
+                        dest->h = anObject->motion->location.h;
+                        dest->v = anObject->motion->location.v;
                     }
                 }
             }
@@ -1784,8 +1784,8 @@ void ThinkObjectResolveDestination( spaceObjectType *anObject, coordPointType *d
                 {
                     TogglePlayerAutoPilot( anObject);
                 }
-                dest->h = anObject->location.h;
-                dest->v = anObject->location.v;
+                dest->h = anObject->motion->location.h;
+                dest->v = anObject->motion->location.v;
             } else
             {
                 dest->h = anObject->destinationLocation.h;
@@ -1818,7 +1818,7 @@ bool ThinkObjectResolveTarget( spaceObjectType *anObject, coordPointType *dest,
             // select closest object as target (and for now be satisfied with our direction
             if ( anObject->attributes & kHasDirectionGoal)
             {
-                anObject->directionGoal = anObject->direction;
+                anObject->directionGoal = anObject->motion->direction;
             }
             anObject->targetObjectNumber = anObject->closestObject;
             anObject->targetObjectID = closestObject->id;
@@ -1827,8 +1827,8 @@ bool ThinkObjectResolveTarget( spaceObjectType *anObject, coordPointType *dest,
             closestObject = *targetObject = NULL;
             anObject->targetObjectNumber = kNoShip;
             anObject->targetObjectID = kNoShip;
-            dest->h = anObject->location.h;
-            dest->v = anObject->location.v;
+            dest->h = anObject->motion->location.h;
+            dest->v = anObject->motion->location.v;
             *distance = anObject->engageRange;
             return ( false);
         }
@@ -1877,8 +1877,8 @@ bool ThinkObjectResolveTarget( spaceObjectType *anObject, coordPointType *dest,
                     *targetObject = NULL;
                     anObject->targetObjectNumber = kNoShip;
                     anObject->targetObjectID = kNoShip;
-                    dest->h = anObject->location.h;
-                    dest->v = anObject->location.v;
+                    dest->h = anObject->motion->location.h;
+                    dest->v = anObject->motion->location.v;
                     *distance = anObject->engageRange;
                     return ( false);
                 }
@@ -1887,8 +1887,8 @@ bool ThinkObjectResolveTarget( spaceObjectType *anObject, coordPointType *dest,
                 closestObject = *targetObject = NULL;
                 anObject->targetObjectNumber = kNoShip;
                 anObject->targetObjectID = kNoShip;
-                dest->h = anObject->location.h;
-                dest->v = anObject->location.v;
+                dest->h = anObject->motion->location.h;
+                dest->v = anObject->motion->location.v;
                 *distance = anObject->engageRange;
                 return ( false);
             }
@@ -1900,7 +1900,7 @@ bool ThinkObjectResolveTarget( spaceObjectType *anObject, coordPointType *dest,
                     ( !(targetObject->active))) &&
                     ( anObject->closestObject != kNoShip))
                 {
-                    closestObject = gSpaceObjectData.get() + anObject->closestObject;
+                    closestObject = globals()->gSpaceObjectData.get() + anObject->closestObject;
                     if ( ( closestObject->attributes & kHated))
                     {
                         targetObject = closestObject;
@@ -1912,8 +1912,8 @@ bool ThinkObjectResolveTarget( spaceObjectType *anObject, coordPointType *dest,
             }
         }*/
 
-        dest->h = (*targetObject)->location.h;
-        dest->v = (*targetObject)->location.v;
+        dest->h = (*targetObject)->motion->location.h;
+        dest->v = (*targetObject)->motion->location.v;
 
         // if it's not the closest object & we have a closest object
         if ((anObject->closestObject != kNoShip) &&
@@ -1932,8 +1932,8 @@ bool ThinkObjectResolveTarget( spaceObjectType *anObject, coordPointType *dest,
                 anObject->targetObjectNumber = anObject->closestObject;
                 *targetObject = mGetSpaceObjectPtr(anObject->targetObjectNumber);
                 anObject->targetObjectID = (*targetObject)->id;
-                dest->h = (*targetObject)->location.h;
-                dest->v = (*targetObject)->location.v;
+                dest->h = (*targetObject)->motion->location.h;
+                dest->v = (*targetObject)->motion->location.v;
                 *distance = anObject->closestDistance;
                 if ( (*targetObject)->cloakState > 250)
                 {
@@ -1954,8 +1954,8 @@ bool ThinkObjectResolveTarget( spaceObjectType *anObject, coordPointType *dest,
         closestObject = *targetObject = NULL;
         anObject->targetObjectNumber = kNoShip;
         anObject->targetObjectID = kNoShip;
-        dest->h = anObject->location.h;
-        dest->v = anObject->location.v;
+        dest->h = anObject->motion->location.h;
+        dest->v = anObject->motion->location.v;
         *distance = anObject->engageRange;
         return ( false);
     }
@@ -1973,8 +1973,8 @@ uint32_t ThinkObjectEngageTarget( spaceObjectType *anObject, spaceObjectType *ta
 
     *theta = 0xffff;
 
-    dest.h = targetObject->location.h;
-    dest.v = targetObject->location.v;
+    dest.h = targetObject->motion->location.h;
+    dest.v = targetObject->motion->location.v;
     if ( targetObject->cloakState > 250)
     {
         dest.h -= 70;
@@ -2047,14 +2047,14 @@ uint32_t ThinkObjectEngageTarget( spaceObjectType *anObject, spaceObjectType *ta
 
     // We don't need to worry if it is very far away, since it must be within farthest weapon range
     // find angle between me & dest
-    slope = MyFixRatio(anObject->location.h - dest.h,
-                anObject->location.v - dest.v);
+    slope = MyFixRatio(anObject->motion->location.h - dest.h,
+                anObject->motion->location.v - dest.v);
     angle = AngleFromSlope( slope);
 
-    if ( dest.h < anObject->location.h)
+    if ( dest.h < anObject->motion->location.h)
         mAddAngle( angle, 180);
-    else if (( anObject->location.h == dest.h) &&
-            ( dest.v < anObject->location.v))
+    else if (( anObject->motion->location.h == dest.h) &&
+            ( dest.v < anObject->motion->location.v))
         angle = 0;
 
     if ( targetObject->cloakState > 250)
@@ -2074,12 +2074,12 @@ uint32_t ThinkObjectEngageTarget( spaceObjectType *anObject, spaceObjectType *ta
 
         }
 
-        beta = targetObject->direction;
+        beta = targetObject->motion->direction;
         mAddAngle( beta, ROT_180);
         *theta = mAngleDifference( beta, angle);
     } else
     {
-        anObject->direction = angle;
+        anObject->motion->direction = angle;
         *theta = 0;
     }
 
@@ -2088,7 +2088,7 @@ uint32_t ThinkObjectEngageTarget( spaceObjectType *anObject, spaceObjectType *ta
         ( targetObject->attributes & kHated))
     {
         // fire away
-        beta = anObject->direction;
+        beta = anObject->motion->direction;
         beta = mAngleDifference( beta, angle);
 
         if ( anObject->pulseType != kNoWeapon)
@@ -2213,14 +2213,14 @@ int32_t GetManualSelectObject(
         anObject = mGetSpaceObjectPtr(startShip);
         if ( anObject->active != kObjectInUse) // if it's not in the loop
         {
-            anObject = gRootObject;
-            startShip = whichShip = gRootObjectNumber;
+            anObject = globals()->gRootObject;
+            startShip = whichShip = globals()->gRootObjectNumber;
         }
 
     } else
     {
-        anObject = gRootObject;
-        startShip = whichShip = gRootObjectNumber;
+        anObject = globals()->gRootObject;
+        startShip = whichShip = globals()->gRootObjectNumber;
     }
 
     do
@@ -2233,9 +2233,9 @@ int32_t GetManualSelectObject(
             ( anObject->owner != sourceObject->owner)) || (( friendOrFoe > 0) &&
             ( anObject->owner == sourceObject->owner)) || ( friendOrFoe == 0)))
         {
-            difference = ABS<int>( sourceObject->location.h - anObject->location.h);
+            difference = ABS<int>( sourceObject->motion->location.h - anObject->motion->location.h);
             dcalc = difference;
-            difference =  ABS<int>( sourceObject->location.v - anObject->location.v);
+            difference =  ABS<int>( sourceObject->motion->location.v - anObject->motion->location.v);
             distance = difference;
 
             if (( dcalc > kMaximumRelevantDistance) ||
@@ -2267,8 +2267,8 @@ int32_t GetManualSelectObject(
 
             if ( thisDistanceState)
             {
-                hdif = sourceObject->location.h - anObject->location.h;
-                vdif = sourceObject->location.v - anObject->location.v;
+                hdif = sourceObject->motion->location.h - anObject->motion->location.h;
+                vdif = sourceObject->motion->location.v - anObject->motion->location.v;
                 while (((ABS(hdif)) > kMaximumAngleDistance) || ( (ABS(vdif)) > kMaximumAngleDistance))
                 {
                     hdif >>= 1;
@@ -2306,8 +2306,8 @@ int32_t GetManualSelectObject(
         anObject = anObject->nextObject;
         if ( anObject == NULL)
         {
-            whichShip = gRootObjectNumber;
-            anObject = gRootObject;
+            whichShip = globals()->gRootObjectNumber;
+            anObject = globals()->gRootObject;
         }
     } while ( whichShip != startShip);
     if ((( resultShip == -1) && ( closestShip != -1)) || ( resultShip == currentShipNum)) resultShip = closestShip;
@@ -2324,7 +2324,8 @@ int32_t GetSpritePointSelectObject( Rect *bounds, spaceObjectType *sourceObject,
     uint32_t        myOwnerFlag = 1 << sourceObject->owner;
 
 
-    for (int32_t whichShip = 0; whichShip < kMaxSpaceObject; whichShip++) {
+    for (int32_t whichShip = NextSpaceObjectSlot(-1); whichShip >= 0;
+            whichShip = NextSpaceObjectSlot(whichShip)) {
         spaceObjectType* anObject = mGetSpaceObjectPtr(whichShip);
         if (( anObject->active) && ( anObject->sprite != NULL) &&
             ( anObject->seenByPlayerFlags & myOwnerFlag) &&
@@ -51,9 +51,13 @@
 using sfz::Exception;
 using sfz::BytesSlice;
 using sfz::PrintTarget;
+using sfz::ReadSource;
 using sfz::String;
 using sfz::StringSlice;
+using sfz::WriteTarget;
 using sfz::format;
+using sfz::read;
+using sfz::write;
 
 namespace macroman = sfz::macroman;
 
@@ -73,12 +77,6 @@ void Update_LabelStrings_ForHotKeyChange( void);
 
 namespace {
 
-static KeyMap gLastKeyMap;
-static int32_t gDestKeyTime = 0;
-static int32_t gDestinationLabel = -1;
-static int32_t gAlarmCount = -1;
-static int32_t gSendMessageLabel = -1;
-
 struct HotKeySuffix {
     spaceObjectType* space_object;
 };
@@ -109,13 +107,13 @@ HotKeySuffix hot_key_suffix(spaceObjectType* space_object) {
 void ResetPlayerShip(int32_t which) {
     globals()->gPlayerShipNumber = which;
     globals()->gSelectionLabel = Labels::add(0, 0, 0, 10, NULL, true, YELLOW);
-    gDestinationLabel = Labels::add(0, 0, 0, -20, NULL, true, SKY_BLUE);
-    gSendMessageLabel = Labels::add(200, 200, 0, 30, NULL, false, GREEN);
+    globals()->gDestinationLabel = Labels::add(0, 0, 0, -20, NULL, true, SKY_BLUE);
+    globals()->gSendMessageLabel = Labels::add(200, 200, 0, 30, NULL, false, GREEN);
     globals()->starfield.reset(globals()->gPlayerShipNumber);
-    gAlarmCount = -1;
+    globals()->gAlarmCount = -1;
     globals()->gAutoPilotOff = true;
     globals()->keyMask = 0;
-    gLastKeyMap.clear();
+    globals()->gLastKeyMap.clear();
     globals()->gLastMessageKeyMap.clear();
     globals()->gZoomMode = kNearestFoeZoom;
     globals()->gKeyMapBufferTop = globals()->gKeyMapBufferBottom = 0;
@@ -138,6 +136,32 @@ PlayerShip::PlayerShip():
     _control_active(false),
     _control_direction(0) { }
 
+void read_from(ReadSource in, PlayerShip& ship) {
+    read(in, ship.gTheseKeys);
+    read(in, ship._gamepad_keys);
+    read(in, ship.gLastKeys);
+    read(in, ship._keys);
+    ship._gamepad_state = static_cast<PlayerShip::GamepadState>(read<int32_t>(in));
+    ship._control_active = read<uint8_t>(in);
+    read(in, ship._control_direction);
+    read(in, globals()->gLastKeyMap);
+    read(in, globals()->gDestKeyTime);
+    read(in, globals()->gAlarmCount);
+}
+
+void write_to(WriteTarget out, const PlayerShip& ship) {
+    write(out, ship.gTheseKeys);
+    write(out, ship._gamepad_keys);
+    write(out, ship.gLastKeys);
+    write(out, ship._keys);
+    write<int32_t>(out, ship._gamepad_state);
+    write<uint8_t>(out, ship._control_active);
+    write(out, ship._control_direction);
+    write(out, globals()->gLastKeyMap);
+    write(out, globals()->gDestKeyTime);
+    write(out, globals()->gAlarmCount);
+}
+
 void PlayerShip::update_keys(const KeyMap& keys) {
     for (int i = 0; i < 256; ++i) {
         if (keys.get(i) && ! _keys.get(i)) {
@@ -212,9 +236,9 @@ static void pick_object(
     uint64_t huge_distance;
     if (select_ship_num >= 0) {
         spaceObjectType* select_ship = mGetSpaceObjectPtr(select_ship_num);
-        uint32_t difference = ABS<int>(origin_ship->location.h - select_ship->location.h);
+        uint32_t difference = ABS<int>(origin_ship->motion->location.h - select_ship->motion->location.h);
         uint32_t dcalc = difference;
-        difference =  ABS<int>(origin_ship->location.v - select_ship->location.v);
+        difference =  ABS<int>(origin_ship->motion->location.v - select_ship->motion->location.v);
         uint32_t distance = difference;
 
         if ((dcalc > kMaximumRelevantDistance)
@@ -563,7 +587,7 @@ void PlayerShip::update(int64_t timePass, const GameCursor& cursor, bool enter_m
             globals()->gKeyMapBufferBottom = 0;
         }
         if (*enterMessage) {
-            String* message = Labels::get_string(gSendMessageLabel);
+            String* message = Labels::get_string(globals()->gSendMessageLabel);
             if (message->empty()) {
                 message->assign("<>");
             }
@@ -590,11 +614,11 @@ void PlayerShip::update(int64_t timePass, const GameCursor& cursor, bool enter_m
 #endif  // NETSPROCKET_AVAILABLE
                 }
                 Labels::set_position(
-                        gSendMessageLabel,
+                        globals()->gSendMessageLabel,
                         viewport.left + ((viewport.width() / 2)),
                         viewport.top + ((play_screen.height() / 2)) +
                         kSendMessageVOffset);
-                Labels::recalc_size(gSendMessageLabel);
+                Labels::recalc_size(globals()->gSendMessageLabel);
             } else {
                 if ((mDeleteKey(*bufMap)) || (mLeftArrowKey(*bufMap))) {
                     if (message->size() > 2) {
@@ -623,8 +647,8 @@ void PlayerShip::update(int64_t timePass, const GameCursor& cursor, bool enter_m
                 {
                     strlen -= (strlen + width) - (viewport.right);
                 }
-                Labels::recalc_size(gSendMessageLabel);
-                Labels::set_position(gSendMessageLabel, strlen, viewport.top +
+                Labels::recalc_size(globals()->gSendMessageLabel);
+                Labels::set_position(globals()->gSendMessageLabel, strlen, viewport.top +
                     ((play_screen.height() / 2) + kSendMessageVOffset));
             }
         } else {
@@ -647,20 +671,20 @@ void PlayerShip::update(int64_t timePass, const GameCursor& cursor, bool enter_m
     }
 
     if (theShip->health < (theShip->baseType->health >> 2L)) {
-         if (gAlarmCount < 0) {
+         if (globals()->gAlarmCount < 0) {
             PlayVolumeSound(kKlaxon, kMaxSoundVolume, kLongPersistence, kMustPlaySound);
-            gAlarmCount = 0;
+            globals()->gAlarmCount = 0;
             Messages::set_status("WARNING: Shields Low", kStatusWarnColor);
          } else {
-            gAlarmCount += timePass;
-            if (gAlarmCount > 125) {
+            globals()->gAlarmCount += timePass;
+            if (globals()->gAlarmCount > 125) {
                 PlayVolumeSound(kKlaxon, kMediumVolume, kMediumLongPersistence, kPrioritySound);
-                gAlarmCount = 0;
+                globals()->gAlarmCount = 0;
                 Messages::set_status("WARNING: Shields Low", kStatusWarnColor);
             }
         }
     } else {
-        gAlarmCount = -1;
+        globals()->gAlarmCount = -1;
     }
 
     if (!(theShip->attributes & kIsHumanControlled)) {
@@ -672,7 +696,7 @@ void PlayerShip::update(int64_t timePass, const GameCursor& cursor, bool enter_m
     minicomputer_handle_keys(gTheseKeys, gLastKeys, false);
 
     if ((mMessageNextKey(_keys))
-            && (!(mMessageNextKey(gLastKeyMap)))
+            && (!(mMessageNextKey(globals()->gLastKeyMap)))
             && (!enter_message)) {
         Messages::advance();
     }
@@ -681,11 +705,11 @@ void PlayerShip::update(int64_t timePass, const GameCursor& cursor, bool enter_m
     attributes = gTheseKeys & dcalc;
 
     if (gTheseKeys & kDestinationKey) {
-        if (gDestKeyTime >= 0) {
-            gDestKeyTime += timePass;
+        if (globals()->gDestKeyTime >= 0) {
+            globals()->gDestKeyTime += timePass;
         }
     } else {
-        if (gDestKeyTime > 45) {
+        if (globals()->gDestKeyTime > 45) {
             if ((theShip->attributes & kCanBeDestination)
                     && (!globals()->destKeyUsedForSelection)) {
                 if (!NETWORK_ON) {
@@ -703,7 +727,7 @@ void PlayerShip::update(int64_t timePass, const GameCursor& cursor, bool enter_m
                 }
             }
         }
-        gDestKeyTime = 0;
+        globals()->gDestKeyTime = 0;
         globals()->destKeyUsedForSelection = false;
     }
 
@@ -779,20 +803,20 @@ void PlayerShip::update(int64_t timePass, const GameCursor& cursor, bool enter_m
 
     // for this we check lastKeys against theseKeys & relevent keys now being pressed
     if ((attributes) && (!(gLastKeys & attributes)) && (!cursor.active())) {
-        gDestKeyTime = -1;
+        globals()->gDestKeyTime = -1;
         if (gTheseKeys & kSelectFriendKey) {
             if (!(gTheseKeys & kDestinationKey)) {
-                select_friendly(theShip, theShip->direction);
+                select_friendly(theShip, theShip->motion->direction);
             } else {
-                target_friendly(theShip, theShip->direction);
+                target_friendly(theShip, theShip->motion->direction);
             }
         } else if (gTheseKeys & kSelectFoeKey) {
-            target_hostile(theShip, theShip->direction);
+            target_hostile(theShip, theShip->motion->direction);
         } else {
             if (!(gTheseKeys & kDestinationKey)) {
-                select_base(theShip, theShip->direction);
+                select_base(theShip, theShip->motion->direction);
             } else {
-                target_base(theShip, theShip->direction);
+                target_base(theShip, theShip->motion->direction);
             }
         }
     }
@@ -812,7 +836,7 @@ void PlayerShip::update(int64_t timePass, const GameCursor& cursor, bool enter_m
         globals()->gAutoPilotOff = true;
 
         if ((_gamepad_state == NO_BUMPER) && _control_active) {
-            int difference = mAngleDifference(_control_direction, theShip->direction);
+            int difference = mAngleDifference(_control_direction, theShip->motion->direction);
             if (abs(difference) < 15) {
                 // pass
             } else if (difference < 0) {
@@ -829,14 +853,14 @@ void PlayerShip::update(int64_t timePass, const GameCursor& cursor, bool enter_m
 
     if ((gTheseKeys & kWarpKey)
             && (gTheseKeys & kDestinationKey)) {
-        gDestKeyTime = -1;
+        globals()->gDestKeyTime = -1;
         if (!(gLastKeys & kWarpKey)) {
             engage_autopilot();
         }
         theShip->keysDown &= ~kWarpKey;
     }
 
-    gLastKeyMap.copy(_keys);
+    globals()->gLastKeyMap.copy(_keys);
     gLastKeys = gTheseKeys;
 }
 
@@ -869,7 +893,7 @@ void PlayerShipHandleClick(Point where, int button) {
         return;
     }
 
-    gDestKeyTime = -1;
+    globals()->gDestKeyTime = -1;
     if (globals()->gPlayerShipNumber >= 0) {
         theShip = mGetSpaceObjectPtr(globals()->gPlayerShipNumber);
         if ((theShip->active) && (theShip->attributes & kIsHumanControlled)) {
@@ -930,20 +954,20 @@ void SetPlayerSelectShip( int32_t whichShip, bool target, int32_t admiralNumber)
     if (target) {
         SetAdmiralDestinationObject( admiralNumber, whichShip, kObjectDestinationType);
         if (admiralNumber == globals()->gPlayerAdmiralNumber) {
-            Labels::set_object( gDestinationLabel, selectShip);
+            Labels::set_object( globals()->gDestinationLabel, selectShip);
             if (whichShip == globals()->gPlayerShipNumber) {
-                Labels::set_age(gDestinationLabel, Labels::kVisibleTime);
+                Labels::set_age(globals()->gDestinationLabel, Labels::kVisibleTime);
             }
             PlayVolumeSound(
                     kComputerBeep1, kMediumLoudVolume, kMediumPersistence, kLowPrioritySound);
             if (selectShip->attributes & kIsDestination) {
                 String string(GetDestBalanceName(selectShip->destinationObject));
                 print(string, hot_key_suffix(selectShip));
-                Labels::set_string(gDestinationLabel, string);
+                Labels::set_string(globals()->gDestinationLabel, string);
             } else {
                 String string(get_object_name(selectShip->whichBaseObject));
                 print(string, hot_key_suffix(selectShip));
-                Labels::set_string(gDestinationLabel, string);
+                Labels::set_string(globals()->gDestinationLabel, string);
             }
         }
 
@@ -1013,7 +1037,7 @@ void ChangePlayerShipNumber( int32_t whichAdmiral, int32_t newShipNumber)
         }
         if ( newShipNumber == GetAdmiralDestinationObject( globals()->gPlayerAdmiralNumber))
         {
-            Labels::set_age( gDestinationLabel, Labels::kVisibleTime);
+            Labels::set_age( globals()->gDestinationLabel, Labels::kVisibleTime);
         }
     } else
     {
@@ -1096,8 +1120,8 @@ void PlayerShipBodyExpire( spaceObjectType *theShip, bool sourceIsBody)
     {
 //      selectShip = gSpaceObjectData.get();
 //      selectShipNum = 0;
-        selectShip = gRootObject;
-        selectShipNum = gRootObjectNumber;
+        selectShip = globals()->gRootObject;
+        selectShipNum = globals()->gRootObjectNumber;
         while ( ( selectShip != NULL) &&
                 (
                     ( selectShip->active != kObjectInUse)
@@ -1126,9 +1150,9 @@ void PlayerShipBodyExpire( spaceObjectType *theShip, bool sourceIsBody)
             globals()->gGameOver = -180;
         }
         if (theShip->owner == globals()->gPlayerAdmiralNumber) {
-            globals()->gScenarioWinner.text = kScenarioNoShipTextID + gThisScenario->levelNameStrNum;
+            globals()->gScenarioWinner.text = kScenarioNoShipTextID + globals()->gThisScenario->levelNameStrNum;
         } else {
-            globals()->gScenarioWinner.text = 10050 + gThisScenario->levelNameStrNum;
+            globals()->gScenarioWinner.text = 10050 + globals()->gThisScenario->levelNameStrNum;
         }
         SetAdmiralFlagship( theShip->owner, -1);
     } else if ( selectShip != NULL)
@@ -1192,18 +1216,18 @@ void Update_LabelStrings_ForHotKeyChange( void)
 
 //      if ( admiralNumber == globals()->gPlayerAdmiralNumber)
         {
-            Labels::set_object( gDestinationLabel, selectShip);
+            Labels::set_object( globals()->gDestinationLabel, selectShip);
             if (whichShip == globals()->gPlayerShipNumber) {
-                Labels::set_age(gDestinationLabel, Labels::kVisibleTime);
+                Labels::set_age(globals()->gDestinationLabel, Labels::kVisibleTime);
             }
             if (selectShip->attributes & kIsDestination) {
                 String string(GetDestBalanceName(selectShip->destinationObject));
                 print(string, hot_key_suffix(selectShip));
-                Labels::set_string(gDestinationLabel, string);
+                Labels::set_string(globals()->gDestinationLabel, string);
             } else {
                 String string(get_object_name(selectShip->whichBaseObject));
                 print(string, hot_key_suffix(selectShip));
-                Labels::set_string(gDestinationLabel, string);
+                Labels::set_string(globals()->gDestinationLabel, string);
             }
         }
     }
@@ -18,10 +18,12 @@
 
 #include "game/scenario-maker.hpp"
 
+#include <algorithm>
 #include <vector>
 #include <sfz/sfz.hpp>
 
 #include "config/keys.hpp"
+#include "config/preferences.hpp"
 #include "data/races.hpp"
 #include "data/resource.hpp"
 #include "data/string-list.hpp"
@@ -50,10 +52,13 @@ using sfz::Bytes;
 using sfz::BytesSlice;
 using sfz::Exception;
 using sfz::PrintTarget;
+using sfz::ReadSource;
 using sfz::String;
 using sfz::StringSlice;
+using sfz::WriteTarget;
 using sfz::range;
 using sfz::read;
+using sfz::write;
 using std::vector;
 
 namespace antares {
@@ -77,39 +82,47 @@ vector<Scenario> gScenarioData;
 vector<Scenario::InitialObject> gScenarioInitialData;
 vector<Scenario::Condition> gScenarioConditionData;
 vector<Scenario::BriefPoint> gScenarioBriefData;
-int32_t gScenarioRotation = 0;
-int32_t gAdmiralNumbers[kMaxPlayerNum];
 
 void CheckActionMedia(int32_t whichAction, int32_t actionNum, uint8_t color);
 void AddBaseObjectActionMedia(int32_t whichBase, int32_t whichType, uint8_t color);
 void AddActionMedia(objectActionType *action, uint8_t color);
+void ResetConditionChecks();
+
+// The base objects are shared between games, so the flags marking which of their media this
+// game has checked or added are kept alongside them in globals().
+int32_t& media_flags(const baseObjectType* base) {
+    vector<int32_t>& flags = globals()->gBaseObjectMediaFlags;
+    flags.resize(plugin()->maxBaseObject);
+    return flags[GetBaseObjectIndex(base)];
+}
 
 void SetAllBaseObjectsUnchecked() {
-    baseObjectType  *aBase = mGetBaseObjectPtr(0);
-    int32_t         count;
+    globals()->gBaseObjectMediaFlags.assign(plugin()->maxBaseObject, 0);
+}
 
-    for ( count = 0; count < globals()->maxBaseObject; count++)
-    {
-        aBase->internalFlags = 0;
-        aBase++;
+// Tables that aren't loaded yet are noted, so that they can be decoded all at once, before the
+// media is added.
+void keep_pix_table(int16_t resource_id) {
+    if (!KeepPixTable(resource_id)) {
+        globals()->gPixTablesToLoad.push_back(resource_id);
     }
 }
 
 void CheckBaseObjectMedia(baseObjectType *aBase, uint8_t color) {
     baseObjectType  *weapon;
 
-    if ( !(aBase->internalFlags & (0x00000001 << color)))
+    if ( !(media_flags(aBase) & (0x00000001 << color)))
     {
-        aBase->internalFlags |= (0x00000001 << color);
+        media_flags(aBase) |= (0x00000001 << color);
         if ( aBase->attributes & kCanThink)
         {
             if ( aBase->pixResID != kNoSpriteTable)
-                KeepPixTable( aBase->pixResID +
+                keep_pix_table( aBase->pixResID +
                     (color << kSpriteTableColorShift));
         } else
         {
             if ( aBase->pixResID != kNoSpriteTable)
-                KeepPixTable( aBase->pixResID);
+                keep_pix_table( aBase->pixResID);
         }
 
         CheckActionMedia( aBase->destroyAction, (aBase->destroyActionNum & kDestroyActionNotMask), color);
@@ -173,7 +186,7 @@ void CheckActionMedia(int32_t whichAction, int32_t actionNum, uint8_t color) {
 
                     case kAlterOwner:
                         baseObject = mGetBaseObjectPtr(0);
-                        for ( count = 0; count < globals()->maxBaseObject; count++)
+                        for ( count = 0; count < plugin()->maxBaseObject; count++)
                         {
                             OKtoExecute = false;
                             if ( action->exclusiveFilter == 0xffffffff)
@@ -190,7 +203,7 @@ void CheckActionMedia(int32_t whichAction, int32_t actionNum, uint8_t color) {
                             }
                             if ( OKtoExecute)
                             {
-                                baseObject->internalFlags |= kOwnerMayChangeFlag;
+                                media_flags(baseObject) |= kOwnerMayChangeFlag;
                             }
                             baseObject++;
                         }
@@ -213,12 +226,14 @@ void CheckActionMedia(int32_t whichAction, int32_t actionNum, uint8_t color) {
     }
 }
 
+}  // namespace
+
 void AddBaseObjectMedia(int32_t whichBase, uint8_t color) {
     baseObjectType      *aBase = mGetBaseObjectPtr( whichBase);
 
-    if ( !(aBase->internalFlags & (0x00000001 << color)))
+    if ( !(media_flags(aBase) & (0x00000001 << color)))
     {
-        aBase->internalFlags |= (0x00000001 << color);
+        media_flags(aBase) |= (0x00000001 << color);
         if ( aBase->pixResID != kNoSpriteTable)
         {
             if ( aBase->attributes & kCanThink)
@@ -260,6 +275,8 @@ void AddBaseObjectMedia(int32_t whichBase, uint8_t color) {
     }
 }
 
+namespace {
+
 void mGetActionFromBaseTypeNum(
         objectActionType*& mactPtr, baseObjectType* mbaseObjPtr, int32_t mactionType,
         int32_t mactionNum) {
@@ -342,7 +359,7 @@ void AddActionMedia(objectActionType *action, uint8_t color) {
 
                     case kAlterOwner:
                         baseObject = mGetBaseObjectPtr(0);
-                        for ( count = 0; count < globals()->maxBaseObject; count++)
+                        for ( count = 0; count < plugin()->maxBaseObject; count++)
                         {
                             OKtoExecute = false;
                             if ( action->exclusiveFilter == 0xffffffff)
@@ -359,7 +376,7 @@ void AddActionMedia(objectActionType *action, uint8_t color) {
                             }
                             if ( OKtoExecute)
                             {
-                                baseObject->internalFlags |= kOwnerMayChangeFlag;
+                                media_flags(baseObject) |= kOwnerMayChangeFlag;
                             }
                             baseObject++;
                         }
@@ -375,7 +392,7 @@ void AddActionMedia(objectActionType *action, uint8_t color) {
     }
 }
 
-void GetInitialCoord(Scenario::InitialObject *initial, coordPointType *coord, int32_t rotation) {
+void GetInitialCoord(const Scenario::InitialObject *initial, coordPointType *coord, int32_t rotation) {
     int32_t lcos, lsin, lscrap;
 
     mAddAngle( rotation, 90);
@@ -396,25 +413,23 @@ void GetInitialCoord(Scenario::InitialObject *initial, coordPointType *coord, in
 
 }  // namespace
 
-const Scenario* gThisScenario = NULL;
-
-Scenario* mGetScenario(int32_t num) {
+const Scenario* mGetScenario(int32_t num) {
     return &gScenarioData[num];
 }
 
 int32_t mGetRealAdmiralNum(int32_t mplayernum) {
-    return gAdmiralNumbers[mplayernum];
+    return globals()->gAdmiralNumbers[mplayernum];
 }
 
-Scenario::InitialObject* Scenario::initial(size_t at) const {
+const Scenario::InitialObject* Scenario::initial(size_t at) const {
     return &gScenarioInitialData[initialFirst + at];
 }
 
-Scenario::Condition* Scenario::condition(size_t at) const {
+const Scenario::Condition* Scenario::condition(size_t at) const {
     return &gScenarioConditionData[conditionFirst + at];
 }
 
-Scenario::BriefPoint* Scenario::brief_point(size_t at) const {
+const Scenario::BriefPoint* Scenario::brief_point(size_t at) const {
     return &gScenarioBriefData[briefPointFirst + at];
 }
 
@@ -455,23 +470,11 @@ int32_t Scenario::epilogue_id() const {
     return epilogueID;
 }
 
-void Scenario::Condition::set_true_yet(bool state) {
-    if (state) {
-        flags |= kHasBeenTrue;
-    } else {
-        flags &= ~kHasBeenTrue;
-    }
-}
-
-bool Scenario::Condition::true_yet() const {
-    return flags & kHasBeenTrue;
-}
-
 void ScenarioMakerInit() {
     {
         Resource rsrc("scenario-info", "nlAG", 128);
         BytesSlice in(rsrc.data());
-        read(in, globals()->scenarioFileInfo);
+        read(in, plugin()->scenarioFileInfo);
         if (!in.empty()) {
             throw Exception("didn't consume all of scenario file info data");
         }
@@ -486,7 +489,7 @@ void ScenarioMakerInit() {
             read(in, scenario);
             gScenarioData.push_back(scenario);
         }
-        globals()->scenarioNum = gScenarioData.size();
+        plugin()->scenarioNum = gScenarioData.size();
     }
 
     {
@@ -498,7 +501,7 @@ void ScenarioMakerInit() {
             read(in, initial);
             gScenarioInitialData.push_back(initial);
         }
-        globals()->maxScenarioInitial = gScenarioInitialData.size();
+        plugin()->maxScenarioInitial = gScenarioInitialData.size();
     }
 
     {
@@ -510,7 +513,7 @@ void ScenarioMakerInit() {
             read(in, condition);
             gScenarioConditionData.push_back(condition);
         }
-        globals()->maxScenarioCondition = gScenarioConditionData.size();
+        plugin()->maxScenarioCondition = gScenarioConditionData.size();
     }
 
     {
@@ -522,7 +525,7 @@ void ScenarioMakerInit() {
             read(in, brief_point);
             gScenarioBriefData.push_back(brief_point);
         }
-        globals()->maxScenarioBrief = gScenarioBriefData.size();
+        plugin()->maxScenarioBrief = gScenarioBriefData.size();
     }
 
     InitRaces();
@@ -531,7 +534,8 @@ void ScenarioMakerInit() {
 }
 
 bool start_construct_scenario(const Scenario* scenario, int32_t* max) {
-    ResetAllSpaceObjects();
+    SetSpaceObjectCapacity(std::max(
+                kMinSpaceObjectCapacity, Preferences::preferences()->object_capacity()));
     ResetActionQueueData();
     Beams::reset();
     ResetAllSprites();
@@ -540,19 +544,19 @@ bool start_construct_scenario(const Scenario* scenario, int32_t* max) {
     ResetAllAdmirals();
     ResetAllDestObjectData();
     ResetMotionGlobals();
-    gAbsoluteScale = kTimesTwoScale;
+    globals()->gAbsoluteScale = kTimesTwoScale;
     globals()->gSynchValue = 0;
 
     if (NETWORK_ON) {
 #ifdef NETSPROCKET_AVAILABLE
         if (IAmHosting()) {
             globals()->gThisScenarioNumber = which;
-            gRandomSeed = Randomize(32760);
+            globals()->gRandomSeed = Randomize(32760);
             SendStartMessage();
         } else {
             globals()->gThisScenarioNumber = -1;
-            gRandomSeed = -1;
-            if ((globals()->gThisScenarioNumber == -1) && (gRandomSeed == -1)) {
+            globals()->gRandomSeed = -1;
+            if ((globals()->gThisScenarioNumber == -1) && (globals()->gRandomSeed == -1)) {
                 if (WaitForAllStart() == false) {
                     StopNetworking();
                     return false;
@@ -563,14 +567,14 @@ bool start_construct_scenario(const Scenario* scenario, int32_t* max) {
 #endif
     }
 
-    gThisScenario = scenario;
+    globals()->gThisScenario = scenario;
 
     {
-        int32_t angle = gThisScenario->angle();
+        int32_t angle = globals()->gThisScenario->angle();
         if (angle < 0) {
-            gScenarioRotation = gRandomSeed.next(ROT_POS);
+            globals()->gScenarioRotation = globals()->gRandomSeed.next(ROT_POS);
         } else {
-            gScenarioRotation = angle;
+            globals()->gScenarioRotation = angle;
         }
     }
 
@@ -578,60 +582,60 @@ bool start_construct_scenario(const Scenario* scenario, int32_t* max) {
     globals()->gScenarioWinner.next = -1;
     globals()->gScenarioWinner.text = -1;
 
-    SetMiniScreenStatusStrList(gThisScenario->scoreStringResID);
+    SetMiniScreenStatusStrList(globals()->gThisScenario->scoreStringResID);
 
     // *** BEGIN INIT ADMIRALS ***
     for (int i = 0; i < kMaxPlayerNum; i++) {
-        gAdmiralNumbers[i] = -1;
+        globals()->gAdmiralNumbers[i] = -1;
     }
 
-    for (int i = 0; i < gThisScenario->playerNum; i++) {
+    for (int i = 0; i < globals()->gThisScenario->playerNum; i++) {
         if (NETWORK_ON) {
 #ifdef NETSPROCKET_AVAILABLE
-            if (gThisScenario->player[i].playerType == kComputerPlayer) {
-                gAdmiralNumbers[i] = MakeNewAdmiral(
+            if (globals()->gThisScenario->player[i].playerType == kComputerPlayer) {
+                globals()->gAdmiralNumbers[i] = MakeNewAdmiral(
                         kNoShip, kNoDestinationObject, kNoDestinationType,
-                        kAIsComputer, gThisScenario->player[i].playerRace,
-                        gThisScenario->player[i].nameResID,
-                        gThisScenario->player[i].nameStrNum,
-                        gThisScenario->player[i].earningPower);
-                PayAdmiral(gAdmiralNumbers[i], mLongToFixed(5000));
+                        kAIsComputer, globals()->gThisScenario->player[i].playerRace,
+                        globals()->gThisScenario->player[i].nameResID,
+                        globals()->gThisScenario->player[i].nameStrNum,
+                        globals()->gThisScenario->player[i].earningPower);
+                PayAdmiral(globals()->gAdmiralNumbers[i], mLongToFixed(5000));
             } else if (GetPlayerRace(i) >= 0) {
                 if (i == globals()->gPlayerAdmiralNumber) {
                     admiralType = 0;
                 } else {
                     admiralType = kAIsRemote;
                 }
-                gAdmiralNumbers[i] = MakeNewAdmiral(
+                globals()->gAdmiralNumbers[i] = MakeNewAdmiral(
                         kNoShip, kNoDestinationObject,
                         kNoDestinationType, kAIsHuman | admiralType,
                         GetRaceIDFromNum(GetPlayerRace(i)),
-                        gThisScenario->player[i].nameResID,
-                        gThisScenario->player[i].nameStrNum,
-                        gThisScenario->player[i].earningPower);
-                PayAdmiral(gAdmiralNumbers[i], mLongToFixed(5000));
-                SetAdmiralColor(gAdmiralNumbers[i], GetPlayerColor(i));
-                SetAdmiralName(gAdmiralNumbers[i], (anyCharType *)GetPlayerName(i));
+                        globals()->gThisScenario->player[i].nameResID,
+                        globals()->gThisScenario->player[i].nameStrNum,
+                        globals()->gThisScenario->player[i].earningPower);
+                PayAdmiral(globals()->gAdmiralNumbers[i], mLongToFixed(5000));
+                SetAdmiralColor(globals()->gAdmiralNumbers[i], GetPlayerColor(i));
+                SetAdmiralName(globals()->gAdmiralNumbers[i], (anyCharType *)GetPlayerName(i));
             }
 #endif  // NETSPROCKET_AVAILABLE
         } else {
-            if (gThisScenario->player[i].playerType == kSingleHumanPlayer) {
-                gAdmiralNumbers[i] = MakeNewAdmiral(
+            if (globals()->gThisScenario->player[i].playerType == kSingleHumanPlayer) {
+                globals()->gAdmiralNumbers[i] = MakeNewAdmiral(
                         kNoShip, kNoDestinationObject, kNoDestinationType,
-                        kAIsHuman, gThisScenario->player[i].playerRace,
-                        gThisScenario->player[i].nameResID,
-                        gThisScenario->player[i].nameStrNum,
-                        gThisScenario->player[i].earningPower);
-                PayAdmiral(gAdmiralNumbers[i], mLongToFixed(5000));
-                globals()->gPlayerAdmiralNumber = gAdmiralNumbers[i];
+                        kAIsHuman, globals()->gThisScenario->player[i].playerRace,
+                        globals()->gThisScenario->player[i].nameResID,
+                        globals()->gThisScenario->player[i].nameStrNum,
+                        globals()->gThisScenario->player[i].earningPower);
+                PayAdmiral(globals()->gAdmiralNumbers[i], mLongToFixed(5000));
+                globals()->gPlayerAdmiralNumber = globals()->gAdmiralNumbers[i];
             } else {
-                gAdmiralNumbers[i] = MakeNewAdmiral(
+                globals()->gAdmiralNumbers[i] = MakeNewAdmiral(
                         kNoShip, kNoDestinationObject, kNoDestinationType,
-                        kAIsComputer, gThisScenario->player[i].playerRace,
-                        gThisScenario->player[i].nameResID,
-                        gThisScenario->player[i].nameStrNum,
-                        gThisScenario->player[i].earningPower);
-                PayAdmiral(gAdmiralNumbers[i], mLongToFixed(5000));
+                        kAIsComputer, globals()->gThisScenario->player[i].playerRace,
+                        globals()->gThisScenario->player[i].nameResID,
+                        globals()->gThisScenario->player[i].nameStrNum,
+                        globals()->gThisScenario->player[i].earningPower);
+                PayAdmiral(globals()->gAdmiralNumbers[i], mLongToFixed(5000));
             }
         }
     }
@@ -645,10 +649,11 @@ bool start_construct_scenario(const Scenario* scenario, int32_t* max) {
     // uncheck all sounds
     SetAllSoundsNoKeep();
     SetAllPixTablesNoKeep();
+    globals()->gPixTablesToLoad.clear();
 
-    *max = gThisScenario->initialNum * 4L
+    *max = globals()->gThisScenario->initialNum * 4L
          + 1
-         + (gThisScenario->startTime & kScenario_StartTimeMask); // for each run through the initial num
+         + (globals()->gThisScenario->startTime & kScenario_StartTimeMask); // for each run through the initial num
 
     return true;
 }
@@ -658,42 +663,42 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
     if (step == 0) {
         // for each initial object
 
-        if (globals()->scenarioFileInfo.energyBlobID < 0) {
+        if (plugin()->scenarioFileInfo.energyBlobID < 0) {
             throw Exception("No energy blob defined");
         }
-        if (globals()->scenarioFileInfo.warpInFlareID < 0) {
+        if (plugin()->scenarioFileInfo.warpInFlareID < 0) {
             throw Exception("No warp in flare defined");
         }
-        if (globals()->scenarioFileInfo.warpOutFlareID < 0) {
+        if (plugin()->scenarioFileInfo.warpOutFlareID < 0) {
             throw Exception("No warp out flare defined");
         }
-        if (globals()->scenarioFileInfo.playerBodyID < 0) {
+        if (plugin()->scenarioFileInfo.playerBodyID < 0) {
             throw Exception("No player body defined");
         }
 
-        for (int i = 0; i < gThisScenario->playerNum; i++) {
-            baseObjectType* baseObject = mGetBaseObjectPtr(globals()->scenarioFileInfo.energyBlobID);
+        for (int i = 0; i < globals()->gThisScenario->playerNum; i++) {
+            baseObjectType* baseObject = mGetBaseObjectPtr(plugin()->scenarioFileInfo.energyBlobID);
             if (baseObject != NULL) {
                 CheckBaseObjectMedia(baseObject, 0);   // special case; always neutral
             }
-            baseObject = mGetBaseObjectPtr(globals()->scenarioFileInfo.warpInFlareID);
+            baseObject = mGetBaseObjectPtr(plugin()->scenarioFileInfo.warpInFlareID);
             if (baseObject != NULL) {
                 CheckBaseObjectMedia(baseObject, 0); // special case; always neutral
             }
-            baseObject = mGetBaseObjectPtr(globals()->scenarioFileInfo.warpOutFlareID);
+            baseObject = mGetBaseObjectPtr(plugin()->scenarioFileInfo.warpOutFlareID);
             if (baseObject != NULL) {
                 CheckBaseObjectMedia(baseObject, 0); // special case; always neutral
             }
-            baseObject = mGetBaseObjectPtr(globals()->scenarioFileInfo.playerBodyID);
+            baseObject = mGetBaseObjectPtr(plugin()->scenarioFileInfo.playerBodyID);
             if (baseObject != NULL) {
                 CheckBaseObjectMedia(baseObject, GetAdmiralColor(i));
             }
         }
     }
 
-    if ((0 <= step) && (step < gThisScenario->initialNum)) {
+    if ((0 <= step) && (step < globals()->gThisScenario->initialNum)) {
         int i = step;
-        Scenario::InitialObject* initial = gThisScenario->initial(i);
+        const Scenario::InitialObject* initial = globals()->gThisScenario->initial(i);
         // get the base object equiv
         baseObjectType* baseObject = mGetBaseObjectPtr(initial->type);
         if (NETWORK_ON && (GetAdmiralRace(initial->owner) >= 0)
@@ -708,7 +713,7 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
         }
         // check the media for this object
         if (baseObject->attributes & kIsDestination) {
-            for (int i = 0; i < gThisScenario->playerNum; i++) {
+            for (int i = 0; i < globals()->gThisScenario->playerNum; i++) {
                 CheckBaseObjectMedia(baseObject, GetAdmiralColor(i));
             }
         } else {
@@ -719,7 +724,7 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
         for (int i = 0; i < kMaxTypeBaseCanBuild; i++) {
             if (initial->canBuild[i] != kNoClass) {
                 // check for each player
-                for (int j = 0; j < gThisScenario->playerNum; j++) {
+                for (int j = 0; j < globals()->gThisScenario->playerNum; j++) {
                     int32_t newShipNum;
                     mGetBaseObjectFromClassRace(baseObject, newShipNum, initial->canBuild[i], GetAdmiralRace(j));
                     if (baseObject != NULL) {
@@ -731,22 +736,22 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
         (*current)++;
         return;
     }
-    step -= gThisScenario->initialNum;
+    step -= globals()->gThisScenario->initialNum;
 
     // check media for all condition actions
     if (step == 0) {
-        Scenario::Condition* condition = gThisScenario->condition(0);
-        for (int i = 0; i < gThisScenario->conditionNum; i++) {
+        const Scenario::Condition* condition = globals()->gThisScenario->condition(0);
+        for (int i = 0; i < globals()->gThisScenario->conditionNum; i++) {
             CheckActionMedia(condition->startVerb, condition->verbNum, 0);
-            condition = gThisScenario->condition(i);
+            condition = globals()->gThisScenario->condition(i);
         }
 
         // make sure we check things whose owner may change
-        for (int i = 0; i < globals()->maxBaseObject; i++) {
+        for (int i = 0; i < plugin()->maxBaseObject; i++) {
             baseObjectType* baseObject = mGetBaseObjectPtr(i);
-            if ((baseObject->internalFlags & kOwnerMayChangeFlag)
-                    && (baseObject->internalFlags & kAnyOwnerColorFlag)) {
-                for (int j = 0; j < gThisScenario->playerNum; j++) {
+            if ((media_flags(baseObject) & kOwnerMayChangeFlag)
+                    && (media_flags(baseObject) & kAnyOwnerColorFlag)) {
+                for (int j = 0; j < globals()->gThisScenario->playerNum; j++) {
                     CheckBaseObjectMedia(baseObject, GetAdmiralColor(i));
                 }
             }
@@ -756,31 +761,33 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
 
         RemoveAllUnusedSounds();
         RemoveAllUnusedPixTables();
+        LoadPixTables(globals()->gPixTablesToLoad);
+        globals()->gPixTablesToLoad.clear();
 
-        for (int i = 0; i < gThisScenario->playerNum; i++) {
-            baseObjectType* baseObject = mGetBaseObjectPtr(globals()->scenarioFileInfo.energyBlobID);
+        for (int i = 0; i < globals()->gThisScenario->playerNum; i++) {
+            baseObjectType* baseObject = mGetBaseObjectPtr(plugin()->scenarioFileInfo.energyBlobID);
             if (baseObject != NULL) {
-                AddBaseObjectMedia(globals()->scenarioFileInfo.energyBlobID, 0); // special case; always neutral
+                AddBaseObjectMedia(plugin()->scenarioFileInfo.energyBlobID, 0); // special case; always neutral
             }
-            baseObject = mGetBaseObjectPtr(globals()->scenarioFileInfo.warpInFlareID);
+            baseObject = mGetBaseObjectPtr(plugin()->scenarioFileInfo.warpInFlareID);
             if (baseObject != NULL) {
-                AddBaseObjectMedia(globals()->scenarioFileInfo.warpInFlareID, 0); // special case; always neutral
+                AddBaseObjectMedia(plugin()->scenarioFileInfo.warpInFlareID, 0); // special case; always neutral
             }
-            baseObject = mGetBaseObjectPtr(globals()->scenarioFileInfo.warpOutFlareID);
+            baseObject = mGetBaseObjectPtr(plugin()->scenarioFileInfo.warpOutFlareID);
             if (baseObject != NULL) {
-                AddBaseObjectMedia(globals()->scenarioFileInfo.warpOutFlareID, 0); // special case; always neutral
+                AddBaseObjectMedia(plugin()->scenarioFileInfo.warpOutFlareID, 0); // special case; always neutral
             }
-            baseObject = mGetBaseObjectPtr(globals()->scenarioFileInfo.playerBodyID);
+            baseObject = mGetBaseObjectPtr(plugin()->scenarioFileInfo.playerBodyID);
             if (baseObject != NULL) {
-                AddBaseObjectMedia(globals()->scenarioFileInfo.playerBodyID, GetAdmiralColor(i));
+                AddBaseObjectMedia(plugin()->scenarioFileInfo.playerBodyID, GetAdmiralColor(i));
             }
         }
     }
 
-    if ((0 <= step) && (step < gThisScenario->initialNum)) {
+    if ((0 <= step) && (step < globals()->gThisScenario->initialNum)) {
         int i = step;
 
-        Scenario::InitialObject* initial = gThisScenario->initial(i);
+        const Scenario::InitialObject* initial = globals()->gThisScenario->initial(i);
 
         // get the base object equiv
         int32_t type = initial->type;
@@ -797,7 +804,7 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
         }
         // check the media for this object
         if (baseObject->attributes & kIsDestination) {
-            for (int j = 0; j < gThisScenario->playerNum; j++) {
+            for (int j = 0; j < globals()->gThisScenario->playerNum; j++) {
                 AddBaseObjectMedia(type, GetAdmiralColor(j));
             }
         } else {
@@ -805,7 +812,7 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
         }
 
         // we may have just moved memory, so let's make sure our ptrs are correct
-        initial = gThisScenario->initial(i);
+        initial = globals()->gThisScenario->initial(i);
         baseObject = mGetBaseObjectPtr(type);
 
         // make sure we're not overriding the sprite
@@ -821,11 +828,11 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
 
         // check any objects this object can build
         for (int j = 0; j < kMaxTypeBaseCanBuild; j++) {
-            initial = gThisScenario->initial(i);
+            initial = globals()->gThisScenario->initial(i);
             if (initial->canBuild[j] != kNoClass) {
                 // check for each player
-                for (int k = 0; k < gThisScenario->playerNum; k++) {
-                    initial = gThisScenario->initial(i);
+                for (int k = 0; k < globals()->gThisScenario->playerNum; k++) {
+                    initial = globals()->gThisScenario->initial(i);
                     baseObject = mGetBaseObjectPtr(type);
                     int32_t newShipNum;
                     mGetBaseObjectFromClassRace(
@@ -839,17 +846,17 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
         (*current)++;
         return;
     }
-    step -= gThisScenario->initialNum;
+    step -= globals()->gThisScenario->initialNum;
 
     // add media for all condition actions
     if (step == 0) {
         {
-            Scenario::Condition* condition = gThisScenario->condition(0);
-            for (int i = 0; i < gThisScenario->conditionNum; i++) {
-                condition = gThisScenario->condition(i);
+            const Scenario::Condition* condition = globals()->gThisScenario->condition(0);
+            for (int i = 0; i < globals()->gThisScenario->conditionNum; i++) {
+                condition = globals()->gThisScenario->condition(i);
                 objectActionType* action = mGetObjectActionPtr(condition->startVerb);
                 for (int j = 0; j < condition->verbNum; j++) {
-                    condition = gThisScenario->condition(i);
+                    condition = globals()->gThisScenario->condition(i);
                     action = mGetObjectActionPtr(condition->startVerb + j);
                     AddActionMedia(action, 0);
                 }
@@ -857,11 +864,11 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
         }
 
         // make sure we check things whose owner may change
-        for (int i = 0; i < globals()->maxBaseObject; i++) {
+        for (int i = 0; i < plugin()->maxBaseObject; i++) {
             baseObjectType* baseObject = mGetBaseObjectPtr(i);
-            if ((baseObject->internalFlags & kOwnerMayChangeFlag) 
-                    && (baseObject->internalFlags & kAnyOwnerColorFlag)) {
-                for (int j = 0; j < gThisScenario->playerNum; j++) {
+            if ((media_flags(baseObject) & kOwnerMayChangeFlag) 
+                    && (media_flags(baseObject) & kAnyOwnerColorFlag)) {
+                for (int j = 0; j < globals()->gThisScenario->playerNum; j++) {
                     AddBaseObjectMedia(i, GetAdmiralColor(j));
                 }
             }
@@ -870,29 +877,25 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
         SetAllBaseObjectsUnchecked();
 
         // begin init admirals used to be here
-        {
-            Scenario::Condition* condition = gThisScenario->condition(0);
-            for (int i = 0; i < gThisScenario->conditionNum; i++) {
-                if (condition->flags & kInitiallyTrue) {
-                    condition->flags |= kHasBeenTrue;
-                } else {
-                    condition->flags &= ~kHasBeenTrue;
-                }
-                condition++;
-            }
+        globals()->gConditionTrueYet.resize(globals()->gThisScenario->conditionNum);
+        for (int i = 0; i < globals()->gThisScenario->conditionNum; i++) {
+            SetConditionTrueYet(i, globals()->gThisScenario->condition(i)->flags & kInitiallyTrue);
         }
+        globals()->gInitialObjectNumbers.assign(globals()->gThisScenario->initialNum, -1);
+        globals()->gInitialObjectIDs.assign(globals()->gThisScenario->initialNum, -1);
+        ResetConditionChecks();
     }
 
-    if ((0 <= step) && (step < gThisScenario->initialNum)) {
-        Scenario::InitialObject* initial = gThisScenario->initial(step);
+    if ((0 <= step) && (step < globals()->gThisScenario->initialNum)) {
+        const Scenario::InitialObject* initial = globals()->gThisScenario->initial(step);
 
         if (!(initial->attributes & kInitiallyHidden)) {
             coordPointType coord;
-            GetInitialCoord(initial, &coord, gScenarioRotation);
+            GetInitialCoord(initial, &coord, globals()->gScenarioRotation);
 
             int32_t owner;
             if (initial->owner > kScenarioNoOwner) {
-                owner = gAdmiralNumbers[initial->owner];
+                owner = globals()->gAdmiralNumbers[initial->owner];
             } else {
                 owner = kScenarioNoOwner;
             }
@@ -928,8 +931,8 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
             }
             fixedPointType v = {0, 0};
             int32_t newShipNum;
-            initial->realObjectNumber = newShipNum = CreateAnySpaceObject(
-                    type, &v, &coord, gScenarioRotation, owner, specialAttributes,
+            globals()->gInitialObjectNumbers[step] = newShipNum = CreateAnySpaceObject(
+                    type, &v, &coord, globals()->gScenarioRotation, owner, specialAttributes,
                     initial->spriteIDOverride);
 
             spaceObjectType* anObject = mGetSpaceObjectPtr(newShipNum);
@@ -938,7 +941,7 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
                         newShipNum, initial->canBuild, initial->earning, initial->nameResID,
                         initial->nameStrNum);
             }
-            initial->realObjectID = anObject->id;
+            globals()->gInitialObjectIDs[step] = anObject->id;
             if ((initial->attributes & kIsPlayerShip)
                     && (GetAdmiralFlagship(owner) == NULL)) {
                 SetAdmiralFlagship(owner, newShipNum);
@@ -962,36 +965,35 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
                 }
             }
         } else {
-            initial->realObjectNumber = -1;
+            globals()->gInitialObjectNumbers[step] = -1;
         }
 
         (*current)++;
         return;
     }
-    step -= gThisScenario->initialNum;
+    step -= globals()->gThisScenario->initialNum;
 
     // double back and set up any defined initial destinations
-    if ((0 <= step) && (step < gThisScenario->initialNum)) {
+    if ((0 <= step) && (step < globals()->gThisScenario->initialNum)) {
         int i = step;
 
-        Scenario::InitialObject* initial = gThisScenario->initial(i);
+        const Scenario::InitialObject* initial = globals()->gThisScenario->initial(i);
         // if the initial object has an initial destination
-        if ((initial->realObjectNumber >= 0) && (initial->initialDestination >= 0)) {
+        if ((globals()->gInitialObjectNumbers[i] >= 0) && (initial->initialDestination >= 0)) {
             // only objects controlled by an Admiral can have destinations
             if (initial->owner > kScenarioNoOwner) {
                 // get the correct admiral #
 
-                int32_t owner = gAdmiralNumbers[initial->owner];
-                initial = gThisScenario->initial(initial->initialDestination);
+                int32_t owner = globals()->gAdmiralNumbers[initial->owner];
 
                 // set the admiral's dest object to the mapped initial dest object
                 SetAdmiralDestinationObject(
-                        owner, initial->realObjectNumber, kObjectDestinationType);
+                        owner, globals()->gInitialObjectNumbers[initial->initialDestination],
+                        kObjectDestinationType);
 
                 // now give the mapped initial object the admiral's destination
 
-                initial = gThisScenario->initial(i);
-                spaceObjectType* anObject = mGetSpaceObjectPtr(initial->realObjectNumber);
+                spaceObjectType* anObject = mGetSpaceObjectPtr(globals()->gInitialObjectNumbers[i]);
                 int32_t specialAttributes = anObject->attributes; // preserve the attributes
                 anObject->attributes &= ~kStaticDestination; // we've got to force this off so we can set dest
                 SetObjectDestination(anObject, NULL);
@@ -1001,7 +1003,7 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
         (*current)++;
         return;
     }
-    step -= gThisScenario->initialNum;
+    step -= globals()->gThisScenario->initialNum;
 
     if (step == 0) {
         // set up all the admiral's destination objects
@@ -1010,7 +1012,7 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
 
         int x = 0;
         const int64_t start_ticks
-            = (gThisScenario->startTime & kScenario_StartTimeMask) * kScenarioTimeMultiple;
+            = (globals()->gThisScenario->startTime & kScenario_StartTimeMask) * kScenarioTimeMultiple;
         const int64_t start_time = add_ticks(0, start_ticks);
         globals()->gGameTime = 0;
         for (int64_t i = 0; i < start_ticks; ++i) {
@@ -1038,270 +1040,409 @@ void construct_scenario(const Scenario* scenario, int32_t* current) {
     }
 }
 
-void CheckScenarioConditions(int32_t timePass) {
-    Scenario::Condition     *condition = NULL;
+namespace {
+
+// What CheckScenarioConditions() knows about each condition, in gConditionState.
+enum {
+    kConditionPolled    = 0x01,     // nothing tells us when it changes, so look every pass
+    kConditionDirty     = 0x02,     // it may have changed since it was last evaluated
+    kConditionTrue      = 0x04,     // it was true when it was last evaluated
+};
+
+int64_t condition_time(int32_t whichCondition) {
+    return ticks_to_usecs(
+            globals()->gThisScenario->condition(whichCondition)->conditionArgument.longValue);
+}
+
+bool condition_time_before(int32_t x, int32_t y) {
+    return condition_time(x) < condition_time(y);
+}
+
+// A condition needs a look if it can still fire, and it is polled, dirty, or was true last time
+// (conditions that aren't kTrueOnlyOnce fire on every pass that they're true).
+void UpdateConditionCheck(int32_t whichCondition) {
+    const Scenario::Condition* condition = globals()->gThisScenario->condition(whichCondition);
+    const uint8_t state = globals()->gConditionState[whichCondition];
+    uint64_t& word = globals()->gConditionsToCheck[whichCondition / 64];
+    const uint64_t bit = 1ull << (whichCondition % 64);
+    if ((!(condition->flags & kTrueOnlyOnce) || !ConditionTrueYet(whichCondition))
+            && (state & (kConditionPolled | kConditionDirty | kConditionTrue))) {
+        word |= bit;
+    } else {
+        word &= ~bit;
+    }
+}
+
+// Returns the first condition after `whichCondition` that needs a look, or -1; pass -1 to start
+// from the beginning.  Conditions marked during a pass are seen by it if they come later.
+int32_t NextConditionToCheck(int32_t whichCondition) {
+    const vector<uint64_t>& words = globals()->gConditionsToCheck;
+    const size_t next = whichCondition + 1;
+    size_t word = next / 64;
+    if (word >= words.size()) {
+        return -1;
+    }
+    uint64_t marked = words[word] & (~0ull << (next % 64));
+    while (marked == 0) {
+        if (++word == words.size()) {
+            return -1;
+        }
+        marked = words[word];
+    }
+    return (word * 64) + __builtin_ctzll(marked);
+}
+
+// Sorts the conditions by what can change them, and marks them all dirty.  Counters change only
+// through AlterAdmiralScore(), time only moves forward, and kNoCondition never holds; the rest
+// are polled.
+void ResetConditionChecks() {
+    const int32_t count = globals()->gThisScenario->conditionNum;
+    globals()->gConditionsToCheck.assign((count + 63) / 64, 0);
+    globals()->gConditionState.assign(count, kConditionDirty);
+    globals()->gCounterConditions.clear();
+    globals()->gTimeConditions.clear();
+    globals()->gNextTimeCondition = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        switch (globals()->gThisScenario->condition(i)->condition) {
+          case kCounterCondition:
+          case kCounterGreaterCondition:
+          case kCounterNotCondition:
+            globals()->gCounterConditions.push_back(i);
+            break;
+          case kTimeCondition:
+            globals()->gTimeConditions.push_back(i);
+            break;
+          case kNoCondition:
+            break;
+          default:
+            globals()->gConditionState[i] |= kConditionPolled;
+            break;
+        }
+        UpdateConditionCheck(i);
+    }
+    std::stable_sort(
+            globals()->gTimeConditions.begin(), globals()->gTimeConditions.end(),
+            condition_time_before);
+}
+
+bool ConditionIsTrue(const Scenario::Condition* condition) {
     spaceObjectType         *sObject = NULL, *dObject = NULL;
-    int32_t                 i, l, difference;
+    int32_t                 l, difference;
     uint32_t                distance, dcalc;
-    Point                   offset(0, 0);
     bool                 conditionTrue = false;
 
-#pragma unused( timePass)
+    switch( condition->condition)
+    {
+        case kCounterCondition:
+            l = mGetRealAdmiralNum(condition->conditionArgument.counter.whichPlayer);
+            if ( GetAdmiralScore( l, condition->conditionArgument.counter.whichCounter) ==
+                condition->conditionArgument.counter.amount)
+            {
+                conditionTrue = true;
+            }
+            break;
 
-        condition = gThisScenario->condition(0);
-        for ( i = 0; i < gThisScenario->conditionNum; i++)
-        {
-            if ( (!(condition->flags & kTrueOnlyOnce)) || ( !(condition->flags & kHasBeenTrue)))
+        case kCounterGreaterCondition:
+            l = mGetRealAdmiralNum(condition->conditionArgument.counter.whichPlayer);
+            if ( GetAdmiralScore( l, condition->conditionArgument.counter.whichCounter) >=
+                condition->conditionArgument.counter.amount)
             {
-                conditionTrue = false;
-                switch( condition->condition)
+                conditionTrue = true;
+            }
+            break;
+
+        case kCounterNotCondition:
+            l = mGetRealAdmiralNum(condition->conditionArgument.counter.whichPlayer);
+            if ( GetAdmiralScore( l, condition->conditionArgument.counter.whichCounter) !=
+                condition->conditionArgument.counter.amount)
+            {
+                conditionTrue = true;
+            }
+            break;
+
+        case kDestructionCondition:
+            sObject = GetObjectFromInitialNumber(
+                    condition->conditionArgument.longValue);
+            if (sObject == NULL) {
+                conditionTrue = true;
+            }
+            break;
+
+        case kOwnerCondition:
+            sObject = GetObjectFromInitialNumber(condition->subjectObject);
+            if (sObject != NULL) {
+                l = mGetRealAdmiralNum(condition->conditionArgument.longValue);
+                if ( l == sObject->owner)
                 {
-                    case kCounterCondition:
-                        l = mGetRealAdmiralNum(condition->conditionArgument.counter.whichPlayer);
-                        if ( GetAdmiralScore( l, condition->conditionArgument.counter.whichCounter) ==
-                            condition->conditionArgument.counter.amount)
-                        {
-                            conditionTrue = true;
-                        }
-                        break;
+                    conditionTrue = true;
+                }
+
+            }
+            break;
 
-                    case kCounterGreaterCondition:
-                        l = mGetRealAdmiralNum(condition->conditionArgument.counter.whichPlayer);
-                        if ( GetAdmiralScore( l, condition->conditionArgument.counter.whichCounter) >=
-                            condition->conditionArgument.counter.amount)
+        case kTimeCondition:
+            if (globals()->gGameTime >=
+                    ticks_to_usecs(condition->conditionArgument.longValue)) {
+                conditionTrue = true;
+            }
+            break;
+
+        case kProximityCondition:
+            sObject = GetObjectFromInitialNumber(condition->subjectObject);
+            if (sObject != NULL) {
+                dObject = GetObjectFromInitialNumber(condition->directObject);
+                if (dObject != NULL) {
+                    difference = ABS<int>( sObject->motion->location.h - dObject->motion->location.h);
+                    dcalc = difference;
+                    difference =  ABS<int>( sObject->motion->location.v - dObject->motion->location.v);
+                    distance = difference;
+
+                    if (( dcalc < kMaximumRelevantDistance) && ( distance < kMaximumRelevantDistance))
+                    {
+                        distance = distance * distance + dcalc * dcalc;
+                        if ( distance < condition->conditionArgument.unsignedLongValue)
                         {
                             conditionTrue = true;
+                        } else
+                        {
                         }
-                        break;
-
-                    case kCounterNotCondition:
-                        l = mGetRealAdmiralNum(condition->conditionArgument.counter.whichPlayer);
-                        if ( GetAdmiralScore( l, condition->conditionArgument.counter.whichCounter) !=
-                            condition->conditionArgument.counter.amount)
+                    }
+                }
+            }
+            break;
+
+        case kDistanceGreaterCondition:
+            sObject = GetObjectFromInitialNumber(condition->subjectObject);
+            if (sObject != NULL) {
+                dObject = GetObjectFromInitialNumber(condition->directObject);
+                if (dObject != NULL) {
+                    difference = ABS<int>( sObject->motion->location.h - dObject->motion->location.h);
+                    dcalc = difference;
+                    difference =  ABS<int>( sObject->motion->location.v - dObject->motion->location.v);
+                    distance = difference;
+
+                    if (( dcalc < kMaximumRelevantDistance) && ( distance < kMaximumRelevantDistance))
+                    {
+                        distance = distance * distance + dcalc * dcalc;
+                        if ( distance >= condition->conditionArgument.unsignedLongValue)
                         {
                             conditionTrue = true;
+                        } else
+                        {
                         }
-                        break;
+                    }
+                }
+            }
+            break;
 
-                    case kDestructionCondition:
-                        sObject = GetObjectFromInitialNumber(
-                                condition->conditionArgument.longValue);
-                        if (sObject == NULL) {
-                            conditionTrue = true;
-                        }
-                        break;
+        case kHalfHealthCondition:
+            sObject = GetObjectFromInitialNumber(condition->subjectObject);
+            if (sObject == NULL) {
+                conditionTrue = true;
+            } else if ( sObject->health <= ( sObject->baseType->health >> 1))
+            {
+                conditionTrue = true;
+            }
+            break;
 
-                    case kOwnerCondition:
-                        sObject = GetObjectFromInitialNumber(condition->subjectObject);
-                        if (sObject != NULL) {
-                            l = mGetRealAdmiralNum(condition->conditionArgument.longValue);
-                            if ( l == sObject->owner)
-                            {
-                                conditionTrue = true;
-                            }
+        case kIsAuxiliaryObject:
+            sObject = GetObjectFromInitialNumber(condition->subjectObject);
+            if (sObject != NULL) {
+                l = GetAdmiralConsiderObject( globals()->gPlayerAdmiralNumber);
+                if ( l >= 0)
+                {
+                    dObject = mGetSpaceObjectPtr(l);
+                    if ( dObject == sObject)
+                    {
+                        conditionTrue = true;
+                    }
+                }
+            }
+            break;
 
-                        }
-                        break;
+        case kIsTargetObject:
+            sObject = GetObjectFromInitialNumber(condition->subjectObject);
+            if (sObject != NULL) {
+                l = GetAdmiralDestinationObject( globals()->gPlayerAdmiralNumber);
+                if ( l >= 0)
+                {
+                    dObject = mGetSpaceObjectPtr(l);
+                    if ( dObject == sObject)
+                    {
+                        conditionTrue = true;
+                    }
+                }
+            }
+            break;
 
-                    case kTimeCondition:
-                        if (globals()->gGameTime >=
-                                ticks_to_usecs(condition->conditionArgument.longValue)) {
-                            conditionTrue = true;
-                        }
-                        break;
+        case kVelocityLessThanEqualToCondition:
+            sObject = GetObjectFromInitialNumber(condition->subjectObject);
+            if (sObject != NULL) {
+                if (( (ABS(sObject->motion->velocity.h)) < condition->conditionArgument.longValue) &&
+                    ( (ABS(sObject->motion->velocity.v)) < condition->conditionArgument.longValue))
+                {
+                    conditionTrue = true;
+                }
+            }
+            break;
 
-                    case kProximityCondition:
-                        sObject = GetObjectFromInitialNumber(condition->subjectObject);
-                        if (sObject != NULL) {
-                            dObject = GetObjectFromInitialNumber(condition->directObject);
-                            if (dObject != NULL) {
-                                difference = ABS<int>( sObject->location.h - dObject->location.h);
-                                dcalc = difference;
-                                difference =  ABS<int>( sObject->location.v - dObject->location.v);
-                                distance = difference;
-
-                                if (( dcalc < kMaximumRelevantDistance) && ( distance < kMaximumRelevantDistance))
-                                {
-                                    distance = distance * distance + dcalc * dcalc;
-                                    if ( distance < condition->conditionArgument.unsignedLongValue)
-                                    {
-                                        conditionTrue = true;
-                                    } else
-                                    {
-                                    }
-                                }
-                            }
-                        }
-                        break;
+        case kNoShipsLeftCondition:
+            if ( GetAdmiralShipsLeft( condition->conditionArgument.longValue) <= 0)
+            {
+                conditionTrue = true;
+            }
+            break;
 
-                    case kDistanceGreaterCondition:
-                        sObject = GetObjectFromInitialNumber(condition->subjectObject);
-                        if (sObject != NULL) {
-                            dObject = GetObjectFromInitialNumber(condition->directObject);
-                            if (dObject != NULL) {
-                                difference = ABS<int>( sObject->location.h - dObject->location.h);
-                                dcalc = difference;
-                                difference =  ABS<int>( sObject->location.v - dObject->location.v);
-                                distance = difference;
-
-                                if (( dcalc < kMaximumRelevantDistance) && ( distance < kMaximumRelevantDistance))
-                                {
-                                    distance = distance * distance + dcalc * dcalc;
-                                    if ( distance >= condition->conditionArgument.unsignedLongValue)
-                                    {
-                                        conditionTrue = true;
-                                    } else
-                                    {
-                                    }
-                                }
-                            }
-                        }
-                        break;
+        case kCurrentMessageCondition:
+            {
+                if (Messages::current() == (condition->conditionArgument.location.h +
+                    condition->conditionArgument.location.v - 1))
+                {
+                    conditionTrue = true;
+                }
 
-                    case kHalfHealthCondition:
-                        sObject = GetObjectFromInitialNumber(condition->subjectObject);
-                        if (sObject == NULL) {
-                            conditionTrue = true;
-                        } else if ( sObject->health <= ( sObject->baseType->health >> 1))
-                        {
-                            conditionTrue = true;
-                        }
-                        break;
+            }
+            break;
+
+        case kCurrentComputerCondition:
+            if (( globals()->gMiniScreenData.currentScreen ==
+                condition->conditionArgument.location.h) &&
+                ((condition->conditionArgument.location.v < 0) ||
+                    (globals()->gMiniScreenData.selectLine ==
+                        condition->conditionArgument.location.v)))
+            {
+                conditionTrue = true;
+            }
+            break;
 
-                    case kIsAuxiliaryObject:
-                        sObject = GetObjectFromInitialNumber(condition->subjectObject);
-                        if (sObject != NULL) {
-                            l = GetAdmiralConsiderObject( globals()->gPlayerAdmiralNumber);
-                            if ( l >= 0)
-                            {
-                                dObject = mGetSpaceObjectPtr(l);
-                                if ( dObject == sObject)
-                                {
-                                    conditionTrue = true;
-                                }
-                            }
-                        }
-                        break;
+        case kZoomLevelCondition:
+            if ( globals()->gZoomMode ==
+                condition->conditionArgument.longValue)
+            {
+                conditionTrue = true;
+            }
+            break;
 
-                    case kIsTargetObject:
-                        sObject = GetObjectFromInitialNumber(condition->subjectObject);
-                        if (sObject != NULL) {
-                            l = GetAdmiralDestinationObject( globals()->gPlayerAdmiralNumber);
-                            if ( l >= 0)
-                            {
-                                dObject = mGetSpaceObjectPtr(l);
-                                if ( dObject == sObject)
-                                {
-                                    conditionTrue = true;
-                                }
-                            }
-                        }
-                        break;
+        case kAutopilotCondition:
+            conditionTrue = IsPlayerShipOnAutoPilot();
 
-                    case kVelocityLessThanEqualToCondition:
-                        sObject = GetObjectFromInitialNumber(condition->subjectObject);
-                        if (sObject != NULL) {
-                            if (( (ABS(sObject->velocity.h)) < condition->conditionArgument.longValue) &&
-                                ( (ABS(sObject->velocity.v)) < condition->conditionArgument.longValue))
-                            {
-                                conditionTrue = true;
-                            }
-                        }
-                        break;
+            break;
 
-                    case kNoShipsLeftCondition:
-                        if ( GetAdmiralShipsLeft( condition->conditionArgument.longValue) <= 0)
-                        {
-                            conditionTrue = true;
-                        }
-                        break;
+        case kNotAutopilotCondition:
+            conditionTrue = !IsPlayerShipOnAutoPilot();
+            break;
 
-                    case kCurrentMessageCondition:
-                        {
-                            if (Messages::current() == (condition->conditionArgument.location.h +
-                                condition->conditionArgument.location.v - 1))
-                            {
-                                conditionTrue = true;
-                            }
+        case kObjectIsBeingBuilt:
+            {
 
-                        }
-                        break;
+                destBalanceType     *buildAtObject = NULL;
 
-                    case kCurrentComputerCondition:
-                        if (( globals()->gMiniScreenData.currentScreen ==
-                            condition->conditionArgument.location.h) &&
-                            ((condition->conditionArgument.location.v < 0) ||
-                                (globals()->gMiniScreenData.selectLine ==
-                                    condition->conditionArgument.location.v)))
-                        {
-                            conditionTrue = true;
-                        }
-                        break;
+                buildAtObject = mGetDestObjectBalancePtr( GetAdmiralBuildAtObject( globals()->gPlayerAdmiralNumber));
+                if ( buildAtObject != NULL)
+                {
+                    if ( buildAtObject->totalBuildTime > 0)
+                    {
+                        conditionTrue = true;
+                    }
+                }
+            }
+            break;
+
+        case kDirectIsSubjectTarget:
+            sObject = GetObjectFromInitialNumber(condition->subjectObject);
+            dObject = GetObjectFromInitialNumber(condition->directObject);
+            if ((sObject != NULL) && (dObject != NULL)) {
+                if ( sObject->destObjectID == dObject->id)
+                    conditionTrue = true;
+            }
+            break;
 
-                    case kZoomLevelCondition:
-                        if ( globals()->gZoomMode ==
-                            condition->conditionArgument.longValue)
-                        {
-                            conditionTrue = true;
-                        }
-                        break;
+        case kSubjectIsPlayerCondition:
+            sObject = GetObjectFromInitialNumber(condition->subjectObject);
+            if (sObject != NULL) {
+                if ( sObject->entryNumber == globals()->gPlayerShipNumber)
+                    conditionTrue = true;
+            }
+            break;
 
-                    case kAutopilotCondition:
-                        conditionTrue = IsPlayerShipOnAutoPilot();
+        default:
+            break;
 
-                        break;
+    }
+    return conditionTrue;
+}
 
-                    case kNotAutopilotCondition:
-                        conditionTrue = !IsPlayerShipOnAutoPilot();
-                        break;
+}  // namespace
 
-                    case kObjectIsBeingBuilt:
-                        {
+void MarkCounterConditionsDirty(int32_t whichAdmiral, int32_t whichCounter) {
+    for (int32_t i: globals()->gCounterConditions) {
+        const Scenario::Condition* condition = globals()->gThisScenario->condition(i);
+        if ((mGetRealAdmiralNum(condition->conditionArgument.counter.whichPlayer) == whichAdmiral)
+                && (condition->conditionArgument.counter.whichCounter == whichCounter)) {
+            MarkConditionDirty(i);
+        }
+    }
+}
 
-                            destBalanceType     *buildAtObject = NULL;
+bool ConditionTrueYet(int32_t whichCondition) {
+    return globals()->gConditionTrueYet[whichCondition];
+}
 
-                            buildAtObject = mGetDestObjectBalancePtr( GetAdmiralBuildAtObject( globals()->gPlayerAdmiralNumber));
-                            if ( buildAtObject != NULL)
-                            {
-                                if ( buildAtObject->totalBuildTime > 0)
-                                {
-                                    conditionTrue = true;
-                                }
-                            }
-                        }
-                        break;
+void SetConditionTrueYet(int32_t whichCondition, bool state) {
+    globals()->gConditionTrueYet[whichCondition] = state;
+}
 
-                    case kDirectIsSubjectTarget:
-                        sObject = GetObjectFromInitialNumber(condition->subjectObject);
-                        dObject = GetObjectFromInitialNumber(condition->directObject);
-                        if ((sObject != NULL) && (dObject != NULL)) {
-                            if ( sObject->destObjectID == dObject->id)
-                                conditionTrue = true;
-                        }
-                        break;
+void MarkConditionDirty(int32_t whichCondition) {
+    if ((whichCondition < 0) || (whichCondition >= globals()->gConditionState.size())) {
+        return;
+    }
+    globals()->gConditionState[whichCondition] |= kConditionDirty;
+    UpdateConditionCheck(whichCondition);
+}
 
-                    case kSubjectIsPlayerCondition:
-                        sObject = GetObjectFromInitialNumber(condition->subjectObject);
-                        if (sObject != NULL) {
-                            if ( sObject->entryNumber == globals()->gPlayerShipNumber)
-                                conditionTrue = true;
-                        }
-                        break;
+// Only the conditions that need a look are visited, in order.  Each is evaluated if it is polled
+// or dirty; otherwise what it was last time still holds.
+void CheckScenarioConditions(int32_t timePass) {
+    const Scenario::Condition   *condition = NULL;
+    spaceObjectType         *sObject = NULL, *dObject = NULL;
+    int32_t                 i;
+    Point                   offset(0, 0);
+    bool                 conditionTrue = false;
 
-                    default:
-                        break;
+#pragma unused( timePass)
+
+        const vector<int32_t>& times = globals()->gTimeConditions;
+        size_t& nextTime = globals()->gNextTimeCondition;
+        while ((nextTime < times.size()) && (globals()->gGameTime >= condition_time(times[nextTime])))
+        {
+            MarkConditionDirty(times[nextTime]);
+            nextTime++;
+        }
 
+        for ( i = NextConditionToCheck(-1); i >= 0; i = NextConditionToCheck(i))
+        {
+            condition = globals()->gThisScenario->condition(i);
+            if ( (!(condition->flags & kTrueOnlyOnce)) || ( !ConditionTrueYet( i)))
+            {
+                uint8_t& state = globals()->gConditionState[i];
+                if ( state & (kConditionPolled | kConditionDirty))
+                {
+                    state &= ~kConditionDirty;
+                    if ( ConditionIsTrue( condition))
+                        state |= kConditionTrue;
+                    else state &= ~kConditionTrue;
                 }
+                conditionTrue = state & kConditionTrue;
                 if ( conditionTrue)
                 {
-                    condition->flags |= kHasBeenTrue;
+                    SetConditionTrueYet( i, true);
                     sObject = GetObjectFromInitialNumber(condition->subjectObject);
                     dObject = GetObjectFromInitialNumber(condition->directObject);
                     ExecuteObjectActions( condition->startVerb, condition->verbNum,
                         sObject, dObject, &offset, true);
                 }
             }
-            condition++;
+            UpdateConditionCheck(i);
         }
 }
 
@@ -1313,7 +1454,7 @@ int32_t GetRealAdmiralNumber(int32_t whichAdmiral) {
 }
 
 void UnhideInitialObject(int32_t whichInitial) {
-    Scenario::InitialObject     *initial;
+    const Scenario::InitialObject   *initial;
     spaceObjectType         *anObject = NULL;
     coordPointType          coord;
     fixedPointType          v = {0, 0};
@@ -1323,13 +1464,13 @@ void UnhideInitialObject(int32_t whichInitial) {
 
     v.h = 0;
     v.v = 0;
-    initial = gThisScenario->initial(whichInitial);
+    initial = globals()->gThisScenario->initial(whichInitial);
     anObject = GetObjectFromInitialNumber(whichInitial);
     if (anObject == NULL) {
-        GetInitialCoord( initial, &coord, gScenarioRotation);
+        GetInitialCoord( initial, &coord, globals()->gScenarioRotation);
 
         if ( initial->owner > kScenarioNoOwner)
-            owner = gAdmiralNumbers[initial->owner];
+            owner = globals()->gAdmiralNumbers[initial->owner];
         else owner = kScenarioNoOwner;
 
         specialAttributes = initial->attributes & ( ~kInitialAttributesMask);
@@ -1364,12 +1505,13 @@ void UnhideInitialObject(int32_t whichInitial) {
             mGetBaseObjectFromClassRace( baseObject, type, baseClass, race);
             if ( baseObject == NULL) type = initial->type;
         }
-        initial->realObjectNumber = newShipNum = CreateAnySpaceObject( type, &v, &coord, 0, owner,
+        newShipNum = CreateAnySpaceObject( type, &v, &coord, 0, owner,
                                             specialAttributes,
                                             initial->spriteIDOverride);
+        globals()->gInitialObjectNumbers[whichInitial] = newShipNum;
 
         anObject = mGetSpaceObjectPtr(newShipNum);
-        initial = gThisScenario->initial(whichInitial);
+        initial = globals()->gThisScenario->initial(whichInitial);
 
         if ( anObject->attributes & kIsDestination)
         {
@@ -1394,7 +1536,7 @@ void UnhideInitialObject(int32_t whichInitial) {
             }
         }
 
-        initial->realObjectID = anObject->id;
+        globals()->gInitialObjectIDs[whichInitial] = anObject->id;
         if (( initial->attributes & kIsPlayerShip) &&
             ( GetAdmiralFlagship( owner) == NULL))
         {
@@ -1412,23 +1554,20 @@ void UnhideInitialObject(int32_t whichInitial) {
             {
                 // get the correct admiral #
 
-                owner = gAdmiralNumbers[initial->owner];
+                owner = globals()->gAdmiralNumbers[initial->owner];
 
-                // INITIAL IS BEING CHANGED HERE
-                initial = gThisScenario->initial(initial->initialDestination);
-                if ( initial->realObjectNumber >= 0)
+                if ( globals()->gInitialObjectNumbers[initial->initialDestination] >= 0)
                 {
                     saveDest = GetAdmiralDestinationObject( owner); // save the original dest
 
                     // set the admiral's dest object to the mapped initial dest object
                     SetAdmiralDestinationObject( owner,
-                        initial->realObjectNumber,
+                        globals()->gInitialObjectNumbers[initial->initialDestination],
                         kObjectDestinationType);
 
                     // now give the mapped initial object the admiral's destination
 
-                    initial = gThisScenario->initial(whichInitial);
-                    anObject = mGetSpaceObjectPtr(initial->realObjectNumber);
+                    anObject = mGetSpaceObjectPtr(globals()->gInitialObjectNumbers[whichInitial]);
                     specialAttributes = anObject->attributes; // preserve the attributes
                     anObject->attributes &= ~kStaticDestination; // we've got to force this off so we can set dest
                     SetObjectDestination( anObject, NULL);
@@ -1444,10 +1583,11 @@ void UnhideInitialObject(int32_t whichInitial) {
 
 spaceObjectType *GetObjectFromInitialNumber(int32_t initialNumber) {
     if (initialNumber >= 0) {
-        Scenario::InitialObject* initial = gThisScenario->initial(initialNumber);
-        if (initial->realObjectNumber >= 0) {
-            spaceObjectType& object = *mGetSpaceObjectPtr(initial->realObjectNumber);
-            if ((object.id != initial->realObjectID) || (object.active != kObjectInUse)) {
+        const int32_t objectNumber = globals()->gInitialObjectNumbers[initialNumber];
+        if (objectNumber >= 0) {
+            spaceObjectType& object = *mGetSpaceObjectPtr(objectNumber);
+            if ((object.id != globals()->gInitialObjectIDs[initialNumber])
+                    || (object.active != kObjectInUse)) {
                 return NULL;
             }
             return &object;
@@ -1500,7 +1640,7 @@ void GetScenarioFullScaleAndCorner(
         Rect *bounds) {
     int32_t         biggest, count, otherCount, mustFit;
     Point           coord, otherCoord, tempCoord;
-    Scenario::InitialObject     *initial;
+    const Scenario::InitialObject   *initial;
 
 
 #pragma unused( rotation)
@@ -1513,12 +1653,12 @@ void GetScenarioFullScaleAndCorner(
         initial = scenario->initial(count);
         if ( !(initial->attributes & kInitiallyHidden))
         {
-            GetInitialCoord( initial, reinterpret_cast<coordPointType *>(&coord), gScenarioRotation);
+            GetInitialCoord( initial, reinterpret_cast<coordPointType *>(&coord), globals()->gScenarioRotation);
 
             for ( otherCount = 0; otherCount < scenario->initialNum; otherCount++)
             {
                 initial = scenario->initial(otherCount);
-                GetInitialCoord( initial, reinterpret_cast<coordPointType *>(&otherCoord), gScenarioRotation);
+                GetInitialCoord( initial, reinterpret_cast<coordPointType *>(&otherCoord), globals()->gScenarioRotation);
 
                 if ( ABS( otherCoord.h - coord.h) > biggest)
                     biggest = ABS( otherCoord.h - coord.h);
@@ -1542,7 +1682,7 @@ void GetScenarioFullScaleAndCorner(
     {
         if ( !(initial->attributes & kInitiallyHidden))
         {
-            GetInitialCoord( initial, reinterpret_cast<coordPointType *>(&tempCoord), gScenarioRotation);
+            GetInitialCoord( initial, reinterpret_cast<coordPointType *>(&tempCoord), globals()->gScenarioRotation);
 
             if ( (tempCoord.h) < coord.h)
                 coord.h = tempCoord.h;
@@ -1580,7 +1720,7 @@ const Scenario* GetScenarioPtrFromChapter(int32_t chapter) {
 }
 
 coordPointType Translate_Coord_To_Scenario_Rotation(int32_t h, int32_t v) {
-    int32_t lcos, lsin, lscrap, angle = gScenarioRotation;
+    int32_t lcos, lsin, lscrap, angle = globals()->gScenarioRotation;
     coordPointType coord;
 
     mAddAngle( angle, 90);
@@ -1601,4 +1741,32 @@ coordPointType Translate_Coord_To_Scenario_Rotation(int32_t h, int32_t v) {
     return coord;
 }
 
+void write_scenario_state(WriteTarget out) {
+    write(out, globals()->gScenarioRotation);
+    write(out, globals()->gAdmiralNumbers, kMaxPlayerNum);
+    for (int32_t i = 0; i < globals()->gThisScenario->conditionNum; ++i) {
+        write(out, globals()->gConditionTrueYet[i]);
+    }
+    for (int32_t i = 0; i < globals()->gThisScenario->initialNum; ++i) {
+        write(out, globals()->gInitialObjectNumbers[i]);
+        write(out, globals()->gInitialObjectIDs[i]);
+    }
+}
+
+void read_scenario_state(ReadSource in) {
+    read(in, globals()->gScenarioRotation);
+    read(in, globals()->gAdmiralNumbers, kMaxPlayerNum);
+    globals()->gConditionTrueYet.resize(globals()->gThisScenario->conditionNum);
+    for (int32_t i = 0; i < globals()->gThisScenario->conditionNum; ++i) {
+        read(in, globals()->gConditionTrueYet[i]);
+    }
+    globals()->gInitialObjectNumbers.resize(globals()->gThisScenario->initialNum);
+    globals()->gInitialObjectIDs.resize(globals()->gThisScenario->initialNum);
+    for (int32_t i = 0; i < globals()->gThisScenario->initialNum; ++i) {
+        read(in, globals()->gInitialObjectNumbers[i]);
+        read(in, globals()->gInitialObjectIDs[i]);
+    }
+    ResetConditionChecks();
+}
+
 }  // namespace antares
@@ -47,12 +47,19 @@ using sfz::Exception;
 using sfz::ReadSource;
 using sfz::String;
 using sfz::StringSlice;
+using sfz::WriteTarget;
 using sfz::read;
+using sfz::write;
+using std::min;
 using std::unique_ptr;
+using std::vector;
 
 namespace antares {
 
-const size_t kActionQueueLength     = 120;
+// The action timing wheel has one slot per tick.  An action due more than a wheel's turn away
+// shares its slot with nearer ones, and is passed over until its own turn comes round.
+const size_t kActionWheelSlots      = 1024;
+const size_t kActionQueueBlockSize  = 128;
 
 const uint8_t kFriendlyColor        = GREEN;
 const uint8_t kHostileColor         = RED;
@@ -65,44 +72,286 @@ static const int16_t kSpaceObjectShortNameResID     = 5001;
 static StringList* space_object_names;
 static StringList* space_object_short_names;
 
-struct actionQueueType {
-    objectActionType            *action;
-    int32_t                         actionNum;
-    int32_t                         actionToDo;
-    int32_t                         scheduledTime;
-    actionQueueType         *nextActionQueue;
-    int32_t                         nextActionQueueNum;
-    spaceObjectType         *subjectObject;
-    int32_t                         subjectObjectNum;
-    int32_t                         subjectObjectID;
-    spaceObjectType         *directObject;
-    int32_t                         directObjectNum;
-    int32_t                         directObjectID;
-    Point                       offset;
+// What ExecuteObjectActions() does for an action: its verb, with the sub-verbs of kDie and
+// kAlter flattened out.  Verbs that do nothing are kNoActionOp.
+enum actionOpType {
+    kNoActionOp,
+    kCreateObjectOp,
+    kCreateObjectSetDestOp,
+    kPlaySoundOp,
+    kMakeSparksOp,
+    kDieExpireOp,
+    kDieDestroyOp,
+    kDieOp,
+    kNilTargetOp,
+    kAlterDamageOp,
+    kAlterEnergyOp,
+    kAlterHiddenOp,
+    kAlterCloakOp,
+    kAlterSpinOp,
+    kAlterOfflineOp,
+    kAlterVelocityOp,
+    kAlterMaxVelocityOp,
+    kAlterThrustOp,
+    kAlterBaseTypeOp,
+    kAlterOwnerOp,
+    kAlterConditionTrueYetOp,
+    kAlterOccupationOp,
+    kAlterAbsoluteCashOp,
+    kAlterAgeOp,
+    kAlterLocationOp,
+    kAlterAbsoluteLocationOp,
+    kAlterWeapon1Op,
+    kAlterWeapon2Op,
+    kAlterSpecialOp,
+    kLandAtOp,
+    kEnterWarpOp,
+    kChangeScoreOp,
+    kDeclareWinnerOp,
+    kDisplayMessageOp,
+    kSetDestinationOp,
+    kActivateSpecialOp,
+    kColorFlashOp,
+    kEnableKeysOp,
+    kDisableKeysOp,
+    kSetZoomOp,
+    kComputerSelectOp,
+    kAssumeInitialObjectOp,
 };
 
-spaceObjectType* gRootObject = NULL;
-int32_t gRootObjectNumber = -1;
-
-static actionQueueType* gFirstActionQueue = NULL;
-static int32_t gFirstActionQueueNumber = -1;
-static baseObjectType kZeroBaseObject;
-static spaceObjectType kZeroSpaceObject = {0, &kZeroBaseObject};
+// An objectActionType, with everything that does not depend on the objects involved worked out
+// when the actions are loaded.  The verb's arguments are still read from `action`.
+struct compiledActionType {
+    objectActionType*   action;
+    actionOpType        op;
+    int32_t             run;            // actions from this one up to the next kNoAction
+    bool                delayed;
+    int16_t             owner;          // 0 no matter, 1 same owner, -1 different owner
+    bool                levelKeyFilter; // compare `filter` with the level key tag, not attributes
+    uint32_t            filter;
+    baseObjectType*     baseObject;     // created, or installed as a weapon, if any
+};
 
-static unique_ptr<spaceObjectType[]> gSpaceObjectData;
+// Shared by every game; the objects and action queues themselves are in globals().
 static unique_ptr<baseObjectType[]> gBaseObjectData;
 static unique_ptr<objectActionType[]> gObjectActionData;
-static unique_ptr<actionQueueType[]> gActionQueueData;
+static unique_ptr<compiledActionType[]> gCompiledActionData;
+
+static void ClearSpaceObjectSlots();
+
+static void AllocateSpaceObjects(int32_t capacity) {
+    globals()->gSpaceObjectData.reset(new spaceObjectType[capacity]);
+    globals()->gSpaceObjectMotionData.reset(new spaceObjectMotionType[capacity]);
+    for (int32_t i = 0; i < capacity; ++i) {
+        globals()->gSpaceObjectData[i].motion = &globals()->gSpaceObjectMotionData[i];
+    }
+    globals()->gSpaceObjectSlots.resize((capacity + 63) / 64);
+    globals()->gObjectOwnerPosition.resize(capacity);
+    globals()->maxSpaceObject = capacity;
+    ClearSpaceObjectSlots();
+}
+
+static int32_t FindOpenSpaceObjectSlot() {
+    size_t& word = globals()->gFirstOpenSlotWord;
+    for ( ; word < globals()->gSpaceObjectSlots.size(); ++word) {
+        const uint64_t open = ~globals()->gSpaceObjectSlots[word];
+        if (open) {
+            const int32_t slot = (word * 64) + __builtin_ctzll(open);
+            return (slot < globals()->maxSpaceObject) ? slot : -1;
+        }
+    }
+    return -1;
+}
+
+static bool SpaceObjectSlotOccupied(int32_t whichObject) {
+    return globals()->gSpaceObjectSlots[whichObject / 64] & (1ull << (whichObject % 64));
+}
+
+// A cell of gObjectCounts; -1 stands for any base type, or any owner.
+static int32_t& ObjectCount(int32_t whichType, int32_t owner) {
+    return globals()->gObjectCounts[((whichType + 1) * (kMaxPlayerNum + 1)) + (owner + 1)];
+}
+
+// Adds the object in an occupied slot to the indices by owner and base type, or, if `delta` is
+// -1, takes it out again.  Objects with no owner are counted, but not listed.
+static void IndexSpaceObject(int32_t whichObject, int32_t delta) {
+    const spaceObjectType* anObject = mGetSpaceObjectPtr(whichObject);
+    const int32_t owner =
+        ((anObject->owner >= 0) && (anObject->owner < kMaxPlayerNum)) ? anObject->owner : -1;
+    const int32_t whichType =
+        ((anObject->whichBaseObject >= 0) && (anObject->whichBaseObject < plugin()->maxBaseObject))
+        ? anObject->whichBaseObject : -1;
+
+    ObjectCount(-1, -1) += delta;
+    if (whichType >= 0) {
+        ObjectCount(whichType, -1) += delta;
+    }
+    if (owner < 0) {
+        return;
+    }
+    ObjectCount(-1, owner) += delta;
+    if (whichType >= 0) {
+        ObjectCount(whichType, owner) += delta;
+    }
+
+    vector<int32_t>& owned = globals()->gObjectsByOwner[owner];
+    int32_t& position = globals()->gObjectOwnerPosition[whichObject];
+    if (delta > 0) {
+        position = owned.size();
+        owned.push_back(whichObject);
+    } else {
+        owned[position] = owned.back();
+        globals()->gObjectOwnerPosition[owned[position]] = position;
+        owned.pop_back();
+    }
+}
+
+static void ClearSpaceObjectSlots() {
+    globals()->gSpaceObjectSlots.assign(globals()->gSpaceObjectSlots.size(), 0);
+    globals()->gFirstOpenSlotWord = 0;
+    globals()->gSpaceObjectHighWater = 0;
+    globals()->gObjectsByOwner.assign(kMaxPlayerNum, vector<int32_t>());
+    globals()->gObjectCounts.assign((plugin()->maxBaseObject + 1) * (kMaxPlayerNum + 1), 0);
+}
+
+static void OccupySpaceObjectSlot(int32_t whichObject) {
+    globals()->gSpaceObjectSlots[whichObject / 64] |= (1ull << (whichObject % 64));
+    globals()->gSpaceObjectHighWater = std::max(globals()->gSpaceObjectHighWater, whichObject + 1);
+    IndexSpaceObject(whichObject, 1);
+}
+
+void ReleaseSpaceObjectSlot(int32_t whichObject) {
+    IndexSpaceObject(whichObject, -1);
+    globals()->gSpaceObjectSlots[whichObject / 64] &= ~(1ull << (whichObject % 64));
+    globals()->gFirstOpenSlotWord = min<size_t>(globals()->gFirstOpenSlotWord, whichObject / 64);
+}
+
+// Returns the lowest slot after `whichObject` that is in use, or -1 if there is none; pass -1
+// to start from the beginning.  Skips free slots a word at a time, so walks over the objects
+// cost little more than the number of live objects.
+int32_t NextSpaceObjectSlot(int32_t whichObject) {
+    const size_t slot = whichObject + 1;
+    size_t word = slot / 64;
+    if (word >= globals()->gSpaceObjectSlots.size()) {
+        return -1;
+    }
+    uint64_t used = globals()->gSpaceObjectSlots[word] & (~0ull << (slot % 64));
+    while (used == 0) {
+        if (++word == globals()->gSpaceObjectSlots.size()) {
+            return -1;
+        }
+        used = globals()->gSpaceObjectSlots[word];
+    }
+    return (word * 64) + __builtin_ctzll(used);
+}
+
+static actionOpType ActionOp(const objectActionType& action) {
+    switch (action.verb) {
+      case kCreateObject:           return kCreateObjectOp;
+      case kCreateObjectSetDest:    return kCreateObjectSetDestOp;
+      case kPlaySound:              return kPlaySoundOp;
+      case kMakeSparks:             return kMakeSparksOp;
+      case kNilTarget:              return kNilTargetOp;
+      case kLandAt:                 return kLandAtOp;
+      case kEnterWarp:              return kEnterWarpOp;
+      case kChangeScore:            return kChangeScoreOp;
+      case kDeclareWinner:          return kDeclareWinnerOp;
+      case kDisplayMessage:         return kDisplayMessageOp;
+      case kSetDestination:         return kSetDestinationOp;
+      case kActivateSpecial:        return kActivateSpecialOp;
+      case kColorFlash:             return kColorFlashOp;
+      case kEnableKeys:             return kEnableKeysOp;
+      case kDisableKeys:            return kDisableKeysOp;
+      case kSetZoom:                return kSetZoomOp;
+      case kComputerSelect:         return kComputerSelectOp;
+      case kAssumeInitialObject:    return kAssumeInitialObjectOp;
+
+      case kDie:
+        switch (action.argument.killObject.dieType) {
+          case kDieExpire:          return kDieExpireOp;
+          case kDieDestroy:         return kDieDestroyOp;
+          default:                  return kDieOp;
+        }
+
+      case kAlter:
+        switch (action.argument.alterObject.alterType) {
+          case kAlterDamage:            return kAlterDamageOp;
+          case kAlterEnergy:            return kAlterEnergyOp;
+          case kAlterHidden:            return kAlterHiddenOp;
+          case kAlterCloak:             return kAlterCloakOp;
+          case kAlterSpin:              return kAlterSpinOp;
+          case kAlterOffline:           return kAlterOfflineOp;
+          case kAlterVelocity:          return kAlterVelocityOp;
+          case kAlterMaxVelocity:       return kAlterMaxVelocityOp;
+          case kAlterThrust:            return kAlterThrustOp;
+          case kAlterBaseType:          return kAlterBaseTypeOp;
+          case kAlterOwner:             return kAlterOwnerOp;
+          case kAlterConditionTrueYet:  return kAlterConditionTrueYetOp;
+          case kAlterOccupation:        return kAlterOccupationOp;
+          case kAlterAbsoluteCash:      return kAlterAbsoluteCashOp;
+          case kAlterAge:               return kAlterAgeOp;
+          case kAlterLocation:          return kAlterLocationOp;
+          case kAlterAbsoluteLocation:  return kAlterAbsoluteLocationOp;
+          case kAlterWeapon1:           return kAlterWeapon1Op;
+          case kAlterWeapon2:           return kAlterWeapon2Op;
+          case kAlterSpecial:           return kAlterSpecialOp;
+          default:                      return kNoActionOp;
+        }
+
+      default:
+        return kNoActionOp;
+    }
+}
+
+// Compiles every object action, once the base objects and actions are loaded.  Actions are
+// shared by every scenario, and any action can begin a range (queued actions resume partway
+// through theirs), so the whole table is compiled rather than each base object's ranges.
+static void CompileObjectActions() {
+    const int32_t count = plugin()->maxObjectAction;
+    gCompiledActionData.reset(new compiledActionType[count]);
+    int32_t run = 0;
+    for (int32_t i = count - 1; i >= 0; --i) {
+        objectActionType& action = gObjectActionData[i];
+        compiledActionType& compiled = gCompiledActionData[i];
+        run = (action.verb == kNoAction) ? 0 : (run + 1);
+        compiled.action = &action;
+        compiled.op = ActionOp(action);
+        compiled.run = run;
+        compiled.delayed = (action.delay > 0);
+        compiled.owner = action.owner;
+        compiled.levelKeyFilter = (action.exclusiveFilter == 0xffffffff);
+        compiled.filter = action.inclusiveFilter;
+        if (compiled.levelKeyFilter) {
+            compiled.filter &= kLevelKeyTagMask;
+        }
+        compiled.baseObject = NULL;
+        switch (compiled.op) {
+          case kCreateObjectOp:
+          case kCreateObjectSetDestOp:
+            compiled.baseObject = mGetBaseObjectPtr(action.argument.createObject.whichBaseType);
+            break;
+          case kAlterWeapon1Op:
+          case kAlterWeapon2Op:
+          case kAlterSpecialOp:
+            if (action.argument.alterObject.minimum != kNoWeapon) {
+                compiled.baseObject = mGetBaseObjectPtr(action.argument.alterObject.minimum);
+            }
+            break;
+          default:
+            break;
+        }
+    }
+}
 
 void SpaceObjectHandlingInit() {
     bool correctBaseObjectColor = false;
 
-    gSpaceObjectData.reset(new spaceObjectType[kMaxSpaceObject]);
+    AllocateSpaceObjects(kMinSpaceObjectCapacity);
     if (gBaseObjectData.get() == NULL) {
         Resource rsrc("objects", "bsob", kBaseObjectResID);
         BytesSlice in(rsrc.data());
         size_t count = rsrc.data().size() / baseObjectType::byte_size;
-        globals()->maxBaseObject = count;
+        plugin()->maxBaseObject = count;
         gBaseObjectData.reset(new baseObjectType[count]);
         for (size_t i = 0; i < count; ++i) {
             read(in, gBaseObjectData[i]);
@@ -117,7 +366,7 @@ void SpaceObjectHandlingInit() {
         Resource rsrc("object-actions", "obac", kObjectActionResID);
         BytesSlice in(rsrc.data());
         size_t count = rsrc.data().size() / objectActionType::byte_size;
-        globals()->maxObjectAction = count;
+        plugin()->maxObjectAction = count;
         gObjectActionData.reset(new objectActionType[count]);
         for (size_t i = 0; i < count; ++i) {
             read(in, gObjectActionData[i]);
@@ -125,34 +374,62 @@ void SpaceObjectHandlingInit() {
         if (!in.empty()) {
             throw Exception("didn't consume all of object action data");
         }
+        CompileObjectActions();
     }
 
-    gActionQueueData.reset(new actionQueueType[kActionQueueLength]);
     if (correctBaseObjectColor) {
         CorrectAllBaseObjectColor();
     }
     ResetAllSpaceObjects();
     ResetActionQueueData();
 
-    space_object_names = new StringList(kSpaceObjectNameResID);
-    space_object_short_names = new StringList(kSpaceObjectShortNameResID);
+    if (space_object_names == NULL) {
+        space_object_names = new StringList(kSpaceObjectNameResID);
+        space_object_short_names = new StringList(kSpaceObjectShortNameResID);
+    }
 }
 
 void CleanupSpaceObjectHandling() {
     gBaseObjectData.reset();
-    gSpaceObjectData.reset();
+    globals()->gSpaceObjectData.reset();
+    globals()->gSpaceObjectMotionData.reset();
+    globals()->gZeroSpaceObject.reset();
+    globals()->gZeroSpaceObjectMotion.reset();
+    globals()->gZeroBaseObject.reset();
     gObjectActionData.reset();
-    gActionQueueData.reset();
+    gCompiledActionData.reset();
+    globals()->gActionQueueBlocks.clear();
+    globals()->gFreeActionQueue = NULL;
+    globals()->gActionWheel.clear();
+}
+
+// ExecuteObjectActions() stands a zeroed object in for a missing subject or direct object, as
+// NULL was in the original.  Actions can write to it, so each game has its own, and it's zeroed
+// again along with the rest of the objects.
+static void ResetZeroSpaceObject() {
+    aresGlobalType& g = *globals();
+    if (!g.gZeroSpaceObject) {
+        g.gZeroSpaceObject.reset(new spaceObjectType);
+        g.gZeroSpaceObjectMotion.reset(new spaceObjectMotionType);
+        g.gZeroBaseObject.reset(new baseObjectType);
+    }
+    *g.gZeroBaseObject = baseObjectType();
+    *g.gZeroSpaceObjectMotion = spaceObjectMotionType();
+    *g.gZeroSpaceObject = spaceObjectType();
+    g.gZeroSpaceObject->baseType = g.gZeroBaseObject.get();
+    g.gZeroSpaceObject->motion = g.gZeroSpaceObjectMotion.get();
 }
 
 void ResetAllSpaceObjects() {
     spaceObjectType *anObject = NULL;
-    int16_t         i;
+    int32_t         i;
 
-    gRootObject = NULL;
-    gRootObjectNumber = -1;
-    anObject = gSpaceObjectData.get();
-    for (i = 0; i < kMaxSpaceObject; i++) {
+    globals()->gRootObject = NULL;
+    globals()->gRootObjectNumber = -1;
+    ResetZeroSpaceObject();
+    ClearSpaceObjectSlots();
+    anObject = globals()->gSpaceObjectData.get();
+    for (i = 0; i < globals()->maxSpaceObject; i++) {
 //      anObject->attributes = 0;
         anObject->active = kObjectAvailable;
         anObject->sprite = NULL;
@@ -242,31 +519,51 @@ void ResetAllSpaceObjects() {
     }
 }
 
+// Sizes the object table for a scenario.  Everything in the old table is discarded, along with
+// the sprites, which are sized to match, and the count of objects dropped for want of a slot.
+void SetSpaceObjectCapacity(int32_t capacity) {
+    if (capacity != globals()->maxSpaceObject) {
+        AllocateSpaceObjects(capacity);
+        SetSpriteCapacity(2 * capacity);
+        globals()->gScrollStarObject = NULL;
+    }
+    ResetAllSpaceObjects();
+    globals()->gDroppedSpaceObjects = 0;
+}
+
+static void FreeActionQueue(actionQueueType* actionQueue) {
+    actionQueue->action = NULL;
+    actionQueue->subjectObject = NULL;
+    actionQueue->directObject = NULL;
+    actionQueue->nextActionQueue = globals()->gFreeActionQueue;
+    globals()->gFreeActionQueue = actionQueue;
+}
+
+static void FreeActionQueueBlock(actionQueueType* block) {
+    for (size_t i = kActionQueueBlockSize; i > 0; --i) {
+        FreeActionQueue(&block[i - 1]);
+    }
+}
+
+static actionQueueType* NewActionQueue() {
+    if (globals()->gFreeActionQueue == NULL) {
+        globals()->gActionQueueBlocks.emplace_back(new actionQueueType[kActionQueueBlockSize]);
+        FreeActionQueueBlock(globals()->gActionQueueBlocks.back().get());
+    }
+    actionQueueType* actionQueue = globals()->gFreeActionQueue;
+    globals()->gFreeActionQueue = actionQueue->nextActionQueue;
+    actionQueue->nextActionQueue = NULL;
+    return actionQueue;
+}
+
 void ResetActionQueueData( void)
 {
-    actionQueueType *action = gActionQueueData.get();
-    int32_t         i;
-
-    gFirstActionQueueNumber = -1;
-    gFirstActionQueue = NULL;
-
-    for ( i = 0; i < kActionQueueLength; i++)
-    {
-        action->actionNum = -1;
-        action->actionToDo = 0;
-        action->action = NULL;
-        action->nextActionQueueNum = -1;
-        action->nextActionQueue = NULL;
-        action->scheduledTime = -1;
-        action->subjectObject = NULL;
-        action->subjectObjectNum = -1;
-        action->subjectObjectID = -1;
-        action->directObject = NULL;
-        action->directObjectNum = -1;
-        action->directObjectID = -1;
-        action->offset.h = action->offset.v = 0;
-        action++;
+    globals()->gActionWheel.assign(kActionWheelSlots, NULL);
+    globals()->gFreeActionQueue = NULL;
+    for (size_t i = globals()->gActionQueueBlocks.size(); i > 0; --i) {
+        FreeActionQueueBlock(globals()->gActionQueueBlocks[i - 1].get());
     }
+    globals()->gActionQueueTime = 0;
 }
 
 baseObjectType* mGetBaseObjectPtr(int32_t whichObject) {
@@ -278,7 +575,14 @@ baseObjectType* mGetBaseObjectPtr(int32_t whichObject) {
 
 spaceObjectType* mGetSpaceObjectPtr(int32_t whichObject) {
     if (whichObject >= 0) {
-        return gSpaceObjectData.get() + whichObject;
+        return globals()->gSpaceObjectData.get() + whichObject;
+    }
+    return nullptr;
+}
+
+spaceObjectMotionType* mGetSpaceObjectMotionPtr(int32_t whichObject) {
+    if (whichObject >= 0) {
+        return globals()->gSpaceObjectMotionData.get() + whichObject;
     }
     return nullptr;
 }
@@ -301,12 +605,12 @@ void mGetBaseObjectFromClassRace(
     else
     {
         mbaseObject = mGetBaseObjectPtr( 0);
-        while (( mcount < globals()->maxBaseObject) && (( mbaseObject->baseClass != mbaseClass) || ( mbaseObject->baseRace != mbaseRace)))
+        while (( mcount < plugin()->maxBaseObject) && (( mbaseObject->baseClass != mbaseClass) || ( mbaseObject->baseRace != mbaseRace)))
         {
             mcount++;
             mbaseObject++;
         }
-        if ( mcount >= globals()->maxBaseObject) mbaseObject = NULL;
+        if ( mcount >= plugin()->maxBaseObject) mbaseObject = NULL;
     }
 }
 
@@ -329,17 +633,14 @@ int AddSpaceObject( spaceObjectType *sourceObject)
     uint8_t         tinyShade;
     int16_t         whichShape = 0, angle;
 
-    destObject = gSpaceObjectData.get();
-
-    while (( destObject->active) && ( whichObject < kMaxSpaceObject))
-    {
-        whichObject++;
-        destObject++;
-    }
-    if ( whichObject == kMaxSpaceObject)
+    whichObject = FindOpenSpaceObjectSlot();
+    if ( whichObject < 0)
     {
+        globals()->gDroppedSpaceObjects++;
         return( -1);
     }
+    destObject = globals()->gSpaceObjectData.get() + whichObject;
+    InvalidateProximityIndex();
 
     if ( sourceObject->pixResID != kNoSpriteTable)
     {
@@ -355,18 +656,21 @@ int AddSpaceObject( spaceObjectType *sourceObject)
     }
 
 //  sourceObject->id = whichObject;
+    spaceObjectMotionType* motion = destObject->motion;
     *destObject = *sourceObject;
+    *motion = *sourceObject->motion;
+    destObject->motion = motion;
 
-    destObject->lastLocation = destObject->location;
+    destObject->motion->lastLocation = destObject->motion->location;
     destObject->collideObject = NULL;
-    destObject->lastLocation.h += 100000;
-    destObject->lastLocation.v += 100000;
-    destObject->lastDir = destObject->direction;
+    destObject->motion->lastLocation.h += 100000;
+    destObject->motion->lastLocation.v += 100000;
+    destObject->motion->lastDir = destObject->motion->direction;
 
-                scaleCalc = ( destObject->location.h - gGlobalCorner.h) * gAbsoluteScale;
+                scaleCalc = ( destObject->motion->location.h - globals()->gGlobalCorner.h) * globals()->gAbsoluteScale;
                 scaleCalc >>= SHIFT_SCALE;
                 where.h = scaleCalc + viewport.left;
-                scaleCalc = (destObject->location.v - gGlobalCorner.v) * gAbsoluteScale;
+                scaleCalc = (destObject->motion->location.v - globals()->gGlobalCorner.v) * globals()->gAbsoluteScale;
                 scaleCalc >>= SHIFT_SCALE; /*+ CLIP_TOP*/;
                 where.v = scaleCalc;
 
@@ -413,7 +717,7 @@ int AddSpaceObject( spaceObjectType *sourceObject)
             whichShape = more_evil_fixed_to_long(destObject->frame.animation.thisShape);
         } else if ( destObject->attributes & kShapeFromDirection)
         {
-            angle = destObject->direction;
+            angle = destObject->motion->direction;
             mAddAngle( angle, destObject->baseType->frame.rotation.rotRes >> 1);
             whichShape = angle / destObject->baseType->frame.rotation.rotRes;
         }
@@ -457,7 +761,7 @@ int AddSpaceObject( spaceObjectType *sourceObject)
 
     if ( destObject->attributes & kIsBeam)
     {
-        destObject->frame.beam.beam = Beams::add( &(destObject->location),
+        destObject->frame.beam.beam = Beams::add( &(destObject->motion->location),
             destObject->baseType->frame.beam.color,
             destObject->baseType->frame.beam.kind,
             destObject->baseType->frame.beam.accuracy,
@@ -465,19 +769,20 @@ int AddSpaceObject( spaceObjectType *sourceObject)
             &(destObject->frame.beam.whichBeam));
     }
 
-    destObject->nextObject = gRootObject;
-    destObject->nextObjectNumber = gRootObjectNumber;
+    destObject->nextObject = globals()->gRootObject;
+    destObject->nextObjectNumber = globals()->gRootObjectNumber;
     destObject->previousObject = NULL;
     destObject->previousObjectNumber = -1;
-    if ( gRootObject != NULL)
+    if ( globals()->gRootObject != NULL)
     {
-        gRootObject->previousObject = destObject;
-        gRootObject->previousObjectNumber = whichObject;
+        globals()->gRootObject->previousObject = destObject;
+        globals()->gRootObject->previousObjectNumber = whichObject;
     }
-    gRootObject = destObject;
-    gRootObjectNumber = whichObject;
+    globals()->gRootObject = destObject;
+    globals()->gRootObjectNumber = whichObject;
 
     destObject->active = kObjectInUse;
+    OccupySpaceObjectSlot(whichObject);
     destObject->nextNearObject = destObject->nextFarObject = NULL;
     destObject->whichLabel = Labels::kNone;
     destObject->entryNumber = whichObject;
@@ -506,9 +811,9 @@ int AddNumberedSpaceObject( spaceObjectType *sourceObject, int32_t whichObject)
     spritePix       oldStyleSprite;
     int32_t         scaleCalc;
 
-    destObject = gSpaceObjectData.get() + whichObject;
+    destObject = globals()->gSpaceObjectData.get() + whichObject;
 
-    if ( whichObject == kMaxSpaceObject) return( -1);
+    if ( whichObject == globals()->maxSpaceObject) return( -1);
 
     if ( sourceObject->pixResID == kNoSpriteTable)
     {
@@ -529,8 +834,8 @@ int AddNumberedSpaceObject( spaceObjectType *sourceObject, int32_t whichObject)
 
 //  sourceObject->id = whichObject;
     *destObject = *sourceObject;
-    where.h = destObject->location.h - gGlobalCorner.h + CLIP_LEFT;
-    where.v = destObject->location.v - gGlobalCorner.v; //+ CLIP_TOP
+    where.h = destObject->location.h - globals()->gGlobalCorner.h + CLIP_LEFT;
+    where.v = destObject->location.v - globals()->gGlobalCorner.v; //+ CLIP_TOP
     if ( destObject->sprite != nil) RemoveSprite( destObject->sprite);
     if ( spriteTable != nil)
     {
@@ -566,8 +871,8 @@ void RemoveAllSpaceObjects( void)
     spaceObjectType *anObject;
     int             i;
 
-    anObject = gSpaceObjectData.get();
-    for ( i = 0; i < kMaxSpaceObject; i++)
+    anObject = globals()->gSpaceObjectData.get();
+    for ( i = 0; i < globals()->maxSpaceObject; i++)
     {
         if ( anObject->sprite != NULL)
         {
@@ -580,6 +885,7 @@ void RemoveAllSpaceObjects( void)
         anObject->attributes = 0;
         anObject++;
     }
+    ClearSpaceObjectSlots();
 }
 
 void CorrectAllBaseObjectColor( void)
@@ -588,7 +894,7 @@ void CorrectAllBaseObjectColor( void)
     baseObjectType  *aBase = gBaseObjectData.get();
     int16_t         i;
 
-    for ( i = 0; i < globals()->maxBaseObject; i++)
+    for ( i = 0; i < plugin()->maxBaseObject; i++)
     {
         if (( aBase->shieldColor != 0xFF) && ( aBase->shieldColor != 0))
         {
@@ -667,7 +973,7 @@ static void InitSpaceObjectFromBaseObject(
         i = dObject->randomSeed.next(sObject->initialDirectionRange);
         mAddAngle( r, i);
     }
-    dObject->direction = r;
+    dObject->motion->direction = r;
 
     f = sObject->initialVelocity;
     if ( sObject->initialVelocityRange > 0)
@@ -684,16 +990,16 @@ static void InitSpaceObjectFromBaseObject(
         newVel.v += velocity->v;
     }
 
-    dObject->velocity.h = newVel.h;
-    dObject->velocity.v = newVel.v;
-    dObject->maxVelocity = sObject->maxVelocity;
+    dObject->motion->velocity.h = newVel.h;
+    dObject->motion->velocity.v = newVel.v;
+    dObject->motion->maxVelocity = sObject->maxVelocity;
 
-    dObject->motionFraction.h = dObject->motionFraction.v = 0;
+    dObject->motion->motionFraction.h = dObject->motion->motionFraction.v = 0;
     if ((dObject->attributes & kCanThink) ||
             (dObject->attributes & kRemoteOrHuman))
-        dObject->thrust = 0;
+        dObject->motion->thrust = 0;
     else
-        dObject->thrust = sObject->maxThrust;
+        dObject->motion->thrust = sObject->maxThrust;
 
 
     dObject->energy = sObject->energy;
@@ -717,7 +1023,7 @@ static void InitSpaceObjectFromBaseObject(
     if ( dObject->attributes & kCanTurn)
     {
         dObject->directionGoal =
-            dObject->turnFraction = dObject->turnVelocity = 0;
+            dObject->motion->turnFraction = dObject->motion->turnVelocity = 0;
     }
     if ( dObject->attributes & kIsSelfAnimated)
     {
@@ -862,10 +1168,13 @@ void ChangeObjectBaseType( spaceObjectType *dObject, int32_t whichBaseObject,
     int32_t         r;
     NatePixTable* spriteTable;
 
+    const bool indexed = SpaceObjectSlotOccupied(dObject->entryNumber);
+    if (indexed) IndexSpaceObject(dObject->entryNumber, -1);
     dObject->attributes = sObject->attributes | (dObject->attributes &
         (kIsHumanControlled | kIsRemote | kIsPlayerShip | kStaticDestination));
     dObject->baseType = sObject;
     dObject->whichBaseObject = whichBaseObject;
+    if (indexed) IndexSpaceObject(dObject->entryNumber, 1);
     dObject->tinySize = sObject->tinySize;
     dObject->shieldColor = sObject->shieldColor;
     dObject->layer = sObject->pixLayer;
@@ -873,7 +1182,7 @@ void ChangeObjectBaseType( spaceObjectType *dObject, int32_t whichBaseObject,
     if ( dObject->attributes & kCanTurn)
     {
         dObject->directionGoal =
-            dObject->turnFraction = dObject->turnVelocity = 0;
+            dObject->motion->turnFraction = dObject->motion->turnVelocity = 0;
     }
     if ( dObject->attributes & kIsSelfAnimated)
     {
@@ -902,7 +1211,7 @@ void ChangeObjectBaseType( spaceObjectType *dObject, int32_t whichBaseObject,
 //      dObject->frame.beam.killMe = false;
     }
 
-    dObject->maxVelocity = sObject->maxVelocity;
+    dObject->motion->maxVelocity = sObject->maxVelocity;
 
     dObject->age = sObject->initialAge + dObject->randomSeed.next(sObject->initialAgeRange);
 
@@ -1033,7 +1342,7 @@ void ChangeObjectBaseType( spaceObjectType *dObject, int32_t whichBaseObject,
             dObject->sprite->whichShape = more_evil_fixed_to_long(dObject->frame.animation.thisShape);
         } else if ( dObject->attributes & kShapeFromDirection)
         {
-            angle = dObject->direction;
+            angle = dObject->motion->direction;
             mAddAngle( angle, sObject->frame.rotation.rotRes >> 1);
             dObject->sprite->whichShape = angle / sObject->frame.rotation.rotRes;
         } else
@@ -1048,20 +1357,11 @@ void AddActionToQueue( objectActionType *action, int32_t actionNumber, int32_t a
                         int32_t delayTime, spaceObjectType *subjectObject,
                         spaceObjectType *directObject, Point* offset)
 {
-    int32_t             queueNumber = 0;
-    actionQueueType     *actionQueue = gActionQueueData.get(),
-                        *nextQueue = gFirstActionQueue, *previousQueue = NULL;
-
-    while (( actionQueue->action != NULL) && ( queueNumber < kActionQueueLength))
-    {
-        actionQueue++;
-        queueNumber++;
-    }
-
-    if ( queueNumber == kActionQueueLength) return;
+    actionQueueType* actionQueue = NewActionQueue();
     actionQueue->action = action;
     actionQueue->actionNum = actionNumber;
-    actionQueue->scheduledTime = delayTime;
+    // Nothing is due before the next call to ExecuteActionQueue().
+    actionQueue->dueTime = globals()->gActionQueueTime + std::max<int32_t>(delayTime, 1);
     actionQueue->subjectObject = subjectObject;
     actionQueue->actionToDo = actionToDo;
 
@@ -1094,87 +1394,62 @@ void AddActionToQueue( objectActionType *action, int32_t actionNumber, int32_t a
         actionQueue->directObjectID = -1;
     }
 
-    while (( nextQueue != NULL) && ( nextQueue->scheduledTime < delayTime))
-    {
-        previousQueue = nextQueue;
-        nextQueue = nextQueue->nextActionQueue;
-    }
-    if ( previousQueue == NULL)
-    {
-        actionQueue->nextActionQueue = gFirstActionQueue;
-        actionQueue->nextActionQueueNum = gFirstActionQueueNumber;
-        gFirstActionQueue = actionQueue;
-        gFirstActionQueueNumber = queueNumber;
-    } else
-    {
-        actionQueue->nextActionQueue = previousQueue->nextActionQueue;
-        actionQueue->nextActionQueueNum = previousQueue->nextActionQueueNum;
+    // Newer actions go first in their slot.  Of the actions due at the same time, the newest has
+    // always fired first, and ExecuteActionQueue() fires each slot in order.
+    actionQueueType*& slot = globals()->gActionWheel[actionQueue->dueTime % kActionWheelSlots];
+    actionQueue->nextActionQueue = slot;
+    slot = actionQueue;
+}
 
-        previousQueue->nextActionQueue = actionQueue;
-        previousQueue->nextActionQueueNum = queueNumber;
+static void FireActionQueue(actionQueueType* actionQueue) {
+    int32_t subjectid = -1;
+    int32_t directid = -1;
+    if ((actionQueue->subjectObject != NULL) && actionQueue->subjectObject->active) {
+        subjectid = actionQueue->subjectObject->id;
+    }
+    if ((actionQueue->directObject != NULL) && actionQueue->directObject->active) {
+        directid = actionQueue->directObject->id;
+    }
+    if ((subjectid == actionQueue->subjectObjectID)
+            && (directid == actionQueue->directObjectID)) {
+        ExecuteObjectActions(actionQueue->actionNum, actionQueue->actionToDo,
+                actionQueue->subjectObject, actionQueue->directObject, &actionQueue->offset,
+                false);
     }
 }
 
 void ExecuteActionQueue( int32_t unitsToDo)
-
 {
-//  actionQueueType     *actionQueue = gFirstActionQueue;
-    actionQueueType     *actionQueue = gActionQueueData.get();
-    int32_t                     subjectid, directid, i;
-
-    for ( i = 0; i < kActionQueueLength; i++)
-    {
-        if ( actionQueue->action != NULL)
-        {
-            actionQueue->scheduledTime -= unitsToDo;
-        }
-        actionQueue++;
-    }
-
-    actionQueue = gFirstActionQueue;
-    while (( gFirstActionQueue != NULL) &&
-        ( gFirstActionQueue->action != NULL) &&
-        ( gFirstActionQueue->scheduledTime <= 0))
-    {
-        subjectid = -1;
-        directid = -1;
-        if ( gFirstActionQueue->subjectObject != NULL)
-        {
-            if ( gFirstActionQueue->subjectObject->active)
-                subjectid = gFirstActionQueue->subjectObject->id;
+    // Actions queued while others fire are timed from the end of this call, as they were when
+    // every entry counted down by `unitsToDo` first.  So none of them comes due until the next.
+    const int64_t start = globals()->gActionQueueTime;
+    globals()->gActionQueueTime += unitsToDo;
+    for (int64_t now = start + 1; now <= globals()->gActionQueueTime; ++now) {
+        // Detach the slot, so that anything queued into it while its actions fire is left alone.
+        actionQueueType*& slot = globals()->gActionWheel[now % kActionWheelSlots];
+        actionQueueType* pending = slot;
+        actionQueueType* later = NULL;
+        actionQueueType** later_end = &later;
+        slot = NULL;
+        while (pending != NULL) {
+            actionQueueType* actionQueue = pending;
+            pending = actionQueue->nextActionQueue;
+            if (actionQueue->dueTime != now) {
+                *later_end = actionQueue;
+                later_end = &actionQueue->nextActionQueue;
+                continue;
+            }
+            FireActionQueue(actionQueue);
+            FreeActionQueue(actionQueue);
         }
 
-        if ( gFirstActionQueue->directObject != NULL)
-        {
-            if ( gFirstActionQueue->directObject->active)
-                directid = gFirstActionQueue->directObject->id;
-        }
-        if (( subjectid == gFirstActionQueue->subjectObjectID) &&
-            ( directid == gFirstActionQueue->directObjectID))
-        {
-            ExecuteObjectActions( gFirstActionQueue->actionNum, gFirstActionQueue->actionToDo,
-                gFirstActionQueue->subjectObject, gFirstActionQueue->directObject,
-                &(gFirstActionQueue->offset), false);
+        // Whatever was queued meanwhile is newer than the actions passed over, so goes first.
+        *later_end = NULL;
+        actionQueueType** end = &slot;
+        while (*end != NULL) {
+            end = &(*end)->nextActionQueue;
         }
-        gFirstActionQueue->actionNum = -1;
-        gFirstActionQueue->actionToDo = 0;
-        gFirstActionQueue->action = NULL;
-        gFirstActionQueue->scheduledTime = -1;
-        gFirstActionQueue->subjectObject = NULL;
-        gFirstActionQueue->subjectObjectNum = -1;
-        gFirstActionQueue->subjectObjectID = -1;
-        gFirstActionQueue->directObject = NULL;
-        gFirstActionQueue->directObjectNum = -1;
-        gFirstActionQueue->directObjectID = -1;
-        gFirstActionQueue->offset.h = gFirstActionQueue->offset.v = 0;
-
-        actionQueue = gFirstActionQueue;
-
-        gFirstActionQueueNumber = gFirstActionQueue->nextActionQueueNum;
-        gFirstActionQueue = gFirstActionQueue->nextActionQueue;
-
-        actionQueue->nextActionQueueNum = -1;
-        actionQueue->nextActionQueue = NULL;
+        *end = later;
     }
 }
 
@@ -1186,7 +1461,6 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
 
     spaceObjectType *anObject, *originalSObject = sObject, *originalDObject = dObject;
     baseObjectType  *baseObject;
-    objectActionType    *action = gObjectActionData.get() + whichAction;
     int16_t         end, angle;
     fixedPointType  fpoint, newVel;
     int32_t         l;
@@ -1197,10 +1471,14 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
     bool         OKtoExecute, checkConditions = false;
     Fixed           aFixed;
     uint8_t         tinyColor;
+    spaceObjectType* const zero = globals()->gZeroSpaceObject.get();
 
     if ( whichAction < 0) return;
-    while (( action->verb != kNoAction) && ( actionNum > 0))
+    const compiledActionType* compiled = gCompiledActionData.get() + whichAction;
+    actionNum = min(actionNum, compiled->run);
+    while ( actionNum > 0)
     {
+        objectActionType* action = compiled->action;
         if ( action->initialSubjectOverride != kNoShip)
             sObject = GetObjectFromInitialNumber( action->initialSubjectOverride);
         else
@@ -1210,7 +1488,7 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
          else
             dObject = originalDObject;
 
-        if (( action->delay > 0) && ( allowDelay))
+        if (( compiled->delayed) && ( allowDelay))
         {
             AddActionToQueue( action, whichAction, actionNum,
                         action->delay, sObject, dObject, offset);
@@ -1241,43 +1519,38 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
         // transports somehow, so we emulate the old behavior of
         // pointing to a zeroed-out object.
         if (dObject == NULL) {
-            dObject = &kZeroSpaceObject;
+            dObject = zero;
         }
         if (sObject == NULL) {
-            sObject = &kZeroSpaceObject;
+            sObject = zero;
         }
         if (anObject == NULL) {
         }
 
         if (anObject == NULL) {
             OKtoExecute = true;
-            anObject = &kZeroSpaceObject;
-        } else if ( ( action->owner == 0) ||
+            anObject = zero;
+        } else if ( ( compiled->owner == 0) ||
                     (
                         (
-                            ( action->owner == -1) &&
+                            ( compiled->owner == -1) &&
                             ( dObject->owner != sObject->owner)
                         ) ||
                         (
-                            ( action->owner == 1) &&
+                            ( compiled->owner == 1) &&
                             ( dObject->owner == sObject->owner)
                         )
                     )
                 )
         {
-            if ( action->exclusiveFilter == 0xffffffff)
+            if ( compiled->levelKeyFilter)
             {
-                if (    (action->inclusiveFilter & kLevelKeyTagMask) ==
-                            ( dObject->baseType->buildFlags & kLevelKeyTagMask)
-                    )
-                {
-                    OKtoExecute = true;
-                }
-            } else if ( ( action->inclusiveFilter & dObject->attributes) == action->inclusiveFilter)
+                OKtoExecute =
+                    (compiled->filter == (dObject->baseType->buildFlags & kLevelKeyTagMask));
+            } else
             {
-                OKtoExecute = true;
+                OKtoExecute = ((compiled->filter & dObject->attributes) == compiled->filter);
             }
-
         }
 /*
         if (    ( anObject == nil) ||
@@ -1293,11 +1566,11 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
 */
         if ( OKtoExecute)
         {
-            switch ( action->verb)
+            switch ( compiled->op)
             {
-                case kCreateObject:
-                case kCreateObjectSetDest:
-                    baseObject = mGetBaseObjectPtr( action->argument.createObject.whichBaseType);
+                case kCreateObjectOp:
+                case kCreateObjectSetDestOp:
+                    baseObject = compiled->baseObject;
                     end = action->argument.createObject.howManyMinimum;
                     if ( action->argument.createObject.howManyRange > 0)
                         end += anObject->randomSeed.next(
@@ -1305,7 +1578,7 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
                     while ( end > 0)
                     {
                         if ( action->argument.createObject.velocityRelative)
-                            fpoint = anObject->velocity;
+                            fpoint = anObject->motion->velocity;
                         else
                             fpoint.h = fpoint.v = 0;
                         l = 0;
@@ -1313,13 +1586,13 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
                         {
                             l = sObject->targetAngle;
                         } else if ( action->argument.createObject.directionRelative)
-                                l = anObject->direction;
+                                l = anObject->motion->direction;
                         /*
                         l += baseObject->initialDirection;
                         if ( baseObject->initialDirectionRange > 0)
                             l += anObject->randomSeed.next(baseObject->initialDirectionRange);
                         */
-                        newLocation = anObject->location;
+                        newLocation = anObject->motion->location;
                         if ( offset != NULL)
                         {
                             newLocation.h += offset->h;
@@ -1343,7 +1616,7 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
 
                         if ( l >= 0)
                         {
-                            spaceObjectType *newObject = gSpaceObjectData.get() + l;
+                            spaceObjectType *newObject = globals()->gSpaceObjectData.get() + l;
                             if ( newObject->attributes & kCanAcceptDestination)
                             {
                                 ul1 = newObject->attributes;
@@ -1352,7 +1625,7 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
                                 {
                                     if ( action->reflexive)
                                     {
-                                        if ( action->verb != kCreateObjectSetDest)
+                                        if ( compiled->op != kCreateObjectSetDestOp)
                                             SetObjectDestination( newObject, anObject);
                                         else if ( anObject->destObjectPtr != NULL)
                                         {
@@ -1397,7 +1670,7 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
 
                     break;
 
-                case kPlaySound:
+                case kPlaySoundOp:
                     l = action->argument.playSound.volumeMinimum;
                     angle = action->argument.playSound.idMinimum;
                     if ( action->argument.playSound.idRange > 0)
@@ -1417,7 +1690,7 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
 
                     break;
 
-                case kMakeSparks:
+                case kMakeSparksOp:
                     if ( anObject->sprite != NULL)
                     {
                         location.h = anObject->sprite->where.h;
@@ -1430,14 +1703,14 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
                                 &location);                                 // location
                     } else
                     {
-                        l = ( anObject->location.h - gGlobalCorner.h) * gAbsoluteScale;
+                        l = ( anObject->motion->location.h - globals()->gGlobalCorner.h) * globals()->gAbsoluteScale;
                         l >>= SHIFT_SCALE;
                         if (( l > -kSpriteMaxSize) && ( l < kSpriteMaxSize))
                             location.h = l + viewport.left;
                         else
                             location.h = -kSpriteMaxSize;
 
-                        l = (anObject->location.v - gGlobalCorner.v) * gAbsoluteScale;
+                        l = (anObject->motion->location.v - globals()->gGlobalCorner.v) * globals()->gAbsoluteScale;
                         l >>= SHIFT_SCALE; /*+ CLIP_TOP*/;
                         if (( l > -kSpriteMaxSize) && ( l < kSpriteMaxSize))
                             location.v = l + viewport.top;
@@ -1453,503 +1726,482 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
                     }
                     break;
 
-                case kDie:
-//                  if ( anObject->attributes & kIsBeam)
-//                      anObject->frame.beam.killMe = true;
-                    switch ( action->argument.killObject.dieType)
+                case kDieExpireOp:
+                    if ( sObject != NULL)
                     {
-                        case kDieExpire:
-                            if ( sObject != NULL)
-                            {
-                                // if the object is occupied by a human, eject him since he can't die
-                                if (( sObject->attributes & (kIsPlayerShip | kRemoteOrHuman)) &&
-                                    (!(sObject->baseType->destroyActionNum & kDestroyActionDontDieFlag)))
-                                {
-                                    CreateFloatingBodyOfPlayer( sObject);
-                                }
+                        // if the object is occupied by a human, eject him since he can't die
+                        if (( sObject->attributes & (kIsPlayerShip | kRemoteOrHuman)) &&
+                            (!(sObject->baseType->destroyActionNum & kDestroyActionDontDieFlag)))
+                        {
+                            CreateFloatingBodyOfPlayer( sObject);
+                        }
 
-                                if ( sObject->baseType->expireAction >= 0)
-                                {
+                        if ( sObject->baseType->expireAction >= 0)
+                        {
 //                                  ExecuteObjectActions(
 //                                      sObject->baseType->expireAction,
 //                                      sObject->baseType->expireActionNum
 //                                       & kDestroyActionNotMask,
 //                                      sObject, dObject, offset, allowDelay);
-                                }
-                                sObject->active = kObjectToBeFreed;
-                            }
-                            break;
+                        }
+                        sObject->active = kObjectToBeFreed;
+                    }
+                    break;
 
-                        case kDieDestroy:
-                            if ( sObject != NULL)
-                            {
-                                // if the object is occupied by a human, eject him since he can't die
-                                if (( sObject->attributes & (kIsPlayerShip | kRemoteOrHuman)) &&
-                                    (!(sObject->baseType->destroyActionNum & kDestroyActionDontDieFlag)))
-                                {
-                                    CreateFloatingBodyOfPlayer( sObject);
-                                }
+                case kDieDestroyOp:
+                    if ( sObject != NULL)
+                    {
+                        // if the object is occupied by a human, eject him since he can't die
+                        if (( sObject->attributes & (kIsPlayerShip | kRemoteOrHuman)) &&
+                            (!(sObject->baseType->destroyActionNum & kDestroyActionDontDieFlag)))
+                        {
+                            CreateFloatingBodyOfPlayer( sObject);
+                        }
 
-                                DestroyObject( sObject);
-                            }
-                            break;
+                        DestroyObject( sObject);
+                    }
+                    break;
 
-                        default:
-                            // if the object is occupied by a human, eject him since he can't die
-                            if (( anObject->attributes & (kIsPlayerShip | kRemoteOrHuman)) &&
-                                (!(anObject->baseType->destroyActionNum & kDestroyActionDontDieFlag)))
-                            {
-                                CreateFloatingBodyOfPlayer( anObject);
-                            }
-                            anObject->active = kObjectToBeFreed;
-                            break;
+                case kDieOp:
+                    // if the object is occupied by a human, eject him since he can't die
+                    if (( anObject->attributes & (kIsPlayerShip | kRemoteOrHuman)) &&
+                        (!(anObject->baseType->destroyActionNum & kDestroyActionDontDieFlag)))
+                    {
+                        CreateFloatingBodyOfPlayer( anObject);
                     }
+                    anObject->active = kObjectToBeFreed;
                     break;
 
-                case kNilTarget:
+                case kNilTargetOp:
                     anObject->targetObjectNumber = kNoShip;
                     anObject->targetObjectID = kNoShip;
                     anObject->lastTarget = kNoShip;
                     break;
 
-                case kAlter:
-                    switch( action->argument.alterObject.alterType)
+                case kAlterDamageOp:
+                    AlterObjectHealth( anObject,
+                        action->argument.alterObject.minimum);
+                    break;
+
+                case kAlterEnergyOp:
+                    AlterObjectEnergy( anObject,
+                        action->argument.alterObject.minimum);
+                    break;
+
+                /*
+                case 919191://kAlterSpecial:
+                    anObject->specialType = action->argument.alterObject.minimum;
+                    baseObject = mGetBaseObjectPtr( anObject->specialType);
+                    anObject->specialAmmo = baseObject->frame.weapon.ammo;
+                    anObject->specialTime = anObject->specialPosition = 0;
+                    if ( baseObject->frame.weapon.range > anObject->longestWeaponRange)
+                        anObject->longestWeaponRange = baseObject->frame.weapon.range;
+                    if ( baseObject->frame.weapon.range < anObject->shortestWeaponRange)
+                        anObject->shortestWeaponRange = baseObject->frame.weapon.range;
+                    break;
+                */
+
+                case kAlterHiddenOp:
+                    l = 0;
+                    do
                     {
-                        case kAlterDamage:
-                            AlterObjectHealth( anObject,
-                                action->argument.alterObject.minimum);
-                            break;
+                        UnhideInitialObject( action->argument.alterObject.minimum + l);
+                        l++;
+                    } while ( l <= action->argument.alterObject.range);
+                    break;
 
-                        case kAlterEnergy:
-                            AlterObjectEnergy( anObject,
-                                action->argument.alterObject.minimum);
-                            break;
+                case kAlterCloakOp:
+                    AlterObjectCloakState( anObject, true);
+                    break;
 
+                case kAlterSpinOp:
+                    if ( anObject->attributes & kCanTurn)
+                    {
+                        if ( anObject->attributes & kShapeFromDirection)
+                        {
+                            f = mMultiplyFixed( anObject->baseType->frame.rotation.maxTurnRate,
+                                            action->argument.alterObject.minimum +
+                                            anObject->randomSeed.next(
+                                                action->argument.alterObject.range));
+                        } else
+                        {
+                            f = mMultiplyFixed( 2 /*kDefaultTurnRate*/,
+                                            action->argument.alterObject.minimum +
+                                            anObject->randomSeed.next(
+                                                action->argument.alterObject.range));
+                        }
+                        f2 = anObject->baseType->mass;
+                        if ( f2 == 0) f = -1;
+                        else
+                        {
+                            f = mDivideFixed( f, f2);
+                        }
+                        anObject->motion->turnVelocity = f;
                         /*
-                        case 919191://kAlterSpecial:
-                            anObject->specialType = action->argument.alterObject.minimum;
-                            baseObject = mGetBaseObjectPtr( anObject->specialType);
-                            anObject->specialAmmo = baseObject->frame.weapon.ammo;
-                            anObject->specialTime = anObject->specialPosition = 0;
-                            if ( baseObject->frame.weapon.range > anObject->longestWeaponRange)
-                                anObject->longestWeaponRange = baseObject->frame.weapon.range;
-                            if ( baseObject->frame.weapon.range < anObject->shortestWeaponRange)
-                                anObject->shortestWeaponRange = baseObject->frame.weapon.range;
-                            break;
-                        */
+                        anObject->frame.rotation.turnVelocity =
+                                mMultiplyFixed( anObject->baseType->frame.rotation.maxTurnRate,
+                                    action->argument.alterObject.minimum);
 
-                        case kAlterHidden:
-                            l = 0;
-                            do
-                            {
-                                UnhideInitialObject( action->argument.alterObject.minimum + l);
-                                l++;
-                            } while ( l <= action->argument.alterObject.range);
-                            break;
+                        anObject->frame.rotation.turnVelocity += anObject->randomSeed(f);
+                        */
+                    }
+                    break;
 
-                        case kAlterCloak:
-                            AlterObjectCloakState( anObject, true);
-                            break;
+                case kAlterOfflineOp:
+                    f = action->argument.alterObject.minimum +
+                        anObject->randomSeed.next(action->argument.alterObject.range);
+                    f2 = anObject->baseType->mass;
+                    if ( f2 == 0) anObject->offlineTime = -1;
+                    else
+                    {
+                        anObject->offlineTime = mDivideFixed( f, f2);
+                    }
+                    anObject->offlineTime = mFixedToLong( anObject->offlineTime);
+                    break;
 
-                        case kAlterSpin:
-                            if ( anObject->attributes & kCanTurn)
+                case kAlterVelocityOp:
+                    if ( sObject != NULL)
+                    {
+                        // active (non-reflexive) altering of velocity means a PUSH, just like
+                        //  two objects colliding.  Negative velocity = slow down
+                        if ((dObject != NULL) && (dObject != zero)) {
+                            if ( action->argument.alterObject.relative)
                             {
-                                if ( anObject->attributes & kShapeFromDirection)
-                                {
-                                    f = mMultiplyFixed( anObject->baseType->frame.rotation.maxTurnRate,
-                                                    action->argument.alterObject.minimum +
-                                                    anObject->randomSeed.next(
-                                                        action->argument.alterObject.range));
-                                } else
-                                {
-                                    f = mMultiplyFixed( 2 /*kDefaultTurnRate*/,
-                                                    action->argument.alterObject.minimum +
-                                                    anObject->randomSeed.next(
-                                                        action->argument.alterObject.range));
-                                }
-                                f2 = anObject->baseType->mass;
-                                if ( f2 == 0) f = -1;
-                                else
+                                if (( dObject->baseType->mass > 0) &&
+                                    ( dObject->motion->maxVelocity > 0))
                                 {
-                                    f = mDivideFixed( f, f2);
-                                }
-                                anObject->turnVelocity = f;
-                                /*
-                                anObject->frame.rotation.turnVelocity =
-                                        mMultiplyFixed( anObject->baseType->frame.rotation.maxTurnRate,
-                                            action->argument.alterObject.minimum);
-
-                                anObject->frame.rotation.turnVelocity += anObject->randomSeed(f);
-                                */
-                            }
-                            break;
-
-                        case kAlterOffline:
-                            f = action->argument.alterObject.minimum +
-                                anObject->randomSeed.next(action->argument.alterObject.range);
-                            f2 = anObject->baseType->mass;
-                            if ( f2 == 0) anObject->offlineTime = -1;
-                            else
-                            {
-                                anObject->offlineTime = mDivideFixed( f, f2);
-                            }
-                            anObject->offlineTime = mFixedToLong( anObject->offlineTime);
-                            break;
-
-                        case kAlterVelocity:
-                            if ( sObject != NULL)
-                            {
-                                // active (non-reflexive) altering of velocity means a PUSH, just like
-                                //  two objects colliding.  Negative velocity = slow down
-                                if ((dObject != NULL) && (dObject != &kZeroSpaceObject)) {
-                                    if ( action->argument.alterObject.relative)
+                                    if ( action->argument.alterObject.minimum >= 0)
                                     {
-                                        if (( dObject->baseType->mass > 0) &&
-                                            ( dObject->maxVelocity > 0))
+                                        // if the minimum >= 0, then PUSH the object like collision
+                                        f = sObject->motion->velocity.h - dObject->motion->velocity.h;
+                                        f /= dObject->baseType->mass;
+                                        f <<= 6L;
+                                        dObject->motion->velocity.h += f;
+                                        f = sObject->motion->velocity.v - dObject->motion->velocity.v;
+                                        f /= dObject->baseType->mass;
+                                        f <<= 6L;
+                                        dObject->motion->velocity.v += f;
+
+                                        // make sure we're not going faster than our top speed
+
+                                        if ( dObject->motion->velocity.h == 0)
+                                        {
+                                            if ( dObject->motion->velocity.v < 0)
+                                                angle = 180;
+                                            else angle = 0;
+                                        } else
                                         {
-                                            if ( action->argument.alterObject.minimum >= 0)
-                                            {
-                                                // if the minimum >= 0, then PUSH the object like collision
-                                                f = sObject->velocity.h - dObject->velocity.h;
-                                                f /= dObject->baseType->mass;
-                                                f <<= 6L;
-                                                dObject->velocity.h += f;
-                                                f = sObject->velocity.v - dObject->velocity.v;
-                                                f /= dObject->baseType->mass;
-                                                f <<= 6L;
-                                                dObject->velocity.v += f;
-
-                                                // make sure we're not going faster than our top speed
-
-                                                if ( dObject->velocity.h == 0)
-                                                {
-                                                    if ( dObject->velocity.v < 0)
-                                                        angle = 180;
-                                                    else angle = 0;
-                                                } else
-                                                {
-                                                    aFixed = MyFixRatio( dObject->velocity.h, dObject->velocity.v);
-
-                                                    angle = AngleFromSlope( aFixed);
-                                                    if ( dObject->velocity.h > 0) angle += 180;
-                                                    if ( angle >= 360) angle -= 360;
-                                                }
-                                            } else
-                                            {
-                                                // if the minumum < 0, then STOP the object like applying breaks
-                                                f = dObject->velocity.h;
-                                                f = mMultiplyFixed( f, action->argument.alterObject.minimum);
+                                            aFixed = MyFixRatio( dObject->motion->velocity.h, dObject->motion->velocity.v);
+
+                                            angle = AngleFromSlope( aFixed);
+                                            if ( dObject->motion->velocity.h > 0) angle += 180;
+                                            if ( angle >= 360) angle -= 360;
+                                        }
+                                    } else
+                                    {
+                                        // if the minumum < 0, then STOP the object like applying breaks
+                                        f = dObject->motion->velocity.h;
+                                        f = mMultiplyFixed( f, action->argument.alterObject.minimum);
 //                                              f /= dObject->baseType->mass;
 //                                              f <<= 6L;
-                                                dObject->velocity.h += f;
-                                                f = dObject->velocity.v;
-                                                f = mMultiplyFixed( f, action->argument.alterObject.minimum);
+                                        dObject->motion->velocity.h += f;
+                                        f = dObject->motion->velocity.v;
+                                        f = mMultiplyFixed( f, action->argument.alterObject.minimum);
 //                                              f /= dObject->baseType->mass;
 //                                              f <<= 6L;
-                                                dObject->velocity.v += f;
-
-                                                // make sure we're not going faster than our top speed
-
-                                                if ( dObject->velocity.h == 0)
-                                                {
-                                                    if ( dObject->velocity.v < 0)
-                                                        angle = 180;
-                                                    else angle = 0;
-                                                } else
-                                                {
-                                                    aFixed = MyFixRatio( dObject->velocity.h, dObject->velocity.v);
-
-                                                    angle = AngleFromSlope( aFixed);
-                                                    if ( dObject->velocity.h > 0) angle += 180;
-                                                    if ( angle >= 360) angle -= 360;
-                                                }
-                                            }
-
-                                            // get the maxthrust of new vector
-
-                                            GetRotPoint(&f, &f2, angle);
-
-                                            f = mMultiplyFixed( dObject->maxVelocity, f);
-                                            f2 = mMultiplyFixed( dObject->maxVelocity, f2);
-
-                                            if ( f < 0)
-                                            {
-                                                if ( dObject->velocity.h < f)
-                                                    dObject->velocity.h = f;
-                                            } else
-                                            {
-                                                if ( dObject->velocity.h > f)
-                                                    dObject->velocity.h = f;
-                                            }
-
-                                            if ( f2 < 0)
-                                            {
-                                                if ( dObject->velocity.v < f2)
-                                                    dObject->velocity.v = f2;
-                                            } else
-                                            {
-                                                if ( dObject->velocity.v > f2)
-                                                    dObject->velocity.v = f2;
-                                            }
+                                        dObject->motion->velocity.v += f;
+
+                                        // make sure we're not going faster than our top speed
+
+                                        if ( dObject->motion->velocity.h == 0)
+                                        {
+                                            if ( dObject->motion->velocity.v < 0)
+                                                angle = 180;
+                                            else angle = 0;
+                                        } else
+                                        {
+                                            aFixed = MyFixRatio( dObject->motion->velocity.h, dObject->motion->velocity.v);
+
+                                            angle = AngleFromSlope( aFixed);
+                                            if ( dObject->motion->velocity.h > 0) angle += 180;
+                                            if ( angle >= 360) angle -= 360;
                                         }
+                                    }
+
+                                    // get the maxthrust of new vector
+
+                                    GetRotPoint(&f, &f2, angle);
+
+                                    f = mMultiplyFixed( dObject->motion->maxVelocity, f);
+                                    f2 = mMultiplyFixed( dObject->motion->maxVelocity, f2);
+
+                                    if ( f < 0)
+                                    {
+                                        if ( dObject->motion->velocity.h < f)
+                                            dObject->motion->velocity.h = f;
                                     } else
                                     {
-                                        GetRotPoint(&f, &f2, sObject->direction);
-                                        f = mMultiplyFixed( action->argument.alterObject.minimum, f);
-                                        f2 = mMultiplyFixed( action->argument.alterObject.minimum, f2);
-                                        anObject->velocity.h = f;
-                                        anObject->velocity.v = f2;
+                                        if ( dObject->motion->velocity.h > f)
+                                            dObject->motion->velocity.h = f;
                                     }
-                                } else
-                                // reflexive alter velocity means a burst of speed in the direction
-                                // the object is facing, where negative speed means backwards. Object can
-                                // excede its max velocity.
-                                // Minimum value is absolute speed in direction.
-                                {
-                                    GetRotPoint(&f, &f2, anObject->direction);
-                                    f = mMultiplyFixed( action->argument.alterObject.minimum, f);
-                                    f2 = mMultiplyFixed( action->argument.alterObject.minimum, f2);
-                                    if ( action->argument.alterObject.relative)
+
+                                    if ( f2 < 0)
                                     {
-                                        anObject->velocity.h += f;
-                                        anObject->velocity.v += f2;
+                                        if ( dObject->motion->velocity.v < f2)
+                                            dObject->motion->velocity.v = f2;
                                     } else
                                     {
-                                        anObject->velocity.h = f;
-                                        anObject->velocity.v = f2;
+                                        if ( dObject->motion->velocity.v > f2)
+                                            dObject->motion->velocity.v = f2;
                                     }
                                 }
-
-                            }
-                            break;
-
-                        case kAlterMaxVelocity:
-                            if ( action->argument.alterObject.minimum < 0)
-                            {
-                                anObject->maxVelocity = anObject->baseType->maxVelocity;
                             } else
                             {
-                                anObject->maxVelocity =
-                                    action->argument.alterObject.minimum;
+                                GetRotPoint(&f, &f2, sObject->motion->direction);
+                                f = mMultiplyFixed( action->argument.alterObject.minimum, f);
+                                f2 = mMultiplyFixed( action->argument.alterObject.minimum, f2);
+                                anObject->motion->velocity.h = f;
+                                anObject->motion->velocity.v = f2;
                             }
-                            break;
-
-                        case kAlterThrust:
-                            f = action->argument.alterObject.minimum +
-                                anObject->randomSeed.next(action->argument.alterObject.range);
+                        } else
+                        // reflexive alter velocity means a burst of speed in the direction
+                        // the object is facing, where negative speed means backwards. Object can
+                        // excede its max velocity.
+                        // Minimum value is absolute speed in direction.
+                        {
+                            GetRotPoint(&f, &f2, anObject->motion->direction);
+                            f = mMultiplyFixed( action->argument.alterObject.minimum, f);
+                            f2 = mMultiplyFixed( action->argument.alterObject.minimum, f2);
                             if ( action->argument.alterObject.relative)
                             {
-                                anObject->thrust += f;
+                                anObject->motion->velocity.h += f;
+                                anObject->motion->velocity.v += f2;
                             } else
                             {
-                                anObject->thrust = f;
+                                anObject->motion->velocity.h = f;
+                                anObject->motion->velocity.v = f2;
                             }
-                            break;
+                        }
 
-                        case kAlterBaseType:
-                            if ((action->reflexive)
-                                    || ((dObject != NULL) && (dObject != &kZeroSpaceObject)))
-                            ChangeObjectBaseType( anObject, action->argument.alterObject.minimum, -1,
-                                action->argument.alterObject.relative);
-                            break;
+                    }
+                    break;
 
-                        case kAlterOwner:
-/*                          anObject->owner = action->argument.alterObject.minimum;
-                            if ( anObject->attributes & kIsDestination)
-                                RecalcAllAdmiralBuildData();
-*/
-                            if ( action->argument.alterObject.relative)
-                            {
-                                // if it's relative AND reflexive, we take the direct
-                                // object's owner, since relative & reflexive would
-                                // do nothing.
-                                if ((action->reflexive) && (dObject != NULL)
-                                        && (dObject != &kZeroSpaceObject))
-                                    AlterObjectOwner( anObject, dObject->owner, true);
-                                else
-                                    AlterObjectOwner( anObject, sObject->owner, true);
-                            } else
-                            {
-                                AlterObjectOwner( anObject,
-                                        action->argument.alterObject.minimum, false);
-                            }
-                            break;
+                case kAlterMaxVelocityOp:
+                    if ( action->argument.alterObject.minimum < 0)
+                    {
+                        anObject->motion->maxVelocity = anObject->baseType->maxVelocity;
+                    } else
+                    {
+                        anObject->motion->maxVelocity =
+                            action->argument.alterObject.minimum;
+                    }
+                    break;
 
-                        case kAlterConditionTrueYet:
-                            if ( action->argument.alterObject.range <= 0)
-                            {
-                                gThisScenario->condition(action->argument.alterObject.minimum)
-                                    ->set_true_yet(action->argument.alterObject.relative);
-                            } else
-                            {
-                                for (
-                                        l = action->argument.alterObject.minimum;
-                                        l <=    (
-                                                    action->argument.alterObject.minimum +
-                                                    action->argument.alterObject.range
-                                                )
-                                                ;
-                                        l++
-                                    )
-                                {
-                                    gThisScenario->condition(l)->set_true_yet(
-                                            action->argument.alterObject.relative);
-                                }
+                case kAlterThrustOp:
+                    f = action->argument.alterObject.minimum +
+                        anObject->randomSeed.next(action->argument.alterObject.range);
+                    if ( action->argument.alterObject.relative)
+                    {
+                        anObject->motion->thrust += f;
+                    } else
+                    {
+                        anObject->motion->thrust = f;
+                    }
+                    break;
 
-                            }
-                            break;
+                case kAlterBaseTypeOp:
+                    if ((action->reflexive)
+                            || ((dObject != NULL) && (dObject != zero)))
+                    ChangeObjectBaseType( anObject, action->argument.alterObject.minimum, -1,
+                        action->argument.alterObject.relative);
+                    break;
 
-                        case kAlterOccupation:
-                            AlterObjectOccupation( anObject, sObject->owner, action->argument.alterObject.minimum, true);
-                            break;
+                case kAlterOwnerOp:
+/*                          anObject->owner = action->argument.alterObject.minimum;
+                    if ( anObject->attributes & kIsDestination)
+                        RecalcAllAdmiralBuildData();
+*/
+                    if ( action->argument.alterObject.relative)
+                    {
+                        // if it's relative AND reflexive, we take the direct
+                        // object's owner, since relative & reflexive would
+                        // do nothing.
+                        if ((action->reflexive) && (dObject != NULL)
+                                && (dObject != zero))
+                            AlterObjectOwner( anObject, dObject->owner, true);
+                        else
+                            AlterObjectOwner( anObject, sObject->owner, true);
+                    } else
+                    {
+                        AlterObjectOwner( anObject,
+                                action->argument.alterObject.minimum, false);
+                    }
+                    break;
 
-                        case kAlterAbsoluteCash:
-                            if ( action->argument.alterObject.relative)
-                            {
-                                if (anObject != &kZeroSpaceObject) {
-                                    PayAdmiralAbsolute( anObject->owner, action->argument.alterObject.minimum);
-                                }
-                            } else
-                            {
-                                PayAdmiralAbsolute( action->argument.alterObject.range,
-                                    action->argument.alterObject.minimum);
-                            }
-                            break;
+                case kAlterConditionTrueYetOp:
+                    if ( action->argument.alterObject.range <= 0)
+                    {
+                        SetConditionTrueYet(action->argument.alterObject.minimum,
+                                action->argument.alterObject.relative);
+                        MarkConditionDirty(action->argument.alterObject.minimum);
+                    } else
+                    {
+                        for (
+                                l = action->argument.alterObject.minimum;
+                                l <=    (
+                                            action->argument.alterObject.minimum +
+                                            action->argument.alterObject.range
+                                        )
+                                        ;
+                                l++
+                            )
+                        {
+                            SetConditionTrueYet(l, action->argument.alterObject.relative);
+                            MarkConditionDirty(l);
+                        }
 
-                        case kAlterAge:
-                            l = action->argument.alterObject.minimum +
-                                anObject->randomSeed.next(action->argument.alterObject.range);
+                    }
+                    break;
 
-                            if ( action->argument.alterObject.relative)
-                            {
-                                if ( anObject->age >= 0)
-                                {
-                                    anObject->age += l;
+                case kAlterOccupationOp:
+                    AlterObjectOccupation( anObject, sObject->owner, action->argument.alterObject.minimum, true);
+                    break;
 
-                                    if ( anObject->age < 0) anObject->age = 0;
-                                } else
-                                {
-                                    anObject->age += l;
-                                }
-                            } else
-                            {
-                                anObject->age = l;
-                            }
-                            break;
+                case kAlterAbsoluteCashOp:
+                    if ( action->argument.alterObject.relative)
+                    {
+                        if (anObject != zero) {
+                            PayAdmiralAbsolute( anObject->owner, action->argument.alterObject.minimum);
+                        }
+                    } else
+                    {
+                        PayAdmiralAbsolute( action->argument.alterObject.range,
+                            action->argument.alterObject.minimum);
+                    }
+                    break;
 
-                        case kAlterLocation:
-                            if ( action->argument.alterObject.relative)
-                            {
-                                if ((dObject == NULL) && (dObject != &kZeroSpaceObject)) {
-                                    newLocation.h = sObject->location.h;
-                                    newLocation.v = sObject->location.v;
-                                } else {
-                                    newLocation.h = dObject->location.h;
-                                    newLocation.v = dObject->location.v;
-                                }
-                            } else
-                            {
-                                newLocation.h = newLocation.v = 0;
-                            }
-                            newLocation.h += anObject->randomSeed.next(
-                                    action->argument.alterObject.minimum << 1)
-                                - action->argument.alterObject.minimum;
-                            newLocation.v += anObject->randomSeed.next(
-                                    action->argument.alterObject.minimum << 1)
-                                - action->argument.alterObject.minimum;
-                            anObject->location.h = newLocation.h;
-                            anObject->location.v = newLocation.v;
-                            break;
+                case kAlterAgeOp:
+                    l = action->argument.alterObject.minimum +
+                        anObject->randomSeed.next(action->argument.alterObject.range);
 
-                        case kAlterAbsoluteLocation:
-                            if ( action->argument.alterObject.relative)
-                            {
-                                anObject->location.h += action->argument.alterObject.minimum;
-                                anObject->location.v += action->argument.alterObject.range;
-                            } else
-                            {
-                                anObject->location = Translate_Coord_To_Scenario_Rotation(
-                                    action->argument.alterObject.minimum,
-                                    action->argument.alterObject.range);
-                            }
-                            break;
+                    if ( action->argument.alterObject.relative)
+                    {
+                        if ( anObject->age >= 0)
+                        {
+                            anObject->age += l;
 
-                        case kAlterWeapon1:
-                            anObject->pulseType = action->argument.alterObject.minimum;
-                            if ( anObject->pulseType != kNoWeapon)
-                            {
-                                baseObject = anObject->pulseBase =
-                                    mGetBaseObjectPtr( anObject->pulseType);
-                                anObject->pulseAmmo =
-                                    baseObject->frame.weapon.ammo;
-                                anObject->pulseTime =
-                                    anObject->pulsePosition = 0;
-                                if ( baseObject->frame.weapon.range > anObject->longestWeaponRange)
-                                    anObject->longestWeaponRange = baseObject->frame.weapon.range;
-                                if ( baseObject->frame.weapon.range < anObject->shortestWeaponRange)
-                                    anObject->shortestWeaponRange = baseObject->frame.weapon.range;
-                            } else
-                            {
-                                anObject->pulseBase = NULL;
-                                anObject->pulseAmmo = 0;
-                                anObject->pulseTime = 0;
-                            }
-                            break;
+                            if ( anObject->age < 0) anObject->age = 0;
+                        } else
+                        {
+                            anObject->age += l;
+                        }
+                    } else
+                    {
+                        anObject->age = l;
+                    }
+                    break;
 
-                        case kAlterWeapon2:
-                            anObject->beamType = action->argument.alterObject.minimum;
-                            if ( anObject->beamType != kNoWeapon)
-                            {
-                                baseObject = anObject->beamBase =
-                                    mGetBaseObjectPtr( anObject->beamType);
-                                anObject->beamAmmo =
-                                    baseObject->frame.weapon.ammo;
-                                anObject->beamTime =
-                                    anObject->beamPosition = 0;
-                                if ( baseObject->frame.weapon.range > anObject->longestWeaponRange)
-                                    anObject->longestWeaponRange = baseObject->frame.weapon.range;
-                                if ( baseObject->frame.weapon.range < anObject->shortestWeaponRange)
-                                    anObject->shortestWeaponRange = baseObject->frame.weapon.range;
-                            } else
-                            {
-                                anObject->beamBase = NULL;
-                                anObject->beamAmmo = 0;
-                                anObject->beamTime = 0;
-                            }
-                            break;
+                case kAlterLocationOp:
+                    if ( action->argument.alterObject.relative)
+                    {
+                        if ((dObject == NULL) && (dObject != zero)) {
+                            newLocation.h = sObject->motion->location.h;
+                            newLocation.v = sObject->motion->location.v;
+                        } else {
+                            newLocation.h = dObject->motion->location.h;
+                            newLocation.v = dObject->motion->location.v;
+                        }
+                    } else
+                    {
+                        newLocation.h = newLocation.v = 0;
+                    }
+                    newLocation.h += anObject->randomSeed.next(
+                            action->argument.alterObject.minimum << 1)
+                        - action->argument.alterObject.minimum;
+                    newLocation.v += anObject->randomSeed.next(
+                            action->argument.alterObject.minimum << 1)
+                        - action->argument.alterObject.minimum;
+                    anObject->motion->location.h = newLocation.h;
+                    anObject->motion->location.v = newLocation.v;
+                    break;
 
-                        case kAlterSpecial:
-                            anObject->specialType = action->argument.alterObject.minimum;
-                            if ( anObject->specialType != kNoWeapon)
-                            {
-                                baseObject = anObject->specialBase =
-                                    mGetBaseObjectPtr( anObject->specialType);
-                                anObject->specialAmmo =
-                                    baseObject->frame.weapon.ammo;
-                                anObject->specialTime =
-                                    anObject->specialPosition = 0;
-                                if ( baseObject->frame.weapon.range > anObject->longestWeaponRange)
-                                    anObject->longestWeaponRange = baseObject->frame.weapon.range;
-                                if ( baseObject->frame.weapon.range < anObject->shortestWeaponRange)
-                                    anObject->shortestWeaponRange = baseObject->frame.weapon.range;
-                            } else
-                            {
-                                anObject->specialBase = NULL;
-                                anObject->specialAmmo = 0;
-                                anObject->specialTime = 0;
-                            }
-                            break;
+                case kAlterAbsoluteLocationOp:
+                    if ( action->argument.alterObject.relative)
+                    {
+                        anObject->motion->location.h += action->argument.alterObject.minimum;
+                        anObject->motion->location.v += action->argument.alterObject.range;
+                    } else
+                    {
+                        anObject->motion->location = Translate_Coord_To_Scenario_Rotation(
+                            action->argument.alterObject.minimum,
+                            action->argument.alterObject.range);
+                    }
+                    break;
 
-                        case kAlterLevelKeyTag:
-                            break;
+                case kAlterWeapon1Op:
+                    anObject->pulseType = action->argument.alterObject.minimum;
+                    if ( anObject->pulseType != kNoWeapon)
+                    {
+                        baseObject = anObject->pulseBase = compiled->baseObject;
+                        anObject->pulseAmmo =
+                            baseObject->frame.weapon.ammo;
+                        anObject->pulseTime =
+                            anObject->pulsePosition = 0;
+                        if ( baseObject->frame.weapon.range > anObject->longestWeaponRange)
+                            anObject->longestWeaponRange = baseObject->frame.weapon.range;
+                        if ( baseObject->frame.weapon.range < anObject->shortestWeaponRange)
+                            anObject->shortestWeaponRange = baseObject->frame.weapon.range;
+                    } else
+                    {
+                        anObject->pulseBase = NULL;
+                        anObject->pulseAmmo = 0;
+                        anObject->pulseTime = 0;
+                    }
+                    break;
 
-                        default:
-                            break;
+                case kAlterWeapon2Op:
+                    anObject->beamType = action->argument.alterObject.minimum;
+                    if ( anObject->beamType != kNoWeapon)
+                    {
+                        baseObject = anObject->beamBase = compiled->baseObject;
+                        anObject->beamAmmo =
+                            baseObject->frame.weapon.ammo;
+                        anObject->beamTime =
+                            anObject->beamPosition = 0;
+                        if ( baseObject->frame.weapon.range > anObject->longestWeaponRange)
+                            anObject->longestWeaponRange = baseObject->frame.weapon.range;
+                        if ( baseObject->frame.weapon.range < anObject->shortestWeaponRange)
+                            anObject->shortestWeaponRange = baseObject->frame.weapon.range;
+                    } else
+                    {
+                        anObject->beamBase = NULL;
+                        anObject->beamAmmo = 0;
+                        anObject->beamTime = 0;
+                    }
+                    break;
 
+                case kAlterSpecialOp:
+                    anObject->specialType = action->argument.alterObject.minimum;
+                    if ( anObject->specialType != kNoWeapon)
+                    {
+                        baseObject = anObject->specialBase = compiled->baseObject;
+                        anObject->specialAmmo =
+                            baseObject->frame.weapon.ammo;
+                        anObject->specialTime =
+                            anObject->specialPosition = 0;
+                        if ( baseObject->frame.weapon.range > anObject->longestWeaponRange)
+                            anObject->longestWeaponRange = baseObject->frame.weapon.range;
+                        if ( baseObject->frame.weapon.range < anObject->shortestWeaponRange)
+                            anObject->shortestWeaponRange = baseObject->frame.weapon.range;
+                    } else
+                    {
+                        anObject->specialBase = NULL;
+                        anObject->specialAmmo = 0;
+                        anObject->specialTime = 0;
                     }
                     break;
 
-                case kLandAt:
+                case kLandAtOp:
                     // even though this is never a reflexive verb, we only effect ourselves
                     if ( sObject->attributes & ( kIsPlayerShip | kRemoteOrHuman))
                     {
@@ -1960,20 +2212,20 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
                         (action->argument.landAt.landingSpeed << kPresenceDataHiWordShift);
                     break;
 
-                case kEnterWarp:
+                case kEnterWarpOp:
                     sObject->presenceState = kWarpInPresence;
 //                  sObject->presenceData = action->argument.enterWarp.warpSpeed;
                     sObject->presenceData = sObject->baseType->warpSpeed;
                     sObject->attributes &= ~kOccupiesSpace;
                     newVel.h = newVel.v = 0;
-//                  CreateAnySpaceObject( globals()->scenarioFileInfo.warpInFlareID, &(newVel),
+//                  CreateAnySpaceObject( plugin()->scenarioFileInfo.warpInFlareID, &(newVel),
 //                      &(sObject->location), sObject->direction, kNoOwner, 0, nil, -1, -1, -1);
-                    CreateAnySpaceObject( globals()->scenarioFileInfo.warpInFlareID, &(newVel),
-                        &(sObject->location), sObject->direction, kNoOwner, 0, -1);
+                    CreateAnySpaceObject( plugin()->scenarioFileInfo.warpInFlareID, &(newVel),
+                        &(sObject->motion->location), sObject->motion->direction, kNoOwner, 0, -1);
                     break;
 
-                case kChangeScore:
-                    if (( action->argument.changeScore.whichPlayer == -1) && (anObject != &kZeroSpaceObject))
+                case kChangeScoreOp:
+                    if (( action->argument.changeScore.whichPlayer == -1) && (anObject != zero))
                         l = anObject->owner;
                     else
                     {
@@ -1986,8 +2238,8 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
                     }
                     break;
 
-                case kDeclareWinner:
-                    if (( action->argument.declareWinner.whichPlayer == -1) && (anObject != &kZeroSpaceObject))
+                case kDeclareWinnerOp:
+                    if (( action->argument.declareWinner.whichPlayer == -1) && (anObject != zero))
                         l = anObject->owner;
                     else
                     {
@@ -1996,7 +2248,7 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
                     DeclareWinner( l, action->argument.declareWinner.nextLevel, action->argument.declareWinner.textID);
                     break;
 
-                case kDisplayMessage:
+                case kDisplayMessageOp:
                     Messages::start(
                             action->argument.displayMessage.resID,
                             (action->argument.displayMessage.resID +
@@ -2005,35 +2257,35 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
 
                     break;
 
-                case kSetDestination:
+                case kSetDestinationOp:
                     ul1 = sObject->attributes;
                     sObject->attributes &= ~kStaticDestination;
                     SetObjectDestination( sObject, anObject);
                     sObject->attributes = ul1;
                     break;
 
-                case kActivateSpecial:
+                case kActivateSpecialOp:
                     ActivateObjectSpecial( sObject);
                     break;
 
-                case kColorFlash:
+                case kColorFlashOp:
                     tinyColor = GetTranslateColorShade(action->argument.colorFlash.color, action->argument.colorFlash.shade);
                     globals()->transitions.start_boolean(
                             action->argument.colorFlash.length,
                             action->argument.colorFlash.length, tinyColor);
                     break;
 
-                case kEnableKeys:
+                case kEnableKeysOp:
                     globals()->keyMask = globals()->keyMask &
                                                     ~action->argument.keys.keyMask;
                     break;
 
-                case kDisableKeys:
+                case kDisableKeysOp:
                     globals()->keyMask = globals()->keyMask |
                                                     action->argument.keys.keyMask;
                     break;
 
-                case kSetZoom:
+                case kSetZoomOp:
                     if (action->argument.zoom.zoomLevel != globals()->gZoomMode)
                     {
                         globals()->gZoomMode = static_cast<ZoomType>(action->argument.zoom.zoomLevel);
@@ -2044,20 +2296,20 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
                     }
                     break;
 
-                case kComputerSelect:
+                case kComputerSelectOp:
                     MiniComputer_SetScreenAndLineHack( action->argument.computerSelect.screenNumber,
                         action->argument.computerSelect.lineNumber);
                     break;
 
-                case kAssumeInitialObject:
+                case kAssumeInitialObjectOp:
                 {
-                    Scenario::InitialObject *initialObject;
+                    int32_t whichInitial;
 
-                    initialObject = gThisScenario->initial(action->argument.assumeInitial.whichInitialObject+GetAdmiralScore(0, 0));
-                    if ( initialObject != NULL)
+                    whichInitial = action->argument.assumeInitial.whichInitialObject+GetAdmiralScore(0, 0);
+                    if (( whichInitial >= 0) && ( whichInitial < globals()->gInitialObjectNumbers.size()))
                     {
-                        initialObject->realObjectID = anObject->id;
-                        initialObject->realObjectNumber = anObject->entryNumber;
+                        globals()->gInitialObjectIDs[whichInitial] = anObject->id;
+                        globals()->gInitialObjectNumbers[whichInitial] = anObject->entryNumber;
                     }
                 }
                     break;
@@ -2068,7 +2320,7 @@ void ExecuteObjectActions( int32_t whichAction, int32_t actionNum,
         }
 
         actionNum--;
-        action++;
+        compiled++;
         whichAction++;
     }
 
@@ -2081,27 +2333,29 @@ int32_t CreateAnySpaceObject( int32_t whichBase, fixedPointType *velocity,
 
 {
     spaceObjectType *madeObject = NULL, newObject, *player = NULL;
+    spaceObjectMotionType newMotion;
     int32_t         newObjectNumber;
     uint32_t        distance, dcalc, difference;
     uint64_t        hugeDistance;
 
-    InitSpaceObjectFromBaseObject( &newObject, whichBase, {gRandomSeed.next(32766)},
+    newObject.motion = &newMotion;
+    InitSpaceObjectFromBaseObject( &newObject, whichBase, {globals()->gRandomSeed.next(32766)},
                                     direction, velocity, owner, spriteIDOverride);
-    newObject.location = *location;
+    newObject.motion->location = *location;
     if ( globals()->gPlayerShipNumber >= 0)
-        player = gSpaceObjectData.get() + globals()->gPlayerShipNumber;
+        player = globals()->gSpaceObjectData.get() + globals()->gPlayerShipNumber;
     else player = NULL;
     if (( player != NULL) && ( player->active))
     {
-        difference = ABS<int>( player->location.h - newObject.location.h);
+        difference = ABS<int>( player->motion->location.h - newObject.motion->location.h);
         dcalc = difference;
-        difference =  ABS<int>( player->location.v - newObject.location.v);
+        difference =  ABS<int>( player->motion->location.v - newObject.motion->location.v);
         distance = difference;
     } else
     {
-        difference = ABS<int>( gGlobalCorner.h - newObject.location.h);
+        difference = ABS<int>( globals()->gGlobalCorner.h - newObject.motion->location.h);
         dcalc = difference;
-        difference =  ABS<int>( gGlobalCorner.v - newObject.location.v);
+        difference =  ABS<int>( globals()->gGlobalCorner.v - newObject.motion->location.v);
         distance = difference;
     }
     /*
@@ -2144,7 +2398,7 @@ int32_t CreateAnySpaceObject( int32_t whichBase, fixedPointType *velocity,
     }
 
     newObject.sprite = NULL;
-    newObject.id = gRandomSeed.next(16384);
+    newObject.id = globals()->gRandomSeed.next(16384);
 
     if ( newObject.attributes & kCanTurn)
     {
@@ -2157,10 +2411,10 @@ int32_t CreateAnySpaceObject( int32_t whichBase, fixedPointType *velocity,
 /*      newObject.frame.beam.lastGlobalLocation = *location;
         newObject.frame.beam.killMe = false;
 
-        h = ( newObject.location.h - gGlobalCorner.h) * gAbsoluteScale;
+        h = ( newObject.location.h - globals()->gGlobalCorner.h) * globals()->gAbsoluteScale;
         h >>= SHIFT_SCALE;
         newObject.frame.beam.thisLocation.left = h + CLIP_LEFT;
-        h = (newObject.location.v - gGlobalCorner.v) * gAbsoluteScale;
+        h = (newObject.location.v - globals()->gGlobalCorner.v) * globals()->gAbsoluteScale;
         h >>= SHIFT_SCALE; //+ CLIP_TOP
         newObject.frame.beam.thisLocation.top = h;
 
@@ -2178,7 +2432,7 @@ int32_t CreateAnySpaceObject( int32_t whichBase, fixedPointType *velocity,
         return ( -1);
     } else
     {
-        madeObject = gSpaceObjectData.get() + newObjectNumber;
+        madeObject = globals()->gSpaceObjectData.get() + newObjectNumber;
         madeObject->attributes |= specialAttributes;
         ExecuteObjectActions( madeObject->baseType->createAction, madeObject->baseType->createActionNum,
                             madeObject, NULL, NULL, true);
@@ -2186,22 +2440,20 @@ int32_t CreateAnySpaceObject( int32_t whichBase, fixedPointType *velocity,
     return( newObjectNumber);
 }
 
+// Counts the objects in use of `whichType` belonging to `owner`; either may be -1, for any.
 int32_t CountObjectsOfBaseType( int32_t whichType, int32_t owner)
 
 {
-    int32_t count, result = 0;
-
-    spaceObjectType *anObject;
-
-    anObject = gSpaceObjectData.get();
-    for ( count = 0; count < kMaxSpaceObject; count++)
+    if (( whichType < -1) || ( whichType >= plugin()->maxBaseObject) ||
+        ( owner < -1) || ( owner >= kMaxPlayerNum))
     {
-        if (( anObject->active) &&
-            (( anObject->whichBaseObject == whichType) || ( whichType == -1)) &&
-            (( anObject->owner == owner) || ( owner == -1))) result++;
-        anObject++;
+        return 0;
     }
-    return (result);
+    return ObjectCount(whichType, owner);
+}
+
+const vector<int32_t>& ObjectsOfOwner(int32_t owner) {
+    return globals()->gObjectsByOwner[owner];
 }
 
 int32_t GetNextObjectWithAttributes( int32_t startWith, uint32_t attributes, bool exclude)
@@ -2210,7 +2462,7 @@ int32_t GetNextObjectWithAttributes( int32_t startWith, uint32_t attributes, boo
     int32_t original = startWith;
     spaceObjectType *anObject;
 
-    anObject = gSpaceObjectData.get() + startWith;
+    anObject = globals()->gSpaceObjectData.get() + startWith;
 
     if ( exclude)
     {
@@ -2221,8 +2473,8 @@ int32_t GetNextObjectWithAttributes( int32_t startWith, uint32_t attributes, boo
 
             if ( anObject == NULL)
             {
-                startWith = gRootObjectNumber;
-                anObject = gRootObject;
+                startWith = globals()->gRootObjectNumber;
+                anObject = globals()->gRootObject;
             }
         } while (( anObject->attributes & attributes) && ( startWith != original));
         if (( startWith == original) && ( anObject->attributes & attributes)) return ( -1);
@@ -2236,8 +2488,8 @@ int32_t GetNextObjectWithAttributes( int32_t startWith, uint32_t attributes, boo
 
             if ( anObject == NULL)
             {
-                startWith = gRootObjectNumber;
-                anObject = gRootObject;
+                startWith = globals()->gRootObjectNumber;
+                anObject = globals()->gRootObject;
             }
         } while ((!( anObject->attributes & attributes)) && ( startWith != original));
         if (( startWith == original) && (!( anObject->attributes & attributes))) return ( -1);
@@ -2315,7 +2567,10 @@ void AlterObjectOwner( spaceObjectType *anObject, int32_t owner, bool message)
             CreateFloatingBodyOfPlayer( anObject);
         }
 
+        const bool indexed = SpaceObjectSlotOccupied(anObject->entryNumber);
+        if (indexed) IndexSpaceObject(anObject->entryNumber, -1);
         anObject->owner = owner;
+        if (indexed) IndexSpaceObject(anObject->entryNumber, 1);
 
         if (( owner >= 0) && ( anObject->attributes & kIsDestination))
         {
@@ -2395,9 +2650,9 @@ void AlterObjectOwner( spaceObjectType *anObject, int32_t owner, bool message)
         anObject->bestConsideredTargetValue = anObject->currentTargetValue = 0xffffffff;
         anObject->bestConsideredTargetNumber = -1;
 
-        fixObject = gSpaceObjectData.get();
-        for ( i = 0; i < kMaxSpaceObject; i++)
+        for ( i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i))
         {
+            fixObject = globals()->gSpaceObjectData.get() + i;
             if (( fixObject->destinationObject == anObject->entryNumber) && ( fixObject->active !=
                 kObjectAvailable) && ( fixObject->attributes & kCanThink))
             {
@@ -2411,7 +2666,6 @@ void AlterObjectOwner( spaceObjectType *anObject, int32_t owner, bool message)
                     anObject->escortStrength += fixObject->baseType->offenseValue;
                 }
             }
-            fixObject++;
         }
 
         if ( anObject->attributes & kIsDestination)
@@ -2480,7 +2734,8 @@ void AlterObjectCloakState( spaceObjectType *anObject, bool cloak)
 void DestroyObject( spaceObjectType *anObject)
 
 {
-    int16_t energyNum, i;
+    int16_t energyNum;
+    int32_t i;
     spaceObjectType *fixObject;
 
     if ( anObject->active == kObjectInUse)
@@ -2489,9 +2744,9 @@ void DestroyObject( spaceObjectType *anObject)
         {
             anObject->health = anObject->baseType->health;
             // if anyone is targeting it, they should stop
-            fixObject = gSpaceObjectData.get();
-            for ( i = 0; i < kMaxSpaceObject; i++)
+            for ( i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i))
             {
+                fixObject = globals()->gSpaceObjectData.get() + i;
                 if (( fixObject->attributes & kCanAcceptDestination) && ( fixObject->active !=
                     kObjectAvailable))
                 {
@@ -2500,7 +2755,6 @@ void DestroyObject( spaceObjectType *anObject)
                         fixObject->targetObjectNumber = kNoDestinationObject;
                     }
                 }
-                fixObject++;
             }
 
             AlterObjectOwner( anObject, -1, true);
@@ -2517,10 +2771,10 @@ void DestroyObject( spaceObjectType *anObject)
                 while ( energyNum > 0)
                 {
 
-//                  CreateAnySpaceObject( globals()->scenarioFileInfo.energyBlobID, &(anObject->velocity),
+//                  CreateAnySpaceObject( plugin()->scenarioFileInfo.energyBlobID, &(anObject->velocity),
 //                      &(anObject->location), anObject->direction, kNoOwner, 0, nil, -1, -1, -1);
-                    CreateAnySpaceObject( globals()->scenarioFileInfo.energyBlobID, &(anObject->velocity),
-                        &(anObject->location), anObject->direction, kNoOwner, 0, -1);
+                    CreateAnySpaceObject( plugin()->scenarioFileInfo.energyBlobID, &(anObject->motion->velocity),
+                        &(anObject->motion->location), anObject->motion->direction, kNoOwner, 0, -1);
                     energyNum--;
                 }
             }
@@ -2531,9 +2785,9 @@ void DestroyObject( spaceObjectType *anObject)
                 (!(anObject->baseType->destroyActionNum & kDestroyActionDontDieFlag)))
             {
                 RemoveDestination( anObject->destinationObject);
-                fixObject = gSpaceObjectData.get();
-                for ( i = 0; i < kMaxSpaceObject; i++)
+                for ( i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i))
                 {
+                    fixObject = globals()->gSpaceObjectData.get() + i;
                     if (( fixObject->attributes & kCanAcceptDestination) && ( fixObject->active !=
                         kObjectAvailable))
                     {
@@ -2544,7 +2798,6 @@ void DestroyObject( spaceObjectType *anObject)
                             fixObject->attributes &= ~kStaticDestination;
                         }
                     }
-                    fixObject++;
                 }
             }
 
@@ -2582,7 +2835,7 @@ void ActivateObjectSpecial( spaceObjectType *anObject)
             anObject->specialPosition++;
             if ( anObject->specialPosition >= baseObject->specialPositionNum) anObject->specialPosition = 0;
 
-            h = anObject->direction;
+            h = anObject->motion->direction;
             mAddAngle( h, -90);
             GetRotPoint(&fcos, &fsin, h);
             fcos = -fcos;
@@ -2608,15 +2861,15 @@ void CreateFloatingBodyOfPlayer( spaceObjectType *anObject)
 {
     int32_t     count;
 
-//  count = CreateAnySpaceObject( globals()->scenarioFileInfo.playerBodyID, &(anObject->velocity),
+//  count = CreateAnySpaceObject( plugin()->scenarioFileInfo.playerBodyID, &(anObject->velocity),
 //      &(anObject->location), anObject->direction, anObject->owner, 0, nil, -1, -1, -1);
 
     // if we're already in a body, don't create a body from it
     // a body expiring is handled elsewhere
-    if ( anObject->whichBaseObject == globals()->scenarioFileInfo.playerBodyID) return;
+    if ( anObject->whichBaseObject == plugin()->scenarioFileInfo.playerBodyID) return;
 
-    count = CreateAnySpaceObject( globals()->scenarioFileInfo.playerBodyID, &(anObject->velocity),
-        &(anObject->location), anObject->direction, anObject->owner, 0, -1);
+    count = CreateAnySpaceObject( plugin()->scenarioFileInfo.playerBodyID, &(anObject->motion->velocity),
+        &(anObject->motion->location), anObject->motion->direction, anObject->owner, 0, -1);
     if ( count >= 0)
     {
 /*      if (( anObject->owner == globals()->gPlayerAdmiralNumber) && ( anObject->attributes & kIsHumanControlled))
@@ -2625,13 +2878,13 @@ void CreateFloatingBodyOfPlayer( spaceObjectType *anObject)
             anObject->attributes &= (~kIsHumanControlled) & (~kIsPlayerShip);
             globals()->gPlayerShipNumber = count;
             ResetScrollStars( globals()->gPlayerShipNumber);
-            anObject = gSpaceObjectData.get() + globals()->gPlayerShipNumber;
+            anObject = globals()->gSpaceObjectData.get() + globals()->gPlayerShipNumber;
             anObject->attributes |= attributes;
         } else
         {
             attributes = anObject->attributes & kIsRemote;
             anObject->attributes &= ~kIsRemote;
-            anObject = gSpaceObjectData.get() + count;
+            anObject = globals()->gSpaceObjectData.get() + count;
             anObject->attributes |= attributes;
         }
         SetAdmiralFlagship( anObject->owner, count);
@@ -2652,4 +2905,357 @@ StringSlice get_object_short_name(int16_t id) {
     return space_object_short_names->at(id);
 }
 
+int32_t GetBaseObjectIndex(const baseObjectType* base) {
+    if ((base == NULL) || (base < gBaseObjectData.get())
+            || (base >= (gBaseObjectData.get() + plugin()->maxBaseObject))) {
+        return -1;
+    }
+    return base - gBaseObjectData.get();
+}
+
+int32_t GetSpaceObjectIndex(const spaceObjectType* object) {
+    if ((object == NULL) || (object < globals()->gSpaceObjectData.get())
+            || (object >= (globals()->gSpaceObjectData.get() + globals()->maxSpaceObject))) {
+        return -1;
+    }
+    return object - globals()->gSpaceObjectData.get();
+}
+
+static int32_t GetObjectActionIndex(const objectActionType* action) {
+    return (action == NULL) ? -1 : (action - gObjectActionData.get());
+}
+
+static void write_motion(WriteTarget out, const spaceObjectMotionType& motion) {
+    write(out, motion.location);
+    write(out, motion.velocity);
+    write(out, motion.motionFraction);
+    write(out, motion.maxVelocity);
+    write(out, motion.thrust);
+    write(out, motion.direction);
+    write(out, motion.turnVelocity);
+    write(out, motion.turnFraction);
+    write(out, motion.lastLocation);
+    write(out, motion.lastDir);
+}
+
+static void read_motion(ReadSource in, spaceObjectMotionType& motion) {
+    read(in, motion.location);
+    read(in, motion.velocity);
+    read(in, motion.motionFraction);
+    read(in, motion.maxVelocity);
+    read(in, motion.thrust);
+    read(in, motion.direction);
+    read(in, motion.turnVelocity);
+    read(in, motion.turnFraction);
+    read(in, motion.lastLocation);
+    read(in, motion.lastDir);
+}
+
+// The frame union is written as whichever member the object's base uses.  A beam's base is
+// always a beam, even after the object itself has been freed and lost its attributes.
+static bool uses_beam_frame(const spaceObjectType& object) {
+    return (object.baseType != NULL) && (object.baseType->attributes & kIsBeam);
+}
+
+void write_space_object(WriteTarget out, const spaceObjectType& o) {
+    write(out, o.attributes);
+    write<int32_t>(out, GetBaseObjectIndex(o.baseType));
+    write(out, o.active);
+    write<int32_t>(out, o.presenceState);
+    write(out, o.presenceData);
+    write(out, o.whichBaseObject);
+    write(out, o.entryNumber);
+    write(out, o.keysDown);
+    write(out, o.tinySize);
+    write(out, o.tinyColor);
+    write(out, o.directionGoal);
+    write(out, o.offlineTime);
+    write<int32_t>(out, GetSpaceObjectIndex(o.collideObject));
+    write(out, o.collisionGrid);
+    write<int32_t>(out, GetSpaceObjectIndex(o.nextNearObject));
+    write(out, o.distanceGrid);
+    write<int32_t>(out, GetSpaceObjectIndex(o.nextFarObject));
+    write<int32_t>(out, GetSpaceObjectIndex(o.previousObject));
+    write(out, o.previousObjectNumber);
+    write<int32_t>(out, GetSpaceObjectIndex(o.nextObject));
+    write(out, o.nextObjectNumber);
+    write(out, o.runTimeFlags);
+    write(out, o.destinationLocation);
+    write(out, o.destinationObject);
+    write<int32_t>(out, GetSpaceObjectIndex(o.destObjectPtr));
+    write(out, o.destObjectDest);
+    write(out, o.destObjectID);
+    write(out, o.destObjectDestID);
+    write(out, o.localFriendStrength);
+    write(out, o.localFoeStrength);
+    write(out, o.escortStrength);
+    write(out, o.remoteFriendStrength);
+    write(out, o.remoteFoeStrength);
+    write(out, o.bestConsideredTargetValue);
+    write(out, o.currentTargetValue);
+    write(out, o.bestConsideredTargetNumber);
+    write(out, o.timeFromOrigin);
+    write(out, o.idealLocationCalc);
+    write(out, o.originLocation);
+    write(out, o.scaledCornerOffset);
+    write(out, o.scaledSize);
+    write(out, o.absoluteBounds);
+    write(out, o.randomSeed.seed);
+    if (uses_beam_frame(o)) {
+        write(out, o.frame.beam.whichBeam);
+        write<int32_t>(out, Beams::index_of(o.frame.beam.beam));
+    } else {
+        write(out, o.frame.animation.thisShape);
+        write(out, o.frame.animation.frameFraction);
+        write(out, o.frame.animation.frameDirection);
+        write(out, o.frame.animation.frameSpeed);
+    }
+    write(out, o.health);
+    write(out, o.energy);
+    write(out, o.battery);
+    write(out, o.owner);
+    write(out, o.age);
+    write(out, o.naturalScale);
+    write(out, o.id);
+    write(out, o.rechargeTime);
+    write(out, o.pulseCharge);
+    write(out, o.beamCharge);
+    write(out, o.specialCharge);
+    write(out, o.warpEnergyCollected);
+    write(out, o.layer);
+    write<int32_t>(out, GetSpriteIndex(o.sprite));
+    write(out, o.whichSprite);
+    write(out, o.distanceFromPlayer);
+    write(out, o.closestDistance);
+    write(out, o.closestObject);
+    write(out, o.targetObjectNumber);
+    write(out, o.targetObjectID);
+    write(out, o.targetAngle);
+    write(out, o.lastTarget);
+    write(out, o.lastTargetDistance);
+    write(out, o.longestWeaponRange);
+    write(out, o.shortestWeaponRange);
+    write(out, o.engageRange);
+    write(out, o.hitState);
+    write(out, o.cloakState);
+    write<int32_t>(out, o.duty);
+    write<int32_t>(out, o.pixResID);
+    write<int32_t>(out, GetBaseObjectIndex(o.pulseBase));
+    write(out, o.pulseType);
+    write(out, o.pulseTime);
+    write(out, o.pulseAmmo);
+    write(out, o.pulsePosition);
+    write<int32_t>(out, GetBaseObjectIndex(o.beamBase));
+    write(out, o.beamType);
+    write(out, o.beamTime);
+    write(out, o.beamAmmo);
+    write(out, o.beamPosition);
+    write<int32_t>(out, GetBaseObjectIndex(o.specialBase));
+    write(out, o.specialType);
+    write(out, o.specialTime);
+    write(out, o.specialAmmo);
+    write(out, o.specialPosition);
+    write(out, o.periodicTime);
+    write(out, o.whichLabel);
+    write(out, o.myPlayerFlag);
+    write(out, o.seenByPlayerFlags);
+    write(out, o.hostileTowardsFlags);
+    write(out, o.shieldColor);
+    write(out, o.originalColor);
+    write_motion(out, *o.motion);
+}
+
+static void read_space_object(ReadSource in, spaceObjectType& o) {
+    read(in, o.attributes);
+    o.baseType = mGetBaseObjectPtr(read<int32_t>(in));
+    read(in, o.active);
+    o.presenceState = static_cast<kPresenceStateType>(read<int32_t>(in));
+    read(in, o.presenceData);
+    read(in, o.whichBaseObject);
+    read(in, o.entryNumber);
+    read(in, o.keysDown);
+    read(in, o.tinySize);
+    read(in, o.tinyColor);
+    read(in, o.directionGoal);
+    read(in, o.offlineTime);
+    o.collideObject = mGetSpaceObjectPtr(read<int32_t>(in));
+    read(in, o.collisionGrid);
+    o.nextNearObject = mGetSpaceObjectPtr(read<int32_t>(in));
+    read(in, o.distanceGrid);
+    o.nextFarObject = mGetSpaceObjectPtr(read<int32_t>(in));
+    o.previousObject = mGetSpaceObjectPtr(read<int32_t>(in));
+    read(in, o.previousObjectNumber);
+    o.nextObject = mGetSpaceObjectPtr(read<int32_t>(in));
+    read(in, o.nextObjectNumber);
+    read(in, o.runTimeFlags);
+    read(in, o.destinationLocation);
+    read(in, o.destinationObject);
+    o.destObjectPtr = mGetSpaceObjectPtr(read<int32_t>(in));
+    read(in, o.destObjectDest);
+    read(in, o.destObjectID);
+    read(in, o.destObjectDestID);
+    read(in, o.localFriendStrength);
+    read(in, o.localFoeStrength);
+    read(in, o.escortStrength);
+    read(in, o.remoteFriendStrength);
+    read(in, o.remoteFoeStrength);
+    read(in, o.bestConsideredTargetValue);
+    read(in, o.currentTargetValue);
+    read(in, o.bestConsideredTargetNumber);
+    read(in, o.timeFromOrigin);
+    read(in, o.idealLocationCalc);
+    read(in, o.originLocation);
+    read(in, o.scaledCornerOffset);
+    read(in, o.scaledSize);
+    read(in, o.absoluteBounds);
+    read(in, o.randomSeed.seed);
+    if (uses_beam_frame(o)) {
+        read(in, o.frame.beam.whichBeam);
+        o.frame.beam.beam = Beams::at(read<int32_t>(in));
+    } else {
+        read(in, o.frame.animation.thisShape);
+        read(in, o.frame.animation.frameFraction);
+        read(in, o.frame.animation.frameDirection);
+        read(in, o.frame.animation.frameSpeed);
+    }
+    read(in, o.health);
+    read(in, o.energy);
+    read(in, o.battery);
+    read(in, o.owner);
+    read(in, o.age);
+    read(in, o.naturalScale);
+    read(in, o.id);
+    read(in, o.rechargeTime);
+    read(in, o.pulseCharge);
+    read(in, o.beamCharge);
+    read(in, o.specialCharge);
+    read(in, o.warpEnergyCollected);
+    read(in, o.layer);
+    o.sprite = GetSpriteAtIndex(read<int32_t>(in));
+    read(in, o.whichSprite);
+    read(in, o.distanceFromPlayer);
+    read(in, o.closestDistance);
+    read(in, o.closestObject);
+    read(in, o.targetObjectNumber);
+    read(in, o.targetObjectID);
+    read(in, o.targetAngle);
+    read(in, o.lastTarget);
+    read(in, o.lastTargetDistance);
+    read(in, o.longestWeaponRange);
+    read(in, o.shortestWeaponRange);
+    read(in, o.engageRange);
+    read(in, o.hitState);
+    read(in, o.cloakState);
+    o.duty = static_cast<dutyType>(read<int32_t>(in));
+    o.pixResID = read<int32_t>(in);
+    o.pulseBase = mGetBaseObjectPtr(read<int32_t>(in));
+    read(in, o.pulseType);
+    read(in, o.pulseTime);
+    read(in, o.pulseAmmo);
+    read(in, o.pulsePosition);
+    o.beamBase = mGetBaseObjectPtr(read<int32_t>(in));
+    read(in, o.beamType);
+    read(in, o.beamTime);
+    read(in, o.beamAmmo);
+    read(in, o.beamPosition);
+    o.specialBase = mGetBaseObjectPtr(read<int32_t>(in));
+    read(in, o.specialType);
+    read(in, o.specialTime);
+    read(in, o.specialAmmo);
+    read(in, o.specialPosition);
+    read(in, o.periodicTime);
+    read(in, o.whichLabel);
+    read(in, o.myPlayerFlag);
+    read(in, o.seenByPlayerFlags);
+    read(in, o.hostileTowardsFlags);
+    read(in, o.shieldColor);
+    read(in, o.originalColor);
+    read_motion(in, *o.motion);
+}
+
+void write_space_objects(WriteTarget out) {
+    write(out, globals()->maxSpaceObject);
+    write(out, globals()->gSpaceObjectHighWater);
+    for (int32_t i = 0; i < globals()->gSpaceObjectHighWater; ++i) {
+        write_space_object(out, globals()->gSpaceObjectData[i]);
+    }
+    write<int32_t>(out, GetSpaceObjectIndex(globals()->gRootObject));
+    write(out, globals()->gRootObjectNumber);
+
+    // Each slot of the action wheel, in order, with its actions in the order they fire.
+    write(out, globals()->gActionQueueTime);
+    for (const actionQueueType* slot: globals()->gActionWheel) {
+        int32_t count = 0;
+        for (const actionQueueType* queue = slot; queue; queue = queue->nextActionQueue) {
+            ++count;
+        }
+        write(out, count);
+        for (const actionQueueType* queue = slot; queue; queue = queue->nextActionQueue) {
+            write<int32_t>(out, GetObjectActionIndex(queue->action));
+            write(out, queue->actionNum);
+            write(out, queue->actionToDo);
+            write(out, queue->dueTime);
+            write<int32_t>(out, GetSpaceObjectIndex(queue->subjectObject));
+            write(out, queue->subjectObjectNum);
+            write(out, queue->subjectObjectID);
+            write<int32_t>(out, GetSpaceObjectIndex(queue->directObject));
+            write(out, queue->directObjectNum);
+            write(out, queue->directObjectID);
+            write(out, queue->offset);
+        }
+    }
+}
+
+void read_space_objects(ReadSource in) {
+    if (read<int32_t>(in) != globals()->maxSpaceObject) {
+        throw Exception("saved state has a different number of object slots");
+    }
+    const int32_t highWater = read<int32_t>(in);
+    if ((highWater < 0) || (highWater > globals()->maxSpaceObject)) {
+        throw Exception("saved state has a bad object count");
+    }
+    ClearSpaceObjectSlots();
+    globals()->gSpaceObjectHighWater = highWater;
+    for (int32_t i = 0; i < globals()->maxSpaceObject; ++i) {
+        spaceObjectType* anObject = globals()->gSpaceObjectData.get() + i;
+        if (i < globals()->gSpaceObjectHighWater) {
+            read_space_object(in, *anObject);
+        } else {
+            anObject->active = kObjectAvailable;
+            anObject->sprite = NULL;
+        }
+        if (anObject->active != kObjectAvailable) {
+            OccupySpaceObjectSlot(i);
+        }
+    }
+    globals()->gRootObject = mGetSpaceObjectPtr(read<int32_t>(in));
+    read(in, globals()->gRootObjectNumber);
+
+    ResetActionQueueData();
+    read(in, globals()->gActionQueueTime);
+    for (actionQueueType*& slot: globals()->gActionWheel) {
+        const int32_t count = read<int32_t>(in);
+        if (count < 0) {
+            throw Exception("saved state has a bad action count");
+        }
+        actionQueueType** end = &slot;
+        for (int32_t i = 0; i < count; ++i) {
+            actionQueueType* queue = NewActionQueue();
+            queue->action = mGetObjectActionPtr(read<int32_t>(in));
+            read(in, queue->actionNum);
+            read(in, queue->actionToDo);
+            read(in, queue->dueTime);
+            queue->subjectObject = mGetSpaceObjectPtr(read<int32_t>(in));
+            read(in, queue->subjectObjectNum);
+            read(in, queue->subjectObjectID);
+            queue->directObject = mGetSpaceObjectPtr(read<int32_t>(in));
+            read(in, queue->directObjectNum);
+            read(in, queue->directObjectID);
+            read(in, queue->offset);
+            *end = queue;
+            end = &queue->nextActionQueue;
+        }
+    }
+}
+
 }  // namespace antares
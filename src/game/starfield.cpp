@@ -43,11 +43,6 @@ const Fixed kFastStarFraction   = 0x00000100;   // 1.000
 
 const uint8_t kStarColor = GRAY;
 
-
-// This object is also used for the radar center, and for zoom to hostile and object modes.  It
-// would be preferable for it to be entirely private to the starfield.
-spaceObjectType* gScrollStarObject = NULL;
-
 namespace {
 
 inline int32_t RandomStarSpeed() {
@@ -65,9 +60,9 @@ Starfield::Starfield():
 }
 
 void Starfield::reset(int32_t which_object) {
-    gScrollStarObject = mGetSpaceObjectPtr(which_object);
+    globals()->gScrollStarObject = mGetSpaceObjectPtr(which_object);
 
-    if (gScrollStarObject == NULL) {
+    if (globals()->gScrollStarObject == NULL) {
         return;
     }
 
@@ -86,7 +81,7 @@ void Starfield::reset(int32_t which_object) {
 
 void Starfield::make_sparks(
         int32_t sparkNum, int32_t sparkSpeed, Fixed maxVelocity, uint8_t color, Point* location) {
-    maxVelocity = evil_scale_by(maxVelocity, gAbsoluteScale);
+    maxVelocity = evil_scale_by(maxVelocity, globals()->gAbsoluteScale);
     if (sparkNum <= 0) {
         return;
     }
@@ -120,35 +115,35 @@ void Starfield::prepare_to_move() {
 }
 
 void Starfield::move(int32_t by_units) {
-    if ((gScrollStarObject == NULL) || !gScrollStarObject->active) {
+    if ((globals()->gScrollStarObject == NULL) || !globals()->gScrollStarObject->active) {
         return;
     }
 
     const fixedPointType slowVelocity = {
         scale_by(
-                mMultiplyFixed(gScrollStarObject->velocity.h, kSlowStarFraction) * by_units,
-                gAbsoluteScale),
+                mMultiplyFixed(globals()->gScrollStarObject->motion->velocity.h, kSlowStarFraction) * by_units,
+                globals()->gAbsoluteScale),
         scale_by(
-                mMultiplyFixed(gScrollStarObject->velocity.v, kSlowStarFraction) * by_units,
-                gAbsoluteScale),
+                mMultiplyFixed(globals()->gScrollStarObject->motion->velocity.v, kSlowStarFraction) * by_units,
+                globals()->gAbsoluteScale),
     };
 
     const fixedPointType mediumVelocity = {
         scale_by(
-                mMultiplyFixed(gScrollStarObject->velocity.h, kMediumStarFraction) * by_units,
-                gAbsoluteScale),
+                mMultiplyFixed(globals()->gScrollStarObject->motion->velocity.h, kMediumStarFraction) * by_units,
+                globals()->gAbsoluteScale),
         scale_by(
-                mMultiplyFixed(gScrollStarObject->velocity.v, kMediumStarFraction) * by_units,
-                gAbsoluteScale),
+                mMultiplyFixed(globals()->gScrollStarObject->motion->velocity.v, kMediumStarFraction) * by_units,
+                globals()->gAbsoluteScale),
     };
 
     const fixedPointType fastVelocity = {
         scale_by(
-                mMultiplyFixed(gScrollStarObject->velocity.h, kFastStarFraction) * by_units,
-                gAbsoluteScale),
+                mMultiplyFixed(globals()->gScrollStarObject->motion->velocity.h, kFastStarFraction) * by_units,
+                globals()->gAbsoluteScale),
         scale_by(
-                mMultiplyFixed(gScrollStarObject->velocity.v, kFastStarFraction) * by_units,
-                gAbsoluteScale),
+                mMultiplyFixed(globals()->gScrollStarObject->motion->velocity.v, kFastStarFraction) * by_units,
+                globals()->gAbsoluteScale),
     };
 
     for (scrollStarType* star: range(_stars, _stars + kScrollStarNum)) {
@@ -269,7 +264,7 @@ void Starfield::draw() const {
     const RgbColor mediumColor = GetRGBTranslateColorShade(kStarColor, LIGHT);
     const RgbColor fastColor = GetRGBTranslateColorShade(kStarColor, LIGHTER);
 
-    switch (gScrollStarObject->presenceState) {
+    switch (globals()->gScrollStarObject->presenceState) {
       default:
         if (!_warp_stars) {
             // we're not warping in any way
@@ -319,9 +314,9 @@ void Starfield::draw() const {
 }
 
 void Starfield::show() {
-    if ((gScrollStarObject->presenceState != kWarpInPresence)
-            && (gScrollStarObject->presenceState != kWarpOutPresence)
-            && (gScrollStarObject->presenceState != kWarpingPresence)) {
+    if ((globals()->gScrollStarObject->presenceState != kWarpInPresence)
+            && (globals()->gScrollStarObject->presenceState != kWarpOutPresence)
+            && (globals()->gScrollStarObject->presenceState != kWarpingPresence)) {
         if (_warp_stars) {
             // we were warping but now are not; erase warped stars
             _warp_stars = false;
@@ -0,0 +1,205 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/state.hpp"
+
+#include "drawing/sprite-handling.hpp"
+#include "game/admiral.hpp"
+#include "game/beam.hpp"
+#include "game/globals.hpp"
+#include "game/input-source.hpp"
+#include "game/messages.hpp"
+#include "game/minicomputer.hpp"
+#include "game/motion.hpp"
+#include "game/player-ship.hpp"
+#include "game/scenario-maker.hpp"
+#include "game/space-object.hpp"
+#include "game/time.hpp"
+#include "math/random.hpp"
+
+using sfz::Bytes;
+using sfz::BytesSlice;
+using sfz::Exception;
+using sfz::ReadSource;
+using sfz::String;
+using sfz::StringSlice;
+using sfz::WriteTarget;
+using sfz::read;
+using sfz::write;
+
+namespace utf8 = sfz::utf8;
+
+namespace antares {
+
+namespace {
+
+// Bump whenever the layout of a snapshot changes.
+const uint32_t kStateVersion = 6;
+
+void write_globals(WriteTarget out) {
+    const aresGlobalType& g = *globals();
+    write(out, g.gActiveCheats, kMaxPlayerNum);
+    write(out, g.gSynchValue);
+    write(out, g.gGameOver);
+    write(out, g.gGameTime);
+    write(out, g.gClosestObject);
+    write(out, g.gFarthestObject);
+    write(out, g.gPlayerShipNumber);
+    write<int32_t>(out, g.gZoomMode);
+    write<int32_t>(out, g.gPreviousZoomMode);
+    write(out, g.gPlayerAdmiralNumber);
+    write(out, g.gScenarioWinner.next);
+    write(out, g.gScenarioWinner.text);
+    write(out, g.gScenarioWinner.player);
+    write(out, g.gRadarCount);
+    write(out, g.gRadarSpeed);
+    write(out, g.gRadarRange);
+    write<uint8_t>(out, g.radar_is_functioning);
+    write<uint8_t>(out, g.gAutoPilotOff);
+    write(out, g.keyMask);
+    for (size_t i = 0; i < kHotKeyNum; ++i) {
+        write(out, g.hotKey[i].objectNum);
+        write(out, g.hotKey[i].objectID);
+    }
+    write(out, g.hotKeyDownTime);
+    write(out, g.lastHotKey);
+    write(out, g.lastSelectedObject);
+    write(out, g.lastSelectedObjectID);
+    write<uint8_t>(out, g.destKeyUsedForSelection);
+    write<uint8_t>(out, g.hotKey_target);
+}
+
+void read_globals(ReadSource in) {
+    aresGlobalType& g = *globals();
+    read(in, g.gActiveCheats, kMaxPlayerNum);
+    read(in, g.gSynchValue);
+    read(in, g.gGameOver);
+    read(in, g.gGameTime);
+    read(in, g.gClosestObject);
+    read(in, g.gFarthestObject);
+    read(in, g.gPlayerShipNumber);
+    g.gZoomMode = static_cast<ZoomType>(read<int32_t>(in));
+    g.gPreviousZoomMode = static_cast<ZoomType>(read<int32_t>(in));
+    read(in, g.gPlayerAdmiralNumber);
+    read(in, g.gScenarioWinner.next);
+    read(in, g.gScenarioWinner.text);
+    read(in, g.gScenarioWinner.player);
+    read(in, g.gRadarCount);
+    read(in, g.gRadarSpeed);
+    read(in, g.gRadarRange);
+    g.radar_is_functioning = read<uint8_t>(in);
+    g.gAutoPilotOff = read<uint8_t>(in);
+    read(in, g.keyMask);
+    for (size_t i = 0; i < kHotKeyNum; ++i) {
+        read(in, g.hotKey[i].objectNum);
+        read(in, g.hotKey[i].objectID);
+    }
+    read(in, g.hotKeyDownTime);
+    read(in, g.lastHotKey);
+    read(in, g.lastSelectedObject);
+    read(in, g.lastSelectedObjectID);
+    g.destKeyUsedForSelection = read<uint8_t>(in);
+    g.hotKey_target = read<uint8_t>(in);
+}
+
+}  // namespace
+
+Bytes save_state() {
+    Bytes state;
+    write(state, kStateVersion);
+    write<int32_t>(state, globals()->gThisScenario->chapter_number());
+    write(state, globals()->gRandomSeed.seed);
+    write(state, globals()->gGlobalCorner);
+    write_globals(state);
+    write_sprites(state);
+    Beams::write_to(state);
+    write_space_objects(state);
+    write_admirals(state);
+    write_scenario_state(state);
+    write_mini_screen(state);
+    Messages::write_to(state);
+    return state;
+}
+
+void restore_state(BytesSlice state) {
+    if (read<uint32_t>(state) != kStateVersion) {
+        throw Exception("saved state is from an incompatible version");
+    }
+    if ((globals()->gThisScenario == NULL) || (read<int32_t>(state) != globals()->gThisScenario->chapter_number())) {
+        throw Exception("saved state is from a different scenario");
+    }
+    read(state, globals()->gRandomSeed.seed);
+    read(state, globals()->gGlobalCorner);
+    read_globals(state);
+    read_sprites(state);
+    Beams::read_from(state);
+    read_space_objects(state);
+    read_admirals(state);
+    read_scenario_state(state);
+    read_mini_screen(state);
+    Messages::read_from(state);
+    if (!state.empty()) {
+        throw Exception("saved state has trailing data");
+    }
+
+    // The starfield scrolls with the player's ship, and motion and collisions read the ship
+    // through gScrollStarObject, so point it at the restored ship.
+    globals()->starfield.reset(globals()->gPlayerShipNumber);
+    // The proximity index isn't saved; the next query rebuilds it from the restored objects.
+    InvalidateProximityIndex();
+}
+
+Bytes save_game(const GameLoopState& loop, const PlayerShip& ship) {
+    Bytes state;
+    write(state, loop.decide_cycle);
+    write(state, loop.scenario_check_time);
+    write(state, loop.ticks);
+    write<int64_t>(state, now_usecs() - globals()->gLastTime);
+    write(state, ship);
+    if (globals()->gInputSource) {
+        globals()->gInputSource->save(state);
+    }
+    write(state, save_state());
+    return state;
+}
+
+void restore_game(BytesSlice state, GameLoopState& loop, PlayerShip& ship) {
+    read(state, loop.decide_cycle);
+    read(state, loop.scenario_check_time);
+    read(state, loop.ticks);
+    globals()->gLastTime = now_usecs() - read<int64_t>(state);
+    read(state, ship);
+    if (globals()->gInputSource) {
+        globals()->gInputSource->restore(state);
+    }
+    restore_state(state);
+}
+
+void write_state_string(WriteTarget out, const StringSlice& string) {
+    Bytes bytes(utf8::encode(string));
+    write<uint32_t>(out, bytes.size());
+    write(out, bytes);
+}
+
+String read_state_string(ReadSource in) {
+    Bytes bytes(read<uint32_t>(in), '\0');
+    in.shift(bytes.data(), bytes.size());
+    return String(utf8::decode(bytes));
+}
+
+}  // namespace antares
@@ -0,0 +1,212 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "game/sync.hpp"
+
+#include <fcntl.h>
+
+#include "data/space-object.hpp"
+#include "game/globals.hpp"
+#include "game/space-object.hpp"
+#include "math/random.hpp"
+
+using sfz::Bytes;
+using sfz::BytesSlice;
+using sfz::PrintTarget;
+using sfz::ReadSource;
+using sfz::ScopedFd;
+using sfz::StringSlice;
+using sfz::WriteTarget;
+using sfz::format;
+using sfz::read;
+using sfz::write;
+using std::vector;
+
+namespace antares {
+
+namespace {
+
+const char kSyncMagic[] = "NLSY";
+const size_t kSyncMagicSize = 4;
+
+// 32-bit FNV-1a.
+uint32_t hash_bytes(const BytesSlice& bytes) {
+    uint32_t hash = 2166136261u;
+    for (uint8_t byte: bytes) {
+        hash = (hash ^ byte) * 16777619u;
+    }
+    return hash;
+}
+
+void dump_field(PrintTarget out, int32_t slot, const char* name, int64_t value) {
+    print(out, format("{0} {1} {2}\n", slot, name, value));
+}
+
+}  // namespace
+
+void read_from(ReadSource in, SyncRecord& record) {
+    read(in, record.at);
+    read(in, record.synch);
+    record.objects.resize(read<uint32_t>(in));
+    for (SyncRecord::Object& object: record.objects) {
+        read(in, object);
+    }
+}
+
+void read_from(ReadSource in, SyncRecord::Object& object) {
+    read(in, object.slot);
+    read(in, object.id);
+    read(in, object.hash);
+}
+
+void write_to(WriteTarget out, const SyncRecord& record) {
+    write(out, record.at);
+    write(out, record.synch);
+    write<uint32_t>(out, record.objects.size());
+    for (const SyncRecord::Object& object: record.objects) {
+        write(out, object);
+    }
+}
+
+void write_to(WriteTarget out, const SyncRecord::Object& object) {
+    write(out, object.slot);
+    write(out, object.id);
+    write(out, object.hash);
+}
+
+SyncRecord sync_record(int64_t at) {
+    SyncRecord record;
+    record.at = at;
+    record.synch = globals()->gSynchValue;
+    Bytes bytes;
+    for (int32_t i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i)) {
+        const spaceObjectType* o = mGetSpaceObjectPtr(i);
+        if (o->active != kObjectInUse) {
+            continue;
+        }
+        bytes.clear();
+        write_space_object(bytes, *o);
+        SyncRecord::Object object = {i, o->id, hash_bytes(bytes)};
+        record.objects.push_back(object);
+    }
+    return record;
+}
+
+SyncRecorder::SyncRecorder(StringSlice path):
+        _file(open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) {
+    write(_file, BytesSlice(kSyncMagic));
+}
+
+void SyncRecorder::record(int64_t at) {
+    Bytes bytes;
+    write(bytes, sync_record(at));
+    write(_file, bytes);
+}
+
+bool read_sync_stream(BytesSlice data, vector<SyncRecord>& records) {
+    if ((data.size() < kSyncMagicSize)
+            || (data.slice(0, kSyncMagicSize) != BytesSlice(kSyncMagic))) {
+        return false;
+    }
+    data.shift(kSyncMagicSize);
+    while (!data.empty()) {
+        records.emplace_back();
+        read(data, records.back());
+    }
+    return true;
+}
+
+void dump_state(PrintTarget out) {
+    print(out, format("global seed {0}\n", globals()->gRandomSeed.seed));
+    print(out, format("global synch {0}\n", globals()->gSynchValue));
+    print(out, format("global time {0}\n", globals()->gGameTime));
+    for (int32_t i = NextSpaceObjectSlot(-1); i >= 0; i = NextSpaceObjectSlot(i)) {
+        const spaceObjectType* o = mGetSpaceObjectPtr(i);
+        if (o->active != kObjectInUse) {
+            continue;
+        }
+        dump_field(out, i, "id", o->id);
+        dump_field(out, i, "base", o->whichBaseObject);
+        dump_field(out, i, "owner", o->owner);
+        dump_field(out, i, "attributes", o->attributes);
+        dump_field(out, i, "presence", o->presenceState);
+        dump_field(out, i, "presence-data", o->presenceData);
+        dump_field(out, i, "location.h", o->motion->location.h);
+        dump_field(out, i, "location.v", o->motion->location.v);
+        dump_field(out, i, "velocity.h", o->motion->velocity.h);
+        dump_field(out, i, "velocity.v", o->motion->velocity.v);
+        dump_field(out, i, "motion-fraction.h", o->motion->motionFraction.h);
+        dump_field(out, i, "motion-fraction.v", o->motion->motionFraction.v);
+        dump_field(out, i, "max-velocity", o->motion->maxVelocity);
+        dump_field(out, i, "thrust", o->motion->thrust);
+        dump_field(out, i, "direction", o->motion->direction);
+        dump_field(out, i, "direction-goal", o->directionGoal);
+        dump_field(out, i, "turn-velocity", o->motion->turnVelocity);
+        dump_field(out, i, "turn-fraction", o->motion->turnFraction);
+        dump_field(out, i, "keys-down", o->keysDown);
+        dump_field(out, i, "offline-time", o->offlineTime);
+        dump_field(out, i, "run-time-flags", o->runTimeFlags);
+        dump_field(out, i, "destination.h", o->destinationLocation.h);
+        dump_field(out, i, "destination.v", o->destinationLocation.v);
+        dump_field(out, i, "destination-object", o->destinationObject);
+        dump_field(out, i, "destination-id", o->destObjectID);
+        dump_field(out, i, "local-friend-strength", o->localFriendStrength);
+        dump_field(out, i, "local-foe-strength", o->localFoeStrength);
+        dump_field(out, i, "escort-strength", o->escortStrength);
+        dump_field(out, i, "remote-friend-strength", o->remoteFriendStrength);
+        dump_field(out, i, "remote-foe-strength", o->remoteFoeStrength);
+        dump_field(out, i, "best-considered-target", o->bestConsideredTargetNumber);
+        dump_field(out, i, "best-considered-value", o->bestConsideredTargetValue);
+        dump_field(out, i, "current-target-value", o->currentTargetValue);
+        dump_field(out, i, "time-from-origin", o->timeFromOrigin);
+        dump_field(out, i, "random-seed", o->randomSeed.seed);
+        dump_field(out, i, "health", o->health);
+        dump_field(out, i, "energy", o->energy);
+        dump_field(out, i, "battery", o->battery);
+        dump_field(out, i, "age", o->age);
+        dump_field(out, i, "natural-scale", o->naturalScale);
+        dump_field(out, i, "recharge-time", o->rechargeTime);
+        dump_field(out, i, "pulse-charge", o->pulseCharge);
+        dump_field(out, i, "beam-charge", o->beamCharge);
+        dump_field(out, i, "special-charge", o->specialCharge);
+        dump_field(out, i, "warp-energy", o->warpEnergyCollected);
+        dump_field(out, i, "distance-from-player", o->distanceFromPlayer);
+        dump_field(out, i, "closest-distance", o->closestDistance);
+        dump_field(out, i, "closest-object", o->closestObject);
+        dump_field(out, i, "target-object", o->targetObjectNumber);
+        dump_field(out, i, "target-id", o->targetObjectID);
+        dump_field(out, i, "target-angle", o->targetAngle);
+        dump_field(out, i, "last-target", o->lastTarget);
+        dump_field(out, i, "last-target-distance", o->lastTargetDistance);
+        dump_field(out, i, "engage-range", o->engageRange);
+        dump_field(out, i, "hit-state", o->hitState);
+        dump_field(out, i, "cloak-state", o->cloakState);
+        dump_field(out, i, "duty", o->duty);
+        dump_field(out, i, "pulse-time", o->pulseTime);
+        dump_field(out, i, "pulse-ammo", o->pulseAmmo);
+        dump_field(out, i, "beam-time", o->beamTime);
+        dump_field(out, i, "beam-ammo", o->beamAmmo);
+        dump_field(out, i, "special-time", o->specialTime);
+        dump_field(out, i, "special-ammo", o->specialAmmo);
+        dump_field(out, i, "periodic-time", o->periodicTime);
+        dump_field(out, i, "seen-by-player-flags", o->seenByPlayerFlags);
+        dump_field(out, i, "hostile-towards-flags", o->hostileTowardsFlags);
+    }
+}
+
+}  // namespace antares
@@ -18,13 +18,21 @@
 
 #include "game/time.hpp"
 
+#include "game/globals.hpp"
 #include "math/units.hpp"
 #include "video/driver.hpp"
 
 namespace antares {
 
 int64_t now_usecs() {
-    return VideoDriver::driver()->usecs();
+    if (VideoDriver::driver()) {
+        return VideoDriver::driver()->usecs();
+    }
+    return ticks_to_usecs(globals()->headless_ticks);
+}
+
+void advance_headless_clock(int ticks) {
+    globals()->headless_ticks += ticks;
 }
 
 }  // namespace antares
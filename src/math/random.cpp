@@ -25,12 +25,11 @@ namespace antares {
 
 namespace {
 
-Random global_seed = {static_cast<int32_t>(0x84744901)};
+// Not part of any game's state, so each thread gets its own.
+thread_local Random global_seed = {static_cast<int32_t>(0x84744901)};
 
 }  // namespace
 
-Random gRandomSeed = {14586};
-
 static int32_t Random() {
     return global_seed.next(0x8000);
 }
@@ -21,7 +21,9 @@
 #include <sfz/sfz.hpp>
 
 using sfz::ReadSource;
+using sfz::WriteTarget;
 using sfz::read;
+using sfz::write;
 
 namespace antares {
 
@@ -250,6 +252,11 @@ void read_from(ReadSource in, fixedPointType& point) {
     read(in, point.v);
 }
 
+void write_to(WriteTarget out, const fixedPointType& point) {
+    write(out, point.h);
+    write(out, point.v);
+}
+
 struct AngleFromSlopeData {
     Fixed min_slope;
     int32_t angle;
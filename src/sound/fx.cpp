@@ -25,11 +25,11 @@
 #include "game/globals.hpp"
 #include "game/motion.hpp"
 #include "game/space-object.hpp"
+#include "game/time.hpp"
 #include "math/macros.hpp"
 #include "math/special.hpp"
 #include "math/units.hpp"
 #include "sound/driver.hpp"
-#include "video/driver.hpp"
 
 using sfz::Exception;
 using sfz::format;
@@ -72,7 +72,7 @@ void PlayVolumeSound(
     int32_t oldestSoundTime = -ticks_to_usecs(kLongPersistence), whichChannel = -1;
     // TODO(sfiera): don't play sound at all if the game is muted.
     if (amplitude > 0) {
-        int timeDif = VideoDriver::driver()->usecs() - globals()->gLastSoundTime;
+        int timeDif = now_usecs() - globals()->gLastSoundTime;
         for (int count = 0; count < kMaxChannelNum; count++) {
             globals()->gChannel[count].soundAge += timeDif;
         }
@@ -126,7 +126,7 @@ void PlayVolumeSound(
 
         // we're not checking for importance
 
-        globals()->gLastSoundTime = VideoDriver::driver()->usecs();
+        globals()->gLastSoundTime = now_usecs();
 
         int whichSound = 0;
         while ((globals()->gSound[whichSound].id != whichSoundID) && (whichSound < kSoundNum)) {
@@ -280,9 +280,9 @@ void mPlayDistanceSound(
                 mplayerobjectptr = NULL;
             }
             if ((mplayerobjectptr != NULL) && (mplayerobjectptr->active)) {
-                mul1 = ABS<int>(mplayerobjectptr->location.h - mobjectptr->location.h);
+                mul1 = ABS<int>(mplayerobjectptr->motion->location.h - mobjectptr->motion->location.h);
                 mul2 = mul1;
-                mul1 =  ABS<int>(mplayerobjectptr->location.v - mobjectptr->location.v);
+                mul1 =  ABS<int>(mplayerobjectptr->motion->location.v - mobjectptr->motion->location.v);
                 mdistance = mul1;
                 if ((mul2 < kMaximumRelevantDistance) && (mdistance < kMaximumRelevantDistance)) {
                     mdistance = mdistance * mdistance + mul2 * mul2;
@@ -300,16 +300,16 @@ void mPlayDistanceSound(
                 }
                 if (mvolume > 0) {
                     PlayLocalizedSound(
-                            mplayerobjectptr->location.h, mplayerobjectptr->location.v,
-                            mobjectptr->location.h, mobjectptr->location.v,
-                            mplayerobjectptr->velocity.h - mobjectptr->velocity.h,
-                            mplayerobjectptr->velocity.v - mobjectptr->velocity.v,
+                            mplayerobjectptr->motion->location.h, mplayerobjectptr->motion->location.v,
+                            mobjectptr->motion->location.h, mobjectptr->motion->location.v,
+                            mplayerobjectptr->motion->velocity.h - mobjectptr->motion->velocity.h,
+                            mplayerobjectptr->motion->velocity.v - mobjectptr->motion->velocity.v,
                             msoundid, mvolume, msoundpersistence, msoundpriority);
                 }
             } else {
-                mul1 = ABS<int>(gGlobalCorner.h - mobjectptr->location.h);
+                mul1 = ABS<int>(globals()->gGlobalCorner.h - mobjectptr->motion->location.h);
                 mul2 = mul1;
-                mul1 =  ABS<int>(gGlobalCorner.v - mobjectptr->location.v);
+                mul1 =  ABS<int>(globals()->gGlobalCorner.v - mobjectptr->motion->location.v);
                 mdistance = mul1;
                 if ((mul2 < kMaximumRelevantDistance) && (mdistance < kMaximumRelevantDistance)) {
                     mdistance = mdistance * mdistance + mul2 * mul2;
@@ -327,9 +327,9 @@ void mPlayDistanceSound(
                 }
                 if (mvolume > 0) {
                     PlayLocalizedSound(
-                            gGlobalCorner.h, gGlobalCorner.v,
-                            mobjectptr->location.h, mobjectptr->location.v,
-                            mobjectptr->velocity.h, mobjectptr->velocity.v,
+                            globals()->gGlobalCorner.h, globals()->gGlobalCorner.v,
+                            mobjectptr->motion->location.h, mobjectptr->motion->location.v,
+                            mobjectptr->motion->velocity.h, mobjectptr->motion->velocity.v,
                             msoundid, mvolume, msoundpersistence, msoundpriority);
                 }
             }
@@ -351,18 +351,18 @@ void mPlayDistanceSound(
             if ((mplayerobjectptr != NULL) && (mplayerobjectptr->active)) {
                 if (mvolume > 0) {
                     PlayLocalizedSound(
-                            mplayerobjectptr->location.h, mplayerobjectptr->location.v,
-                            mobjectptr->location.h, mobjectptr->location.v,
-                            mplayerobjectptr->velocity.h - mobjectptr->velocity.h,
-                            mplayerobjectptr->velocity.v - mobjectptr->velocity.v,
+                            mplayerobjectptr->motion->location.h, mplayerobjectptr->motion->location.v,
+                            mobjectptr->motion->location.h, mobjectptr->motion->location.v,
+                            mplayerobjectptr->motion->velocity.h - mobjectptr->motion->velocity.h,
+                            mplayerobjectptr->motion->velocity.v - mobjectptr->motion->velocity.v,
                             msoundid, mvolume, msoundpersistence, msoundpriority);
                 }
             } else {
                 if (mvolume > 0) {
                     PlayLocalizedSound(
-                            gGlobalCorner.h, gGlobalCorner.v,
-                            mobjectptr->location.h, mobjectptr->location.v,
-                            mobjectptr->velocity.h, mobjectptr->velocity.v,
+                            globals()->gGlobalCorner.h, globals()->gGlobalCorner.v,
+                            mobjectptr->motion->location.h, mobjectptr->motion->location.v,
+                            mobjectptr->motion->velocity.h, mobjectptr->motion->velocity.v,
                             msoundid, mvolume, msoundpersistence, msoundpriority);
                 }
             }
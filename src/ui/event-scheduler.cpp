@@ -38,6 +38,10 @@ EventScheduler::EventScheduler():
         _ticks(0),
         _event_tracker(true) { }
 
+void EventScheduler::start_at(int64_t ticks) {
+    _ticks = ticks;
+}
+
 void EventScheduler::schedule_snapshot(int64_t at) {
     _snapshot_times.push_back(at);
     push_heap(_snapshot_times.begin(), _snapshot_times.end(), greater<int64_t>());
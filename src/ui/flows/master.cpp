@@ -131,7 +131,7 @@ void Master::init() {
     initialFadeColor.red = initialFadeColor.green = initialFadeColor.blue = 0;
 
     RotationInit();
-    gRandomSeed.seed = _seed;
+    globals()->gRandomSeed.seed = _seed;
 
     InitDirectText();
     Labels::init();
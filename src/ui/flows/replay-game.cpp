@@ -29,16 +29,33 @@
 
 namespace antares {
 
+using sfz::BytesSlice;
+using sfz::Exception;
 using sfz::read;
 using std::swap;
 
-ReplayGame::ReplayGame(int16_t replay_id):
+ReplayGame::ReplayGame(int16_t replay_id, uint64_t start_at):
         _state(NEW),
         _resource("replays", "NLRP", replay_id),
         _data(_resource.data()),
+        _keyframe(NULL),
         _random_seed{_data.global_seed},
         _scenario(GetScenarioPtrFromChapter(_data.chapter_id)),
-        _game_result(NO_GAME) { }
+        _game_result(NO_GAME) {
+    if (start_at > 0) {
+        try {
+            Resource index("replays", "NLRI", replay_id);
+            BytesSlice in(index.data());
+            read(in, _index);
+        } catch (Exception& e) {
+            return;  // No index; play from the start.
+        }
+        if ((_index.chapter_id == _data.chapter_id)
+                && (_index.global_seed == _data.global_seed)) {
+            _keyframe = _index.find(start_at);
+        }
+    }
+}
 
 ReplayGame::~ReplayGame() { }
 
@@ -53,15 +70,16 @@ void ReplayGame::become_front() {
         {
             _state = PLAYING;
             globals()->gInputSource.reset(new ReplayInputSource(&_data));
-            swap(_random_seed, gRandomSeed);
+            swap(_random_seed, globals()->gRandomSeed);
             _game_result = NO_GAME;
             _seconds = 0;
-            stack()->push(new MainPlay(_scenario, true, true, &_game_result, &_seconds));
+            stack()->push(new MainPlay(
+                        _scenario, true, true, _keyframe, &_game_result, &_seconds));
         }
         break;
 
       case PLAYING:
-        swap(_random_seed, gRandomSeed);
+        swap(_random_seed, globals()->gRandomSeed);
         globals()->gInputSource.reset();
         stack()->pop(this);
         break;
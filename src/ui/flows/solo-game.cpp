@@ -81,7 +81,7 @@ void SoloGame::become_front() {
         _game_result = NO_GAME;
         _seconds = 0;
         globals()->gInputSource.reset();
-        stack()->push(new MainPlay(_scenario, false, true, &_game_result, &_seconds));
+        stack()->push(new MainPlay(_scenario, false, true, NULL, &_game_result, &_seconds));
         break;
 
       case PLAYING:
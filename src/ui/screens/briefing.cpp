@@ -23,6 +23,7 @@
 #include "drawing/color.hpp"
 #include "drawing/interface.hpp"
 #include "drawing/shapes.hpp"
+#include "game/globals.hpp"
 #include "game/instruments.hpp"
 #include "game/scenario-maker.hpp"
 #include "math/random.hpp"
@@ -113,7 +114,7 @@ void BriefingScreen::mouse_down(const MouseDownEvent& event) {
     for (size_t i = 0; i < _inline_pict.size(); ++i) {
         if (_inline_pict[i].bounds.contains(event.where())) {
             const int pict_id = _inline_pict[i].id;
-            for (int i = 0; i < globals()->maxBaseObject; ++i) {
+            for (int i = 0; i < plugin()->maxBaseObject; ++i) {
                 if (mGetBaseObjectPtr(i)->pictPortraitResID == pict_id) {
                     stack()->push(new ObjectDataScreen(
                                 event.where(), i, ObjectDataScreen::MOUSE, event.button()));
@@ -307,7 +308,7 @@ void BriefingScreen::show_object_data_key(int index, int key) {
     if (index < _inline_pict.size()) {
         const int pict_id = _inline_pict[index].id;
         const Point origin = _inline_pict[index].bounds.center();
-        for (int i = 0; i < globals()->maxBaseObject; ++i) {
+        for (int i = 0; i < plugin()->maxBaseObject; ++i) {
             if (mGetBaseObjectPtr(i)->pictPortraitResID == pict_id) {
                 stack()->push(new ObjectDataScreen(origin, i, ObjectDataScreen::KEY, key));
                 return;
@@ -19,12 +19,15 @@
 #include "ui/screens/main.hpp"
 
 #include "config/preferences.hpp"
+#include "data/replay.hpp"
+#include "data/resource.hpp"
 #include "drawing/text.hpp"
 #include "game/globals.hpp"
 #include "game/main.hpp"
 #include "game/scenario-maker.hpp"
 #include "game/time.hpp"
 #include "math/random.hpp"
+#include "math/units.hpp"
 #include "sound/music.hpp"
 #include "ui/card.hpp"
 #include "ui/flows/replay-game.hpp"
@@ -43,6 +46,18 @@ namespace {
 const int64_t kMainDemoTimeOutTime = 30e6;
 const int kTitleTextScrollWidth = 450;
 
+// Idle demos pick up somewhere in the first half of the game, so that the title screen doesn't
+// show the same opening every time.  ReplayGame begins at the nearest keyframe, so a demo with
+// no index (an NLRI resource beside its NLRP) still plays from the start.
+uint64_t idle_demo_start(int16_t replay_id) {
+    Resource rsrc("replays", "NLRP", replay_id);
+    ReplayData data(rsrc.data());
+    if (data.duration < 2) {
+        return 0;
+    }
+    return uint64_t(Randomize(int(data.duration / 2))) * kDecideEveryCycles;
+}
+
 }  // namespace
 
 MainScreen::MainScreen():
@@ -79,7 +94,7 @@ void MainScreen::fire_timer() {
     if (demo == _replays.size()) {
         stack()->push(new ScrollTextScreen(5600, kTitleTextScrollWidth, 15.0));
     } else {
-        stack()->push(new ReplayGame(_replays.at(demo)));
+        stack()->push(new ReplayGame(_replays.at(demo), idle_demo_start(_replays.at(demo))));
     }
 }
 
@@ -134,7 +149,7 @@ void MainScreen::handle_button(antares::Button& button) {
         break;
 
       case DEMO:
-        stack()->push(new ReplayGame(_replays.at(rand() % _replays.size())));
+        stack()->push(new ReplayGame(_replays.at(rand() % _replays.size()), 0));
         break;
 
       case REPLAY_INTRO:
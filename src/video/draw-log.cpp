@@ -0,0 +1,282 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "video/draw-log.hpp"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sfz/sfz.hpp>
+
+using sfz::Bytes;
+using sfz::BytesSlice;
+using sfz::Exception;
+using sfz::PrintTarget;
+using sfz::String;
+using sfz::StringSlice;
+using sfz::WriteTarget;
+using sfz::format;
+using sfz::print;
+using sfz::read;
+using sfz::write;
+using std::vector;
+
+namespace utf8 = sfz::utf8;
+
+namespace antares {
+
+namespace {
+
+const char kDrawLogMagic[] = "NLDL";
+const size_t kDrawLogMagicSize = 4;
+
+enum {
+    kNameRecord = 0x01,
+    kFrameRecord = 0x02,
+};
+
+// The name of each command, as TextVideoDriver prints it, and its fields: 'i' for an integer,
+// 'c' for a color, and 'n' for a name.
+const struct {
+    const char* name;
+    const char* fields;
+} kCommands[kDrawCommandCount] = {
+    {"rect",      "iiiic"},
+    {"dither",    "iiiic"},
+    {"point",     "iic"},
+    {"line",      "iiiic"},
+    {"triangle",  "iiiic"},
+    {"diamond",   "iiiic"},
+    {"plus",      "iiiic"},
+    {"draw",      "iiiin"},
+    {"crop",      "iiiiiin"},
+    {"tint",      "iiiicn"},
+    {"static",    "iiiicin"},
+    {"outline",   "iiiiccn"},
+};
+
+void write_varint(WriteTarget out, uint64_t value) {
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value) {
+            byte |= 0x80;
+        }
+        out.push(1, byte);
+    } while (value);
+}
+
+uint64_t read_varint(BytesSlice& in) {
+    uint64_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+        if (shift >= 64) {
+            throw Exception("draw log varint too long");
+        }
+        read(in, byte);
+        value |= uint64_t(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+// Differences wrap around, so that any two int32_t values have one.
+uint32_t zigzag(uint32_t delta) {
+    return (delta << 1) ^ -(delta >> 31);
+}
+
+uint32_t unzigzag(uint32_t value) {
+    return (value >> 1) ^ -(value & 1);
+}
+
+void read_frame(BytesSlice in, const vector<String>& names, vector<String>& commands) {
+    int32_t last[kDrawCommandCount][DrawLogWriter::kMaxIntegers] = {};
+    while (!in.empty()) {
+        uint8_t command;
+        read(in, command);
+        if (command >= kDrawCommandCount) {
+            throw Exception(format("unknown draw log command {0}", command));
+        }
+        String line(kCommands[command].name);
+        int integer = 0;
+        for (const char* field = kCommands[command].fields; *field; ++field) {
+            line.push("\t");
+            switch (*field) {
+              case 'i':
+                {
+                    int32_t& value = last[command][integer++];
+                    value = uint32_t(value) + unzigzag(read_varint(in));
+                    print(line, value);
+                }
+                break;
+              case 'c':
+                {
+                    RgbColor color;
+                    read(in, color.alpha);
+                    read(in, color.red);
+                    read(in, color.green);
+                    read(in, color.blue);
+                    print(line, hex(color));
+                }
+                break;
+              case 'n':
+                {
+                    const uint64_t id = read_varint(in);
+                    if (id >= names.size()) {
+                        throw Exception(format("undefined draw log name {0}", id));
+                    }
+                    print(line, names[id]);
+                }
+                break;
+            }
+        }
+        commands.push_back(line);
+    }
+}
+
+}  // namespace
+
+HexColor hex(RgbColor color) {
+    HexColor result = {color};
+    return result;
+}
+
+void print_to(PrintTarget target, HexColor color) {
+    using sfz::hex;
+    print(target, hex(color.color.red, 2));
+    print(target, hex(color.color.green, 2));
+    print(target, hex(color.color.blue, 2));
+    if (color.color.alpha != 255) {
+        print(target, hex(color.color.alpha, 2));
+    }
+}
+
+DrawLogWriter::DrawLogWriter(const StringSlice& path):
+        _file(open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+        _names_written(0),
+        _command(-1),
+        _integer(0) {
+    write(_file, BytesSlice(kDrawLogMagic));
+    clear();
+}
+
+int32_t DrawLogWriter::intern(const StringSlice& name) {
+    auto it = _ids.find(name);
+    if (it != _ids.end()) {
+        return it->second;
+    }
+    const int32_t id = _names.size();
+    _names.push_back(String(name));
+    _ids[name] = id;
+    return id;
+}
+
+void DrawLogWriter::clear() {
+    _frame.clear();
+    _command = -1;
+    memset(_last, 0, sizeof(_last));
+}
+
+DrawLogWriter& DrawLogWriter::begin(DrawCommand command) {
+    _command = command;
+    _integer = 0;
+    _frame.push(1, command);
+    return *this;
+}
+
+DrawLogWriter& DrawLogWriter::integer(int32_t value) {
+    int32_t& last = _last[_command][_integer++];
+    write_varint(_frame, zigzag(uint32_t(value) - uint32_t(last)));
+    last = value;
+    return *this;
+}
+
+DrawLogWriter& DrawLogWriter::point(const Point& point) {
+    return integer(point.h).integer(point.v);
+}
+
+DrawLogWriter& DrawLogWriter::rect(const Rect& rect) {
+    return integer(rect.left).integer(rect.top).integer(rect.right).integer(rect.bottom);
+}
+
+DrawLogWriter& DrawLogWriter::color(const RgbColor& color) {
+    _frame.push(1, color.alpha);
+    _frame.push(1, color.red);
+    _frame.push(1, color.green);
+    _frame.push(1, color.blue);
+    return *this;
+}
+
+DrawLogWriter& DrawLogWriter::name(int32_t id) {
+    write_varint(_frame, id);
+    return *this;
+}
+
+void DrawLogWriter::write_frame(int64_t ticks) {
+    Bytes record;
+    for ( ; _names_written < _names.size(); ++_names_written) {
+        Bytes name(utf8::encode(_names[_names_written]));
+        record.push(1, kNameRecord);
+        write_varint(record, _names_written);
+        write_varint(record, name.size());
+        record.push(name);
+    }
+    record.push(1, kFrameRecord);
+    write_varint(record, ticks);
+    write_varint(record, _frame.size());
+    record.push(_frame);
+    write(_file, record);
+}
+
+bool read_draw_log(BytesSlice data, vector<DrawLogFrame>& frames) {
+    if ((data.size() < kDrawLogMagicSize)
+            || (data.slice(0, kDrawLogMagicSize) != BytesSlice(kDrawLogMagic))) {
+        return false;
+    }
+    data.shift(kDrawLogMagicSize);
+    vector<String> names;
+    while (!data.empty()) {
+        uint8_t record;
+        read(data, record);
+        if (record == kNameRecord) {
+            if (read_varint(data) != names.size()) {
+                throw Exception("draw log names out of order");
+            }
+            const uint64_t size = read_varint(data);
+            if (size > data.size()) {
+                throw Exception("draw log truncated");
+            }
+            names.push_back(String(utf8::decode(data.slice(0, size))));
+            data.shift(size);
+        } else if (record == kFrameRecord) {
+            frames.emplace_back();
+            frames.back().ticks = read_varint(data);
+            const uint64_t size = read_varint(data);
+            if (size > data.size()) {
+                throw Exception("draw log truncated");
+            }
+            read_frame(data.slice(0, size), names, frames.back().commands);
+            data.shift(size);
+        } else {
+            throw Exception(format("unknown draw log record {0}", record));
+        }
+    }
+    return true;
+}
+
+}  // namespace antares
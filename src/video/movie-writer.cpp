@@ -0,0 +1,101 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+
+#include "video/movie-writer.hpp"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sfz/sfz.hpp>
+
+#include "drawing/color.hpp"
+
+using sfz::ScopedFd;
+using sfz::String;
+using sfz::StringSlice;
+using sfz::format;
+using sfz::range;
+using sfz::write;
+
+namespace utf8 = sfz::utf8;
+
+namespace antares {
+
+namespace {
+
+const char kFrameHeader[] = "FRAME\n";
+const size_t kFrameHeaderSize = sizeof(kFrameHeader) - 1;
+
+// Full-resolution (4:4:4) planes, converted with the integer approximation of BT.601 that most
+// encoders assume for studio-range video.
+uint8_t luma(const RgbColor& c) {
+    return ((66 * c.red + 129 * c.green + 25 * c.blue + 128) >> 8) + 16;
+}
+
+uint8_t blue_difference(const RgbColor& c) {
+    return ((-38 * c.red - 74 * c.green + 112 * c.blue + 128) >> 8) + 128;
+}
+
+uint8_t red_difference(const RgbColor& c) {
+    return ((112 * c.red - 94 * c.green - 18 * c.blue + 128) >> 8) + 128;
+}
+
+}  // namespace
+
+MovieWriter::MovieWriter(const StringSlice& path, Size size):
+        _file(open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+        _size(size),
+        _frame_size(kFrameHeaderSize + (3 * size.width * size.height)),
+        _next_ticks(-1),
+        _frame(new uint8_t[_frame_size]) {
+    memcpy(_frame.get(), kFrameHeader, kFrameHeaderSize);
+}
+
+MovieWriter::~MovieWriter() { }
+
+void MovieWriter::write_frame(int64_t ticks, const PixMap& pix) {
+    if (_next_ticks < 0) {
+        String header(format(
+                    "YUV4MPEG2 W{0} H{1} F60:1 Ip A1:1 C444 XANTARES_START_TICK={2}\n",
+                    _size.width, _size.height, ticks));
+        write(_file, utf8::encode(header));
+    } else if (ticks < _next_ticks) {
+        return;
+    } else {
+        for (int64_t i = _next_ticks; i < ticks; ++i) {
+            write(_file, _frame.get(), _frame_size);
+        }
+    }
+
+    const int32_t plane_size = _size.width * _size.height;
+    uint8_t* y = _frame.get() + kFrameHeaderSize;
+    uint8_t* cb = y + plane_size;
+    uint8_t* cr = cb + plane_size;
+    for (int32_t row: range(_size.height)) {
+        const RgbColor* in = pix.row(row);
+        for (int32_t col: range(_size.width)) {
+            *(y++) = luma(in[col]);
+            *(cb++) = blue_difference(in[col]);
+            *(cr++) = red_difference(in[col]);
+        }
+    }
+    write(_file, _frame.get(), _frame_size);
+    _next_ticks = ticks + 1;
+}
+
+}  // namespace antares
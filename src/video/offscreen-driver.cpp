@@ -18,7 +18,6 @@
 
 #include "video/offscreen-driver.hpp"
 
-#include <fcntl.h>
 #include <stdlib.h>
 #include <strings.h>
 #include <algorithm>
@@ -28,20 +27,20 @@
 
 #include "cocoa/core-opengl.hpp"
 #include "config/preferences.hpp"
+#include "drawing/pix-kernels.hpp"
 #include "drawing/pix-map.hpp"
 #include "game/time.hpp"
 #include "math/geometry.hpp"
 #include "ui/card.hpp"
 #include "ui/event.hpp"
+#include "video/movie-writer.hpp"
+#include "video/snapshot-writer.hpp"
 
 using sfz::BytesSlice;
 using sfz::Exception;
 using sfz::Optional;
-using sfz::ScopedFd;
 using sfz::String;
 using sfz::StringSlice;
-using sfz::WriteTarget;
-using sfz::dec;
 using sfz::format;
 using sfz::range;
 using std::greater;
@@ -64,21 +63,14 @@ class SnapshotBuffer {
     int32_t width() const { return _screen_size.width; }
     int32_t height() const { return _screen_size.height; }
     int32_t row_bytes() const { return width() * _bytes_per_pixel; }
+    const uint8_t* data() const { return _data.get(); }
     void* mutable_data() { return _data.get(); }
 
-    void write_to(const WriteTarget& out) const {
-        ArrayPixMap pix(_screen_size.width, _screen_size.height);
-        uint8_t* p = _data.get();
+    void copy_to(ArrayPixMap& pix) const {
+        const PixKernels& kernels = pix_kernels();
         for (int32_t y: range(_screen_size.height)) {
-            for (int32_t x: range(_screen_size.width)) {
-                uint8_t blue = *(p++);
-                uint8_t green = *(p++);
-                uint8_t red = *(p++);
-                ++p;
-                pix.set(x, y, RgbColor(red, green, blue));
-            }
+            kernels.convert_bgra(pix.mutable_row(y), _data.get() + (y * row_bytes()), width());
         }
-        write(out, pix);
     }
 
   private:
@@ -87,10 +79,6 @@ class SnapshotBuffer {
     unique_ptr<uint8_t[]> _data;
 };
 
-void write_to(const WriteTarget& out, const SnapshotBuffer& buffer) {
-    buffer.write_to(out);
-}
-
 static const CGLPixelFormatAttribute kAttrs[] = {
     kCGLPFAColorSize, static_cast<CGLPixelFormatAttribute>(24),
     // kCGLPFAAccelerated,
@@ -110,18 +98,34 @@ class OffscreenVideoDriver::MainLoop : public EventScheduler::MainLoop {
             _setup(_context, _buffer),
             _output_dir(output_dir),
             _loop(driver, initial) {
+        if (!driver._movie_path.empty()) {
+            _movie.reset(new MovieWriter(
+                        driver._movie_path, Preferences::preferences()->screen_size()));
+        } else if (_output_dir.has()) {
+            _snapshots.reset(new SnapshotWriter(
+                        format("{0}/screens", *_output_dir),
+                        Preferences::preferences()->screen_size()));
+        }
     }
 
     bool takes_snapshots() {
-        return _output_dir.has();
+        return _output_dir.has() || _movie.get();
     }
 
     void snapshot(int64_t ticks) {
-        String dir(format("{0}/screens", *_output_dir));
-        makedirs(dir, 0755);
-        String path(format("{0}/{1}.png", dir, dec(ticks, 6)));
-        ScopedFd file(open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644));
-        write(file, _buffer);
+        if (_movie.get()) {
+            ArrayPixMap pix(_buffer.width(), _buffer.height());
+            _buffer.copy_to(pix);
+            _movie->write_frame(ticks, pix);
+            return;
+        }
+        _snapshots->write_bgra_frame(ticks, _buffer.data(), _buffer.row_bytes());
+    }
+
+    void finish() {
+        if (_snapshots.get()) {
+            _snapshots->finish();
+        }
     }
 
     void draw() { _loop.draw(); }
@@ -141,6 +145,8 @@ class OffscreenVideoDriver::MainLoop : public EventScheduler::MainLoop {
     };
     Setup _setup;
     Optional<String> _output_dir;
+    unique_ptr<MovieWriter> _movie;
+    unique_ptr<SnapshotWriter> _snapshots;
     OpenGlVideoDriver::MainLoop _loop;
 };
 
@@ -150,9 +156,14 @@ OffscreenVideoDriver::OffscreenVideoDriver(
         _output_dir(output_dir),
         _scheduler(scheduler) { }
 
+void OffscreenVideoDriver::write_movie(const StringSlice& path) {
+    _movie_path.assign(path);
+}
+
 void OffscreenVideoDriver::loop(Card* initial) {
     MainLoop loop(*this, _output_dir, initial);
     _scheduler.loop(loop);
+    loop.finish();
 }
 
 }  // namespace antares
@@ -42,6 +42,7 @@ using sfz::format;
 using sfz::print;
 using std::min;
 using std::max;
+using std::shared_ptr;
 using std::unique_ptr;
 
 namespace io = sfz::io;
@@ -68,30 +69,36 @@ static const GLchar* kShaderSource =
     "uniform int seed;\n"
     "\n"
     "void main() {\n"
+    "    int mode = color_mode;\n"
+    "    float fraction = static_fraction;\n"
+    "    if (mode < 0) {\n"
+    "        mode = int(gl_TexCoord[2].s + 0.5);\n"
+    "        fraction = gl_TexCoord[2].t;\n"
+    "    }\n"
     "    vec2 uv = gl_TexCoord[0].xy;\n"
     "    vec4 sprite_color = texture2DRect(sprite, uv);\n"
-    "    if (color_mode == 0) {\n"
+    "    if (mode == 0) {\n"
     "        gl_FragColor = gl_Color;\n"
-    "    } else if (color_mode == 1) {\n"
+    "    } else if (mode == 1) {\n"
     "        if (mod(floor(gl_TexCoord[1].s) + floor(gl_TexCoord[1].t), 2) == 1) {\n"
     "            gl_FragColor = gl_Color;\n"
     "        } else {\n"
     "            gl_FragColor = vec4(0, 0, 0, 0);\n"
     "        }\n"
-    "    } else if (color_mode == 2) {\n"
+    "    } else if (mode == 2) {\n"
     "        gl_FragColor = sprite_color;\n"
-    "    } else if (color_mode == 3) {\n"
+    "    } else if (mode == 3) {\n"
     "        gl_FragColor = gl_Color * sprite_color;\n"
-    "    } else if (color_mode == 4) {\n"
+    "    } else if (mode == 4) {\n"
     "        vec2 uv2 = (gl_TexCoord[1].xy + vec2(seed / 256, seed)) * vec2(1.0/256, 1.0/256);\n"
     "        vec4 static_color = texture2D(static_image, uv2);\n"
-    "        if (static_color.w <= static_fraction) {\n"
+    "        if (static_color.w <= fraction) {\n"
     "            vec4 sprite_alpha = vec4(1, 1, 1, sprite_color.w);\n"
     "            gl_FragColor = gl_Color * sprite_alpha;\n"
     "        } else {\n"
     "            gl_FragColor = sprite_color;\n"
     "        }\n"
-    "    } else if (color_mode == 5) {\n"
+    "    } else if (mode == 5) {\n"
     "        float neighborhood =\n"
     "                texture2DRect(sprite, uv + vec2(-unit.s, -unit.t)).w +\n"
     "                texture2DRect(sprite, uv + vec2(-unit.s,       0)).w +\n"
@@ -137,35 +144,135 @@ void gl_log(GLint object) {
     print(io::err, format("object {0} log: {1}\n", object, (const char*)log.get()));
 }
 
-class OpenGlSprite : public Sprite {
+// Sprites are packed into atlases of this size, except for those too big to share one, which
+// get a texture of their own.
+const int32_t kAtlasSize = 1024;
+const int32_t kMaxPackedSize = kAtlasSize / 4;
+
+// Color modes, as the shader numbers them.  A negative color_mode uniform makes the shader take
+// the mode from the vertex instead.
+enum {
+    kFillMode = 0,
+    kDitherMode = 1,
+    kSpriteMode = 2,
+    kShadedMode = 3,
+    kStaticMode = 4,
+    kOutlineMode = 5,
+    kVertexMode = -1,
+};
+
+GLenum pixel_type() {
+#if defined(__LITTLE_ENDIAN__)
+    return GL_UNSIGNED_INT_8_8_8_8;
+#elif defined(__BIG_ENDIAN__)
+    return GL_UNSIGNED_INT_8_8_8_8_REV;
+#else
+#error "Couldn't determine endianness of platform"
+#endif
+}
+
+}  // namespace
+
+// A texture holding many sprites, placed in rows ("shelves") from the top down.  Space is not
+// reused as sprites are freed; instead, an atlas is emptied once all of its sprites are gone.
+class OpenGlVideoDriver::Atlas {
   public:
-    OpenGlSprite(PrintItem name, const PixMap& image, const OpenGlVideoDriver::Uniforms& uniforms)
-            : _name(name),
-              _size(image.size()),
-              _uniforms(uniforms) {
+    Atlas(Size size):
+            _size(size),
+            _shelf_top(0),
+            _shelf_height(0),
+            _shelf_right(0),
+            _sprites(0) {
         glBindTexture(GL_TEXTURE_RECTANGLE_EXT, _texture.id);
         glTexParameteri(GL_TEXTURE_RECTANGLE_EXT, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_RECTANGLE_EXT, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_RECTANGLE_EXT, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_RECTANGLE_EXT, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-#if defined(__LITTLE_ENDIAN__)
-        GLenum type = GL_UNSIGNED_INT_8_8_8_8;
-#elif defined(__BIG_ENDIAN__)
-        GLenum type = GL_UNSIGNED_INT_8_8_8_8_REV;
-#else
-#error "Couldn't determine endianness of platform"
-#endif
+        glTexImage2D(
+                GL_TEXTURE_RECTANGLE_EXT, 0, GL_RGBA, size.width, size.height,
+                0, GL_BGRA, pixel_type(), NULL);
+    }
+
+    GLuint id() const { return _texture.id; }
+    bool empty() const { return _sprites == 0; }
+    bool dedicated() const { return (_size.width != kAtlasSize) || (_size.height != kAtlasSize); }
+
+    // Reserves `size` texels, setting `origin` to their top left.  Returns false if there's no
+    // room left.
+    bool allocate(Size size, Point* origin) {
+        if (empty()) {
+            _shelf_top = _shelf_height = _shelf_right = 0;
+        }
+        if ((_shelf_right + size.width) > _size.width) {
+            _shelf_top += _shelf_height;
+            _shelf_height = 0;
+            _shelf_right = 0;
+        }
+        if (((_shelf_right + size.width) > _size.width)
+                || ((_shelf_top + size.height) > _size.height)) {
+            return false;
+        }
+        *origin = Point(_shelf_right, _shelf_top);
+        _shelf_right += size.width;
+        _shelf_height = max(_shelf_height, size.height);
+        ++_sprites;
+        return true;
+    }
+
+    void release() {
+        --_sprites;
+    }
 
-        // Add a 1-pixel clear border.  Color mode 5 (outline) won't work unless we do this.
+    void upload(Point origin, const PixMap& image) {
+        glBindTexture(GL_TEXTURE_RECTANGLE_EXT, _texture.id);
+        glTexSubImage2D(
+                GL_TEXTURE_RECTANGLE_EXT, 0, origin.h, origin.v,
+                image.size().width, image.size().height, GL_BGRA, pixel_type(), image.bytes());
+        gl_check();
+    }
+
+  private:
+    struct Texture {
+        Texture() { glGenTextures(1, &id); }
+        ~Texture() { glDeleteTextures(1, &id); }
+
+        GLuint id;
+        DISALLOW_COPY_AND_ASSIGN(Texture);
+    };
+
+    const Size _size;
+    Texture _texture;
+    int32_t _shelf_top;
+    int32_t _shelf_height;
+    int32_t _shelf_right;
+    int _sprites;
+
+    DISALLOW_COPY_AND_ASSIGN(Atlas);
+};
+
+// Holds its atlas by shared_ptr, since some sprites outlive the driver.
+class OpenGlVideoDriver::Sprite : public antares::Sprite {
+  public:
+    Sprite(PrintItem name, const PixMap& image, OpenGlVideoDriver& driver)
+            : _name(name),
+              _size(image.size()),
+              _driver(driver) {
+        // Add a 1-pixel clear border.  Color mode 5 (outline) won't work unless we do this, and
+        // it keeps sampling from straying into the neighboring sprites of the atlas.
         Size size = image.size();
         size.width += 2;
         size.height += 2;
         ArrayPixMap copy(size);
         copy.fill(RgbColor::kClear);
         copy.view(Rect(1, 1, size.width - 1, size.height - 1)).copy(image);
-        glTexImage2D(
-                GL_TEXTURE_RECTANGLE_EXT, 0, GL_RGBA, size.width, size.height,
-                0, GL_BGRA, type, copy.bytes());
+        _atlas = driver.allocate(size, &_origin);
+        _atlas->upload(_origin, copy);
+        _bounds = Rect(_origin, image.size());
+        _bounds.offset(1, 1);
+    }
+
+    ~Sprite() {
+        _atlas->release();
     }
 
     virtual StringSlice name() const {
@@ -173,115 +280,94 @@ class OpenGlSprite : public Sprite {
     }
 
     virtual void draw(const Rect& draw_rect) const {
-        glUniform1i(_uniforms.color_mode, 2);
-        draw_internal(draw_rect);
+        _driver.enqueue(_atlas, draw_rect, _bounds, RgbColor::kWhite, kSpriteMode, 0);
     }
 
     virtual void draw_cropped(const Rect& draw_rect, Point origin) const {
+        // Texels outside the sprite would be clear, so leave them out rather than sample the
+        // neighbors in the atlas.
         Rect texture_rect(origin, draw_rect.size());
-        texture_rect.offset(1, 1);
-
-        glUniform1i(_uniforms.color_mode, 2);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_RECTANGLE_EXT, _texture.id);
-        gl_check();
-        glBegin(GL_QUADS);
-        glMultiTexCoord2f(GL_TEXTURE0, texture_rect.left, texture_rect.top);
-        glVertex2f(draw_rect.left, draw_rect.top);
-        glMultiTexCoord2f(GL_TEXTURE0, texture_rect.left, texture_rect.bottom);
-        glVertex2f(draw_rect.left, draw_rect.bottom);
-        glMultiTexCoord2f(GL_TEXTURE0, texture_rect.right, texture_rect.bottom);
-        glVertex2f(draw_rect.right, draw_rect.bottom);
-        glMultiTexCoord2f(GL_TEXTURE0, texture_rect.right, texture_rect.top);
-        glVertex2f(draw_rect.right, draw_rect.top);
-        glEnd();
-        gl_check();
+        texture_rect.offset(_bounds.left, _bounds.top);
+        Rect clipped(texture_rect);
+        clipped.clip_to(_bounds);
+        if (clipped.empty()) {
+            return;
+        }
+        Rect to(draw_rect);
+        to.left += clipped.left - texture_rect.left;
+        to.top += clipped.top - texture_rect.top;
+        to.right -= texture_rect.right - clipped.right;
+        to.bottom -= texture_rect.bottom - clipped.bottom;
+        _driver.enqueue(_atlas, to, clipped, RgbColor::kWhite, kSpriteMode, 0);
     }
 
     virtual void draw_shaded(const Rect& draw_rect, const RgbColor& tint) const {
-        glColor4ub(tint.red, tint.green, tint.blue, 255);
-        glUniform1i(_uniforms.color_mode, 3);
-        draw_internal(draw_rect);
+        const RgbColor color(255, tint.red, tint.green, tint.blue);
+        _driver.enqueue(_atlas, draw_rect, _bounds, color, kShadedMode, 0);
     }
 
     virtual void draw_static(const Rect& draw_rect, const RgbColor& color, uint8_t frac) const {
-        glColor4ub(color.red, color.green, color.blue, color.alpha);
-        glUniform1i(_uniforms.color_mode, 4);
-        glUniform1f(_uniforms.static_fraction, frac / 255.0);
-        draw_internal(draw_rect);
+        _driver.enqueue(_atlas, draw_rect, _bounds, color, kStaticMode, frac / 255.0);
     }
 
+    // Not batched: the outline needs the unit and outline_color uniforms.
     virtual void draw_outlined(
             const Rect& draw_rect, const RgbColor& outline_color,
             const RgbColor& fill_color) const {
-        glUniform1i(_uniforms.color_mode, 5);
+        _driver.flush();
+        const OpenGlVideoDriver::Uniforms& uniforms = _driver._uniforms;
+        glUniform1i(uniforms.color_mode, kOutlineMode);
         glUniform2f(
-                _uniforms.unit,
+                uniforms.unit,
                 double(_size.width) / draw_rect.width(),
                 double(_size.height) / draw_rect.height());
         glColor4ub(fill_color.red, fill_color.green, fill_color.blue, fill_color.alpha);
         glUniform4f(
-                _uniforms.outline_color, outline_color.red / 255.0, outline_color.green / 255.0,
+                uniforms.outline_color, outline_color.red / 255.0, outline_color.green / 255.0,
                 outline_color.blue / 255.0, outline_color.alpha / 255.0);
-        draw_internal(draw_rect);
-    }
-
-    virtual const Size& size() const {
-        return _size;
-    }
 
-  private:
-    virtual void draw_internal(const Rect& draw_rect) const {
-        const int32_t w = _size.width;
-        const int32_t h = _size.height;
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_RECTANGLE_EXT, _texture.id);
+        glBindTexture(GL_TEXTURE_RECTANGLE_EXT, _atlas->id());
         gl_check();
         glBegin(GL_QUADS);
-        glMultiTexCoord2f(GL_TEXTURE0, 1, 1);
-        glMultiTexCoord2f(GL_TEXTURE1, draw_rect.left, draw_rect.top);
+        glMultiTexCoord2f(GL_TEXTURE0, _bounds.left, _bounds.top);
         glVertex2f(draw_rect.left, draw_rect.top);
-        glMultiTexCoord2f(GL_TEXTURE0, 1, h + 1);
-        glMultiTexCoord2f(GL_TEXTURE1, draw_rect.left, draw_rect.bottom);
+        glMultiTexCoord2f(GL_TEXTURE0, _bounds.left, _bounds.bottom);
         glVertex2f(draw_rect.left, draw_rect.bottom);
-        glMultiTexCoord2f(GL_TEXTURE0, w + 1, h + 1);
-        glMultiTexCoord2f(GL_TEXTURE1, draw_rect.right, draw_rect.bottom);
+        glMultiTexCoord2f(GL_TEXTURE0, _bounds.right, _bounds.bottom);
         glVertex2f(draw_rect.right, draw_rect.bottom);
-        glMultiTexCoord2f(GL_TEXTURE0, w + 1, 1);
-        glMultiTexCoord2f(GL_TEXTURE1, draw_rect.right, draw_rect.top);
+        glMultiTexCoord2f(GL_TEXTURE0, _bounds.right, _bounds.top);
         glVertex2f(draw_rect.right, draw_rect.top);
         glEnd();
         gl_check();
     }
 
-    struct Texture {
-        Texture() { glGenTextures(1, &id); }
-        ~Texture() { glDeleteTextures(1, &id); }
-
-        GLuint id;
-        DISALLOW_COPY_AND_ASSIGN(Texture);
-    };
+    virtual const Size& size() const {
+        return _size;
+    }
 
+  private:
     const String _name;
-    Texture _texture;
     Size _size;
-    const OpenGlVideoDriver::Uniforms& _uniforms;
+    OpenGlVideoDriver& _driver;
+    std::shared_ptr<Atlas> _atlas;
+    Point _origin;
+    Rect _bounds;  // the sprite within the atlas, not counting its border
 
-    DISALLOW_COPY_AND_ASSIGN(OpenGlSprite);
+    DISALLOW_COPY_AND_ASSIGN(Sprite);
 };
 
-}  // namespace
-
 OpenGlVideoDriver::OpenGlVideoDriver(Size screen_size)
         : _screen_size(screen_size),
           _static_seed{0} { }
 
 unique_ptr<Sprite> OpenGlVideoDriver::new_sprite(PrintItem name, const PixMap& content) {
-    return unique_ptr<Sprite>(new OpenGlSprite(name, content, _uniforms));
+    return unique_ptr<antares::Sprite>(new Sprite(name, content, *this));
 }
 
 void OpenGlVideoDriver::fill_rect(const Rect& rect, const RgbColor& color) {
-    glUniform1i(_uniforms.color_mode, 0);
+    flush();
+    glUniform1i(_uniforms.color_mode, kFillMode);
     glColor4ub(color.red, color.green, color.blue, color.alpha);
     glBegin(GL_QUADS);
     glVertex2f(rect.right, rect.top);
@@ -292,7 +378,8 @@ void OpenGlVideoDriver::fill_rect(const Rect& rect, const RgbColor& color) {
 }
 
 void OpenGlVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
-    glUniform1i(_uniforms.color_mode, 1);
+    flush();
+    glUniform1i(_uniforms.color_mode, kDitherMode);
     glColor4ub(color.red, color.green, color.blue, color.alpha);
     glBegin(GL_QUADS);
     glMultiTexCoord2f(GL_TEXTURE1, rect.right, rect.top);
@@ -307,7 +394,8 @@ void OpenGlVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
 }
 
 void OpenGlVideoDriver::draw_point(const Point& at, const RgbColor& color) {
-    glUniform1i(_uniforms.color_mode, 0);
+    flush();
+    glUniform1i(_uniforms.color_mode, kFillMode);
     glColor4ub(color.red, color.green, color.blue, color.alpha);
     glBegin(GL_POINTS);
     glVertex2f(at.h + 0.5, at.v + 0.5);
@@ -315,7 +403,8 @@ void OpenGlVideoDriver::draw_point(const Point& at, const RgbColor& color) {
 }
 
 void OpenGlVideoDriver::draw_line(const Point& from, const Point& to, const RgbColor& color) {
-    glUniform1i(_uniforms.color_mode, 0);
+    flush();
+    glUniform1i(_uniforms.color_mode, kFillMode);
 
     // Shortcut: when `from` == `to`, we can draw just a point.
     if (from == to) {
@@ -418,6 +507,97 @@ void OpenGlVideoDriver::draw_plus(const Rect& rect, const RgbColor& color) {
     _pluses[size]->draw_shaded(to, color);
 }
 
+shared_ptr<OpenGlVideoDriver::Atlas> OpenGlVideoDriver::allocate(Size size, Point* origin) {
+    if ((size.width > kMaxPackedSize) || (size.height > kMaxPackedSize)) {
+        shared_ptr<Atlas> atlas(new Atlas(size));
+        atlas->allocate(size, origin);
+        _atlases.push_back(atlas);
+        return atlas;
+    }
+
+    // Before reusing the space of an emptied atlas, draw anything queued from it.  Emptied
+    // atlases of single sprites are dropped.
+    for (auto it = _atlases.begin(); it != _atlases.end(); ) {
+        if ((*it)->empty()) {
+            if (*it == _batch_atlas) {
+                flush();
+            }
+            if ((*it)->dedicated()) {
+                it = _atlases.erase(it);
+                continue;
+            }
+        }
+        ++it;
+    }
+    for (const shared_ptr<Atlas>& atlas: _atlases) {
+        if (!atlas->dedicated() && atlas->allocate(size, origin)) {
+            return atlas;
+        }
+    }
+    shared_ptr<Atlas> atlas(new Atlas(Size(kAtlasSize, kAtlasSize)));
+    atlas->allocate(size, origin);
+    _atlases.push_back(atlas);
+    return atlas;
+}
+
+void OpenGlVideoDriver::enqueue(
+        const shared_ptr<Atlas>& atlas, const Rect& draw_rect, const Rect& texture_rect,
+        const RgbColor& color, int mode, float fraction) {
+    if (atlas != _batch_atlas) {
+        flush();
+        _batch_atlas = atlas;
+    }
+    const Point corners[4][2] = {
+        {Point(draw_rect.left, draw_rect.top), Point(texture_rect.left, texture_rect.top)},
+        {Point(draw_rect.left, draw_rect.bottom), Point(texture_rect.left, texture_rect.bottom)},
+        {Point(draw_rect.right, draw_rect.bottom), Point(texture_rect.right, texture_rect.bottom)},
+        {Point(draw_rect.right, draw_rect.top), Point(texture_rect.right, texture_rect.top)},
+    };
+    for (const auto& corner: corners) {
+        Vertex vertex = {
+            float(corner[0].h), float(corner[0].v),
+            float(corner[1].h), float(corner[1].v),
+            float(mode), fraction,
+            {color.red, color.green, color.blue, color.alpha},
+        };
+        _batch.push_back(vertex);
+    }
+}
+
+void OpenGlVideoDriver::flush() {
+    if (_batch.empty()) {
+        return;
+    }
+    glUniform1i(_uniforms.color_mode, kVertexMode);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_RECTANGLE_EXT, _batch_atlas->id());
+
+    // The second texture coordinate is the screen position, as the static uses it.
+    const Vertex* v = _batch.data();
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &v->x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), v->color);
+    const GLenum units[] = {GL_TEXTURE0, GL_TEXTURE1, GL_TEXTURE2};
+    const float* coords[] = {&v->u, &v->x, &v->mode};
+    for (int i = 0; i < 3; ++i) {
+        glClientActiveTexture(units[i]);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), coords[i]);
+    }
+
+    glDrawArrays(GL_QUADS, 0, _batch.size());
+
+    for (int i = 2; i >= 0; --i) {
+        glClientActiveTexture(units[i]);
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    }
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    gl_check();
+    _batch.clear();
+}
+
 OpenGlVideoDriver::MainLoop::Setup::Setup(OpenGlVideoDriver& driver) {
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glClearColor(0, 0, 0, 1);
@@ -518,6 +698,7 @@ void OpenGlVideoDriver::MainLoop::draw() {
     gl_check();
 
     _stack.top()->draw();
+    _driver.flush();
 
     glPopMatrix();
     glMatrixMode(GL_PROJECTION);
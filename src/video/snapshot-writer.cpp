@@ -0,0 +1,188 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "video/snapshot-writer.hpp"
+
+#include <fcntl.h>
+#include <string.h>
+#include <algorithm>
+#include <sfz/sfz.hpp>
+
+#include "drawing/color.hpp"
+#include "drawing/pix-kernels.hpp"
+
+using sfz::Bytes;
+using sfz::ScopedFd;
+using sfz::String;
+using sfz::StringSlice;
+using sfz::dec;
+using sfz::format;
+using sfz::range;
+using sfz::write;
+using std::exception_ptr;
+using std::lock_guard;
+using std::max;
+using std::mutex;
+using std::thread;
+using std::unique_lock;
+using std::unique_ptr;
+
+namespace antares {
+
+struct SnapshotWriter::Frame {
+    Frame(Size size):
+            raw(new uint8_t[size.width * size.height * 4]),
+            pix(size) { }
+
+    int64_t sequence;
+    int64_t ticks;
+
+    // If set, the snapshot is still BGRA in `raw`, and the worker converts it into `pix`.
+    bool bgra;
+    unique_ptr<uint8_t[]> raw;
+    ArrayPixMap pix;
+};
+
+SnapshotWriter::SnapshotWriter(const StringSlice& dir, Size size):
+        _dir(dir),
+        _size(size),
+        _next_sequence(0),
+        _next_written(0),
+        _stopping(false) {
+    makedirs(_dir, 0755);
+
+    // Leave a core for the simulation, and give each worker two buffers, so that there is one to
+    // fill while the other is being encoded.
+    const size_t jobs = max<size_t>(thread::hardware_concurrency(), 2) - 1;
+    while (_frames.size() < 2 * jobs) {
+        _frames.emplace_back(new Frame(_size));
+        _free.push_back(_frames.back().get());
+    }
+    while (_threads.size() < jobs) {
+        _threads.push_back(thread([this] { work(); }));
+    }
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    {
+        lock_guard<mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _queued.notify_all();
+    for (thread& t: _threads) {
+        t.join();
+    }
+}
+
+void SnapshotWriter::write_frame(int64_t ticks, const PixMap& pix) {
+    Frame* frame = acquire();
+    frame->ticks = ticks;
+    frame->bgra = false;
+    frame->pix.copy(pix);
+    submit(frame);
+}
+
+void SnapshotWriter::write_bgra_frame(int64_t ticks, const uint8_t* data, int32_t row_bytes) {
+    Frame* frame = acquire();
+    frame->ticks = ticks;
+    frame->bgra = true;
+    const size_t width_bytes = _size.width * 4;
+    for (int32_t y: range(_size.height)) {
+        memcpy(frame->raw.get() + (y * width_bytes), data + (y * row_bytes), width_bytes);
+    }
+    submit(frame);
+}
+
+void SnapshotWriter::finish() {
+    unique_lock<mutex> lock(_mutex);
+    _written.wait(lock, [this] { return _next_written == _next_sequence; });
+    if (_error) {
+        std::rethrow_exception(_error);
+    }
+}
+
+SnapshotWriter::Frame* SnapshotWriter::acquire() {
+    unique_lock<mutex> lock(_mutex);
+    _written.wait(lock, [this] { return !_free.empty(); });
+    if (_error) {
+        std::rethrow_exception(_error);
+    }
+    Frame* frame = _free.back();
+    _free.pop_back();
+    return frame;
+}
+
+void SnapshotWriter::submit(Frame* frame) {
+    {
+        lock_guard<mutex> lock(_mutex);
+        frame->sequence = _next_sequence++;
+        _pending.push_back(frame);
+    }
+    _queued.notify_one();
+}
+
+// Workers take frames in the order they were queued, but may finish encoding them in any order.
+// Each waits for its turn before writing its file, so that files are completed in order.
+void SnapshotWriter::work() {
+    unique_lock<mutex> lock(_mutex);
+    while (true) {
+        _queued.wait(lock, [this] { return _stopping || !_pending.empty(); });
+        if (_pending.empty()) {
+            return;
+        }
+        Frame* frame = _pending.front();
+        _pending.pop_front();
+        lock.unlock();
+
+        exception_ptr error;
+        Bytes png;
+        try {
+            if (frame->bgra) {
+                pix_kernels().convert_bgra(
+                        frame->pix.mutable_bytes(), frame->raw.get(),
+                        _size.width * _size.height);
+            }
+            write(png, frame->pix);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        _written.wait(lock, [this, frame] { return _next_written == frame->sequence; });
+        lock.unlock();
+        if (!error) {
+            try {
+                String path(format("{0}/{1}.png", _dir, dec(frame->ticks, 6)));
+                ScopedFd file(open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644));
+                write(file, png);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        lock.lock();
+        if (error && !_error) {
+            _error = error;
+        }
+        ++_next_written;
+        _free.push_back(frame);
+        _written.notify_all();
+    }
+}
+
+}  // namespace antares
@@ -0,0 +1,422 @@
+// Copyright (C) 1997, 1999-2001, 2008 Nathan Lamont
+// Copyright (C) 2008-2012 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "video/software-driver.hpp"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+#include <sfz/sfz.hpp>
+
+#include "drawing/color.hpp"
+#include "drawing/pix-map.hpp"
+#include "drawing/shapes.hpp"
+#include "math/geometry.hpp"
+#include "ui/card.hpp"
+#include "video/movie-writer.hpp"
+#include "video/snapshot-writer.hpp"
+
+using sfz::Optional;
+using sfz::PrintItem;
+using sfz::String;
+using sfz::StringSlice;
+using sfz::format;
+using std::abs;
+using std::max;
+using std::min;
+using std::unique_ptr;
+using std::vector;
+
+namespace antares {
+
+namespace {
+
+// Matches the static texture of OpenGlVideoDriver, which is 256x256 and repeats.
+const int32_t kStaticSize = 256;
+
+// `over` * `alpha` + `under` * (1 - `alpha`), in 8-bit fixed point.
+inline uint8_t mix(uint8_t over, uint8_t under, uint8_t alpha) {
+    return ((over * alpha) + (under * (255 - alpha)) + 127) / 255;
+}
+
+// `x` * `y`, as the shader multiplies normalized colors.
+inline uint8_t modulate(uint8_t x, uint8_t y) {
+    return ((x * y) + 127) / 255;
+}
+
+// As glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA).  The screen has no alpha channel of
+// its own, so `under` stays opaque.
+inline void blend_pixel(RgbColor* under, const RgbColor& over) {
+    if (over.alpha == 255) {
+        *under = RgbColor(over.red, over.green, over.blue);
+    } else if (over.alpha > 0) {
+        under->red = mix(over.red, under->red, over.alpha);
+        under->green = mix(over.green, under->green, over.alpha);
+        under->blue = mix(over.blue, under->blue, over.alpha);
+    }
+}
+
+// Which of `size` texels GL_NEAREST samples for the center of pixel `i`, when they are stretched
+// across `scaled` pixels.  May be outside [0, size) if `i` is outside [0, scaled).
+inline int32_t texel(int32_t i, int32_t size, int32_t scaled) {
+    if (i < 0) {
+        return -1;
+    }
+    return (((2 * i) + 1) * size) / (2 * scaled);
+}
+
+}  // namespace
+
+class SoftwareVideoDriver::Sprite : public antares::Sprite {
+  public:
+    Sprite(PrintItem name, SoftwareVideoDriver& driver, const PixMap& image):
+            _name(name),
+            _driver(driver),
+            _image(image.size()) {
+        _image.copy(image);
+    }
+
+    virtual StringSlice name() const { return _name; }
+
+    // Color mode 2: the sprite as is.
+    virtual void draw(const Rect& draw_rect) const {
+        render(draw_rect, [](int32_t, int32_t, const RgbColor& sprite) -> RgbColor {
+            return sprite;
+        });
+    }
+
+    // Also color mode 2, but unscaled, from `origin` within the sprite.  Texels past the edge
+    // of the sprite are clear, as its texture has a clear border.
+    virtual void draw_cropped(const Rect& draw_rect, Point origin) const {
+        Rect clipped(draw_rect);
+        clipped.clip_to(_driver.screen_rect());
+        const Rect bounds(Point(0, 0), _image.size());
+        for (int32_t y = clipped.top; y < clipped.bottom; ++y) {
+            RgbColor* out = _driver._screen.mutable_row(y);
+            const int32_t v = origin.v + (y - draw_rect.top);
+            for (int32_t x = clipped.left; x < clipped.right; ++x) {
+                const Point p(origin.h + (x - draw_rect.left), v);
+                if (bounds.contains(p)) {
+                    blend_pixel(out + x, _image.get(p.h, p.v));
+                }
+            }
+        }
+    }
+
+    // Color mode 3: the sprite multiplied by `tint`, keeping the sprite's alpha.
+    virtual void draw_shaded(const Rect& draw_rect, const RgbColor& tint) const {
+        render(draw_rect, [&tint](int32_t, int32_t, const RgbColor& sprite) -> RgbColor {
+            return RgbColor(
+                    sprite.alpha, modulate(tint.red, sprite.red),
+                    modulate(tint.green, sprite.green), modulate(tint.blue, sprite.blue));
+        });
+    }
+
+    // Color mode 4: where the static is at most `frac`, `color` in the shape of the sprite;
+    // elsewhere, the sprite as is.
+    virtual void draw_static(const Rect& draw_rect, const RgbColor& color, uint8_t frac) const {
+        const SoftwareVideoDriver& driver = _driver;
+        render(draw_rect, [&driver, &color, frac](
+                    int32_t x, int32_t y, const RgbColor& sprite) -> RgbColor {
+            if (driver.static_at(x, y) <= frac) {
+                return RgbColor(
+                        modulate(color.alpha, sprite.alpha), color.red, color.green, color.blue);
+            }
+            return sprite;
+        });
+    }
+
+    // Color mode 5: `outline_color` where the sprite is more opaque than the average of its
+    // eight neighbors, `fill_color` elsewhere within the sprite, and nothing outside of it.
+    virtual void draw_outlined(
+            const Rect& draw_rect, const RgbColor& outline_color,
+            const RgbColor& fill_color) const {
+        if (draw_rect.empty() || _image.size().width == 0 || _image.size().height == 0) {
+            return;
+        }
+        Rect clipped(draw_rect);
+        clipped.clip_to(_driver.screen_rect());
+        for (int32_t y = clipped.top; y < clipped.bottom; ++y) {
+            RgbColor* out = _driver._screen.mutable_row(y);
+            const int32_t j = y - draw_rect.top;
+            for (int32_t x = clipped.left; x < clipped.right; ++x) {
+                const int32_t i = x - draw_rect.left;
+                const int alpha = alpha_at(i, j, draw_rect);
+                if (alpha == 0) {
+                    continue;
+                }
+                const int neighborhood =
+                    alpha_at(i - 1, j - 1, draw_rect) + alpha_at(i - 1, j, draw_rect) +
+                    alpha_at(i - 1, j + 1, draw_rect) + alpha_at(i, j - 1, draw_rect) +
+                    alpha_at(i, j + 1, draw_rect) + alpha_at(i + 1, j - 1, draw_rect) +
+                    alpha_at(i + 1, j, draw_rect) + alpha_at(i + 1, j + 1, draw_rect);
+                if ((alpha * 8) > neighborhood) {
+                    blend_pixel(out + x, outline_color);
+                } else {
+                    blend_pixel(out + x, fill_color);
+                }
+            }
+        }
+    }
+
+    virtual const Size& size() const { return _image.size(); }
+
+  private:
+    // Calls `shade(x, y, sprite)` for each on-screen pixel of `draw_rect`, with the texel of
+    // the sprite that falls there, and blends the result onto the screen.
+    template <typename Shade>
+    void render(const Rect& draw_rect, Shade shade) const {
+        const Size& size = _image.size();
+        if (draw_rect.empty() || (size.width == 0) || (size.height == 0)) {
+            return;
+        }
+        Rect clipped(draw_rect);
+        clipped.clip_to(_driver.screen_rect());
+        if (clipped.empty()) {
+            return;
+        }
+        vector<int32_t> columns(clipped.width());
+        for (int32_t x = clipped.left; x < clipped.right; ++x) {
+            columns[x - clipped.left] = texel(x - draw_rect.left, size.width, draw_rect.width());
+        }
+        for (int32_t y = clipped.top; y < clipped.bottom; ++y) {
+            const RgbColor* in = _image.row(
+                    texel(y - draw_rect.top, size.height, draw_rect.height()));
+            RgbColor* out = _driver._screen.mutable_row(y) + clipped.left;
+            for (int32_t i = 0; i < clipped.width(); ++i) {
+                blend_pixel(out + i, shade(clipped.left + i, y, in[columns[i]]));
+            }
+        }
+    }
+
+    // The alpha of the texel that pixel (i, j) of `draw_rect` samples, or 0 outside the sprite.
+    int alpha_at(int32_t i, int32_t j, const Rect& draw_rect) const {
+        const Size& size = _image.size();
+        const int32_t u = texel(i, size.width, draw_rect.width());
+        const int32_t v = texel(j, size.height, draw_rect.height());
+        if ((u < 0) || (u >= size.width) || (v < 0) || (v >= size.height)) {
+            return 0;
+        }
+        return _image.get(u, v).alpha;
+    }
+
+    const String _name;
+    SoftwareVideoDriver& _driver;
+    ArrayPixMap _image;
+
+    DISALLOW_COPY_AND_ASSIGN(Sprite);
+};
+
+class SoftwareVideoDriver::MainLoop : public EventScheduler::MainLoop {
+  public:
+    MainLoop(SoftwareVideoDriver& driver, const Optional<String>& output_dir, Card* initial):
+            _driver(driver),
+            _output_dir(output_dir),
+            _stack(initial) {
+        if (!driver._movie_path.empty()) {
+            _movie.reset(new MovieWriter(driver._movie_path, driver._screen.size()));
+        } else if (_output_dir.has()) {
+            _snapshots.reset(new SnapshotWriter(
+                        format("{0}/screens", *_output_dir), driver._screen.size()));
+        }
+    }
+
+    bool takes_snapshots() {
+        return _output_dir.has() || _movie.get();
+    }
+
+    void snapshot(int64_t ticks) {
+        if (_movie.get()) {
+            _movie->write_frame(ticks, _driver._screen);
+            return;
+        }
+        _snapshots->write_frame(ticks, _driver._screen);
+    }
+
+    void finish() {
+        if (_snapshots.get()) {
+            _snapshots->finish();
+        }
+    }
+
+    void draw() {
+        if (done()) {
+            return;
+        }
+        _driver._screen.fill(RgbColor::kBlack);
+        _driver._seed = _driver._static_seed.next(256);
+        _driver._seed <<= 8;
+        _driver._seed += _driver._static_seed.next(256);
+        _stack.top()->draw();
+    }
+
+    bool done() const { return _stack.empty(); }
+    Card* top() const { return _stack.top(); }
+
+  private:
+    SoftwareVideoDriver& _driver;
+    Optional<String> _output_dir;
+    unique_ptr<MovieWriter> _movie;
+    unique_ptr<SnapshotWriter> _snapshots;
+    CardStack _stack;
+};
+
+SoftwareVideoDriver::SoftwareVideoDriver(
+        Size screen_size, EventScheduler& scheduler, const Optional<String>& output_dir):
+        _scheduler(scheduler),
+        _output_dir(output_dir),
+        _screen(screen_size),
+        _static(new uint8_t[kStaticSize * kStaticSize]),
+        _static_seed{0},
+        _seed(0) {
+    _screen.fill(RgbColor::kBlack);
+    Random static_index = {0};
+    for (int i = 0; i < (kStaticSize * kStaticSize); ++i) {
+        _static[i] = static_index.next(256);
+    }
+}
+
+unique_ptr<Sprite> SoftwareVideoDriver::new_sprite(PrintItem name, const PixMap& content) {
+    return unique_ptr<antares::Sprite>(new Sprite(name, *this, content));
+}
+
+void SoftwareVideoDriver::fill_rect(const Rect& rect, const RgbColor& color) {
+    Rect clipped(rect);
+    clipped.clip_to(screen_rect());
+    for (int32_t y = clipped.top; y < clipped.bottom; ++y) {
+        RgbColor* out = _screen.mutable_row(y);
+        for (int32_t x = clipped.left; x < clipped.right; ++x) {
+            blend_pixel(out + x, color);
+        }
+    }
+}
+
+// Color mode 1: `color` on the pixels whose coordinates have an odd sum.
+void SoftwareVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
+    Rect clipped(rect);
+    clipped.clip_to(screen_rect());
+    for (int32_t y = clipped.top; y < clipped.bottom; ++y) {
+        RgbColor* out = _screen.mutable_row(y);
+        for (int32_t x = clipped.left + ((clipped.left + y + 1) & 1); x < clipped.right; x += 2) {
+            blend_pixel(out + x, color);
+        }
+    }
+}
+
+void SoftwareVideoDriver::draw_point(const Point& at, const RgbColor& color) {
+    blend(at.h, at.v, color);
+}
+
+void SoftwareVideoDriver::draw_line(const Point& from, const Point& to, const RgbColor& color) {
+    // Points and horizontal or vertical lines are drawn exactly as OpenGlVideoDriver draws them.
+    if ((from.h == to.h) || (from.v == to.v)) {
+        Rect rect(
+                min(from.h, to.h), min(from.v, to.v),
+                max(from.h, to.h) + 1, max(from.v, to.v) + 1);
+        fill_rect(rect, color);
+        return;
+    }
+
+    // Other lines use Bresenham's algorithm, including both end points.
+    const int32_t dx = abs(to.h - from.h);
+    const int32_t dy = -abs(to.v - from.v);
+    const int32_t sx = (from.h < to.h) ? 1 : -1;
+    const int32_t sy = (from.v < to.v) ? 1 : -1;
+    int32_t error = dx + dy;
+    Point p = from;
+    while (true) {
+        blend(p.h, p.v, color);
+        if (p == to) {
+            break;
+        }
+        const int32_t e2 = 2 * error;
+        if (e2 >= dy) {
+            error += dy;
+            p.h += sx;
+        }
+        if (e2 <= dx) {
+            error += dx;
+            p.v += sy;
+        }
+    }
+}
+
+void SoftwareVideoDriver::draw_triangle(const Rect& rect, const RgbColor& color) {
+    size_t size = min(rect.width(), rect.height());
+    Rect to(0, 0, size, size);
+    to.offset(rect.left, rect.top);
+    if (_triangles.find(size) == _triangles.end()) {
+        ArrayPixMap pix(size, size);
+        pix.fill(RgbColor::kClear);
+        draw_triangle_up(&pix, RgbColor::kWhite);
+        _triangles[size] = new_sprite("", pix);
+    }
+    _triangles[size]->draw_shaded(to, color);
+}
+
+void SoftwareVideoDriver::draw_diamond(const Rect& rect, const RgbColor& color) {
+    size_t size = min(rect.width(), rect.height());
+    Rect to(0, 0, size, size);
+    to.offset(rect.left, rect.top);
+    if (_diamonds.find(size) == _diamonds.end()) {
+        ArrayPixMap pix(size, size);
+        pix.fill(RgbColor::kClear);
+        draw_compat_diamond(&pix, RgbColor::kWhite);
+        _diamonds[size] = new_sprite("", pix);
+    }
+    _diamonds[size]->draw_shaded(to, color);
+}
+
+void SoftwareVideoDriver::draw_plus(const Rect& rect, const RgbColor& color) {
+    size_t size = min(rect.width(), rect.height());
+    Rect to(0, 0, size, size);
+    to.offset(rect.left, rect.top);
+    if (_pluses.find(size) == _pluses.end()) {
+        ArrayPixMap pix(size, size);
+        pix.fill(RgbColor::kClear);
+        draw_compat_plus(&pix, RgbColor::kWhite);
+        _pluses[size] = new_sprite("", pix);
+    }
+    _pluses[size]->draw_shaded(to, color);
+}
+
+void SoftwareVideoDriver::write_movie(const StringSlice& path) {
+    _movie_path.assign(path);
+}
+
+void SoftwareVideoDriver::loop(Card* initial) {
+    MainLoop loop(*this, _output_dir, initial);
+    _scheduler.loop(loop);
+    loop.finish();
+}
+
+void SoftwareVideoDriver::blend(int32_t x, int32_t y, const RgbColor& color) {
+    if (screen_rect().contains(Point(x, y))) {
+        blend_pixel(_screen.mutable_row(y) + x, color);
+    }
+}
+
+// The shader offsets its lookup into the static texture by (seed / 256, seed), with integer
+// division, and the texture repeats.
+uint8_t SoftwareVideoDriver::static_at(int32_t x, int32_t y) const {
+    const int32_t s = (x + (_seed / 256)) & (kStaticSize - 1);
+    const int32_t t = (y + _seed) & (kStaticSize - 1);
+    return _static[(t * kStaticSize) + s];
+}
+
+}  // namespace antares
@@ -22,11 +22,8 @@
 #include <stdlib.h>
 #include <strings.h>
 #include <algorithm>
-#include <OpenGL/OpenGL.h>
-#include <OpenGL/gl.h>
 #include <sfz/sfz.hpp>
 
-#include "cocoa/core-opengl.hpp"
 #include "config/preferences.hpp"
 #include "drawing/pix-map.hpp"
 #include "game/globals.hpp"
@@ -34,16 +31,15 @@
 #include "math/geometry.hpp"
 #include "ui/card.hpp"
 #include "ui/event.hpp"
+#include "video/draw-log.hpp"
 
 using sfz::Optional;
 using sfz::PrintItem;
-using sfz::PrintTarget;
 using sfz::ScopedFd;
 using sfz::String;
 using sfz::StringSlice;
 using sfz::dec;
 using sfz::format;
-using sfz::print;
 using sfz::write;
 using std::make_pair;
 using std::pair;
@@ -52,33 +48,13 @@ namespace utf8 = sfz::utf8;
 
 namespace antares {
 
-namespace {
-
-struct HexColor {
-    RgbColor color;
-};
-HexColor hex(RgbColor color) {
-    HexColor result = {color};
-    return result;
-}
-void print_to(PrintTarget target, HexColor color) {
-    using sfz::hex;
-    print(target, hex(color.color.red, 2));
-    print(target, hex(color.color.green, 2));
-    print(target, hex(color.color.blue, 2));
-    if (color.color.alpha != 255) {
-        print(target, hex(color.color.alpha, 2));
-    }
-}
-
-}  // namespace
-
 class TextVideoDriver::Sprite : public antares::Sprite {
   public:
     Sprite(PrintItem name, TextVideoDriver& driver, Size size):
             _name(name),
             _driver(driver),
-            _size(size) { }
+            _size(size),
+            _id(-1) { }
 
     virtual StringSlice name() const { return _name; }
 
@@ -86,6 +62,10 @@ class TextVideoDriver::Sprite : public antares::Sprite {
         if (!world.intersects(draw_rect)) {
             return;
         }
+        if (DrawLogWriter* draw_log = begin(kDrawCommand)) {
+            draw_log->rect(draw_rect).name(_id);
+            return;
+        }
         PrintItem args[] = {
             draw_rect.left, draw_rect.top, draw_rect.right, draw_rect.bottom,
             _name,
@@ -97,6 +77,10 @@ class TextVideoDriver::Sprite : public antares::Sprite {
         if (!world.intersects(draw_rect)) {
             return;
         }
+        if (DrawLogWriter* draw_log = begin(kCropCommand)) {
+            draw_log->rect(draw_rect).point(origin).name(_id);
+            return;
+        }
         PrintItem args[] = {
             draw_rect.left, draw_rect.top, draw_rect.right, draw_rect.bottom,
             origin.h, origin.v, _name,
@@ -108,6 +92,10 @@ class TextVideoDriver::Sprite : public antares::Sprite {
         if (!world.intersects(draw_rect)) {
             return;
         }
+        if (DrawLogWriter* draw_log = begin(kTintCommand)) {
+            draw_log->rect(draw_rect).color(tint).name(_id);
+            return;
+        }
         PrintItem args[] = {
             draw_rect.left, draw_rect.top, draw_rect.right, draw_rect.bottom,
             hex(tint), _name,
@@ -119,6 +107,10 @@ class TextVideoDriver::Sprite : public antares::Sprite {
         if (!world.intersects(draw_rect)) {
             return;
         }
+        if (DrawLogWriter* draw_log = begin(kStaticCommand)) {
+            draw_log->rect(draw_rect).color(color).integer(frac).name(_id);
+            return;
+        }
         PrintItem args[] = {
             draw_rect.left, draw_rect.top, draw_rect.right, draw_rect.bottom,
             hex(color), frac, _name,
@@ -132,6 +124,10 @@ class TextVideoDriver::Sprite : public antares::Sprite {
         if (!world.intersects(draw_rect)) {
             return;
         }
+        if (DrawLogWriter* draw_log = begin(kOutlineCommand)) {
+            draw_log->rect(draw_rect).color(outline_color).color(fill_color).name(_id);
+            return;
+        }
         PrintItem args[] = {
             draw_rect.left, draw_rect.top, draw_rect.right, draw_rect.bottom,
             hex(outline_color), hex(fill_color), _name,
@@ -142,9 +138,22 @@ class TextVideoDriver::Sprite : public antares::Sprite {
     virtual const Size& size() const { return _size; }
 
   private:
+    // Starts a command in the draw log, if there is one.
+    DrawLogWriter* begin(DrawCommand command) const {
+        DrawLogWriter* draw_log = _driver._draw_log.get();
+        if (draw_log) {
+            if (_id < 0) {
+                _id = draw_log->intern(_name);
+            }
+            draw_log->begin(command);
+        }
+        return draw_log;
+    }
+
     String _name;
     TextVideoDriver& _driver;
     Size _size;
+    mutable int32_t _id;  // in the draw log
 };
 
 class TextVideoDriver::MainLoop : public EventScheduler::MainLoop {
@@ -155,10 +164,14 @@ class TextVideoDriver::MainLoop : public EventScheduler::MainLoop {
             _stack(initial) { }
 
     bool takes_snapshots() {
-        return _output_dir.has();
+        return _output_dir.has() || _driver._draw_log.get();
     }
 
     void snapshot(int64_t ticks) {
+        if (_driver._draw_log.get()) {
+            _driver._draw_log->write_frame(ticks);
+            return;
+        }
         String dir(format("{0}/screens", *_output_dir));
         makedirs(dir, 0755);
         String path(format("{0}/{1}.txt", dir, dec(ticks, 6)));
@@ -167,6 +180,9 @@ class TextVideoDriver::MainLoop : public EventScheduler::MainLoop {
     }
 
     void draw() {
+        if (_driver._draw_log.get()) {
+            _driver._draw_log->clear();
+        }
         _driver._log.clear();
         _driver._last_args.clear();
         _stack.top()->draw();
@@ -194,21 +210,37 @@ void TextVideoDriver::fill_rect(const Rect& rect, const RgbColor& color) {
     if (!world.intersects(rect)) {
         return;
     }
+    if (_draw_log.get()) {
+        _draw_log->begin(kRectCommand).rect(rect).color(color);
+        return;
+    }
     PrintItem args[] = {rect.left, rect.top, rect.right, rect.bottom, hex(color)};
     log("rect", args);
 }
 
 void TextVideoDriver::dither_rect(const Rect& rect, const RgbColor& color) {
+    if (_draw_log.get()) {
+        _draw_log->begin(kDitherCommand).rect(rect).color(color);
+        return;
+    }
     PrintItem args[] = {rect.left, rect.top, rect.right, rect.bottom, hex(color)};
     log("dither", args);
 }
 
 void TextVideoDriver::draw_point(const Point& at, const RgbColor& color) {
+    if (_draw_log.get()) {
+        _draw_log->begin(kPointCommand).point(at).color(color);
+        return;
+    }
     PrintItem args[] = {at.h, at.v, hex(color)};
     log("point", args);
 }
 
 void TextVideoDriver::draw_line(const Point& from, const Point& to, const RgbColor& color) {
+    if (_draw_log.get()) {
+        _draw_log->begin(kLineCommand).point(from).point(to).color(color);
+        return;
+    }
     PrintItem args[] = {from.h, from.v, to.h, to.v, hex(color)};
     log("line", args);
 }
@@ -217,6 +249,10 @@ void TextVideoDriver::draw_triangle(const Rect& rect, const RgbColor& color) {
     if (!world.intersects(rect)) {
         return;
     }
+    if (_draw_log.get()) {
+        _draw_log->begin(kTriangleCommand).rect(rect).color(color);
+        return;
+    }
     PrintItem args[] = {rect.left, rect.top, rect.right, rect.bottom, hex(color)};
     log("triangle", args);
 }
@@ -225,6 +261,10 @@ void TextVideoDriver::draw_diamond(const Rect& rect, const RgbColor& color) {
     if (!world.intersects(rect)) {
         return;
     }
+    if (_draw_log.get()) {
+        _draw_log->begin(kDiamondCommand).rect(rect).color(color);
+        return;
+    }
     PrintItem args[] = {rect.left, rect.top, rect.right, rect.bottom, hex(color)};
     log("diamond", args);
 }
@@ -233,10 +273,18 @@ void TextVideoDriver::draw_plus(const Rect& rect, const RgbColor& color) {
     if (!world.intersects(rect)) {
         return;
     }
+    if (_draw_log.get()) {
+        _draw_log->begin(kPlusCommand).rect(rect).color(color);
+        return;
+    }
     PrintItem args[] = {rect.left, rect.top, rect.right, rect.bottom, hex(color)};
     log("plus", args);
 }
 
+void TextVideoDriver::write_draw_log(const StringSlice& path) {
+    _draw_log.reset(new DrawLogWriter(path));
+}
+
 void TextVideoDriver::loop(Card* initial) {
     MainLoop loop(*this, _output_dir, initial);
     _scheduler.loop(loop);
@@ -258,6 +306,10 @@ sfz::StringSlice TextVideoDriver::last_arg(size_t index) const {
 
 template <int size>
 void TextVideoDriver::log(StringSlice command, PrintItem (&args)[size]) {
+    // Without an output directory, the log would never be written, so don't format it.
+    if (!_output_dir.has()) {
+        return;
+    }
     vector<pair<size_t, size_t>> this_args;
     bool new_command = _last_args.empty() || (command != last_arg(0));
 